@@ -0,0 +1,61 @@
+// Copyright (c) 2015 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+
+#include "arith_uint256.h"
+#include "memusage.h"
+#include "txdb.h"
+
+#include <iostream>
+
+/** Number of entries per page, as a caller of getaddressdeltas with "limit" would ask for */
+static const size_t PAGE_SIZE = 100;
+
+static void FillAddressIndex(CExplorerIndexDB& db, const uint160& hash, int nEntries)
+{
+    std::vector<std::pair<CAddressIndexKey, CAmount> > vect;
+    vect.reserve(nEntries);
+    for (int i = 0; i < nEntries; i++)
+        vect.push_back(std::make_pair(CAddressIndexKey(1, hash, i / 10 + 1, i % 10, ArithToUint256(arith_uint256(i)), 0, false), 1000));
+    CDBBatch batch(db);
+    db.BatchAddressIndex(batch, vect, false);
+    db.WriteBatch(batch);
+}
+
+// Reading a page from the middle of an address's history takes the same time
+// and memory however long the history is; reading it all grows with it.
+// The memory the entries of one read take is reported on stderr, next to the timings.
+static void AddressIndexRead(benchmark::State& state, const char* pszName, int nHistory, bool fPaged)
+{
+    CExplorerIndexDB db("bench", 8 << 20, true, true);
+    uint160 hash;
+    FillAddressIndex(db, hash, nHistory);
+    CAddressIndexKey cursor(1, hash, nHistory / 20 + 1, 0, uint256(), 0, false);
+
+    size_t nPeakUsage = 0;
+    while (state.KeepRunning()) {
+        std::vector<std::pair<CAddressIndexKey, CAmount> > entries;
+        if (fPaged) {
+            db.ForEachAddressIndex(hash, 1, 0, 0, &cursor, [&entries](const CAddressIndexKey& key, CAmount amount) {
+                entries.push_back(std::make_pair(key, amount));
+                return entries.size() < PAGE_SIZE;
+            });
+        } else {
+            db.ReadAddressIndex(hash, 1, entries);
+        }
+        nPeakUsage = std::max(nPeakUsage, memusage::DynamicUsage(entries));
+    }
+    std::cerr << pszName << ",memory," << nPeakUsage << " bytes\n";
+}
+
+static void AddressIndexPage1k(benchmark::State& state) { AddressIndexRead(state, "AddressIndexPage1k", 1000, true); }
+static void AddressIndexPage100k(benchmark::State& state) { AddressIndexRead(state, "AddressIndexPage100k", 100000, true); }
+static void AddressIndexFull1k(benchmark::State& state) { AddressIndexRead(state, "AddressIndexFull1k", 1000, false); }
+static void AddressIndexFull100k(benchmark::State& state) { AddressIndexRead(state, "AddressIndexFull100k", 100000, false); }
+
+BENCHMARK(AddressIndexPage1k);
+BENCHMARK(AddressIndexPage100k);
+BENCHMARK(AddressIndexFull1k);
+BENCHMARK(AddressIndexFull100k);
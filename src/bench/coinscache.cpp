@@ -0,0 +1,77 @@
+// Copyright (c) 2017 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+
+#include "coins.h"
+#include "random.h"
+
+#include <unordered_map>
+
+/** Outputs in the cache, about what a few hundred MB of -dbcache holds */
+static const int CACHE_COINS = 200000;
+
+static std::vector<COutPoint> MakeOutpoints(int nCount)
+{
+    std::vector<COutPoint> outpoints;
+    outpoints.reserve(nCount);
+    for (int i = 0; i < nCount; i++)
+        outpoints.push_back(COutPoint(GetRandHash(), i % 4));
+    return outpoints;
+}
+
+static Coin MakeCoin()
+{
+    Coin coin;
+    coin.out.nValue = 1000;
+    coin.out.scriptPubKey = CScript() << OP_DUP << OP_HASH160 << std::vector<unsigned char>(20, 0) << OP_EQUALVERIFY << OP_CHECKSIG;
+    coin.nHeight = 1;
+    return coin;
+}
+
+// Fill a map the way FetchCoin and BatchWrite do, look every entry up, then
+// erase them all the way a flush does. The std::unordered_map variant is the
+// map the cache used before.
+template <typename Map>
+static void CoinsMapCycle(benchmark::State& state)
+{
+    static const std::vector<COutPoint> outpoints = MakeOutpoints(CACHE_COINS);
+    const Coin coin = MakeCoin();
+    while (state.KeepRunning()) {
+        Map map;
+        for (const COutPoint& outpoint : outpoints) {
+            Coin copy(coin);
+            map.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::forward_as_tuple(std::move(copy)));
+        }
+        for (const COutPoint& outpoint : outpoints)
+            assert(map.find(outpoint) != map.end());
+        for (typename Map::iterator it = map.begin(); it != map.end(); )
+            map.erase(it++);
+    }
+}
+
+static void CoinsMapPooled(benchmark::State& state) { CoinsMapCycle<CCoinsMap>(state); }
+static void CoinsMapUnordered(benchmark::State& state) { CoinsMapCycle<std::unordered_map<COutPoint, CCoinsCacheEntry, SaltedOutpointHasher> >(state); }
+
+// Add coins to a child cache, then flush them into its parent, as connecting
+// a block does.
+static void CoinsCacheFlush(benchmark::State& state)
+{
+    static const std::vector<COutPoint> outpoints = MakeOutpoints(CACHE_COINS / 10);
+    const Coin coin = MakeCoin();
+    CCoinsView base;
+    while (state.KeepRunning()) {
+        CCoinsViewCache parent(&base);
+        CCoinsViewCache child(&parent);
+        for (const COutPoint& outpoint : outpoints)
+            child.AddCoin(outpoint, Coin(coin), false);
+        for (const COutPoint& outpoint : outpoints)
+            assert(child.HaveCoin(outpoint));
+        child.Flush();
+    }
+}
+
+BENCHMARK(CoinsMapPooled);
+BENCHMARK(CoinsMapUnordered);
+BENCHMARK(CoinsCacheFlush);
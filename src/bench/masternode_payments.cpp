@@ -0,0 +1,55 @@
+// Copyright (c) 2014-2017 The TIMECoin Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+
+#include "masternode-payments.h"
+#include "random.h"
+#include "script/standard.h"
+
+#include <vector>
+
+/** Blocks a node keeps the payment votes of, the storage limit of a large network */
+static const int VOTE_BLOCKS = 5000;
+
+/** The votes of MNPAYMENTS_SIGNATURES_TOTAL masternodes for every block, created once */
+static const std::vector<CMasternodePaymentVote>& GetPaymentVotes()
+{
+    static std::vector<CMasternodePaymentVote> vecVotes;
+    if (!vecVotes.empty())
+        return vecVotes;
+
+    std::vector<COutPoint> vecVoters;
+    for (int i = 0; i < MNPAYMENTS_SIGNATURES_TOTAL; i++)
+        vecVoters.push_back(COutPoint(GetRandHash(), 0));
+
+    for (int nHeight = 0; nHeight < VOTE_BLOCKS; nHeight++) {
+        uint256 hashPayee = GetRandHash();
+        CScript payee = GetScriptForDestination(CKeyID(uint160(std::vector<unsigned char>(hashPayee.begin(), hashPayee.begin() + 20))));
+        for (const auto& outpoint : vecVoters) {
+            CMasternodePaymentVote vote(outpoint, nHeight, payee);
+            // votes are not signed here, only stored
+            vote.vchSig.resize(65);
+            vecVotes.push_back(vote);
+        }
+    }
+    return vecVotes;
+}
+
+// Receiving the votes of every block, then pruning the oldest block once per new tip
+static void MasternodePaymentVotes(benchmark::State& state)
+{
+    const std::vector<CMasternodePaymentVote>& vecVotes = GetPaymentVotes();
+    while (state.KeepRunning()) {
+        CMasternodePayments payments;
+        for (const auto& vote : vecVotes) {
+            payments.RecordPaymentVote(vote);
+            payments.StorePaymentVote(vote);
+        }
+        for (int nHeight = 1; nHeight <= VOTE_BLOCKS; nHeight++)
+            payments.RemoveBlocksBelow(nHeight);
+    }
+}
+
+BENCHMARK(MasternodePaymentVotes);
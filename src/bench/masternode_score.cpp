@@ -0,0 +1,61 @@
+// Copyright (c) 2014-2017 The TIMECoin Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+
+#include "hash.h"
+#include "masternode.h"
+#include "random.h"
+
+#include <vector>
+
+/** Masternodes scored for each block, as for the payment queue and the ranks */
+static const int SCORE_MASTERNODES = 5000;
+
+static std::vector<CMasternode>& GetMasternodes()
+{
+    static std::vector<CMasternode> vecMasternodes;
+    if (!vecMasternodes.empty())
+        return vecMasternodes;
+
+    for (int i = 0; i < SCORE_MASTERNODES; i++) {
+        CMasternode mn;
+        mn.vin = CTxIn(COutPoint(GetRandHash(), GetRandInt(8)));
+        mn.nCollateralMinConfBlockHash = GetRandHash();
+        mn.UpdateScoreMidstate();
+        vecMasternodes.push_back(mn);
+    }
+    return vecMasternodes;
+}
+
+// Hashing all 100 bytes for every masternode, as the scores were calculated before the midstates
+static void MasternodeScoreCHashWriter(benchmark::State& state)
+{
+    const std::vector<CMasternode>& vecMasternodes = GetMasternodes();
+    uint256 blockHash = GetRandHash();
+    while (state.KeepRunning()) {
+        for (const auto& mn : vecMasternodes) {
+            CHashWriter ss(SER_GETHASH, PROTOCOL_VERSION);
+            ss << mn.vin.prevout << mn.nCollateralMinConfBlockHash << blockHash;
+            UintToArith256(ss.GetHash());
+        }
+    }
+}
+
+static void MasternodeScores(benchmark::State& state)
+{
+    std::vector<CMasternode>& vecMasternodes = GetMasternodes();
+    std::vector<CMasternode*> vecPointers;
+    for (auto& mn : vecMasternodes)
+        vecPointers.push_back(&mn);
+
+    uint256 blockHash = GetRandHash();
+    std::vector<arith_uint256> vecScores;
+    while (state.KeepRunning()) {
+        CMasternode::CalculateScores(vecPointers, blockHash, vecScores);
+    }
+}
+
+BENCHMARK(MasternodeScoreCHashWriter);
+BENCHMARK(MasternodeScores);
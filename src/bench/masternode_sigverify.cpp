@@ -0,0 +1,188 @@
+// Copyright (c) 2014-2017 The TIMECoin Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+
+#include "key.h"
+#include "masternode.h"
+#include "masternode-sigverify.h"
+#include "messagesigner.h"
+#include "netbase.h"
+#include "random.h"
+#include "util.h"
+
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+/** Masternodes in the synthetic list a node syncs */
+static const int SYNC_MASTERNODES = 5000;
+
+/** The mnb and mnp messages of a full list sync, signed once and copied for each run */
+static const std::vector<CMasternodeSigVerifier::CMessage>& GetSyncMessages()
+{
+    static std::vector<CMasternodeSigVerifier::CMessage> vecMessages;
+    if (!vecMessages.empty())
+        return vecMessages;
+
+    for (int i = 0; i < SYNC_MASTERNODES; i++) {
+        CKey keyCollateral, keyMasternode;
+        keyCollateral.MakeNewKey(true);
+        keyMasternode.MakeNewKey(true);
+        COutPoint outpoint(GetRandHash(), 0);
+        CService service = LookupNumeric(strprintf("10.%d.%d.1", i / 256, i % 256).c_str(), 9999);
+
+        CMasternodeBroadcast mnb(service, outpoint, keyCollateral.GetPubKey(), keyMasternode.GetPubKey(), PROTOCOL_VERSION);
+        CMasternodePing mnp;
+        mnp.vin = CTxIn(outpoint);
+        mnp.blockHash = GetRandHash();
+        if (!mnp.Sign(keyMasternode, keyMasternode.GetPubKey()) || !mnb.Sign(keyCollateral))
+            assert(false);
+        mnb.lastPing = mnp;
+
+        CMasternodeSigVerifier::CMessage message;
+        message.mnb = mnb;
+        // as received from the network, with the signature not checked yet
+        message.mnb.fSignatureChecked = false;
+        vecMessages.push_back(message);
+
+        message = CMasternodeSigVerifier::CMessage();
+        message.fPing = true;
+        message.mnp = mnp;
+        message.mnp.pubKeySignatureChecked = CPubKey();
+        message.pubKeyMasternode = keyMasternode.GetPubKey();
+        vecMessages.push_back(message);
+    }
+    return vecMessages;
+}
+
+// Verifying the signatures of the list one message at a time, as
+// CMasternodeMan::ProcessMessage did before the verifier threads
+static void MasternodeSigVerifySerial(benchmark::State& state)
+{
+    const std::vector<CMasternodeSigVerifier::CMessage>& vecMessages = GetSyncMessages();
+    while (state.KeepRunning()) {
+        std::vector<CMasternodeSigVerifier::CMessage> vecCopy(vecMessages);
+        for (auto& message : vecCopy)
+            CMasternodeSigVerifier::Verify(message);
+    }
+}
+
+static void MasternodeSigVerifyParallel(benchmark::State& state)
+{
+    const std::vector<CMasternodeSigVerifier::CMessage>& vecMessages = GetSyncMessages();
+
+    CMasternodeSigVerifier verifier;
+    boost::thread_group threads;
+    for (int i = 0; i < MAX_MASTERNODE_SIGVERIFY_THREADS; i++)
+        threads.create_thread(boost::bind(&CMasternodeSigVerifier::Thread, &verifier));
+
+    while (state.KeepRunning()) {
+        for (const auto& message : vecMessages) {
+            if (message.fPing)
+                verifier.PushPing(message.nodeId, message.mnp, message.pubKeyMasternode);
+            else
+                verifier.PushBroadcast(message.nodeId, message.mnb);
+        }
+        std::vector<CMasternodeSigVerifier::CMessage> vecVerified;
+        while (true) {
+            verifier.PopVerified(vecVerified);
+            if (vecVerified.size() == vecMessages.size())
+                break;
+            MilliSleep(1);
+        }
+    }
+
+    threads.interrupt_all();
+    threads.join_all();
+}
+
+/** Addresses we get mnv replies from, each shared by a few masternodes of which one is real */
+static const int VERIFY_ADDRESSES = 1000;
+static const int VERIFY_MASTERNODES_PER_ADDRESS = 4;
+
+struct VerifyReply
+{
+    CMasternodeVerification mnv;
+    std::string strMessage1;
+    // the keys of the masternodes with the address of the reply
+    std::vector<CPubKey> vecPubKeys;
+};
+
+static const std::vector<VerifyReply>& GetVerifyReplies()
+{
+    static std::vector<VerifyReply> vecReplies;
+    if (!vecReplies.empty())
+        return vecReplies;
+
+    uint256 blockHash = GetRandHash();
+    for (int i = 0; i < VERIFY_ADDRESSES; i++) {
+        VerifyReply reply;
+        CService service = LookupNumeric(strprintf("10.%d.%d.1", i / 256, i % 256).c_str(), 9999);
+        reply.mnv = CMasternodeVerification(service, GetRandInt(999999), 1000);
+        reply.strMessage1 = strprintf("%s%d%s", service.ToString(false), reply.mnv.nonce, blockHash.ToString());
+        for (int j = 0; j < VERIFY_MASTERNODES_PER_ADDRESS; j++) {
+            CKey key;
+            key.MakeNewKey(true);
+            reply.vecPubKeys.push_back(key.GetPubKey());
+            // the real one is the last one tried
+            if (j == VERIFY_MASTERNODES_PER_ADDRESS - 1 && !CMessageSigner::SignMessage(reply.strMessage1, reply.mnv.vchSig1, key))
+                assert(false);
+        }
+        vecReplies.push_back(reply);
+    }
+    return vecReplies;
+}
+
+// Checking each reply against every masternode at its address in turn, as
+// ProcessVerifyReply did before the verifier threads
+static void MasternodeVerifyReplySerial(benchmark::State& state)
+{
+    const std::vector<VerifyReply>& vecReplies = GetVerifyReplies();
+    while (state.KeepRunning()) {
+        for (const auto& reply : vecReplies) {
+            std::string strError;
+            for (const auto& pubKey : reply.vecPubKeys) {
+                if (CMessageSigner::VerifyMessage(pubKey, reply.mnv.vchSig1, reply.strMessage1, strError))
+                    break;
+            }
+        }
+    }
+}
+
+static void MasternodeVerifyReplyParallel(benchmark::State& state)
+{
+    const std::vector<VerifyReply>& vecReplies = GetVerifyReplies();
+
+    CMasternodeSigVerifier verifier;
+    boost::thread_group threads;
+    for (int i = 0; i < MAX_MASTERNODE_SIGVERIFY_THREADS; i++)
+        threads.create_thread(boost::bind(&CMasternodeSigVerifier::Thread, &verifier));
+
+    while (state.KeepRunning()) {
+        for (const auto& reply : vecReplies)
+            verifier.PushVerification(-1, reply.mnv, reply.strMessage1, "");
+        std::vector<CMasternodeSigVerifier::CMessage> vecVerified;
+        while (vecVerified.size() < vecReplies.size()) {
+            verifier.PopVerified(vecVerified);
+            MilliSleep(1);
+        }
+        // then matching the signer by key id, as CMasternodeMan does
+        for (size_t i = 0; i < vecVerified.size(); i++) {
+            for (const auto& pubKey : vecReplies[i].vecPubKeys) {
+                if (pubKey.GetID() == vecVerified[i].keyIDSigner1)
+                    break;
+            }
+        }
+    }
+
+    threads.interrupt_all();
+    threads.join_all();
+}
+
+BENCHMARK(MasternodeSigVerifySerial);
+BENCHMARK(MasternodeSigVerifyParallel);
+BENCHMARK(MasternodeVerifyReplySerial);
+BENCHMARK(MasternodeVerifyReplyParallel);
@@ -0,0 +1,50 @@
+// Copyright (c) 2017 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+
+#include "consensus/merkle.h"
+#include "crypto/sha256.h"
+#include "hash.h"
+#include "random.h"
+#include "uint256.h"
+
+#include <vector>
+
+/** Transactions in a large block */
+static const int MERKLE_LEAVES = 9001;
+
+// The double SHA256 of pairs of hashes, with the fastest implementation
+// SHA256AutoDetect found and with one CHash256 per pair as before.
+static void SHA256D64_1024(benchmark::State& state)
+{
+    std::vector<unsigned char> in(64 * 1024, 0);
+    while (state.KeepRunning())
+        SHA256D64(in.data(), in.data(), 1024);
+}
+
+static void CHash256_1024(benchmark::State& state)
+{
+    std::vector<unsigned char> in(64 * 1024, 0);
+    while (state.KeepRunning()) {
+        for (int i = 0; i < 1024; i++)
+            CHash256().Write(&in[64 * i], 64).Finalize(&in[32 * i]);
+    }
+}
+
+static void MerkleRoot(benchmark::State& state)
+{
+    std::vector<uint256> leaves(MERKLE_LEAVES);
+    for (size_t i = 0; i < leaves.size(); i++)
+        leaves[i] = GetRandHash();
+    while (state.KeepRunning()) {
+        bool mutated = false;
+        uint256 root = ComputeMerkleRoot(leaves, &mutated);
+        leaves[0] = root;
+    }
+}
+
+BENCHMARK(SHA256D64_1024);
+BENCHMARK(CHash256_1024);
+BENCHMARK(MerkleRoot);
@@ -5,8 +5,104 @@
 
 #include "chain.h"
 
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
 using namespace std;
 
+/**
+ * CBlockIndexArena implementation
+ */
+CBlockIndex* CBlockIndexArena::apChunks[CBlockIndexArena::MAX_CHUNKS];
+CBlockIndex** CBlockIndexArena::apExternal[CBlockIndexArena::MAX_CHUNKS];
+
+namespace {
+
+static const uintptr_t CACHE_LINE_SIZE = 64;
+
+/** What CBlockIndexArena allocated, and where; only At() reads without taking the lock */
+struct BlockIndexArenaState
+{
+    std::mutex mutex;
+    std::vector<char*> vAllocations;
+    //! chunk start address -> chunk number
+    std::map<uintptr_t, uint32_t> mapChunks;
+    uint32_t nChunks;
+    uint32_t nChunkUsed;
+    std::unordered_map<const CBlockIndex*, uint32_t> mapExternal;
+    uint32_t nExternal;
+
+    BlockIndexArenaState() : nChunks(0), nChunkUsed(0), nExternal(0) {}
+};
+
+BlockIndexArenaState& GetArenaState()
+{
+    static BlockIndexArenaState state;
+    return state;
+}
+
+}
+
+CBlockIndex* CBlockIndexArena::Allocate()
+{
+    BlockIndexArenaState& state = GetArenaState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.nChunks == 0 || state.nChunkUsed == CHUNK_SIZE) {
+        assert(state.nChunks < MAX_CHUNKS);
+        char* pAllocation = new char[CHUNK_SIZE * sizeof(CBlockIndex) + CACHE_LINE_SIZE];
+        uintptr_t nStart = ((uintptr_t)pAllocation + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+        state.vAllocations.push_back(pAllocation);
+        state.mapChunks[nStart] = state.nChunks;
+        apChunks[state.nChunks++] = (CBlockIndex*)nStart;
+        state.nChunkUsed = 0;
+    }
+    return new (&apChunks[state.nChunks - 1][state.nChunkUsed++]) CBlockIndex();
+}
+
+void CBlockIndexArena::Clear()
+{
+    BlockIndexArenaState& state = GetArenaState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (uint32_t i = 0; i < state.nChunks; i++)
+        apChunks[i] = NULL;
+    for (size_t i = 0; i < state.vAllocations.size(); i++)
+        delete[] state.vAllocations[i];
+    state.vAllocations.clear();
+    state.mapChunks.clear();
+    state.nChunks = 0;
+    state.nChunkUsed = 0;
+}
+
+uint32_t CBlockIndexArena::PositionOf(const CBlockIndex* pindex)
+{
+    if (pindex == NULL)
+        return 0;
+
+    BlockIndexArenaState& state = GetArenaState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    uintptr_t nAddress = (uintptr_t)pindex;
+    std::map<uintptr_t, uint32_t>::const_iterator it = state.mapChunks.upper_bound(nAddress);
+    if (it != state.mapChunks.begin()) {
+        --it;
+        if (nAddress < it->first + CHUNK_SIZE * sizeof(CBlockIndex))
+            return ((it->second << CHUNK_BITS) | (uint32_t)((nAddress - it->first) / sizeof(CBlockIndex))) + 1;
+    }
+
+    // Not one of ours: it is looked up through the external table
+    std::pair<std::unordered_map<const CBlockIndex*, uint32_t>::iterator, bool> ret = state.mapExternal.insert(std::make_pair(pindex, state.nExternal));
+    if (ret.second) {
+        uint32_t nExternal = state.nExternal++;
+        if ((nExternal & (CHUNK_SIZE - 1)) == 0) {
+            assert((nExternal >> CHUNK_BITS) < MAX_CHUNKS);
+            apExternal[nExternal >> CHUNK_BITS] = new CBlockIndex*[CHUNK_SIZE];
+        }
+        apExternal[nExternal >> CHUNK_BITS][nExternal & (CHUNK_SIZE - 1)] = const_cast<CBlockIndex*>(pindex);
+    }
+    return (ret.first->second | EXTERNAL) + 1;
+}
+
 /**
  * CChain implementation
  */
@@ -146,34 +146,90 @@ enum BlockStatus {
     BLOCK_FAILED_MASK        =   BLOCK_FAILED_VALID | BLOCK_FAILED_CHILD,
 };
 
+class CBlockIndex;
+
+/**
+ * Where block index entries are allocated: chunks of CHUNK_SIZE entries, each
+ * starting on a cache line and never moved, so an entry is named by a 32-bit
+ * position. Entries made anywhere else, such as on the stack or in tests, are
+ * given a position in a table of their own the first time one is linked to.
+ */
+class CBlockIndexArena
+{
+public:
+    static const int CHUNK_BITS = 14;
+    static const uint32_t CHUNK_SIZE = 1 << CHUNK_BITS;
+    static const uint32_t MAX_CHUNKS = 1 << (31 - CHUNK_BITS);
+    //! Set in the positions of entries that are not in a chunk
+    static const uint32_t EXTERNAL = 0x80000000;
+
+    //! A new entry, next to the one allocated before it where the chunk has room
+    static CBlockIndex* Allocate();
+    //! Free every entry Allocate returned
+    static void Clear();
+
+    //! The position of an entry, 0 for NULL
+    static uint32_t PositionOf(const CBlockIndex* pindex);
+    //! The entry at a position PositionOf returned
+    static CBlockIndex* At(uint32_t nPosition);
+
+private:
+    static CBlockIndex* apChunks[MAX_CHUNKS];
+    static CBlockIndex** apExternal[MAX_CHUNKS];
+};
+
+/** A link from one block index entry to another: its arena position, used like a pointer */
+class CBlockIndexLink
+{
+private:
+    uint32_t nPosition;
+
+public:
+    CBlockIndexLink() : nPosition(0) {}
+    explicit CBlockIndexLink(CBlockIndex* pindex) : nPosition(CBlockIndexArena::PositionOf(pindex)) {}
+
+    CBlockIndexLink& operator=(CBlockIndex* pindex)
+    {
+        nPosition = CBlockIndexArena::PositionOf(pindex);
+        return *this;
+    }
+
+    operator CBlockIndex*() const { return CBlockIndexArena::At(nPosition); }
+    CBlockIndex* operator->() const { return CBlockIndexArena::At(nPosition); }
+};
+
 /** The block chain is a tree shaped structure starting with the
  * genesis block at the root, with each block potentially having multiple
  * candidates to be the next block. A blockindex may have multiple pprev pointing
  * to it, but at most one of them can be part of the currently active branch.
+ *
+ * The entries of mapBlockIndex come from CBlockIndexArena, and link to their
+ * parents by 32-bit arena positions instead of pointers. What a walk back
+ * through pprev and pskip reads (heights, status, time, bits and chain work)
+ * fills the first 64 bytes of an entry; the rest of the header, the counts
+ * and the disk positions fill the other 64.
  */
 class CBlockIndex
 {
 public:
-    //! pointer to the hash of the block, if any. Memory is owned by this CBlockIndex
+    //! pointer to the hash of the block, if any. Memory is owned by the mapBlockIndex key
     const uint256* phashBlock;
 
-    //! pointer to the index of the predecessor of this block
-    CBlockIndex* pprev;
+    //! the index of the predecessor of this block
+    CBlockIndexLink pprev;
 
-    //! pointer to the index of some further predecessor of this block
-    CBlockIndex* pskip;
+    //! the index of some further predecessor of this block
+    CBlockIndexLink pskip;
 
     //! height of the entry in the chain. The genesis block has height 0
     int nHeight;
 
-    //! Which # file this block is stored in (blk?????.dat)
-    int nFile;
-
-    //! Byte offset within blk?????.dat where this block's data is stored
-    unsigned int nDataPos;
+    //! Verification status of this block. See enum BlockStatus
+    unsigned int nStatus;
 
-    //! Byte offset within rev?????.dat where this block's undo data is stored
-    unsigned int nUndoPos;
+    //! block header fields the difficulty and median time past walks read
+    unsigned int nTIMECoin;
+    unsigned int nBits;
 
     //! (memory only) Total amount of work (expected number of hashes) in the chain up to and including this block
     arith_uint256 nChainWork;
@@ -187,18 +243,22 @@ public:
     //! Change to 64-bit type when necessary; won't happen before 2030
     unsigned int nChainTx;
 
-    //! Verification status of this block. See enum BlockStatus
-    unsigned int nStatus;
+    //! (memory only) Sequential id assigned to distinguish order in which blocks are received.
+    uint32_t nSequenceId;
+
+    //! Which # file this block is stored in (blk?????.dat)
+    int nFile;
+
+    //! Byte offset within blk?????.dat where this block's data is stored
+    unsigned int nDataPos;
 
-    //! block header
+    //! Byte offset within rev?????.dat where this block's undo data is stored
+    unsigned int nUndoPos;
+
+    //! the rest of the block header
     int nVersion;
-    uint256 hashMerkleRoot;
-    unsigned int nTIMECoin;
-    unsigned int nBits;
     unsigned int nNonce;
-
-    //! (memory only) Sequential id assigned to distinguish order in which blocks are received.
-    uint32_t nSequenceId;
+    uint256 hashMerkleRoot;
 
     void SetNull()
     {
@@ -298,7 +358,7 @@ public:
     std::string ToString() const
     {
         return strprintf("CBlockIndex(pprev=%p, nHeight=%d, merkle=%s, hashBlock=%s)",
-            pprev, nHeight,
+            (const CBlockIndex*)pprev, nHeight,
             hashMerkleRoot.ToString(),
             GetBlockHash().ToString());
     }
@@ -334,6 +394,17 @@ public:
     const CBlockIndex* GetAncestor(int height) const;
 };
 
+inline CBlockIndex* CBlockIndexArena::At(uint32_t nPosition)
+{
+    if (nPosition-- == 0)
+        return NULL;
+    if (nPosition & EXTERNAL) {
+        nPosition &= ~EXTERNAL;
+        return apExternal[nPosition >> CHUNK_BITS][nPosition & (CHUNK_SIZE - 1)];
+    }
+    return apChunks[nPosition >> CHUNK_BITS] + (nPosition & (CHUNK_SIZE - 1));
+}
+
 /** Used to marshal pointers into hashes for db storage. */
 class CDiskBlockIndex : public CBlockIndex
 {
@@ -408,17 +479,18 @@ public:
 /** An in-memory indexed chain of blocks. */
 class CChain {
 private:
-    std::vector<CBlockIndex*> vChain;
+    //! arena positions rather than pointers, half the memory for a long chain
+    std::vector<CBlockIndexLink> vChain;
 
 public:
     /** Returns the index entry for the genesis block of this chain, or NULL if none. */
     CBlockIndex *Genesis() const {
-        return vChain.size() > 0 ? vChain[0] : NULL;
+        return vChain.size() > 0 ? (CBlockIndex*)vChain[0] : NULL;
     }
 
     /** Returns the index entry for the tip of this chain, or NULL if none. */
     CBlockIndex *Tip() const {
-        return vChain.size() > 0 ? vChain[vChain.size() - 1] : NULL;
+        return vChain.size() > 0 ? (CBlockIndex*)vChain[vChain.size() - 1] : NULL;
     }
 
     /** Returns the index entry at a particular height in this chain, or NULL if no such height exists. */
@@ -0,0 +1,321 @@
+// Copyright (c) 2010 Satoshi Nakamoto
+// Copyright (c) 2009-2015 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "coinstats.h"
+
+#include "chain.h"
+#include "indexwriter.h"
+#include "streams.h"
+#include "sync.h"
+#include "txdb.h"
+#include "util.h"
+#include "validation.h"
+#include "version.h"
+
+#include <memory>
+
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+
+namespace {
+
+/** The hash_serialized_2 serialization of one transaction's unspent outputs */
+template <typename Stream>
+void SerializeOutputs(Stream& ss, const uint256& txid, const std::map<uint32_t, Coin>& outputs)
+{
+    ss << txid;
+    ss << VARINT(outputs.begin()->second.nHeight * 2 + outputs.begin()->second.fCoinBase);
+    for (const auto& output : outputs) {
+        ss << VARINT(output.first + 1);
+        ss << *(const CScriptBase*)(&output.second.out.scriptPubKey);
+        ss << VARINT(output.second.out.nValue);
+    }
+    ss << VARINT(0);
+}
+
+void AddOutputTotals(CCoinsStats& stats, const std::map<uint32_t, Coin>& outputs)
+{
+    stats.nTransactions++;
+    for (const auto& output : outputs) {
+        stats.nTransactionOutputs++;
+        stats.nTotalAmount += output.second.out.nValue;
+    }
+}
+
+}
+
+void ApplyCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& coin, bool fRemove)
+{
+    CDataStream ss(SER_DISK, PROTOCOL_VERSION);
+    ss << outpoint;
+    ss << (uint32_t)(coin.nHeight * 2 + coin.fCoinBase);
+    ss << coin.out;
+    const unsigned char* data = (const unsigned char*)&ss[0];
+    if (fRemove)
+        muhash.Remove(data, ss.size());
+    else
+        muhash.Insert(data, ss.size());
+}
+
+CCoinsStatsHasher::CCoinsStatsHasher(CCoinsStats& statsIn, const uint256& hashBlock, CoinStatsHashType hashType) : stats(statsIn), ss(SER_GETHASH, PROTOCOL_VERSION)
+{
+    stats.hashBlock = hashBlock;
+    stats.hashType = hashType;
+    ss << hashBlock;
+}
+
+void CCoinsStatsHasher::ApplyOutputs()
+{
+    assert(!outputs.empty());
+    if (stats.hashType == COINSTATS_HASH_SERIALIZED)
+        SerializeOutputs(ss, prevkey, outputs);
+    AddOutputTotals(stats, outputs);
+    outputs.clear();
+}
+
+void CCoinsStatsHasher::Add(const COutPoint& outpoint, const Coin& coin)
+{
+    if (!outputs.empty() && outpoint.hash != prevkey)
+        ApplyOutputs();
+    prevkey = outpoint.hash;
+    outputs[outpoint.n] = coin;
+    if (stats.hashType == COINSTATS_HASH_MUHASH)
+        ApplyCoinHash(muhash, outpoint, coin, false);
+}
+
+void CCoinsStatsHasher::Finalize()
+{
+    if (!outputs.empty())
+        ApplyOutputs();
+    if (stats.hashType == COINSTATS_HASH_MUHASH)
+        muhash.Finalize(stats.hashMuHash.begin());
+    else
+        stats.hashSerialized = ss.GetHash();
+}
+
+void CCoinStatsIndexValue::AddCoin(const COutPoint& outpoint, const Coin& coin)
+{
+    ApplyCoinHash(muhash, outpoint, coin, false);
+    nTransactionOutputs++;
+    nTotalAmount += coin.out.nValue;
+}
+
+void CCoinStatsIndexValue::SpendCoin(const COutPoint& outpoint, const Coin& coin)
+{
+    ApplyCoinHash(muhash, outpoint, coin, true);
+    nTransactionOutputs--;
+    nTotalAmount -= coin.out.nValue;
+}
+
+namespace {
+
+/** One range of a parallel scan: the coins whose txid starts with a byte in [nBegin, nEnd) */
+struct CCoinsScanRange
+{
+    boost::scoped_ptr<CCoinsViewCursor> pcursor;
+    int nEnd;
+
+    //! Results, valid once fDone
+    CCoinsStats stats;
+    std::unique_ptr<CDataStream> serialized;
+    MuHash3072 muhash;
+    bool fDone;
+    bool fOk;
+
+    CCoinsScanRange() : nEnd(0), serialized(new CDataStream(SER_GETHASH, PROTOCOL_VERSION)), fDone(false), fOk(false) {}
+};
+
+class CCoinsScan
+{
+private:
+    CoinStatsHashType hashType;
+    std::vector<CCoinsScanRange> ranges;
+
+    boost::mutex mutex;
+    boost::condition_variable cond;
+    //! The next range to scan, and the ranges the master has hashed
+    int nNext;
+    int nHashed;
+    //! Ranges scanned ahead of hashing are buffered; cap them
+    int nMaxAhead;
+    bool fAbort;
+
+    bool ScanRange(CCoinsScanRange& range)
+    {
+        CCoinsViewCursor* pcursor = range.pcursor.get();
+        std::map<uint32_t, Coin> outputs;
+        uint256 prevkey;
+        for (; pcursor->Valid(); pcursor->Next()) {
+            COutPoint key;
+            Coin coin;
+            if (!pcursor->GetKey(key) || !pcursor->GetValue(coin))
+                return error("%s: unable to read value", __func__);
+            if (*key.hash.begin() >= range.nEnd)
+                break;
+            if (!outputs.empty() && key.hash != prevkey) {
+                if (hashType == COINSTATS_HASH_SERIALIZED)
+                    SerializeOutputs(*range.serialized, prevkey, outputs);
+                AddOutputTotals(range.stats, outputs);
+                outputs.clear();
+                if (fAbort)
+                    return false;
+            }
+            prevkey = key.hash;
+            if (hashType == COINSTATS_HASH_MUHASH)
+                ApplyCoinHash(range.muhash, key, coin, false);
+            outputs[key.n] = coin;
+        }
+        if (!outputs.empty()) {
+            if (hashType == COINSTATS_HASH_SERIALIZED)
+                SerializeOutputs(*range.serialized, prevkey, outputs);
+            AddOutputTotals(range.stats, outputs);
+        }
+        return true;
+    }
+
+public:
+    CCoinsScan(CoinStatsHashType hashTypeIn, int nThreads) : hashType(hashTypeIn), ranges(COINSTATS_SCAN_RANGES), nNext(0), nHashed(0), nMaxAhead(2 * nThreads), fAbort(false) {}
+
+    /** Open a cursor per range. Must not race with writes to the database. */
+    void Open(CCoinsViewDB* view)
+    {
+        for (int i = 0; i < COINSTATS_SCAN_RANGES; i++) {
+            uint256 txidStart;
+            *txidStart.begin() = i * 256 / COINSTATS_SCAN_RANGES;
+            ranges[i].nEnd = (i + 1) * 256 / COINSTATS_SCAN_RANGES;
+            ranges[i].pcursor.reset(view->Cursor(COutPoint(txidStart, 0)));
+        }
+    }
+
+    void Thread()
+    {
+        while (true) {
+            int nRange;
+            {
+                boost::unique_lock<boost::mutex> lock(mutex);
+                // With hash_serialized_2 the master hashes the ranges in order
+                while (!fAbort && nNext < COINSTATS_SCAN_RANGES && hashType == COINSTATS_HASH_SERIALIZED && nNext >= nHashed + nMaxAhead)
+                    cond.wait(lock);
+                if (fAbort || nNext == COINSTATS_SCAN_RANGES)
+                    return;
+                nRange = nNext++;
+            }
+            bool fOk = ScanRange(ranges[nRange]);
+            {
+                boost::unique_lock<boost::mutex> lock(mutex);
+                ranges[nRange].fOk = fOk;
+                ranges[nRange].fDone = true;
+                ranges[nRange].pcursor.reset();
+                cond.notify_all();
+            }
+        }
+    }
+
+    /** Combine the ranges in order as they are done, into stats and the hash writer or MuHash */
+    bool Collect(CCoinsStats& stats, CHashWriter& ss, MuHash3072& muhash)
+    {
+        for (int i = 0; i < COINSTATS_SCAN_RANGES; i++) {
+            CCoinsScanRange& range = ranges[i];
+            {
+                boost::unique_lock<boost::mutex> lock(mutex);
+                while (!range.fDone)
+                    cond.wait(lock);
+            }
+            if (!range.fOk)
+                return false;
+            stats.nTransactions += range.stats.nTransactions;
+            stats.nTransactionOutputs += range.stats.nTransactionOutputs;
+            stats.nTotalAmount += range.stats.nTotalAmount;
+            if (hashType == COINSTATS_HASH_SERIALIZED) {
+                if (!range.serialized->empty())
+                    ss.write(&(*range.serialized)[0], range.serialized->size());
+                range.serialized.reset();
+            } else {
+                muhash *= range.muhash;
+            }
+            boost::unique_lock<boost::mutex> lock(mutex);
+            nHashed++;
+            cond.notify_all();
+        }
+        return true;
+    }
+
+    void Abort()
+    {
+        boost::unique_lock<boost::mutex> lock(mutex);
+        fAbort = true;
+        cond.notify_all();
+    }
+};
+
+}
+
+bool GetUTXOStats(CCoinsViewDB *view, CCoinsStats &stats, CoinStatsHashType hashType, int nThreads)
+{
+    nThreads = std::max(1, std::min(nThreads, COINSTATS_MAX_SCAN_THREADS));
+    CCoinsScan scan(hashType, nThreads);
+    {
+        // Open every cursor while no flush can start, so they all see the same state
+        LOCK(cs_main);
+        view->WaitForFlush();
+        scan.Open(view);
+        stats.hashBlock = view->GetBestBlock();
+        stats.nHeight = mapBlockIndex.find(stats.hashBlock)->second->nHeight;
+    }
+    stats.hashType = hashType;
+    stats.nTransactions = stats.nTransactionOutputs = 0;
+    stats.nTotalAmount = 0;
+
+    CHashWriter ss(SER_GETHASH, PROTOCOL_VERSION);
+    ss << stats.hashBlock;
+    MuHash3072 muhash;
+
+    boost::thread_group threads;
+    for (int i = 0; i < nThreads; i++)
+        threads.create_thread(boost::bind(&CCoinsScan::Thread, &scan));
+    bool fOk;
+    try {
+        fOk = scan.Collect(stats, ss, muhash);
+    } catch (const boost::thread_interrupted&) {
+        scan.Abort();
+        threads.join_all();
+        throw;
+    }
+    if (!fOk)
+        scan.Abort();
+    threads.join_all();
+    if (!fOk)
+        return false;
+
+    if (hashType == COINSTATS_HASH_SERIALIZED)
+        stats.hashSerialized = ss.GetHash();
+    else
+        muhash.Finalize(stats.hashMuHash.begin());
+    stats.nDiskSize = view->EstimateSize();
+    return true;
+}
+
+bool GetUTXOStatsFromIndex(CCoinsStats &stats)
+{
+    if (!IsExplorerIndexSynced(INDEX_COINSTATS) || !indexWriter.Sync())
+        return false;
+    CCoinStatsIndexValue value;
+    {
+        LOCK(cs_main);
+        CExplorerIndexDB* pdb = explorerIndexes[INDEX_COINSTATS].pdb;
+        if (!pdb || !pdb->ReadCoinStats(value))
+            return false;
+    }
+    stats.hashBlock = value.hashBlock;
+    stats.nHeight = value.nHeight;
+    stats.hashType = COINSTATS_HASH_MUHASH;
+    stats.nTransactions = 0;
+    stats.nTransactionOutputs = value.nTransactionOutputs;
+    stats.nTotalAmount = value.nTotalAmount;
+    value.muhash.Finalize(stats.hashMuHash.begin());
+    stats.nDiskSize = pcoinsdbview->EstimateSize();
+    return true;
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2010 Satoshi Nakamoto
+// Copyright (c) 2009-2015 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_COINSTATS_H
+#define BITCOIN_COINSTATS_H
+
+#include "amount.h"
+#include "coins.h"
+#include "crypto/muhash.h"
+#include "hash.h"
+#include "serialize.h"
+#include "uint256.h"
+
+#include <map>
+
+class CCoinsViewDB;
+
+/** Ranges of the txid space a full scan of the UTXO set is split into */
+static const int COINSTATS_SCAN_RANGES = 64;
+/** Most threads a full scan uses */
+static const int COINSTATS_MAX_SCAN_THREADS = 8;
+
+/** Which hash of the UTXO set to compute */
+enum CoinStatsHashType
+{
+    //! hash_serialized_2: a hash of the whole set in database order
+    COINSTATS_HASH_SERIALIZED,
+    //! muhash: a MuHash3072 of the coins, which can be kept up to date block by block
+    COINSTATS_HASH_MUHASH,
+};
+
+/** Totals of a UTXO set, and its hash */
+struct CCoinsStats
+{
+    int nHeight;
+    uint256 hashBlock;
+    //! Not known when the stats come from the coinstats index
+    uint64_t nTransactions;
+    uint64_t nTransactionOutputs;
+    CoinStatsHashType hashType;
+    uint256 hashSerialized;
+    uint256 hashMuHash;
+    uint64_t nDiskSize;
+    CAmount nTotalAmount;
+
+    CCoinsStats() : nHeight(0), nTransactions(0), nTransactionOutputs(0), hashType(COINSTATS_HASH_SERIALIZED), nDiskSize(0), nTotalAmount(0) {}
+};
+
+/** Add a coin to a MuHash of the UTXO set, or remove it */
+void ApplyCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& coin, bool fRemove);
+
+/**
+ * Accumulates CCoinsStats over the coins of a UTXO set, which have to be
+ * added in key order: the outputs of each transaction are hashed together.
+ */
+class CCoinsStatsHasher
+{
+private:
+    CCoinsStats& stats;
+    CHashWriter ss;
+    MuHash3072 muhash;
+    uint256 prevkey;
+    std::map<uint32_t, Coin> outputs;
+
+    void ApplyOutputs();
+
+public:
+    CCoinsStatsHasher(CCoinsStats& statsIn, const uint256& hashBlock, CoinStatsHashType hashType = COINSTATS_HASH_SERIALIZED);
+
+    void Add(const COutPoint& outpoint, const Coin& coin);
+
+    /** Hash the last transaction's outputs and set the hash of stats.hashType */
+    void Finalize();
+};
+
+/**
+ * The state of the UTXO set the coinstats index keeps: the MuHash and totals
+ * as of a block, updated with the coins each block creates and spends.
+ */
+class CCoinStatsIndexValue
+{
+public:
+    uint256 hashBlock;
+    int nHeight;
+    uint64_t nTransactionOutputs;
+    CAmount nTotalAmount;
+    MuHash3072 muhash;
+
+    CCoinStatsIndexValue() : nHeight(-1), nTransactionOutputs(0), nTotalAmount(0) {}
+
+    void AddCoin(const COutPoint& outpoint, const Coin& coin);
+    void SpendCoin(const COutPoint& outpoint, const Coin& coin);
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion) {
+        READWRITE(hashBlock);
+        READWRITE(nHeight);
+        READWRITE(nTransactionOutputs);
+        READWRITE(nTotalAmount);
+        unsigned char state[MuHash3072::SERIALIZED_SIZE];
+        if (!ser_action.ForRead())
+            muhash.ToBytes(state);
+        READWRITE(FLATDATA(state));
+        if (ser_action.ForRead())
+            muhash.FromBytes(state);
+    }
+};
+
+/**
+ * Calculate statistics about the unspent transaction output set by reading
+ * all of it. The txid space is split into ranges that several threads scan
+ * from consistent database iterators.
+ */
+bool GetUTXOStats(CCoinsViewDB *view, CCoinsStats &stats, CoinStatsHashType hashType = COINSTATS_HASH_SERIALIZED, int nThreads = 1);
+
+/** The statistics the coinstats index holds for the active chain tip, without a scan */
+bool GetUTXOStatsFromIndex(CCoinsStats &stats);
+
+#endif // BITCOIN_COINSTATS_H
@@ -0,0 +1,179 @@
+// Copyright (c) 2017 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "crypto/muhash.h"
+
+#include "crypto/common.h"
+#include "crypto/sha256.h"
+
+#include <string.h>
+
+namespace {
+
+/** 2^3072 - p */
+const Num3072::limb_t MAX_PRIME_DIFF = 1103717;
+
+Num3072::limb_t ReadLimb(const unsigned char* ptr)
+{
+    return Num3072::LIMB_SIZE == 64 ? ReadLE64(ptr) : ReadLE32(ptr);
+}
+
+void WriteLimb(unsigned char* ptr, Num3072::limb_t x)
+{
+    if (Num3072::LIMB_SIZE == 64)
+        WriteLE64(ptr, x);
+    else
+        WriteLE32(ptr, x);
+}
+
+}
+
+Num3072::Num3072(const unsigned char data[BYTE_SIZE])
+{
+    for (int i = 0; i < LIMBS; i++)
+        limbs[i] = ReadLimb(data + i * sizeof(limb_t));
+    FullReduce();
+}
+
+void Num3072::SetToOne()
+{
+    limbs[0] = 1;
+    for (int i = 1; i < LIMBS; i++)
+        limbs[i] = 0;
+}
+
+void Num3072::FullReduce()
+{
+    // n >= p exactly when n + (2^3072 - p) carries out of the top limb
+    limb_t sum[LIMBS];
+    limb_t carry = MAX_PRIME_DIFF;
+    for (int i = 0; i < LIMBS; i++) {
+        sum[i] = limbs[i] + carry;
+        carry = sum[i] < carry;
+    }
+    if (carry)
+        memcpy(limbs, sum, sizeof(limbs));
+}
+
+void Num3072::Multiply(const Num3072& a)
+{
+    // Schoolbook multiplication into 2 * LIMBS limbs
+    limb_t product[2 * LIMBS];
+    for (int i = 0; i < 2 * LIMBS; i++)
+        product[i] = 0;
+    for (int i = 0; i < LIMBS; i++) {
+        limb_t carry = 0;
+        for (int j = 0; j < LIMBS; j++) {
+            double_limb_t cur = (double_limb_t)limbs[i] * a.limbs[j] + product[i + j] + carry;
+            product[i + j] = (limb_t)cur;
+            carry = (limb_t)(cur >> LIMB_SIZE);
+        }
+        product[i + LIMBS] = carry;
+    }
+
+    // As 2^3072 = MAX_PRIME_DIFF (mod p), fold the high half onto the low half
+    limb_t carry = 0;
+    for (int i = 0; i < LIMBS; i++) {
+        double_limb_t cur = (double_limb_t)product[i + LIMBS] * MAX_PRIME_DIFF + product[i] + carry;
+        limbs[i] = (limb_t)cur;
+        carry = (limb_t)(cur >> LIMB_SIZE);
+    }
+    // ... and what carries out of the top limb, until nothing does
+    while (carry) {
+        double_limb_t cur = (double_limb_t)carry * MAX_PRIME_DIFF + limbs[0];
+        limbs[0] = (limb_t)cur;
+        carry = (limb_t)(cur >> LIMB_SIZE);
+        for (int i = 1; i < LIMBS && carry; i++) {
+            limbs[i] += carry;
+            carry = limbs[i] < carry;
+        }
+    }
+    FullReduce();
+}
+
+Num3072 Num3072::GetInverse() const
+{
+    // By Fermat's little theorem, a^(p-2) is the inverse of a. All bits of
+    // p - 2 above its low limb are set; square and multiply from the top.
+    const limb_t nLowLimb = (limb_t)0 - (MAX_PRIME_DIFF + 2);
+    Num3072 result;
+    for (int i = LIMBS - 1; i >= 0; i--) {
+        const limb_t exponent = i == 0 ? nLowLimb : ~(limb_t)0;
+        for (int bit = LIMB_SIZE - 1; bit >= 0; bit--) {
+            result.Multiply(result);
+            if ((exponent >> bit) & 1)
+                result.Multiply(*this);
+        }
+    }
+    return result;
+}
+
+void Num3072::Divide(const Num3072& a)
+{
+    Multiply(a.GetInverse());
+}
+
+void Num3072::ToBytes(unsigned char out[BYTE_SIZE]) const
+{
+    for (int i = 0; i < LIMBS; i++)
+        WriteLimb(out + i * sizeof(limb_t), limbs[i]);
+}
+
+Num3072 MuHash3072::ToNum3072(const unsigned char* data, size_t len)
+{
+    // Expand the element's SHA256 to 3072 bits
+    unsigned char seed[CSHA256::OUTPUT_SIZE];
+    CSHA256().Write(data, len).Finalize(seed);
+    unsigned char bytes[Num3072::BYTE_SIZE];
+    for (unsigned char i = 0; i < Num3072::BYTE_SIZE / CSHA256::OUTPUT_SIZE; i++)
+        CSHA256().Write(seed, sizeof(seed)).Write(&i, 1).Finalize(bytes + i * CSHA256::OUTPUT_SIZE);
+    return Num3072(bytes);
+}
+
+MuHash3072& MuHash3072::Insert(const unsigned char* data, size_t len)
+{
+    numerator.Multiply(ToNum3072(data, len));
+    return *this;
+}
+
+MuHash3072& MuHash3072::Remove(const unsigned char* data, size_t len)
+{
+    denominator.Multiply(ToNum3072(data, len));
+    return *this;
+}
+
+MuHash3072& MuHash3072::operator*=(const MuHash3072& other)
+{
+    numerator.Multiply(other.numerator);
+    denominator.Multiply(other.denominator);
+    return *this;
+}
+
+MuHash3072& MuHash3072::operator/=(const MuHash3072& other)
+{
+    numerator.Multiply(other.denominator);
+    denominator.Multiply(other.numerator);
+    return *this;
+}
+
+void MuHash3072::Finalize(unsigned char out[32])
+{
+    numerator.Divide(denominator);
+    denominator.SetToOne();
+    unsigned char bytes[Num3072::BYTE_SIZE];
+    numerator.ToBytes(bytes);
+    CSHA256().Write(bytes, sizeof(bytes)).Finalize(out);
+}
+
+void MuHash3072::ToBytes(unsigned char out[SERIALIZED_SIZE]) const
+{
+    numerator.ToBytes(out);
+    denominator.ToBytes(out + Num3072::BYTE_SIZE);
+}
+
+void MuHash3072::FromBytes(const unsigned char data[SERIALIZED_SIZE])
+{
+    numerator = Num3072(data);
+    denominator = Num3072(data + Num3072::BYTE_SIZE);
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2017 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_CRYPTO_MUHASH_H
+#define BITCOIN_CRYPTO_MUHASH_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/** An integer modulo the prime 2^3072 - 1103717 */
+class Num3072
+{
+public:
+#ifdef __SIZEOF_INT128__
+    typedef uint64_t limb_t;
+    typedef unsigned __int128 double_limb_t;
+#else
+    typedef uint32_t limb_t;
+    typedef uint64_t double_limb_t;
+#endif
+    static const int LIMB_SIZE = sizeof(limb_t) * 8;
+    static const int LIMBS = 3072 / LIMB_SIZE;
+    static const size_t BYTE_SIZE = 384;
+
+    //! Least significant limb first, always fully reduced
+    limb_t limbs[LIMBS];
+
+    Num3072() { SetToOne(); }
+
+    /** Read a little endian number; values of p and above are reduced */
+    explicit Num3072(const unsigned char data[BYTE_SIZE]);
+
+    void SetToOne();
+    void Multiply(const Num3072& a);
+    /** Multiply by the inverse of a, which must not be zero */
+    void Divide(const Num3072& a);
+    Num3072 GetInverse() const;
+    void ToBytes(unsigned char out[BYTE_SIZE]) const;
+
+private:
+    //! Subtract p if the number is p or above
+    void FullReduce();
+};
+
+/**
+ * A hash of a multiset of byte strings that can be updated as elements are
+ * added and removed, in any order (MuHash).
+ *
+ * Each element is hashed to a number modulo a 3072-bit prime, and the set
+ * is the product of its elements. Removed elements are multiplied into a
+ * separate denominator, so that the expensive modular inverse is only
+ * computed once, by Finalize(). Two hashes can also be combined with *= and
+ * /=, so a set can be hashed in parts, for example by several threads.
+ */
+class MuHash3072
+{
+private:
+    Num3072 numerator;
+    Num3072 denominator;
+
+    static Num3072 ToNum3072(const unsigned char* data, size_t len);
+
+public:
+    static const size_t SERIALIZED_SIZE = 2 * Num3072::BYTE_SIZE;
+
+    //! The hash of the empty set
+    MuHash3072() {}
+
+    MuHash3072& Insert(const unsigned char* data, size_t len);
+    MuHash3072& Remove(const unsigned char* data, size_t len);
+
+    MuHash3072& operator*=(const MuHash3072& other);
+    MuHash3072& operator/=(const MuHash3072& other);
+
+    /** Write the SHA256 of the set's number. Reduces the state to a single number first. */
+    void Finalize(unsigned char out[32]);
+
+    void ToBytes(unsigned char out[SERIALIZED_SIZE]) const;
+    void FromBytes(const unsigned char data[SERIALIZED_SIZE]);
+};
+
+#endif // BITCOIN_CRYPTO_MUHASH_H
@@ -6,6 +6,8 @@
 
 #include "crypto/common.h"
 
+#include <algorithm>
+#include <assert.h>
 #include <string.h>
 
 // Internal implementation code.
@@ -127,9 +129,87 @@ void Transform(uint32_t* s, const unsigned char* chunk)
     s[7] += h;
 }
 
+/** Write the SHA256 of the 32-byte hash in state s, the second hash of a double-SHA256. */
+void FinalizeD(unsigned char* out, uint32_t* s)
+{
+    unsigned char buf[64] = {0};
+    for (int i = 0; i < 8; i++)
+        WriteBE32(buf + 4 * i, s[i]);
+    buf[32] = 0x80;
+    buf[62] = 0x01;
+    Initialize(s);
+    Transform(s, buf);
+    for (int i = 0; i < 8; i++)
+        WriteBE32(out + 4 * i, s[i]);
+}
+
+/** Double-SHA256 of one 64-byte input. */
+void TransformD64(unsigned char* out, const unsigned char* in)
+{
+    static const unsigned char padding64[64] = {0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0};
+    uint32_t s[8];
+    Initialize(s);
+    Transform(s, in);
+    Transform(s, padding64);
+    FinalizeD(out, s);
+}
+
+/** Double-SHA256 of one message whose state after its first 64 bytes is midstate, and whose padded rest is in. */
+void TransformDMidstate(unsigned char* out, const uint32_t* midstate, const unsigned char* in)
+{
+    uint32_t s[8];
+    std::copy(midstate, midstate + 8, s);
+    Transform(s, in);
+    FinalizeD(out, s);
+}
+
 } // namespace sha256
+
+typedef void (*TransformD64Type)(unsigned char*, const unsigned char*);
+typedef void (*TransformDMidstateType)(unsigned char*, const uint32_t*, const unsigned char*);
+
+//! Multi-way implementations, set by SHA256AutoDetect if the CPU supports them
+TransformD64Type TransformD64_4way = NULL;
+TransformD64Type TransformD64_8way = NULL;
+TransformDMidstateType TransformDMidstate_4way = NULL;
+TransformDMidstateType TransformDMidstate_8way = NULL;
+
 } // namespace
 
+#if defined(ENABLE_SHA256_MULTIWAY)
+namespace sha256d64_sse41
+{
+void Transform_4way(unsigned char* out, const unsigned char* in);
+void TransformMidstate_4way(unsigned char* out, const uint32_t* midstates, const unsigned char* in);
+}
+
+namespace sha256d64_avx2
+{
+void Transform_8way(unsigned char* out, const unsigned char* in);
+void TransformMidstate_8way(unsigned char* out, const uint32_t* midstates, const unsigned char* in);
+}
+#endif
+
+std::string SHA256AutoDetect()
+{
+    std::string ret = "standard";
+#if defined(ENABLE_SHA256_MULTIWAY)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.1")) {
+        TransformD64_4way = sha256d64_sse41::Transform_4way;
+        TransformDMidstate_4way = sha256d64_sse41::TransformMidstate_4way;
+        ret += ",sse41(4way)";
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        TransformD64_8way = sha256d64_avx2::Transform_8way;
+        TransformDMidstate_8way = sha256d64_avx2::TransformMidstate_8way;
+        ret += ",avx2(8way)";
+    }
+#endif
+    return ret;
+}
+
 
 ////// SHA-256
 
@@ -187,3 +267,64 @@ CSHA256& CSHA256::Reset()
     sha256::Initialize(s);
     return *this;
 }
+
+void CSHA256::GetMidstate(uint32_t stateRet[8]) const
+{
+    assert(bytes % 64 == 0);
+    std::copy(s, s + 8, stateRet);
+}
+
+void SHA256D64(unsigned char* out, const unsigned char* in, size_t blocks)
+{
+    if (TransformD64_8way) {
+        while (blocks >= 8) {
+            TransformD64_8way(out, in);
+            out += 256;
+            in += 512;
+            blocks -= 8;
+        }
+    }
+    if (TransformD64_4way) {
+        while (blocks >= 4) {
+            TransformD64_4way(out, in);
+            out += 128;
+            in += 256;
+            blocks -= 4;
+        }
+    }
+    while (blocks) {
+        sha256::TransformD64(out, in);
+        out += 32;
+        in += 64;
+        --blocks;
+    }
+}
+
+void SHA256DMidstate(unsigned char* out, const uint32_t* midstates, const unsigned char* in, size_t blocks)
+{
+    if (TransformDMidstate_8way) {
+        while (blocks >= 8) {
+            TransformDMidstate_8way(out, midstates, in);
+            out += 256;
+            midstates += 64;
+            in += 512;
+            blocks -= 8;
+        }
+    }
+    if (TransformDMidstate_4way) {
+        while (blocks >= 4) {
+            TransformDMidstate_4way(out, midstates, in);
+            out += 128;
+            midstates += 32;
+            in += 256;
+            blocks -= 4;
+        }
+    }
+    while (blocks) {
+        sha256::TransformDMidstate(out, midstates, in);
+        out += 32;
+        midstates += 8;
+        in += 64;
+        --blocks;
+    }
+}
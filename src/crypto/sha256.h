@@ -7,6 +7,12 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <string>
+
+#if (defined(__x86_64__) || defined(__amd64__)) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+// SHA256D64 can hash several inputs at once with SSE4.1 or AVX2 (crypto/sha256_multiway.cpp)
+#define ENABLE_SHA256_MULTIWAY
+#endif
 
 /** A hasher class for SHA-256. */
 class CSHA256
@@ -23,6 +29,30 @@ public:
     CSHA256& Write(const unsigned char* data, size_t len);
     void Finalize(unsigned char hash[OUTPUT_SIZE]);
     CSHA256& Reset();
+    /** The state after the data written so far, a whole number of 64-byte blocks, to finish hashes starting with it with SHA256DMidstate */
+    void GetMidstate(uint32_t stateRet[8]) const;
 };
 
+/** Pick the fastest SHA256D64 implementation the CPU supports, and return a description of it */
+std::string SHA256AutoDetect();
+
+/**
+ * Compute the double-SHA256 of each of blocks 64-byte inputs, such as the
+ * pairs of hashes making up a merkle tree level.
+ *
+ * output: blocks * 32 bytes; it may be input, as no output is written before its input is read
+ * input:  blocks * 64 bytes
+ */
+void SHA256D64(unsigned char* output, const unsigned char* input, size_t blocks);
+
+/**
+ * Finish the double-SHA256 of each of blocks messages of 65 to 119 bytes, whose
+ * first 64 bytes are hashed already, such as the scores of many masternodes.
+ *
+ * output:    blocks * 32 bytes
+ * midstates: blocks * 8 words, the state of each message after its first 64 bytes (CSHA256::GetMidstate)
+ * input:     blocks * 64 bytes, the rest of each message followed by its SHA-256 padding
+ */
+void SHA256DMidstate(unsigned char* output, const uint32_t* midstates, const unsigned char* input, size_t blocks);
+
 #endif // BITCOIN_CRYPTO_SHA256_H
@@ -0,0 +1,219 @@
+// Copyright (c) 2017 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Double-SHA256 of several 64-byte inputs at once, or of several messages
+// continuing from midstates, one input per vector lane.
+// The vectors are GCC/clang vector extensions, and each entry point is
+// compiled for the instruction set named in its target attribute, so this
+// file needs no special compiler flags. SHA256AutoDetect only uses an entry
+// point once the CPU has been found to support it.
+
+#include "crypto/sha256.h"
+
+#include "crypto/common.h"
+
+#if defined(ENABLE_SHA256_MULTIWAY)
+
+#include <stdint.h>
+
+#if !defined(__clang__)
+// The helpers below are always inlined into the entry points, so the vectors
+// they take and return never cross a function call
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace
+{
+
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+
+typedef uint32_t v4u32 __attribute__((vector_size(16)));
+typedef uint32_t v8u32 __attribute__((vector_size(32)));
+
+template <typename V> ALWAYS_INLINE V Ch(const V& x, const V& y, const V& z) { return z ^ (x & (y ^ z)); }
+template <typename V> ALWAYS_INLINE V Maj(const V& x, const V& y, const V& z) { return (x & y) | (z & (x | y)); }
+template <typename V> ALWAYS_INLINE V Sigma0(const V& x) { return (x >> 2 | x << 30) ^ (x >> 13 | x << 19) ^ (x >> 22 | x << 10); }
+template <typename V> ALWAYS_INLINE V Sigma1(const V& x) { return (x >> 6 | x << 26) ^ (x >> 11 | x << 21) ^ (x >> 25 | x << 7); }
+template <typename V> ALWAYS_INLINE V sigma0(const V& x) { return (x >> 7 | x << 25) ^ (x >> 18 | x << 14) ^ (x >> 3); }
+template <typename V> ALWAYS_INLINE V sigma1(const V& x) { return (x >> 17 | x << 15) ^ (x >> 19 | x << 13) ^ (x >> 10); }
+
+static const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static const uint32_t INIT[8] = {
+    0x6a09e667ul, 0xbb67ae85ul, 0x3c6ef372ul, 0xa54ff53aul, 0x510e527ful, 0x9b05688cul, 0x1f83d9abul, 0x5be0cd19ul,
+};
+
+/** The message schedule words of the padding block following a 64-byte message, each already added to its round constant */
+struct PaddingSchedule
+{
+    uint32_t kw[64];
+
+    PaddingSchedule()
+    {
+        uint32_t w[64] = {0x80000000ul};
+        w[15] = 512;
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = (w[i - 15] >> 7 | w[i - 15] << 25) ^ (w[i - 15] >> 18 | w[i - 15] << 14) ^ (w[i - 15] >> 3);
+            uint32_t s1 = (w[i - 2] >> 17 | w[i - 2] << 15) ^ (w[i - 2] >> 19 | w[i - 2] << 13) ^ (w[i - 2] >> 10);
+            w[i] = s1 + w[i - 7] + s0 + w[i - 16];
+        }
+        for (int i = 0; i < 64; i++)
+            kw[i] = K[i] + w[i];
+    }
+};
+
+static const PaddingSchedule padding64;
+
+template <typename V> ALWAYS_INLINE V Broadcast(uint32_t x) { return V() + x; }
+
+/** One round of SHA-256, with kw the round constant plus the message word */
+template <typename V>
+ALWAYS_INLINE void Round(const V& a, const V& b, const V& c, V& d, const V& e, const V& f, const V& g, V& h, const V& kw)
+{
+    V t1 = h + Sigma1(e) + Ch(e, f, g) + kw;
+    V t2 = Sigma0(a) + Maj(a, b, c);
+    d += t1;
+    h = t1 + t2;
+}
+
+/** Run the 64 rounds on state s, with round i adding kw(i): the round constant plus the message word */
+template <typename V, typename KW>
+ALWAYS_INLINE void Rounds(V* s, const KW& kw)
+{
+    V a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+    for (int i = 0; i < 64; i += 8) {
+        Round(a, b, c, d, e, f, g, h, kw(i + 0));
+        Round(h, a, b, c, d, e, f, g, kw(i + 1));
+        Round(g, h, a, b, c, d, e, f, kw(i + 2));
+        Round(f, g, h, a, b, c, d, e, kw(i + 3));
+        Round(e, f, g, h, a, b, c, d, kw(i + 4));
+        Round(d, e, f, g, h, a, b, c, kw(i + 5));
+        Round(c, d, e, f, g, h, a, b, kw(i + 6));
+        Round(b, c, d, e, f, g, h, a, kw(i + 7));
+    }
+    s[0] += a; s[1] += b; s[2] += c; s[3] += d; s[4] += e; s[5] += f; s[6] += g; s[7] += h;
+}
+
+/** Round inputs of a message block, extending its 16 words in place into the schedule */
+template <typename V>
+struct MessageKW
+{
+    V* w;
+
+    ALWAYS_INLINE V operator()(int i) const
+    {
+        if (i >= 16)
+            w[i & 15] += sigma1(w[(i - 2) & 15]) + w[(i - 7) & 15] + sigma0(w[(i - 15) & 15]);
+        return w[i & 15] + K[i];
+    }
+};
+
+/** Round inputs of the padding block following a 64-byte message */
+template <typename V>
+struct PaddingKW
+{
+    ALWAYS_INLINE V operator()(int i) const { return Broadcast<V>(padding64.kw[i]); }
+};
+
+/** Load the 64-byte block of each of the N lanes into the message words */
+template <typename V, int N>
+ALWAYS_INLINE void LoadBlocks(V* w, const unsigned char* in)
+{
+    for (int j = 0; j < 16; j++) {
+        for (int lane = 0; lane < N; lane++)
+            w[j][lane] = ReadBE32(in + 64 * lane + 4 * j);
+    }
+}
+
+/** Second hash of a double-SHA256: hash the 32-byte first hash in state s, padded to one block, and write it out */
+template <typename V, int N>
+ALWAYS_INLINE void FinalizeD(unsigned char* out, V* s)
+{
+    V w[16];
+    for (int j = 0; j < 8; j++)
+        w[j] = s[j];
+    w[8] = Broadcast<V>(0x80000000ul);
+    for (int j = 9; j < 15; j++)
+        w[j] = Broadcast<V>(0);
+    w[15] = Broadcast<V>(256);
+    for (int j = 0; j < 8; j++)
+        s[j] = Broadcast<V>(INIT[j]);
+    Rounds(s, MessageKW<V>{w});
+
+    for (int lane = 0; lane < N; lane++) {
+        for (int j = 0; j < 8; j++)
+            WriteBE32(out + 32 * lane + 4 * j, s[j][lane]);
+    }
+}
+
+/** Double-SHA256 of N 64-byte inputs, one per lane. out may be in, as all input is read first. */
+template <typename V, int N>
+ALWAYS_INLINE void TransformD64(unsigned char* out, const unsigned char* in)
+{
+    V s[8], w[16];
+
+    // First hash: the 64 input bytes, then the padding block
+    LoadBlocks<V, N>(w, in);
+    for (int j = 0; j < 8; j++)
+        s[j] = Broadcast<V>(INIT[j]);
+    Rounds(s, MessageKW<V>{w});
+    Rounds(s, PaddingKW<V>());
+
+    FinalizeD<V, N>(out, s);
+}
+
+/** Double-SHA256 of N messages, one per lane, continuing from their midstates with their last, padded, block */
+template <typename V, int N>
+ALWAYS_INLINE void TransformDMidstate(unsigned char* out, const uint32_t* midstates, const unsigned char* in)
+{
+    V s[8], w[16];
+
+    LoadBlocks<V, N>(w, in);
+    for (int j = 0; j < 8; j++) {
+        for (int lane = 0; lane < N; lane++)
+            s[j][lane] = midstates[8 * lane + j];
+    }
+    Rounds(s, MessageKW<V>{w});
+
+    FinalizeD<V, N>(out, s);
+}
+
+} // namespace
+
+namespace sha256d64_sse41
+{
+__attribute__((target("sse4.1"))) void Transform_4way(unsigned char* out, const unsigned char* in)
+{
+    TransformD64<v4u32, 4>(out, in);
+}
+
+__attribute__((target("sse4.1"))) void TransformMidstate_4way(unsigned char* out, const uint32_t* midstates, const unsigned char* in)
+{
+    TransformDMidstate<v4u32, 4>(out, midstates, in);
+}
+}
+
+namespace sha256d64_avx2
+{
+__attribute__((target("avx2"))) void Transform_8way(unsigned char* out, const unsigned char* in)
+{
+    TransformD64<v8u32, 8>(out, in);
+}
+
+__attribute__((target("avx2"))) void TransformMidstate_8way(unsigned char* out, const uint32_t* midstates, const unsigned char* in)
+{
+    TransformDMidstate<v8u32, 8>(out, midstates, in);
+}
+}
+
+#endif // ENABLE_SHA256_MULTIWAY
@@ -73,14 +73,19 @@ public:
     }
 };
 
-static leveldb::Options GetOptions(size_t nCacheSize)
+static leveldb::Options GetOptions(size_t nCacheSize, const CDBOptions& dbOptions)
 {
     leveldb::Options options;
     options.block_cache = leveldb::NewLRUCache(nCacheSize / 2);
-    options.write_buffer_size = nCacheSize / 4; // up to two write buffers may be held in memory simultaneously
-    options.filter_policy = leveldb::NewBloomFilterPolicy(10);
-    options.compression = leveldb::kNoCompression;
-    options.max_open_files = 64;
+    if (dbOptions.nWriteBufferSize)
+        options.write_buffer_size = dbOptions.nWriteBufferSize;
+    else
+        options.write_buffer_size = nCacheSize / 4; // up to two write buffers may be held in memory simultaneously
+    if (dbOptions.nBloomBits > 0)
+        options.filter_policy = leveldb::NewBloomFilterPolicy(dbOptions.nBloomBits);
+    options.compression = dbOptions.fCompression ? leveldb::kSnappyCompression : leveldb::kNoCompression;
+    options.max_open_files = dbOptions.nMaxOpenFiles;
+    options.block_size = dbOptions.nBlockSize;
     options.info_log = new CBitcoinLevelDBLogger();
     if (leveldb::kMajorVersion > 1 || (leveldb::kMajorVersion == 1 && leveldb::kMinorVersion >= 16)) {
         // LevelDB versions before 1.16 consider short writes to be corruption. Only trigger error
@@ -90,14 +95,89 @@ static leveldb::Options GetOptions(size_t nCacheSize)
     return options;
 }
 
-CDBWrapper::CDBWrapper(const boost::filesystem::path& path, size_t nCacheSize, bool fMemory, bool fWipe, bool obfuscate)
+static bool ParseDBOptionSize(const std::string& strValue, int64_t nMin, int64_t nMax, int64_t& nValue)
+{
+    return ParseInt64(strValue, &nValue) && nValue >= nMin && nValue <= nMax;
+}
+
+/** The databases -dboption settings can be for */
+static const char* const DB_OPTION_DATABASES[] = {"chainstate", "blockindex", "address", "spent", "timestamp", "balance", "coinstats"};
+
+bool ParseDBOptions(const std::string& strName, CDBOptions& options, std::string& strError)
+{
+    std::map<std::string, std::vector<std::string> >::const_iterator itSettings = mapMultiArgs.find("-dboption");
+    if (itSettings == mapMultiArgs.end())
+        return true;
+    for (const std::string& strSetting : itSettings->second) {
+        size_t nDot = strSetting.find('.');
+        size_t nEquals = strSetting.find('=');
+        if (nDot == std::string::npos || nEquals == std::string::npos || nEquals < nDot) {
+            strError = strprintf("-dboption=%s is not of the form <database>.<option>=<value>", strSetting);
+            return false;
+        }
+        std::string strDatabase = strSetting.substr(0, nDot);
+        std::string strOption = strSetting.substr(nDot + 1, nEquals - nDot - 1);
+        std::string strValue = strSetting.substr(nEquals + 1);
+        if (std::find(std::begin(DB_OPTION_DATABASES), std::end(DB_OPTION_DATABASES), strDatabase) == std::end(DB_OPTION_DATABASES)) {
+            strError = strprintf("-dboption=%s: unknown database %s", strSetting, strDatabase);
+            return false;
+        }
+        CDBOptions parsed = options;
+        int64_t nValue = 0;
+        bool fValid;
+        if (strOption == "compression") {
+            // The bundled LevelDB is built without Snappy, which would store the blocks uncompressed
+            if (strValue == "1") {
+                strError = strprintf("-dboption=%s: compression is not available, LevelDB is built without Snappy", strSetting);
+                return false;
+            }
+            fValid = strValue == "0";
+            parsed.fCompression = false;
+        } else if (strOption == "bloombits") {
+            fValid = ParseDBOptionSize(strValue, 0, 64, nValue);
+            parsed.nBloomBits = nValue;
+        } else if (strOption == "writebuffer") {
+            // In MiB, like -dbcache
+            fValid = ParseDBOptionSize(strValue, 0, 1024, nValue);
+            parsed.nWriteBufferSize = nValue << 20;
+        } else if (strOption == "maxopenfiles") {
+            fValid = ParseDBOptionSize(strValue, 16, 100000, nValue);
+            parsed.nMaxOpenFiles = nValue;
+        } else if (strOption == "blocksize") {
+            // In KiB
+            fValid = ParseDBOptionSize(strValue, 1, 4096, nValue);
+            parsed.nBlockSize = nValue << 10;
+        } else {
+            strError = strprintf("-dboption=%s: unknown option %s", strSetting, strOption);
+            return false;
+        }
+        if (!fValid) {
+            strError = strprintf("-dboption=%s: invalid value for %s", strSetting, strOption);
+            return false;
+        }
+        if (strDatabase == strName)
+            options = parsed;
+    }
+    return true;
+}
+
+CDBOptions GetDBOptions(const std::string& strName)
+{
+    CDBOptions options;
+    std::string strError;
+    if (!ParseDBOptions(strName, options, strError))
+        return CDBOptions();
+    return options;
+}
+
+CDBWrapper::CDBWrapper(const boost::filesystem::path& path, size_t nCacheSizeIn, bool fMemory, bool fWipe, bool obfuscate, const CDBOptions& dbOptionsIn) : dbOptions(dbOptionsIn), nCacheSize(nCacheSizeIn)
 {
     penv = NULL;
     readoptions.verify_checksums = true;
     iteroptions.verify_checksums = true;
     iteroptions.fill_cache = false;
     syncoptions.sync = true;
-    options = GetOptions(nCacheSize);
+    options = GetOptions(nCacheSize, dbOptions);
     options.create_if_missing = true;
     if (fMemory) {
         penv = leveldb::NewMemEnv(leveldb::Env::Default());
@@ -182,6 +262,24 @@ std::vector<unsigned char> CDBWrapper::CreateObfuscateKey() const
 
 }
 
+size_t CDBWrapper::EstimateTotalSize() const
+{
+    // Keys start with a prefix byte below 0xff
+    std::string strEnd(1, '\xff');
+    leveldb::Range range("", strEnd);
+    uint64_t size = 0;
+    pdb->GetApproximateSizes(&range, 1, &size);
+    return size;
+}
+
+std::string CDBWrapper::GetProperty(const std::string& strProperty) const
+{
+    std::string strValue;
+    if (!pdb->GetProperty(strProperty, &strValue))
+        return std::string();
+    return strValue;
+}
+
 bool CDBWrapper::IsEmpty()
 {
     boost::scoped_ptr<CDBIterator> it(NewIterator());
@@ -20,6 +20,35 @@
 static const size_t DBWRAPPER_PREALLOC_KEY_SIZE = 64;
 static const size_t DBWRAPPER_PREALLOC_VALUE_SIZE = 1024;
 
+/** LevelDB settings of one database, tunable with -dboption */
+struct CDBOptions
+{
+    //! Compress table blocks with Snappy. -dboption only accepts 0, as the bundled LevelDB is built without it.
+    bool fCompression;
+    //! Bits per key of the bloom filter that lets reads of absent keys (such as
+    //! GetCoin misses) skip the table files, or 0 for no filter
+    int nBloomBits;
+    //! Size of the in-memory write buffer, or 0 for a quarter of the cache size
+    size_t nWriteBufferSize;
+    //! Number of table files kept open
+    int nMaxOpenFiles;
+    //! Approximate size of the uncompressed blocks table files are read in
+    size_t nBlockSize;
+
+    CDBOptions() : fCompression(false), nBloomBits(10), nWriteBufferSize(0), nMaxOpenFiles(64), nBlockSize(4096) {}
+};
+
+/**
+ * Apply the -dboption=<database>.<option>=<value> settings for one database
+ * (chainstate, blockindex, or the name of an explorer index) to options.
+ * Every setting is checked, whichever database it is for; returns false with
+ * strError set if one is malformed or names an unknown database or option.
+ */
+bool ParseDBOptions(const std::string& strName, CDBOptions& options, std::string& strError);
+
+/** The settings of one database, with malformed ones ignored (init rejects them) */
+CDBOptions GetDBOptions(const std::string& strName);
+
 class dbwrapper_error : public std::runtime_error
 {
 public:
@@ -173,6 +202,12 @@ public:
         return piter->value().size();
     }
 
+    /** Append the value as stored, still obfuscated, to vch */
+    void AppendRawValue(std::vector<char>& vch) {
+        leveldb::Slice slValue = piter->value();
+        vch.insert(vch.end(), slValue.data(), slValue.data() + slValue.size());
+    }
+
 };
 
 class CDBWrapper
@@ -185,6 +220,10 @@ private:
     //! database options used
     leveldb::Options options;
 
+    //! the settings options were made from
+    CDBOptions dbOptions;
+    size_t nCacheSize;
+
     //! options used when reading from the database
     leveldb::ReadOptions readoptions;
 
@@ -219,8 +258,9 @@ public:
      * @param[in] fWipe       If true, remove all existing data.
      * @param[in] obfuscate   If true, store data obfuscated via simple XOR. If false, XOR
      *                        with a zero'd byte array.
+     * @param[in] dbOptionsIn Compression, bloom filter and table settings.
      */
-    CDBWrapper(const boost::filesystem::path& path, size_t nCacheSize, bool fMemory = false, bool fWipe = false, bool obfuscate = false);
+    CDBWrapper(const boost::filesystem::path& path, size_t nCacheSize, bool fMemory = false, bool fWipe = false, bool obfuscate = false, const CDBOptions& dbOptionsIn = CDBOptions());
     ~CDBWrapper();
 
     template <typename K, typename V>
@@ -324,6 +364,15 @@ public:
         return size;
     }
 
+    /** Approximate size of the whole database on disk */
+    size_t EstimateTotalSize() const;
+
+    /** Value of a LevelDB property such as "leveldb.stats", or empty if it is unknown */
+    std::string GetProperty(const std::string& strProperty) const;
+
+    const CDBOptions& GetDBOptions() const { return dbOptions; }
+    size_t GetCacheSize() const { return nCacheSize; }
+
     /**
      * Compact a certain range of keys in the database.
      */
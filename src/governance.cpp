@@ -591,27 +591,29 @@ std::vector<CGovernanceVote> CGovernanceManager::GetCurrentVotes(const uint256&
     if(it == mapObjects.end()) return vecResult;
     CGovernanceObject& govobj = it->second;
 
-    CMasternode mn;
-    std::map<COutPoint, CMasternode> mapMasternodes;
+    std::vector<COutPoint> vecOutpoints;
     if(mnCollateralOutpointFilter == COutPoint()) {
-        mapMasternodes = mnodeman.GetFullMasternodeMap();
-    } else if (mnodeman.Get(mnCollateralOutpointFilter, mn)) {
-        mapMasternodes[mnCollateralOutpointFilter] = mn;
+        CMasternodeMan::snapshot_t pMasternodes = mnodeman.GetListSnapshot();
+        for (const auto& mnpair : *pMasternodes) {
+            vecOutpoints.push_back(mnpair.first);
+        }
+    } else if (mnodeman.Has(mnCollateralOutpointFilter)) {
+        vecOutpoints.push_back(mnCollateralOutpointFilter);
     }
 
     // Loop thru each MN collateral outpoint and get the votes for the `nParentHash` governance object
-    for (auto& mnpair : mapMasternodes)
+    for (const auto& outpoint : vecOutpoints)
     {
         // get a vote_rec_t from the govobj
         vote_rec_t voteRecord;
-        if (!govobj.GetCurrentMNVotes(mnpair.first, voteRecord)) continue;
+        if (!govobj.GetCurrentMNVotes(outpoint, voteRecord)) continue;
 
         for (vote_instance_m_it it3 = voteRecord.mapInstances.begin(); it3 != voteRecord.mapInstances.end(); ++it3) {
             int signal = (it3->first);
             int outcome = ((it3->second).eOutcome);
             int64_t nCreationTIMECoin = ((it3->second).nCreationTIMECoin);
 
-            CGovernanceVote vote = CGovernanceVote(mnpair.first, nParentHash, (vote_signal_enum_t)signal, (vote_outcome_enum_t)outcome);
+            CGovernanceVote vote = CGovernanceVote(outpoint, nParentHash, (vote_signal_enum_t)signal, (vote_outcome_enum_t)outcome);
             vote.SetTIMECoin(nCreationTIMECoin);
 
             vecResult.push_back(vote);
@@ -0,0 +1,629 @@
+// Copyright (c) 2009-2015 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "indexwriter.h"
+
+#include "chainparams.h"
+#include "primitives/block.h"
+#include "txdb.h"
+#include "undo.h"
+#include "util.h"
+#include "utiltime.h"
+#include "validation.h"
+
+#include <map>
+#include <set>
+
+#include <boost/thread.hpp>
+
+CIndexWriter indexWriter;
+
+CExplorerIndexState explorerIndexes[INDEX_COUNT] = {
+    { "address", true, NULL, NULL, false },
+    { "spent", true, NULL, NULL, false },
+    { "timestamp", true, NULL, NULL, false },
+    { "balance", false, NULL, NULL, false },
+    { "coinstats", false, NULL, NULL, false },
+};
+
+/** Cache size the index databases were opened with, for reopening one to wipe it */
+static size_t nExplorerIndexCacheSize = 0;
+
+void ApplyCoinStatsUpdate(CCoinStatsIndexValue& value, const CIndexBlockUpdate& update)
+{
+    // Undoing a block spends the coins it created and brings back the ones it spent
+    for (std::vector<std::pair<COutPoint, Coin> >::const_iterator it = update.coinsCreated.begin(); it != update.coinsCreated.end(); ++it) {
+        if (update.fErase)
+            value.SpendCoin(it->first, it->second);
+        else
+            value.AddCoin(it->first, it->second);
+    }
+    for (std::vector<std::pair<COutPoint, Coin> >::const_iterator it = update.coinsSpent.begin(); it != update.coinsSpent.end(); ++it) {
+        if (update.fErase)
+            value.AddCoin(it->first, it->second);
+        else
+            value.SpendCoin(it->first, it->second);
+    }
+    value.hashBlock = update.hashBestBlock;
+    value.nHeight = update.nBestHeight;
+}
+
+bool CIndexWriter::WriteUpdates(const std::deque<CIndexBlockUpdate>& updates)
+{
+    if (updates.empty())
+        return true;
+
+    int64_t nTIMECoinStart = GetTIMECoinMicros();
+    size_t nEntries = 0;
+    for (std::deque<CIndexBlockUpdate>::const_iterator it = updates.begin(); it != updates.end(); ++it)
+        nEntries += it->GetEntryCount();
+
+    for (int nIndex = 0; nIndex < INDEX_COUNT; nIndex++) {
+        CExplorerIndexDB* pdb = explorerIndexes[nIndex].pdb;
+        if (!pdb)
+            continue;
+
+        CDBBatch batch(*pdb);
+        const CIndexBlockUpdate* pupdateLast = NULL;
+        std::map<std::pair<unsigned int, uint160>, CAddressBalanceValue> mapBalanceChanges;
+        CCoinStatsIndexValue coinStats;
+        if (nIndex == INDEX_COINSTATS && !pdb->ReadCoinStats(coinStats) && !pdb->IsEmpty())
+            return error("%s: failed to read %s index", __func__, pdb->name);
+        for (std::deque<CIndexBlockUpdate>::const_iterator it = updates.begin(); it != updates.end(); ++it) {
+            if (!(it->nIndexes & (1 << nIndex)))
+                continue;
+            switch (nIndex) {
+            case INDEX_ADDRESS:
+                pdb->BatchAddressIndex(batch, it->addressIndex, it->fErase);
+                pdb->BatchAddressUnspentIndex(batch, it->addressUnspentIndex);
+                break;
+            case INDEX_SPENT:
+                pdb->BatchSpentIndex(batch, it->spentIndex);
+                break;
+            case INDEX_TIMESTAMP:
+                if (it->fTIMECoinstamp)
+                    pdb->BatchTIMECoinstampIndex(batch, it->timestampIndex);
+                break;
+            case INDEX_BALANCE:
+                for (std::vector<std::pair<CAddressIndexIteratorKey, CAddressBalanceValue> >::const_iterator itBalance = it->addressBalanceIndex.begin(); itBalance != it->addressBalanceIndex.end(); ++itBalance)
+                    mapBalanceChanges[std::make_pair(itBalance->first.type, itBalance->first.hashBytes)] += itBalance->second;
+                break;
+            case INDEX_COINSTATS:
+                ApplyCoinStatsUpdate(coinStats, *it);
+                break;
+            }
+            pupdateLast = &*it;
+        }
+        if (!pupdateLast)
+            continue;
+
+        // Each total is read once per batch, and only ever by this thread
+        for (std::map<std::pair<unsigned int, uint160>, CAddressBalanceValue>::const_iterator it = mapBalanceChanges.begin(); it != mapBalanceChanges.end(); ++it) {
+            CAddressBalanceValue value;
+            if (!pdb->ReadAddressBalance(it->first.second, it->first.first, value))
+                return error("%s: failed to read %s index", __func__, pdb->name);
+            value += it->second;
+            pdb->BatchAddressBalance(batch, it->first.second, it->first.first, value);
+        }
+        if (nIndex == INDEX_COINSTATS)
+            pdb->BatchCoinStats(batch, coinStats);
+        pdb->BatchBestBlock(batch, pupdateLast->hashBestBlock, pupdateLast->nBestHeight);
+
+        try {
+            if (!pdb->WriteBatch(batch))
+                return error("%s: failed to write %s index", __func__, pdb->name);
+        } catch (const std::exception& e) {
+            return error("%s: failed to write %s index: %s", __func__, pdb->name, e.what());
+        }
+    }
+
+    LogPrint("bench", "    - Index writer: %u blocks, %u entries up to height %d: %.2fms\n",
+             updates.size(), nEntries, updates.back().nBestHeight, 0.001 * (GetTIMECoinMicros() - nTIMECoinStart));
+    return true;
+}
+
+bool CIndexWriter::Push(CIndexBlockUpdate& update)
+{
+    // Called from ConnectBlock; don't abandon a block half way through
+    boost::this_thread::disable_interruption di;
+    boost::unique_lock<boost::mutex> lock(mutex);
+    if (fFailed)
+        return false;
+
+    // Let the writer catch up if it has fallen far behind
+    while (fRunning && !fFailed && nQueuedEntries >= INDEXWRITER_MAX_QUEUED_ENTRIES)
+        condIdle.wait(lock);
+
+    queue.push_back(CIndexBlockUpdate());
+    CIndexBlockUpdate& queued = queue.back();
+    queued.nIndexes = update.nIndexes;
+    queued.hashBestBlock = update.hashBestBlock;
+    queued.nBestHeight = update.nBestHeight;
+    queued.fErase = update.fErase;
+    queued.addressIndex.swap(update.addressIndex);
+    queued.addressUnspentIndex.swap(update.addressUnspentIndex);
+    queued.spentIndex.swap(update.spentIndex);
+    queued.fTIMECoinstamp = update.fTIMECoinstamp;
+    queued.timestampIndex = update.timestampIndex;
+    queued.addressBalanceIndex.swap(update.addressBalanceIndex);
+    queued.coinsCreated.swap(update.coinsCreated);
+    queued.coinsSpent.swap(update.coinsSpent);
+    nQueuedEntries += queued.GetEntryCount();
+
+    if (!fRunning && nQueuedEntries >= INDEXWRITER_BATCH_ENTRIES) {
+        // Nobody else is going to write these
+        lock.unlock();
+        return Sync();
+    }
+    condWorker.notify_one();
+    return true;
+}
+
+bool CIndexWriter::Sync()
+{
+    boost::this_thread::disable_interruption di;
+    boost::unique_lock<boost::mutex> lock(mutex);
+    nSyncWaiting++;
+    condWorker.notify_one();
+    while (fRunning && !fFailed && (!queue.empty() || fWriting))
+        condIdle.wait(lock);
+    nSyncWaiting--;
+
+    if (!fRunning && !fFailed && !queue.empty()) {
+        // No writer thread (yet, or any more): write the queue from here
+        std::deque<CIndexBlockUpdate> updates;
+        updates.swap(queue);
+        nQueuedEntries = 0;
+        if (!WriteUpdates(updates))
+            fFailed = true;
+        condIdle.notify_all();
+    }
+    return !fFailed;
+}
+
+void CIndexWriter::Thread()
+{
+    {
+        boost::unique_lock<boost::mutex> lock(mutex);
+        fRunning = true;
+    }
+    try {
+        while (true) {
+            std::deque<CIndexBlockUpdate> updates;
+            {
+                boost::unique_lock<boost::mutex> lock(mutex);
+                while (queue.empty())
+                    condWorker.wait(lock);
+                // Give ConnectBlock a moment to queue more blocks, so they share one batch
+                boost::system_time deadline = boost::get_system_time() + boost::posix_time::milliseconds(INDEXWRITER_BATCH_WAIT);
+                while (nQueuedEntries < INDEXWRITER_BATCH_ENTRIES && nSyncWaiting == 0) {
+                    if (!condWorker.timed_wait(lock, deadline))
+                        break;
+                }
+                updates.swap(queue);
+                nQueuedEntries = 0;
+                fWriting = true;
+                condIdle.notify_all();
+            }
+
+            bool fOk = WriteUpdates(updates);
+
+            {
+                boost::unique_lock<boost::mutex> lock(mutex);
+                fWriting = false;
+                if (!fOk)
+                    fFailed = true;
+                condIdle.notify_all();
+            }
+            if (!fOk)
+                break;
+        }
+    } catch (const boost::thread_interrupted&) {
+        boost::unique_lock<boost::mutex> lock(mutex);
+        fRunning = false;
+        condIdle.notify_all();
+        throw;
+    }
+
+    boost::unique_lock<boost::mutex> lock(mutex);
+    fRunning = false;
+    condIdle.notify_all();
+}
+
+void ThreadIndexWriter()
+{
+    RenameThread("time-indexwriter");
+    indexWriter.Thread();
+}
+
+/** The address index type and hash of a script, or 0 for scripts the indexes don't track */
+static int GetIndexAddress(const CScript& script, uint160& hashBytes)
+{
+    if (script.IsPayToScriptHash()) {
+        hashBytes = uint160(std::vector<unsigned char>(script.begin()+2, script.begin()+22));
+        return 2;
+    } else if (script.IsPayToPublicKeyHash()) {
+        hashBytes = uint160(std::vector<unsigned char>(script.begin()+3, script.begin()+23));
+        return 1;
+    }
+    hashBytes.SetNull();
+    return 0;
+}
+
+static void IndexTxOutputs(const CTransaction& tx, int nTx, const CBlockIndex* pindex, bool fDisconnect, CIndexBlockUpdate& update)
+{
+    const uint256& txhash = tx.GetHash();
+    for (unsigned int n = 0; n < tx.vout.size(); n++) {
+        // Outputs are undone in reverse order
+        unsigned int k = fDisconnect ? tx.vout.size() - 1 - n : n;
+        const CTxOut& out = tx.vout[k];
+        uint160 hashBytes;
+        int addressType = GetIndexAddress(out.scriptPubKey, hashBytes);
+        if (addressType == 0)
+            continue;
+
+        // record (or undo) receiving activity
+        update.addressIndex.push_back(std::make_pair(CAddressIndexKey(addressType, hashBytes, pindex->nHeight, nTx, txhash, k, false), out.nValue));
+
+        // record (or remove) the unspent output
+        update.addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(addressType, hashBytes, txhash, k),
+                                                            fDisconnect ? CAddressUnspentValue() : CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
+    }
+}
+
+static void IndexTxInputs(const CTransaction& tx, int nTx, const CTxUndo& txundo, const CBlockIndex* pindex, bool fDisconnect, CIndexBlockUpdate& update)
+{
+    const bool fAddress = update.nIndexes & ((1 << INDEX_ADDRESS) | (1 << INDEX_BALANCE));
+    const bool fSpent = update.nIndexes & (1 << INDEX_SPENT);
+    const uint256& txhash = tx.GetHash();
+    for (unsigned int n = 0; n < tx.vin.size(); n++) {
+        // Inputs are restored in reverse order
+        unsigned int j = fDisconnect ? tx.vin.size() - 1 - n : n;
+        const COutPoint& prevout = tx.vin[j].prevout;
+        const Coin& coin = txundo.vprevout[j];
+        uint160 hashBytes;
+        int addressType = GetIndexAddress(coin.out.scriptPubKey, hashBytes);
+
+        if (fSpent) {
+            // the txid and input that spent an output, and the amount and address of an input
+            update.spentIndex.push_back(std::make_pair(CSpentIndexKey(prevout.hash, prevout.n),
+                                                       fDisconnect ? CSpentIndexValue() : CSpentIndexValue(txhash, j, pindex->nHeight, coin.out.nValue, addressType, hashBytes)));
+        }
+
+        if (fAddress && addressType > 0) {
+            // record (or undo) spending activity
+            update.addressIndex.push_back(std::make_pair(CAddressIndexKey(addressType, hashBytes, pindex->nHeight, nTx, txhash, j, true), coin.out.nValue * -1));
+
+            // remove (or restore) the spent output in the unspent index
+            update.addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(addressType, hashBytes, prevout.hash, prevout.n),
+                                                                fDisconnect ? CAddressUnspentValue(coin.out.nValue, coin.out.scriptPubKey, coin.nHeight) : CAddressUnspentValue()));
+        }
+    }
+}
+
+bool BuildIndexBlockUpdate(const CBlock& block, const CBlockUndo& blockundo, const CBlockIndex* pindex, bool fDisconnect, unsigned int nIndexes, CIndexBlockUpdate& update)
+{
+    const CBlockIndex* pindexBest = fDisconnect ? pindex->pprev : pindex;
+    update.nIndexes = nIndexes;
+    update.hashBestBlock = pindexBest->GetBlockHash();
+    update.nBestHeight = pindexBest->nHeight;
+    update.fErase = fDisconnect;
+
+    // The genesis block's outputs are not spendable and never indexed. ConnectBlock
+    // doesn't add its coinbase to the UTXO set either, so the coinstats index
+    // must not count it to match a scan.
+    if (!pindex->pprev)
+        return true;
+
+    if (blockundo.vtxundo.size() + 1 != block.vtx.size())
+        return error("%s: block and undo data inconsistent", __func__);
+
+    // The balance index is derived from the address index entries
+    const bool fAddress = nIndexes & ((1 << INDEX_ADDRESS) | (1 << INDEX_BALANCE));
+    if (fAddress || (nIndexes & (1 << INDEX_SPENT))) {
+        // Entries are in the order the block is connected, or reverse order when
+        // disconnecting, as one batch may both create and spend an output
+        for (unsigned int n = 0; n < block.vtx.size(); n++) {
+            unsigned int i = fDisconnect ? block.vtx.size() - 1 - n : n;
+            const CTransaction& tx = block.vtx[i];
+            if (fDisconnect && fAddress)
+                IndexTxOutputs(tx, i, pindex, fDisconnect, update);
+            if (i > 0) {
+                const CTxUndo& txundo = blockundo.vtxundo[i-1];
+                if (txundo.vprevout.size() != tx.vin.size())
+                    return error("%s: transaction and undo data inconsistent", __func__);
+                IndexTxInputs(tx, i, txundo, pindex, fDisconnect, update);
+            }
+            if (!fDisconnect && fAddress)
+                IndexTxOutputs(tx, i, pindex, fDisconnect, update);
+        }
+    }
+
+    if (nIndexes & (1 << INDEX_BALANCE)) {
+        std::map<std::pair<unsigned int, uint160>, CAddressBalanceValue> mapBalanceChanges;
+        std::set<std::pair<std::pair<unsigned int, uint160>, uint256> > setAddressTxs;
+        for (std::vector<std::pair<CAddressIndexKey, CAmount> >::const_iterator it = update.addressIndex.begin(); it != update.addressIndex.end(); ++it) {
+            std::pair<unsigned int, uint160> address(it->first.type, it->first.hashBytes);
+            CAddressBalanceValue& change = mapBalanceChanges[address];
+            change.balance += it->second;
+            if (it->second > 0)
+                change.received += it->second;
+            if (setAddressTxs.insert(std::make_pair(address, it->first.txhash)).second)
+                change.txCount++;
+        }
+        update.addressBalanceIndex.reserve(mapBalanceChanges.size());
+        for (std::map<std::pair<unsigned int, uint160>, CAddressBalanceValue>::const_iterator it = mapBalanceChanges.begin(); it != mapBalanceChanges.end(); ++it) {
+            CAddressBalanceValue change = it->second;
+            if (fDisconnect)
+                change = CAddressBalanceValue(-change.balance, -change.received, -change.txCount);
+            update.addressBalanceIndex.push_back(std::make_pair(CAddressIndexIteratorKey(it->first.first, it->first.second), change));
+        }
+        if (!(nIndexes & (1 << INDEX_ADDRESS))) {
+            update.addressIndex.clear();
+            update.addressUnspentIndex.clear();
+        }
+    }
+
+    if (nIndexes & (1 << INDEX_COINSTATS)) {
+        // The same coins either way: the writer applies them in reverse when disconnecting
+        for (unsigned int i = 0; i < block.vtx.size(); i++) {
+            const CTransaction& tx = block.vtx[i];
+            const uint256& txhash = tx.GetHash();
+            for (unsigned int k = 0; k < tx.vout.size(); k++) {
+                // Like AddCoins, skip outputs that never enter the UTXO set
+                if (!tx.vout[k].scriptPubKey.IsUnspendable())
+                    update.coinsCreated.push_back(std::make_pair(COutPoint(txhash, k), Coin(tx.vout[k], pindex->nHeight, tx.IsCoinBase())));
+            }
+            if (i > 0) {
+                const CTxUndo& txundo = blockundo.vtxundo[i-1];
+                if (txundo.vprevout.size() != tx.vin.size())
+                    return error("%s: transaction and undo data inconsistent", __func__);
+                for (unsigned int j = 0; j < tx.vin.size(); j++)
+                    update.coinsSpent.push_back(std::make_pair(tx.vin[j].prevout, txundo.vprevout[j]));
+            }
+        }
+    }
+
+    if ((nIndexes & (1 << INDEX_TIMESTAMP)) && !fDisconnect) {
+        update.fTIMECoinstamp = true;
+        update.timestampIndex = CTIMECoinstampIndexKey(pindex->nTIMECoin, pindex->GetBlockHash());
+    }
+    return true;
+}
+
+bool PushExplorerIndexUpdate(CIndexBlockUpdate& update, const CBlockIndex* pindexBest)
+{
+    AssertLockHeld(cs_main);
+    const unsigned int nIndexes = update.nIndexes;
+    if (!indexWriter.Push(update))
+        return false;
+    for (int nIndex = 0; nIndex < INDEX_COUNT; nIndex++) {
+        if (nIndexes & (1 << nIndex))
+            explorerIndexes[nIndex].pindexBest = pindexBest;
+    }
+    return true;
+}
+
+unsigned int GetSyncedExplorerIndexes(const CBlockIndex* pindexBest)
+{
+    AssertLockHeld(cs_main);
+    unsigned int nIndexes = 0;
+    for (int nIndex = 0; nIndex < INDEX_COUNT; nIndex++) {
+        // VerifyDB reconnects blocks the indexes already have
+        if (explorerIndexes[nIndex].pdb && explorerIndexes[nIndex].fSynced && explorerIndexes[nIndex].pindexBest == pindexBest)
+            nIndexes |= 1 << nIndex;
+    }
+    return nIndexes;
+}
+
+bool IsExplorerIndexSynced(ExplorerIndex index)
+{
+    LOCK(cs_main);
+    return explorerIndexes[index].pdb && explorerIndexes[index].fSynced;
+}
+
+void OpenExplorerIndexes(size_t nCacheSize, bool fWipe)
+{
+    const bool fEnabled[INDEX_COUNT] = { fAddressIndex, fSpentIndex, fTIMECoinstampIndex, fAddressBalanceIndex, fCoinStatsIndex };
+
+    CloseExplorerIndexes();
+    nExplorerIndexCacheSize = nCacheSize;
+    for (int nIndex = 0; nIndex < INDEX_COUNT; nIndex++) {
+        CExplorerIndexState& index = explorerIndexes[nIndex];
+        // A disabled index is left on disk as it is, and caught up if it is enabled again
+        if (fEnabled[nIndex])
+            index.pdb = new CExplorerIndexDB(index.name, nCacheSize, false, fWipe);
+    }
+}
+
+/**
+ * Versions before the indexes had databases of their own kept the address,
+ * spent and timestamp indexes in the block tree. Move them into indexes/<name>
+ * as of the block they were written up to, rather than rebuilding them from
+ * the block files. An index that is not enabled is left where it is until it
+ * is; once none is left this is not looked at again.
+ */
+static bool MoveLegacyExplorerIndexes()
+{
+    AssertLockHeld(cs_main);
+    if (pblocktree->ReadLegacyExplorerIndexesMoved())
+        return true;
+
+    // Before the indexes were written in the background they were written with
+    // the blocks, so without a best block of their own they are at the tip
+    const CBlockIndex* pindexLegacy = chainActive.Tip();
+    uint256 hashLegacy;
+    int nLegacyHeight;
+    if (pblocktree->ReadLegacyIndexBestBlock(hashLegacy, nLegacyHeight)) {
+        BlockMap::iterator mi = mapBlockIndex.find(hashLegacy);
+        pindexLegacy = mi != mapBlockIndex.end() && mi->second->nHeight == nLegacyHeight ? mi->second : NULL;
+    }
+
+    bool fAllMoved = true;
+    const ExplorerIndex legacyIndexes[] = {INDEX_ADDRESS, INDEX_SPENT, INDEX_TIMESTAMP};
+    for (ExplorerIndex nIndex : legacyIndexes) {
+        CExplorerIndexState& index = explorerIndexes[nIndex];
+        bool fLegacy = false;
+        pblocktree->ReadFlag(std::string(index.name) + "index", fLegacy);
+        if (fLegacy && !index.pdb) {
+            LogPrintf("%s: keeping the %s index an older version left in the block index database until it is enabled\n", __func__, index.name);
+            fAllMoved = false;
+            continue;
+        }
+
+        CExplorerIndexDB* pdbTo = NULL;
+        if (fLegacy && pindexLegacy) {
+            uint256 hashBest;
+            int nBestHeight;
+            if (!index.pdb->IsEmpty() && !index.pdb->ReadBestBlock(hashBest, nBestHeight)) {
+                // A move that was cut short
+                delete index.pdb;
+                index.pdb = new CExplorerIndexDB(index.name, nExplorerIndexCacheSize, false, true);
+            }
+            if (index.pdb->IsEmpty())
+                pdbTo = index.pdb;
+        }
+
+        size_t nMoved = 0;
+        if (!pblocktree->MoveLegacyExplorerIndex(index.name, pdbTo, pindexLegacy ? pindexLegacy->GetBlockHash() : uint256(),
+                                                 pindexLegacy ? pindexLegacy->nHeight : -1, nMoved))
+            return error("%s: failed to move the %s index out of the block index database", __func__, index.name);
+        if (pdbTo)
+            LogPrintf("%s: moved %u %s index entries at height %d out of the block index database\n", __func__, nMoved, index.name, pindexLegacy->nHeight);
+        else if (fLegacy && pindexLegacy)
+            LogPrintf("%s: erased the copy of the %s index left in the block index database\n", __func__, index.name);
+        else if (fLegacy)
+            LogPrintf("%s: erased the %s index left in the block index database at unknown block %s\n", __func__, index.name, hashLegacy.ToString());
+    }
+
+    if (fAllMoved && !pblocktree->WriteLegacyExplorerIndexesMoved())
+        return error("%s: failed to write to the block index database", __func__);
+    return true;
+}
+
+bool LoadExplorerIndexes()
+{
+    LOCK(cs_main);
+    if (!MoveLegacyExplorerIndexes())
+        return false;
+
+    for (int nIndex = 0; nIndex < INDEX_COUNT; nIndex++) {
+        CExplorerIndexState& index = explorerIndexes[nIndex];
+        index.pindexBest = NULL;
+        index.fSynced = false;
+        if (!index.pdb)
+            continue;
+
+        uint256 hashBest;
+        int nBestHeight;
+        if (index.pdb->ReadBestBlock(hashBest, nBestHeight)) {
+            BlockMap::iterator mi = mapBlockIndex.find(hashBest);
+            if (mi == mapBlockIndex.end() || nBestHeight != mi->second->nHeight) {
+                LogPrintf("%s: %s index is at unknown block %s, rebuilding it\n", __func__, index.name, hashBest.ToString());
+                delete index.pdb;
+                index.pdb = new CExplorerIndexDB(index.name, nExplorerIndexCacheSize, false, true);
+            } else {
+                index.pindexBest = mi->second;
+            }
+        } else if (!index.pdb->IsEmpty()) {
+            return error("%s: %s index has no best block", __func__, index.name);
+        } else {
+            LogPrintf("%s: %s index is empty, building it from the block files in the background\n", __func__, index.name);
+        }
+
+        // The index may have been written past a chainstate that was not
+        // flushed; re-applying those blocks' entries when they are connected
+        // again is harmless, so it is in sync at the tip. Otherwise the index
+        // builder disconnects those blocks from it first.
+        const CBlockIndex* pindexTip = chainActive.Tip();
+        if (index.fIdempotent && index.pindexBest && pindexTip && index.pindexBest->nHeight > pindexTip->nHeight &&
+            index.pindexBest->GetAncestor(pindexTip->nHeight) == pindexTip)
+            index.pindexBest = pindexTip;
+
+        index.fSynced = index.pindexBest == pindexTip;
+        LogPrintf("%s: %s index enabled, %s at height %d\n", __func__, index.name,
+                  index.fSynced ? "synced" : "catching up from", index.pindexBest ? index.pindexBest->nHeight : -1);
+    }
+    return true;
+}
+
+void CloseExplorerIndexes()
+{
+    indexWriter.Sync();
+    LOCK(cs_main);
+    for (int nIndex = 0; nIndex < INDEX_COUNT; nIndex++) {
+        CExplorerIndexState& index = explorerIndexes[nIndex];
+        delete index.pdb;
+        index.pdb = NULL;
+        index.pindexBest = NULL;
+        index.fSynced = false;
+    }
+}
+
+/** Bring one index up to the active chain tip, one block at a time */
+static bool BuildExplorerIndex(ExplorerIndex nIndex)
+{
+    const Consensus::Params& consensusParams = Params().GetConsensus();
+    CExplorerIndexState& index = explorerIndexes[nIndex];
+    int64_t nLastProgress = GetTIMECoinMillis();
+
+    while (true) {
+        boost::this_thread::interruption_point();
+
+        const CBlockIndex* pindex;
+        bool fDisconnect;
+        CDiskBlockPos posUndo;
+        {
+            LOCK(cs_main);
+            if (!index.pdb)
+                return true;
+            if (index.pindexBest && !chainActive.Contains(index.pindexBest)) {
+                // Left on a fork: rewind to the active chain first
+                pindex = index.pindexBest;
+                fDisconnect = true;
+            } else {
+                pindex = index.pindexBest ? chainActive.Next(index.pindexBest) : chainActive.Genesis();
+                fDisconnect = false;
+            }
+            if (!pindex) {
+                index.fSynced = true;
+                LogPrintf("%s: %s index synced at height %d\n", __func__, index.name, chainActive.Height());
+                return true;
+            }
+            if (!(pindex->nStatus & BLOCK_HAVE_DATA))
+                return error("%s: %s index: block %s not available", __func__, index.name, pindex->GetBlockHash().ToString());
+            posUndo = pindex->GetUndoPos();
+        }
+
+        CBlock block;
+        CBlockUndo blockundo;
+        if (!ReadBlockFromDisk(block, pindex, consensusParams))
+            return error("%s: %s index: failed to read block %s", __func__, index.name, pindex->GetBlockHash().ToString());
+        if (pindex->pprev && (posUndo.IsNull() || !UndoReadFromDisk(blockundo, posUndo, pindex->pprev->GetBlockHash())))
+            return error("%s: %s index: failed to read undo data of block %s", __func__, index.name, pindex->GetBlockHash().ToString());
+
+        CIndexBlockUpdate update;
+        if (!BuildIndexBlockUpdate(block, blockundo, pindex, fDisconnect, 1 << nIndex, update))
+            return error("%s: %s index: failed to index block %s", __func__, index.name, pindex->GetBlockHash().ToString());
+        {
+            LOCK(cs_main);
+            if (!PushExplorerIndexUpdate(update, fDisconnect ? pindex->pprev : pindex))
+                return error("%s: %s index: failed to write block %s", __func__, index.name, pindex->GetBlockHash().ToString());
+        }
+
+        if (GetTIMECoinMillis() - nLastProgress > 10000) {
+            LogPrintf("%s: %s index at height %d\n", __func__, index.name, pindex->nHeight);
+            nLastProgress = GetTIMECoinMillis();
+        }
+    }
+}
+
+void ThreadBuildExplorerIndexes()
+{
+    RenameThread("time-indexbuild");
+    for (int nIndex = 0; nIndex < INDEX_COUNT; nIndex++) {
+        if (!IsExplorerIndexSynced((ExplorerIndex)nIndex) && !BuildExplorerIndex((ExplorerIndex)nIndex))
+            LogPrintf("%s: building the %s index failed, it stays unavailable\n", __func__, explorerIndexes[nIndex].name);
+    }
+}
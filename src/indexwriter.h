@@ -0,0 +1,188 @@
+// Copyright (c) 2009-2015 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_INDEXWRITER_H
+#define BITCOIN_INDEXWRITER_H
+
+#include "amount.h"
+#include "coins.h"
+#include "spentindex.h"
+#include "uint256.h"
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+class CBlock;
+class CBlockIndex;
+class CBlockUndo;
+class CCoinStatsIndexValue;
+class CExplorerIndexDB;
+
+/** Stop accumulating and write once this many index entries are queued */
+static const size_t INDEXWRITER_BATCH_ENTRIES = 100000;
+/** Block ConnectBlock when this many index entries are waiting to be written */
+static const size_t INDEXWRITER_MAX_QUEUED_ENTRIES = 1000000;
+/** How long the writer waits for more blocks before writing a partial batch (ms) */
+static const int INDEXWRITER_BATCH_WAIT = 100;
+
+/** The explorer indexes, each kept in its own database */
+enum ExplorerIndex
+{
+    INDEX_ADDRESS = 0,  //!< -addressindex: address deltas and unspent outputs
+    INDEX_SPENT,        //!< -spentindex
+    INDEX_TIMESTAMP,    //!< -timestampindex
+    INDEX_BALANCE,      //!< -addressbalanceindex: running totals per address
+    INDEX_COINSTATS,    //!< -coinstatsindex: MuHash and totals of the UTXO set
+    INDEX_COUNT
+};
+
+/** State of one explorer index. Guarded by cs_main, except that pdb only changes during init and shutdown. */
+struct CExplorerIndexState
+{
+    //! Database directory under indexes/, and the name getindexinfo reports
+    const char* name;
+
+    //! Whether writing a block's entries twice is harmless. The running
+    //! totals of the balance index are not, so it is never fast-forwarded.
+    bool fIdempotent;
+
+    //! NULL when the index is disabled
+    CExplorerIndexDB* pdb;
+
+    //! The last block the index has been updated to (the update may still be queued)
+    const CBlockIndex* pindexBest;
+
+    //! Once synced, ConnectBlock and DisconnectBlock keep the index up to date.
+    //! Before that the index builder thread catches it up with the active chain.
+    bool fSynced;
+};
+
+extern CExplorerIndexState explorerIndexes[INDEX_COUNT];
+
+/** The explorer index changes made by connecting or disconnecting one block */
+struct CIndexBlockUpdate
+{
+    //! Bit (1 << ExplorerIndex) set for each index this update covers
+    unsigned int nIndexes;
+
+    //! The block the indexes describe once this update is written
+    uint256 hashBestBlock;
+    int nBestHeight;
+
+    //! Disconnecting erases the block's address index entries instead of writing them
+    bool fErase;
+    std::vector<std::pair<CAddressIndexKey, CAmount> > addressIndex;
+    std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > addressUnspentIndex;
+    std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> > spentIndex;
+    bool fTIMECoinstamp;
+    CTIMECoinstampIndexKey timestampIndex;
+    //! Changes to each address's running totals, negated when disconnecting
+    std::vector<std::pair<CAddressIndexIteratorKey, CAddressBalanceValue> > addressBalanceIndex;
+    //! The coins the block creates and spends; disconnecting undoes both
+    std::vector<std::pair<COutPoint, Coin> > coinsCreated;
+    std::vector<std::pair<COutPoint, Coin> > coinsSpent;
+
+    CIndexBlockUpdate() : nIndexes(0), nBestHeight(-1), fErase(false), fTIMECoinstamp(false) {}
+
+    size_t GetEntryCount() const
+    {
+        return addressIndex.size() + addressUnspentIndex.size() + spentIndex.size() + (fTIMECoinstamp ? 1 : 0) + addressBalanceIndex.size() +
+               coinsCreated.size() + coinsSpent.size();
+    }
+};
+
+/**
+ * Writes the explorer indexes (-addressindex, -spentindex, -timestampindex,
+ * -addressbalanceindex, -coinstatsindex) to their databases on its own thread.
+ *
+ * Updates are applied in the order they are pushed. The writer gathers the
+ * updates of as many blocks as are waiting into a single LevelDB batch per
+ * index, together with the hash and height of the last block in it, so each
+ * index on disk always describes a whole number of blocks.
+ *
+ * Readers and FlushStateToDisk call Sync() first; flushing the chainstate
+ * only after the indexes keeps the indexes from ever being behind it.
+ */
+class CIndexWriter
+{
+private:
+    //! Protects everything below
+    boost::mutex mutex;
+
+    //! The writer thread blocks on this when out of work
+    boost::condition_variable condWorker;
+
+    //! Pushing and syncing threads block on this while the writer catches up
+    boost::condition_variable condIdle;
+
+    std::deque<CIndexBlockUpdate> queue;
+    size_t nQueuedEntries;
+
+    //! Whether a batch taken off the queue is being written
+    bool fWriting;
+
+    //! Whether the writer thread is running; Sync() writes inline otherwise
+    bool fRunning;
+
+    //! Number of Sync() calls waiting, which makes the writer skip accumulation
+    int nSyncWaiting;
+
+    //! Set once a write failed. Nothing further is written.
+    bool fFailed;
+
+    bool WriteUpdates(const std::deque<CIndexBlockUpdate>& updates);
+
+public:
+    CIndexWriter() : nQueuedEntries(0), fWriting(false), fRunning(false), nSyncWaiting(0), fFailed(false) {}
+
+    /** Queue an update. Its contents are moved out. Returns false if an earlier write failed. */
+    bool Push(CIndexBlockUpdate& update);
+
+    /** Wait until every queued update is on disk. Returns false if a write failed. */
+    bool Sync();
+
+    /** Worker thread body, runs until interrupted */
+    void Thread();
+};
+
+extern CIndexWriter indexWriter;
+
+/** Run the index writer thread */
+void ThreadIndexWriter();
+
+/**
+ * Compute the index changes of connecting (or, with fDisconnect, disconnecting)
+ * a block from the block and its undo data, for the indexes in nIndexes.
+ */
+bool BuildIndexBlockUpdate(const CBlock& block, const CBlockUndo& blockundo, const CBlockIndex* pindex, bool fDisconnect, unsigned int nIndexes, CIndexBlockUpdate& update);
+
+/** Bring the UTXO set state of the coinstats index forward, or back, by one block */
+void ApplyCoinStatsUpdate(CCoinStatsIndexValue& value, const CIndexBlockUpdate& update);
+
+/** Queue an update and record its block as the best block of the indexes it covers. cs_main must be held. */
+bool PushExplorerIndexUpdate(CIndexBlockUpdate& update, const CBlockIndex* pindexBest);
+
+/** The synced indexes written up to pindexBest, which ConnectBlock and DisconnectBlock have to update. cs_main must be held. */
+unsigned int GetSyncedExplorerIndexes(const CBlockIndex* pindexBest);
+
+/** Whether an index is enabled and caught up with the active chain */
+bool IsExplorerIndexSynced(ExplorerIndex index);
+
+/** Open the databases of the enabled indexes (fAddressIndex, fSpentIndex, fTIMECoinstampIndex, fAddressBalanceIndex, fCoinStatsIndex) */
+void OpenExplorerIndexes(size_t nCacheSize, bool fWipe);
+
+/** Read where each open index was written up to. Requires the block index to be loaded. */
+bool LoadExplorerIndexes();
+
+/** Write out anything queued and close the databases */
+void CloseExplorerIndexes();
+
+/** Catch up the indexes that are behind the active chain, then exit */
+void ThreadBuildExplorerIndexes();
+
+#endif // BITCOIN_INDEXWRITER_H
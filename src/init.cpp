@@ -18,8 +18,10 @@
 #include "checkpoints.h"
 #include "compat/sanity.h"
 #include "consensus/validation.h"
+#include "crypto/sha256.h"
 #include "httpserver.h"
 #include "httprpc.h"
+#include "indexwriter.h"
 #include "key.h"
 #include "validation.h"
 #include "miner.h"
@@ -28,6 +30,7 @@
 #include "netfulfilledman.h"
 #include "net_processing.h"
 #include "policy/policy.h"
+#include "reindex.h"
 #include "rpc/server.h"
 #include "script/standard.h"
 #include "script/sigcache.h"
@@ -55,6 +58,7 @@
 #include "keepass.h"
 #endif
 #include "masternode-payments.h"
+#include "masternode-sigverify.h"
 #include "masternode-sync.h"
 #include "masternodeman.h"
 #include "masternodeconfig.h"
@@ -275,6 +279,7 @@ void PrepareShutdown()
         pcoinsdbview = NULL;
         delete pblocktree;
         pblocktree = NULL;
+        CloseExplorerIndexes();
     }
 #ifdef ENABLE_WALLET
     if (pwalletMain)
@@ -394,6 +399,7 @@ std::string HelpMessage(HelpMessageMode mode)
     strUsage += HelpMessageOpt("-version", _("Print version and exit"));
     strUsage += HelpMessageOpt("-alerts", strprintf(_("Receive and display P2P network alerts (default: %u)"), DEFAULT_ALERTS));
     strUsage += HelpMessageOpt("-alertnotify=<cmd>", _("Execute command when a relevant alert is received or we see a really long fork (%s in cmd is replaced by message)"));
+    strUsage += HelpMessageOpt("-backgroundflush", strprintf(_("Write the chainstate to disk from a background thread, without pausing block processing (default: %u)"), DEFAULT_BACKGROUND_FLUSH));
     strUsage += HelpMessageOpt("-blocknotify=<cmd>", _("Execute command when the best block changes (%s in cmd is replaced by block hash)"));
     if (showDebug)
         strUsage += HelpMessageOpt("-blocksonly", strprintf(_("Whether to operate in a blocks only mode (default: %u)"), DEFAULT_BLOCKSONLY));
@@ -429,6 +435,8 @@ std::string HelpMessage(HelpMessageMode mode)
     strUsage += HelpMessageOpt("-addressindex", strprintf(_("Maintain a full address index, used to query for the balance, txids and unspent outputs for addresses (default: %u)"), DEFAULT_ADDRESSINDEX));
     strUsage += HelpMessageOpt("-timestampindex", strprintf(_("Maintain a timestamp index for block hashes, used to query blocks hashes by a range of timestamps (default: %u)"), DEFAULT_TIMECSTAMPINDEX));
     strUsage += HelpMessageOpt("-spentindex", strprintf(_("Maintain a full spent index, used to query the spending txid and input index for an outpoint (default: %u)"), DEFAULT_SPENTINDEX));
+    strUsage += HelpMessageOpt("-addressbalanceindex", strprintf(_("Maintain the balance, total received and transaction count of every address, used to answer getaddressbalance without reading the address history (default: %u)"), DEFAULT_ADDRESSBALANCEINDEX));
+    strUsage += HelpMessageOpt("-coinstatsindex", strprintf(_("Maintain a MuHash and the totals of the UTXO set as blocks are connected, used by gettxoutsetinfo \"muhash\" to answer without reading the whole set (default: %u)"), DEFAULT_COINSTATSINDEX));
 
     strUsage += HelpMessageGroup(_("Connection options:"));
     strUsage += HelpMessageOpt("-addnode=<ip>", _("Add a node to connect to and attempt to keep the connection open"));
@@ -530,6 +538,9 @@ std::string HelpMessage(HelpMessageMode mode)
         strUsage += HelpMessageOpt("-checkblockindex", strprintf("Do a full consistency check for mapBlockIndex, setBlockIndexCandidates, chainActive and mapBlocksUnlinked occasionally. Also sets -checkmempool (default: %u)", Params(CBaseChainParams::MAIN).DefaultConsistencyChecks()));
         strUsage += HelpMessageOpt("-checkmempool=<n>", strprintf("Run checks every <n> transactions (default: %u)", Params(CBaseChainParams::MAIN).DefaultConsistencyChecks()));
         strUsage += HelpMessageOpt("-checkpoints", strprintf("Disable expensive verification for known chain history (default: %u)", DEFAULT_CHECKPOINTS_ENABLED));
+        strUsage += HelpMessageOpt("-dboption=<db>.<option>=<n>", "Tune the LevelDB database <db> (chainstate, blockindex, address, spent, timestamp, balance or coinstats). "
+            "Options: compression (only 0, LevelDB is built without Snappy), bloombits (bloom filter bits per key, 0 for none, default: 10), "
+            "writebuffer (MiB, default: a quarter of the database cache), maxopenfiles (default: 64), blocksize (KiB, default: 4). Can be specified multiple times");
 #ifdef ENABLE_WALLET
         strUsage += HelpMessageOpt("-dblogsize=<n>", strprintf("Flush wallet database activity from memory to disk log every <n> megabytes (default: %u)", DEFAULT_WALLET_DBLOGSIZE));
 #endif
@@ -728,17 +739,10 @@ void ThreadImport(std::vector<boost::filesystem::path> vImportFiles)
 
     // -reindex
     if (fReindex) {
-        int nFile = 0;
-        while (true) {
-            CDiskBlockPos pos(nFile, 0);
-            if (!boost::filesystem::exists(GetBlockPosFilename(pos, "blk")))
-                break; // No block files left to reindex
-            FILE *file = OpenBlockFile(pos, true);
-            if (!file)
-                break; // This error is logged in OpenBlockFile
-            LogPrintf("Reindexing block file blk%05u.dat...\n", (unsigned int)nFile);
-            LoadExternalBlockFile(chainparams, file, &pos);
-            nFile++;
+        if (!ReindexBlockFiles(chainparams, std::min(GetNumCores(), MAX_REINDEX_THREADS))) {
+            LogPrintf("Reindexing failed\n");
+            StartShutdown();
+            return;
         }
         pblocktree->WriteReindexing(false);
         fReindex = false;
@@ -927,18 +931,6 @@ void InitParameterInteraction()
         LogPrintf("%s: parameter interaction: can't use -hdseed and -mnemonic/-mnemonicpassphrase together, will prefer -seed\n", __func__);
     }
 #endif // ENABLE_WALLET
-
-    // Make sure additional indexes are recalculated correctly in VerifyDB
-    // (we must reconnect blocks whenever we disconnect them for these indexes to work)
-    bool fAdditionalIndexes =
-        GetBoolArg("-addressindex", DEFAULT_ADDRESSINDEX) ||
-        GetBoolArg("-spentindex", DEFAULT_SPENTINDEX) ||
-        GetBoolArg("-timestampindex", DEFAULT_TIMECSTAMPINDEX);
-
-    if (fAdditionalIndexes && GetArg("-checklevel", DEFAULT_CHECKLEVEL) < 4) {
-        mapArgs["-checklevel"] = "4";
-        LogPrintf("%s: parameter interaction: additional indexes -> setting -checklevel=4\n", __func__);
-    }
 }
 
 void InitLogging()
@@ -1090,6 +1082,14 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
     if (nMempoolSizeMax < 0 || nMempoolSizeMax < nMempoolSizeMin)
         return InitError(strprintf(_("-maxmempool must be at least %d MB"), std::ceil(nMempoolSizeMin / 1000000.0)));
 
+    // Every database reads its -dboption settings when it is opened; reject malformed ones now
+    {
+        CDBOptions dbOptions;
+        std::string strDBOptionError;
+        if (!ParseDBOptions("chainstate", dbOptions, strDBOptionError))
+            return InitError(strDBOptionError);
+    }
+
     // -par=0 means autodetect, but nScriptCheckThreads==0 means no concurrency
     nScriptCheckThreads = GetArg("-par", DEFAULT_SCRIPTCHECK_THREADS);
     if (nScriptCheckThreads <= 0)
@@ -1225,6 +1225,10 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
     // Initialize fast PRNG
     seed_insecure_rand(false);
 
+    // Pick the fastest merkle tree hashing the CPU supports
+    std::string strSHA256Algo = SHA256AutoDetect();
+    LogPrintf("Using the '%s' SHA256 implementation\n", strSHA256Algo);
+
     // Initialize elliptic curve code
     ECC_Start();
     globalVerifyHandle.reset(new ECCVerifyHandle());
@@ -1288,6 +1292,9 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
             return InitError(_("Unable to sign spork message, wrong key?"));
     }
 
+    // Start the explorer index writer before any block can be connected (it idles without explorer indexes)
+    threadGroup.create_thread(&ThreadIndexWriter);
+
     // Start the lightweight task scheduler thread
     CScheduler::Function serviceLoop = boost::bind(&CScheduler::serviceQueue, &scheduler);
     threadGroup.create_thread(boost::bind(&TraceThread<CScheduler::Function>, "scheduler", serviceLoop));
@@ -1531,6 +1538,17 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
     int64_t nBlockTreeDBCache = nTotalCache / 8;
     nBlockTreeDBCache = std::min(nBlockTreeDBCache, (GetBoolArg("-txindex", DEFAULT_TXINDEX) ? nMaxBlockDBAndTxIndexCache : nMaxBlockDBCache) << 20);
     nTotalCache -= nBlockTreeDBCache;
+    fAddressIndex = GetBoolArg("-addressindex", DEFAULT_ADDRESSINDEX);
+    fSpentIndex = GetBoolArg("-spentindex", DEFAULT_SPENTINDEX);
+    fTIMECoinstampIndex = GetBoolArg("-timestampindex", DEFAULT_TIMECSTAMPINDEX);
+    fAddressBalanceIndex = GetBoolArg("-addressbalanceindex", DEFAULT_ADDRESSBALANCEINDEX);
+    fCoinStatsIndex = GetBoolArg("-coinstatsindex", DEFAULT_COINSTATSINDEX);
+    int nExplorerIndexes = (fAddressIndex ? 1 : 0) + (fSpentIndex ? 1 : 0) + (fTIMECoinstampIndex ? 1 : 0) + (fAddressBalanceIndex ? 1 : 0) + (fCoinStatsIndex ? 1 : 0);
+    int64_t nIndexDBCache = 0;
+    if (nExplorerIndexes > 0) {
+        nIndexDBCache = std::min(nTotalCache / 8 / nExplorerIndexes, nMaxIndexDBCache << 20); // each explorer index db gets its own cache
+        nTotalCache -= nIndexDBCache * nExplorerIndexes;
+    }
     int64_t nCoinDBCache = std::min(nTotalCache / 2, (nTotalCache / 4) + (1 << 23)); // use 25%-50% of the remainder for disk cache
     nCoinDBCache = std::min(nCoinDBCache, nMaxCoinsDBCache << 20); // cap total coins db cache
     nTotalCache -= nCoinDBCache;
@@ -1538,6 +1556,8 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
     nMempoolSizeMax = GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000;
     LogPrintf("Cache configuration:\n");
     LogPrintf("* Using %.1fMiB for block index database\n", nBlockTreeDBCache * (1.0 / 1024 / 1024));
+    if (nExplorerIndexes > 0)
+        LogPrintf("* Using %.1fMiB for each of %d explorer index databases\n", nIndexDBCache * (1.0 / 1024 / 1024), nExplorerIndexes);
     LogPrintf("* Using %.1fMiB for chain state database\n", nCoinDBCache * (1.0 / 1024 / 1024));
     LogPrintf("* Using %.1fMiB for in-memory UTXO set (plus up to %.1fMiB of unused mempool space)\n", nCoinCacheUsage * (1.0 / 1024 / 1024), nMempoolSizeMax * (1.0 / 1024 / 1024));
 
@@ -1558,6 +1578,8 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
                 delete pblocktree;
 
                 pblocktree = new CBlockTreeDB(nBlockTreeDBCache, false, fReindex);
+                // Indexes are rebuilt along with the chainstate, as blocks are connected
+                OpenExplorerIndexes(nIndexDBCache, fReindex || fReindexChainState);
                 pcoinsdbview = new CCoinsViewDB(nCoinDBCache, false, fReindex || fReindexChainState);
                 pcoinscatcher = new CCoinsViewErrorCatcher(pcoinsdbview);
                 pcoinsTip = new CCoinsViewCache(pcoinscatcher);
@@ -1573,7 +1595,13 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
                         strLoadError = _("Error upgrading chainstate database");
                         break;
                     }
+                    if (pcoinsdbview->IsSnapshotLoading()) {
+                        strLoadError = _("The chainstate database holds a partly loaded UTXO snapshot. You need to rebuild the database using -reindex-chainstate");
+                        break;
+                    }
                 }
+                if (GetBoolArg("-backgroundflush", DEFAULT_BACKGROUND_FLUSH))
+                    pcoinsdbview->StartBackgroundFlush();
                 if (fRequestShutdown) break;
 
                 if (!LoadBlockIndex()) {
@@ -1586,6 +1614,11 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
                 if (!mapBlockIndex.empty() && mapBlockIndex.count(chainparams.GetConsensus().hashGenesisBlock) == 0)
                     return InitError(_("Incorrect or no genesis block found. Wrong datadir for network?"));
 
+                if (!LoadExplorerIndexes()) {
+                    strLoadError = _("Error loading explorer index databases");
+                    break;
+                }
+
                 // Initialize the block index (no-op if non-empty database was already loaded)
                 if (!InitBlockIndex(chainparams)) {
                     strLoadError = _("Error initializing block database");
@@ -1666,6 +1699,9 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
     }
     LogPrintf(" block index %15dms\n", GetTIMECoinMillis() - nStart);
 
+    // Catch up explorer indexes that were just enabled or fell behind, while the node runs
+    threadGroup.create_thread(&ThreadBuildExplorerIndexes);
+
     boost::filesystem::path est_path = GetDataDir() / FEE_ESTIMATES_FILENAME;
     CAutoFile est_filein(fopen(est_path.string().c_str(), "rb"), SER_DISK, CLIENT_VERSION);
     // Allowed to fail as this file IS missing on first startup.
@@ -2016,6 +2052,12 @@ bool AppInit2(boost::thread_group& threadGroup, CScheduler& scheduler)
     // ********************************************************* Step 11d: start time-ps-<smth> threads
 
     threadGroup.create_thread(boost::bind(&ThreadCheckPrivateSend, boost::ref(*g_connman)));
+    if (!fLiteMode) {
+        int nSigVerifyThreads = std::max(1, std::min(GetNumCores() - 1, MAX_MASTERNODE_SIGVERIFY_THREADS));
+        LogPrintf("Using %d threads for masternode signature verification\n", nSigVerifyThreads);
+        for (int i = 0; i < nSigVerifyThreads; i++)
+            threadGroup.create_thread(&ThreadMasternodeSigVerify);
+    }
     if (fMasterNode)
         threadGroup.create_thread(boost::bind(&ThreadCheckPrivateSendServer, boost::ref(*g_connman)));
 #ifdef ENABLE_WALLET
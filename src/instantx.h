@@ -119,7 +119,7 @@ public:
     std::string ToString();
 };
 
-class CTxLockRequest : public CTransaction
+class CTxLockRequest
 {
 private:
     static const CAmount MIN_FEE            = 0.0001 * COIN;
@@ -127,8 +127,35 @@ private:
 public:
     static const int WARN_MANY_INPUTS       = 100;
 
-    CTxLockRequest() = default;
-    CTxLockRequest(const CTransaction& tx) : CTransaction(tx) {};
+    // shared with the mempool, the lock candidate and relay instead of copied
+    CTransactionRef tx;
+
+    CTxLockRequest() : tx(MakeTransactionRef()) {};
+    CTxLockRequest(const CTransaction& txIn) : tx(MakeTransactionRef(txIn)) {};
+    CTxLockRequest(const CTransactionRef& txIn) : tx(txIn) {};
+
+    // serialized as the plain transaction
+    size_t GetSerializeSize(int nType, int nVersion) const
+    {
+        return tx->GetSerializeSize(nType, nVersion);
+    }
+
+    template<typename Stream>
+    void Serialize(Stream& s, int nType, int nVersion) const
+    {
+        tx->Serialize(s, nType, nVersion);
+    }
+
+    template<typename Stream>
+    void Unserialize(Stream& s, int nType, int nVersion)
+    {
+        CTransaction txIn;
+        txIn.Unserialize(s, nType, nVersion);
+        tx = MakeTransactionRef(txIn);
+    }
+
+    const uint256& GetHash() const { return tx->GetHash(); }
+    std::string ToString() const { return tx->ToString(); }
 
     bool IsValid() const;
     CAmount GetMinFee() const;
@@ -136,7 +163,7 @@ public:
 
     explicit operator bool() const
     {
-        return *this != CTxLockRequest();
+        return !tx->IsNull();
     }
 };
 
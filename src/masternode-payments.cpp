@@ -11,13 +11,16 @@
 #include "netfulfilledman.h"
 #include "spork.h"
 #include "util.h"
+#include "validation.h"
 
 #include <boost/lexical_cast.hpp>
 
 /** Object for who's going to get paid on which blocks */
 CMasternodePayments mnpayments;
 
-CCriticalSection cs_vecPayees;
+/** Object for who got paid last on which blocks */
+CMasternodeLastPaidIndex mnLastPaidIndex;
+
 CCriticalSection cs_mapMasternodeBlocks;
 CCriticalSection cs_mapMasternodePaymentVotes;
 
@@ -240,6 +243,7 @@ void CMasternodePayments::Clear()
     LOCK2(cs_mapMasternodeBlocks, cs_mapMasternodePaymentVotes);
     mapMasternodeBlocks.clear();
     mapMasternodePaymentVotes.clear();
+    mapVoteHashesByHeight.clear();
 }
 
 bool CMasternodePayments::CanVote(COutPoint outMasternode, int nBlockHeight)
@@ -344,26 +348,19 @@ void CMasternodePayments::ProcessMessage(CNode* pfrom, std::string& strCommand,
         // Ignore any payments messages until masternode list is synced
         if(!masternodeSync.IsMasternodeListSynced()) return;
 
-        {
-            LOCK(cs_mapMasternodePaymentVotes);
-            if(mapMasternodePaymentVotes.count(nHash)) {
-                LogPrint("mnpayments", "MASTERNODEPAYMENTVOTE -- hash=%s, nHeight=%d seen\n", nHash.ToString(), nCachedBlockHeight);
-                return;
-            }
-
-            // Avoid processing same vote multiple times
-            mapMasternodePaymentVotes[nHash] = vote;
-            // but first mark vote as non-verified,
-            // AddPaymentVote() below should take care of it if vote is actually ok
-            mapMasternodePaymentVotes[nHash].MarkAsNotVerified();
-        }
-
+        // Check the range before storing anything, votes for heights we would never prune must not pile up
         int nFirstBlock = nCachedBlockHeight - GetStorageLimit();
         if(vote.nBlockHeight < nFirstBlock || vote.nBlockHeight > nCachedBlockHeight+20) {
             LogPrint("mnpayments", "MASTERNODEPAYMENTVOTE -- vote out of range: nFirstBlock=%d, nBlockHeight=%d, nHeight=%d\n", nFirstBlock, vote.nBlockHeight, nCachedBlockHeight);
             return;
         }
 
+        // Avoid processing same vote multiple times
+        if(!RecordPaymentVote(vote)) {
+            LogPrint("mnpayments", "MASTERNODEPAYMENTVOTE -- hash=%s, nHeight=%d seen\n", nHash.ToString(), nCachedBlockHeight);
+            return;
+        }
+
         std::string strError = "";
         if(!vote.IsValid(pfrom, nCachedBlockHeight, strError, connman)) {
             LogPrint("mnpayments", "MASTERNODEPAYMENTVOTE -- invalid message, error: %s\n", strError);
@@ -437,8 +434,11 @@ bool CMasternodePaymentVote::Sign()
 
 bool CMasternodePayments::GetBlockPayee(int nBlockHeight, CScript& payee)
 {
-    if(mapMasternodeBlocks.count(nBlockHeight)){
-        return mapMasternodeBlocks[nBlockHeight].GetBestPayee(payee);
+    LOCK(cs_mapMasternodeBlocks);
+
+    std::map<int, CMasternodeBlockPayees>::iterator it = mapMasternodeBlocks.find(nBlockHeight);
+    if(it != mapMasternodeBlocks.end()){
+        return it->second.GetBestPayee(payee);
     }
 
     return false;
@@ -456,9 +456,10 @@ bool CMasternodePayments::IsScheduled(CMasternode& mn, int nNotBlockHeight)
     mnpayee = GetScriptForDestination(mn.pubKeyCollateralAddress.GetID());
 
     CScript payee;
-    for(int64_t h = nCachedBlockHeight; h <= nCachedBlockHeight + 8; h++){
-        if(h == nNotBlockHeight) continue;
-        if(mapMasternodeBlocks.count(h) && mapMasternodeBlocks[h].GetBestPayee(payee) && mnpayee == payee) {
+    std::map<int, CMasternodeBlockPayees>::iterator it = mapMasternodeBlocks.lower_bound(nCachedBlockHeight);
+    for(; it != mapMasternodeBlocks.end() && it->first <= nCachedBlockHeight + 8; ++it){
+        if(it->first == nNotBlockHeight) continue;
+        if(it->second.GetBestPayee(payee) && mnpayee == payee) {
             return true;
         }
     }
@@ -466,27 +467,81 @@ bool CMasternodePayments::IsScheduled(CMasternode& mn, int nNotBlockHeight)
     return false;
 }
 
+bool CMasternodePayments::RecordPaymentVote(const CMasternodePaymentVote& vote)
+{
+    LOCK(cs_mapMasternodePaymentVotes);
+
+    uint256 nHash = vote.GetHash();
+    std::pair<std::map<uint256, CMasternodePaymentVote>::iterator, bool> ret =
+            mapMasternodePaymentVotes.insert(std::make_pair(nHash, vote));
+    if(!ret.second) return false;
+
+    // mark vote as non-verified, AddPaymentVote() should take care of it if vote is actually ok
+    ret.first->second.MarkAsNotVerified();
+    mapVoteHashesByHeight[vote.nBlockHeight].push_back(nHash);
+    return true;
+}
+
 bool CMasternodePayments::AddPaymentVote(const CMasternodePaymentVote& vote)
 {
     uint256 blockHash = uint256();
     if(!GetBlockHash(blockHash, vote.nBlockHeight - 101)) return false;
 
-    if(HasVerifiedPaymentVote(vote.GetHash())) return false;
+    return StorePaymentVote(vote);
+}
 
+bool CMasternodePayments::StorePaymentVote(const CMasternodePaymentVote& vote)
+{
     LOCK2(cs_mapMasternodeBlocks, cs_mapMasternodePaymentVotes);
 
-    mapMasternodePaymentVotes[vote.GetHash()] = vote;
-
-    if(!mapMasternodeBlocks.count(vote.nBlockHeight)) {
-       CMasternodeBlockPayees blockPayees(vote.nBlockHeight);
-       mapMasternodeBlocks[vote.nBlockHeight] = blockPayees;
+    uint256 nHash = vote.GetHash();
+    std::map<uint256, CMasternodePaymentVote>::iterator itVote = mapMasternodePaymentVotes.find(nHash);
+    if(itVote == mapMasternodePaymentVotes.end()) {
+        mapMasternodePaymentVotes.insert(std::make_pair(nHash, vote));
+        mapVoteHashesByHeight[vote.nBlockHeight].push_back(nHash);
+    } else if(itVote->second.IsVerified()) {
+        return false;
+    } else {
+        itVote->second = vote;
     }
 
-    mapMasternodeBlocks[vote.nBlockHeight].AddPayee(vote);
+    std::map<int, CMasternodeBlockPayees>::iterator itBlock = mapMasternodeBlocks.find(vote.nBlockHeight);
+    if(itBlock == mapMasternodeBlocks.end()) {
+        itBlock = mapMasternodeBlocks.insert(std::make_pair(vote.nBlockHeight, CMasternodeBlockPayees(vote.nBlockHeight))).first;
+    }
+    itBlock->second.AddPayee(vote);
 
     return true;
 }
 
+void CMasternodePayments::RemoveBlocksBelow(int nFirstBlock)
+{
+    LOCK2(cs_mapMasternodeBlocks, cs_mapMasternodePaymentVotes);
+
+    int nVotesRemoved = 0;
+    std::map<int, std::vector<uint256> >::iterator itHeight = mapVoteHashesByHeight.begin();
+    while(itHeight != mapVoteHashesByHeight.end() && itHeight->first < nFirstBlock) {
+        for(const auto& hash : itHeight->second) {
+            nVotesRemoved += mapMasternodePaymentVotes.erase(hash);
+        }
+        mapVoteHashesByHeight.erase(itHeight++);
+    }
+    mapMasternodeBlocks.erase(mapMasternodeBlocks.begin(), mapMasternodeBlocks.lower_bound(nFirstBlock));
+
+    std::map<COutPoint, int>::iterator itLastVote = mapMasternodesLastVote.begin();
+    while(itLastVote != mapMasternodesLastVote.end()) {
+        if(itLastVote->second < nFirstBlock) {
+            mapMasternodesLastVote.erase(itLastVote++);
+        } else {
+            ++itLastVote;
+        }
+    }
+
+    if(nVotesRemoved) {
+        LogPrint("mnpayments", "CMasternodePayments::RemoveBlocksBelow -- Removed %d old Masternode payment votes below nBlockHeight=%d\n", nVotesRemoved, nFirstBlock);
+    }
+}
+
 bool CMasternodePayments::HasVerifiedPaymentVote(uint256 hashIn)
 {
     LOCK(cs_mapMasternodePaymentVotes);
@@ -496,8 +551,6 @@ bool CMasternodePayments::HasVerifiedPaymentVote(uint256 hashIn)
 
 void CMasternodeBlockPayees::AddPayee(const CMasternodePaymentVote& vote)
 {
-    LOCK(cs_vecPayees);
-
     BOOST_FOREACH(CMasternodePayee& payee, vecPayees) {
         if (payee.GetPayee() == vote.payee) {
             payee.AddVoteHash(vote.GetHash());
@@ -510,8 +563,6 @@ void CMasternodeBlockPayees::AddPayee(const CMasternodePaymentVote& vote)
 
 bool CMasternodeBlockPayees::GetBestPayee(CScript& payeeRet)
 {
-    LOCK(cs_vecPayees);
-
     if(!vecPayees.size()) {
         LogPrint("mnpayments", "CMasternodeBlockPayees::GetBestPayee -- ERROR: couldn't find any payee\n");
         return false;
@@ -530,8 +581,6 @@ bool CMasternodeBlockPayees::GetBestPayee(CScript& payeeRet)
 
 bool CMasternodeBlockPayees::HasPayeeWithVotes(const CScript& payeeIn, int nVotesReq)
 {
-    LOCK(cs_vecPayees);
-
     BOOST_FOREACH(CMasternodePayee& payee, vecPayees) {
         if (payee.GetVoteCount() >= nVotesReq && payee.GetPayee() == payeeIn) {
             return true;
@@ -544,8 +593,6 @@ bool CMasternodeBlockPayees::HasPayeeWithVotes(const CScript& payeeIn, int nVote
 
 bool CMasternodeBlockPayees::IsTransactionValid(const CTransaction& txNew)
 {
-    LOCK(cs_vecPayees);
-
     int nMaxSignatures = 0;
     std::string strPayeesPossible = "";
 
@@ -589,8 +636,6 @@ bool CMasternodeBlockPayees::IsTransactionValid(const CTransaction& txNew)
 
 std::string CMasternodeBlockPayees::GetRequiredPaymentsString()
 {
-    LOCK(cs_vecPayees);
-
     std::string strRequiredPayments = "Unknown";
 
     BOOST_FOREACH(CMasternodePayee& payee, vecPayees)
@@ -635,22 +680,8 @@ void CMasternodePayments::CheckAndRemove()
 {
     if(!masternodeSync.IsBlockchainSynced()) return;
 
-    LOCK2(cs_mapMasternodeBlocks, cs_mapMasternodePaymentVotes);
-
-    int nLimit = GetStorageLimit();
-
-    std::map<uint256, CMasternodePaymentVote>::iterator it = mapMasternodePaymentVotes.begin();
-    while(it != mapMasternodePaymentVotes.end()) {
-        CMasternodePaymentVote vote = (*it).second;
+    RemoveBlocksBelow(nCachedBlockHeight - GetStorageLimit());
 
-        if(nCachedBlockHeight - vote.nBlockHeight > nLimit) {
-            LogPrint("mnpayments", "CMasternodePayments::CheckAndRemove -- Removing old Masternode payment: nBlockHeight=%d\n", vote.nBlockHeight);
-            mapMasternodePaymentVotes.erase(it++);
-            mapMasternodeBlocks.erase(vote.nBlockHeight);
-        } else {
-            ++it;
-        }
-    }
     LogPrintf("CMasternodePayments::CheckAndRemove -- %s\n", ToString());
 }
 
@@ -722,6 +753,13 @@ bool CMasternodePayments::ProcessBlock(int nBlockHeight, CConnman& connman)
     // if we have not enough data about masternodes.
     if(!masternodeSync.IsMasternodeListSynced()) return false;
 
+    // Nor if some of the payments are unknown, as below a UTXO snapshot: masternodes
+    // paid in blocks we have no data for would look like they have never been paid
+    if(!mnLastPaidIndex.IsComplete()) {
+        LogPrint("mnpayments", "CMasternodePayments::ProcessBlock -- last paid index is incomplete, not voting\n");
+        return false;
+    }
+
     int nRank;
 
     if (!mnodeman.GetMasternodeRank(activeMasternode.outpoint, nRank, nBlockHeight - 101, GetMinMasternodePaymentsProto())) {
@@ -1025,3 +1063,164 @@ void CMasternodePayments::UpdatedBlockTip(const CBlockIndex *pindex, CConnman& c
     CheckPreviousBlockVotes(nFutureBlock - 1);
     ProcessBlock(nFutureBlock, connman);
 }
+
+void CMasternodeLastPaidIndex::ConnectPayments(const CBlock& block, const CBlockIndex* pindex)
+{
+    CPaymentsUndo& undo = mapUndo[pindex->nHeight];
+    undo.hashBlock = pindex->GetBlockHash();
+    undo.vPrevious.clear();
+
+    if(!block.vtx.empty()) {
+        CAmount nMasternodePayment = GetMasternodePayment(pindex->nHeight, block.vtx[0].GetValueOut());
+
+        LOCK(cs_mapMasternodeBlocks);
+        std::map<int, CMasternodeBlockPayees>::iterator itBlock = mnpayments.mapMasternodeBlocks.find(pindex->nHeight);
+        if(itBlock != mnpayments.mapMasternodeBlocks.end()) {
+            BOOST_FOREACH(const CTxOut& txout, block.vtx[0].vout) {
+                // only count payments to payees that were voted for, as UpdateLastPaid always did
+                if(txout.nValue != nMasternodePayment || !itBlock->second.HasPayeeWithVotes(txout.scriptPubKey, 2))
+                    continue;
+                CLastPaid& lastPaid = mapLastPaid[txout.scriptPubKey];
+                undo.vPrevious.push_back(std::make_pair(txout.scriptPubKey, lastPaid));
+                lastPaid = CLastPaid(pindex->nHeight, pindex->nTIMECoin);
+            }
+        }
+    }
+
+    while(!mapUndo.empty() && mapUndo.begin()->first <= pindex->nHeight - MNPAYMENTS_LAST_PAID_UNDO_BLOCKS)
+        mapUndo.erase(mapUndo.begin());
+
+    pindexBest = pindex;
+}
+
+bool CMasternodeLastPaidIndex::Initialize(int nBlocks)
+{
+    const CBlockIndex* pindexTip;
+    std::vector<std::pair<const CBlockIndex*, CDiskBlockPos> > vBlockPos;
+    int nMissingHeightNew = -1;
+    {
+        LOCK2(cs_main, cs);
+
+        pindexTip = chainActive.Tip();
+        if(!pindexTip || pindexBest == pindexTip) return true;
+
+        const CBlockIndex* pindex = chainActive[std::max(0, pindexTip->nHeight - nBlocks + 1)];
+        for(; pindex; pindex = chainActive.Next(pindex)) {
+            // blocks below a snapshot base or pruned away hold no data to scan,
+            // the index is incomplete until they are out of the window
+            if(!(pindex->nStatus & BLOCK_HAVE_DATA)) {
+                nMissingHeightNew = pindex->nHeight;
+                continue;
+            }
+            vBlockPos.push_back(std::make_pair(pindex, pindex->GetBlockPos()));
+        }
+    }
+
+    // a single pass over the blocks in the payments window, replacing the
+    // per-masternode scans which read each of them once per masternode;
+    // up to GetStorageLimit() blocks, read without holding cs_main
+    int64_t nStart = GetTIMECoinMillis();
+    std::vector<CBlock> vBlocks(vBlockPos.size());
+    for(size_t i = 0; i < vBlockPos.size(); i++) {
+        const CBlockIndex* pindex = vBlockPos[i].first;
+        if(!ReadBlockFromDisk(vBlocks[i], vBlockPos[i].second, Params().GetConsensus()) || vBlocks[i].GetHash() != pindex->GetBlockHash()) {
+            return error("CMasternodeLastPaidIndex::Initialize -- failed to read block %s", pindex->GetBlockHash().ToString());
+        }
+        // only the coinbase pays masternodes
+        vBlocks[i].vtx.resize(std::min<size_t>(vBlocks[i].vtx.size(), 1));
+    }
+
+    LOCK2(cs_main, cs);
+
+    if(pindexBest == pindexTip) return true;
+    if(chainActive.Tip() != pindexTip) {
+        LogPrint("mnpayments", "CMasternodeLastPaidIndex::Initialize -- tip changed while reading blocks, will retry\n");
+        return false;
+    }
+
+    mapLastPaid.clear();
+    mapUndo.clear();
+    nBlocksBuilt = nBlocks;
+    nMissingHeight = nMissingHeightNew;
+    for(size_t i = 0; i < vBlocks.size(); i++) {
+        ConnectPayments(vBlocks[i], vBlockPos[i].first);
+    }
+    pindexBest = pindexTip;
+
+    LogPrint("mnpayments", "CMasternodeLastPaidIndex::Initialize -- %d payees from %d blocks in %dms\n",
+                mapLastPaid.size(), std::min(nBlocks, pindexTip->nHeight + 1), GetTIMECoinMillis() - nStart);
+    return true;
+}
+
+void CMasternodeLastPaidIndex::Clear()
+{
+    LOCK(cs);
+    mapLastPaid.clear();
+    mapUndo.clear();
+    pindexBest = NULL;
+    nMissingHeight = -1;
+}
+
+void CMasternodeLastPaidIndex::BlockConnected(const CBlock& block, const CBlockIndex* pindex)
+{
+    LOCK(cs);
+
+    if(!pindexBest) return;
+
+    if(pindex->pprev != pindexBest) {
+        // missed a block somehow, rebuild on the next lookup
+        mapLastPaid.clear();
+        mapUndo.clear();
+        pindexBest = NULL;
+        return;
+    }
+
+    ConnectPayments(block, pindex);
+}
+
+void CMasternodeLastPaidIndex::BlockDisconnected(const CBlock& block, const CBlockIndex* pindex)
+{
+    LOCK(cs);
+
+    if(!pindexBest) return;
+
+    std::map<int, CPaymentsUndo>::iterator it = mapUndo.find(pindex->nHeight);
+    if(pindex != pindexBest || it == mapUndo.end() || it->second.hashBlock != pindex->GetBlockHash()) {
+        // reorganization deeper than the undo data, rebuild on the next lookup
+        mapLastPaid.clear();
+        mapUndo.clear();
+        pindexBest = NULL;
+        return;
+    }
+
+    // restore in reverse, in case the block paid a payee twice
+    const std::vector<std::pair<CScript, CLastPaid> >& vPrevious = it->second.vPrevious;
+    for(std::vector<std::pair<CScript, CLastPaid> >::const_reverse_iterator itPrev = vPrevious.rbegin(); itPrev != vPrevious.rend(); ++itPrev) {
+        if(itPrev->second.nHeight < 0) {
+            mapLastPaid.erase(itPrev->first);
+        } else {
+            mapLastPaid[itPrev->first] = itPrev->second;
+        }
+    }
+    mapUndo.erase(it);
+
+    pindexBest = pindex->pprev;
+}
+
+bool CMasternodeLastPaidIndex::GetLastPaid(const CScript& payee, int& nHeightRet, int64_t& nTimeRet) const
+{
+    LOCK(cs);
+
+    std::map<CScript, CLastPaid>::const_iterator it = mapLastPaid.find(payee);
+    if(it == mapLastPaid.end()) return false;
+
+    nHeightRet = it->second.nHeight;
+    nTimeRet = it->second.nTime;
+    return true;
+}
+
+bool CMasternodeLastPaidIndex::IsComplete() const
+{
+    LOCK(cs);
+    return pindexBest && nMissingHeight <= pindexBest->nHeight - nBlocksBuilt;
+}
@@ -15,6 +15,7 @@
 class CMasternodePayments;
 class CMasternodePaymentVote;
 class CMasternodeBlockPayees;
+class CMasternodeLastPaidIndex;
 
 static const int MNPAYMENTS_SIGNATURES_REQUIRED         = 6;
 static const int MNPAYMENTS_SIGNATURES_TOTAL            = 10;
@@ -26,11 +27,14 @@ static const int MNPAYMENTS_SIGNATURES_TOTAL            = 10;
 static const int MIN_MASTERNODE_PAYMENT_PROTO_VERSION_1 = 70206;
 static const int MIN_MASTERNODE_PAYMENT_PROTO_VERSION_2 = 70208;
 
-extern CCriticalSection cs_vecPayees;
+//! blocks the last paid index can disconnect before it has to be rebuilt from disk
+static const int MNPAYMENTS_LAST_PAID_UNDO_BLOCKS       = 100;
+
 extern CCriticalSection cs_mapMasternodeBlocks;
-extern CCriticalSection cs_mapMasternodePayeeVotes;
+extern CCriticalSection cs_mapMasternodePaymentVotes;
 
 extern CMasternodePayments mnpayments;
+extern CMasternodeLastPaidIndex mnLastPaidIndex;
 
 /// TODO: all 4 functions do not belong here really, they should be refactored/moved somewhere (main.cpp ?)
 bool IsBlockValueValid(const CBlock& block, int nBlockHeight, CAmount blockReward, std::string &strErrorRet);
@@ -65,14 +69,14 @@ public:
         READWRITE(vecVoteHashes);
     }
 
-    CScript GetPayee() { return scriptPubKey; }
+    const CScript& GetPayee() const { return scriptPubKey; }
 
-    void AddVoteHash(uint256 hashIn) { vecVoteHashes.push_back(hashIn); }
-    std::vector<uint256> GetVoteHashes() { return vecVoteHashes; }
-    int GetVoteCount() { return vecVoteHashes.size(); }
+    void AddVoteHash(const uint256& hashIn) { vecVoteHashes.push_back(hashIn); }
+    const std::vector<uint256>& GetVoteHashes() const { return vecVoteHashes; }
+    int GetVoteCount() const { return vecVoteHashes.size(); }
 };
 
-// Keep track of votes for payees from masternodes
+// Keep track of votes for payees from masternodes, guarded by cs_mapMasternodeBlocks
 class CMasternodeBlockPayees
 {
 public:
@@ -175,6 +179,10 @@ private:
     // Keep track of current block height
     int nCachedBlockHeight;
 
+    // the hashes of the votes in mapMasternodePaymentVotes by block height, to drop
+    // the votes of old blocks without looking at the others
+    std::map<int, std::vector<uint256> > mapVoteHashesByHeight;
+
 public:
     std::map<uint256, CMasternodePaymentVote> mapMasternodePaymentVotes;
     std::map<int, CMasternodeBlockPayees> mapMasternodeBlocks;
@@ -187,13 +195,26 @@ public:
 
     template <typename Stream, typename Operation>
     inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion) {
+        LOCK2(cs_mapMasternodeBlocks, cs_mapMasternodePaymentVotes);
         READWRITE(mapMasternodePaymentVotes);
         READWRITE(mapMasternodeBlocks);
+        if(ser_action.ForRead()) {
+            mapVoteHashesByHeight.clear();
+            for (const auto& votepair : mapMasternodePaymentVotes) {
+                mapVoteHashesByHeight[votepair.second.nBlockHeight].push_back(votepair.first);
+            }
+        }
     }
 
     void Clear();
 
+    /// Remember a vote as not verified yet so it is processed once only, false if it is known already
+    bool RecordPaymentVote(const CMasternodePaymentVote& vote);
     bool AddPaymentVote(const CMasternodePaymentVote& vote);
+    /// Store a verified vote and count it for its payee, false if it is stored already
+    bool StorePaymentVote(const CMasternodePaymentVote& vote);
+    /// Drop the votes and payees of the blocks below nFirstBlock
+    void RemoveBlocksBelow(int nFirstBlock);
     bool HasVerifiedPaymentVote(uint256 hashIn);
     bool ProcessBlock(int nBlockHeight, CConnman& connman);
     void CheckPreviousBlockVotes(int nPrevBlockHeight);
@@ -223,4 +244,60 @@ public:
     void UpdatedBlockTip(const CBlockIndex *pindex, CConnman& connman);
 };
 
+//
+// Masternode Last Paid Index
+// Keeps track of the last block that paid each payee script
+//
+
+class CMasternodeLastPaidIndex
+{
+private:
+    struct CLastPaid
+    {
+        int nHeight;
+        int64_t nTime;
+
+        CLastPaid() : nHeight(-1), nTime(0) {}
+        CLastPaid(int nHeightIn, int64_t nTimeIn) : nHeight(nHeightIn), nTime(nTimeIn) {}
+    };
+
+    // what connecting a block replaced, so the block can be disconnected again
+    struct CPaymentsUndo
+    {
+        uint256 hashBlock;
+        std::vector<std::pair<CScript, CLastPaid> > vPrevious;
+    };
+
+    mutable CCriticalSection cs;
+
+    std::map<CScript, CLastPaid> mapLastPaid;
+    // undo data of the last MNPAYMENTS_LAST_PAID_UNDO_BLOCKS blocks, by height
+    std::map<int, CPaymentsUndo> mapUndo;
+    // the block the index is up to date with, NULL until it is built
+    const CBlockIndex* pindexBest;
+    // the number of blocks it was built from, and the highest of them that had
+    // no data to scan (below a UTXO snapshot or pruned), -1 if there was none
+    int nBlocksBuilt;
+    int nMissingHeight;
+
+    void ConnectPayments(const CBlock& block, const CBlockIndex* pindex);
+
+public:
+    CMasternodeLastPaidIndex() : pindexBest(NULL), nBlocksBuilt(0), nMissingHeight(-1) {}
+
+    /// Build the index from the last nBlocks blocks of the active chain unless it is already up to date.
+    /// Reads the blocks without cs_main, so must be called without it; fails if the tip moves meanwhile.
+    bool Initialize(int nBlocks);
+    /// Drop the index, it is rebuilt on the next Initialize (e.g. once the payment votes are synced)
+    void Clear();
+
+    /// Called by ConnectTip/DisconnectTip with cs_main held; ignored until the index is built
+    void BlockConnected(const CBlock& block, const CBlockIndex* pindex);
+    void BlockDisconnected(const CBlock& block, const CBlockIndex* pindex);
+
+    bool GetLastPaid(const CScript& payee, int& nHeightRet, int64_t& nTimeRet) const;
+    /// Whether every block of the payments window had data, so payments found missing were never made
+    bool IsComplete() const;
+};
+
 #endif
@@ -0,0 +1,153 @@
+// Copyright (c) 2014-2017 The TIMECoin Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "masternode-sigverify.h"
+#include "messagesigner.h"
+#include "util.h"
+
+#include <boost/thread.hpp>
+
+CMasternodeSigVerifier mnSigVerifier;
+
+void CMasternodeSigVerifier::Verify(CMessage& message)
+{
+    int nDos = 0;
+    if(message.fVerification) {
+        // the masternodes the signatures could be from are matched by CMasternodeMan,
+        // which only has to compare key ids then, however many share an address
+        CMessageSigner::RecoverMessageSigner(message.mnv.vchSig1, message.strMessage1, message.keyIDSigner1);
+        if(!message.mnv.vchSig2.empty()) {
+            CMessageSigner::RecoverMessageSigner(message.mnv.vchSig2, message.strMessage2, message.keyIDSigner2);
+        }
+        message.fSignersRecovered = true;
+    } else if(message.fPing) {
+        // unknown masternode, CMasternodeMan has nothing to verify it against either
+        if(!message.pubKeyMasternode.IsValid()) return;
+        message.mnp.CheckSignature(message.pubKeyMasternode, nDos);
+    } else {
+        message.mnb.CheckSignature(nDos);
+    }
+}
+
+bool CMasternodeSigVerifier::Push(const std::shared_ptr<CMessage>& pmessage)
+{
+    boost::unique_lock<boost::mutex> lock(mutex);
+    // mapSeen* only know a message once it is processed, a copy from another peer
+    // is dropped here instead of being verified a second time meanwhile
+    if(pmessage->fVerify && setInFlight.count(pmessage->hash)) return false;
+    size_t& nNodeQueued = mapNodeQueued[pmessage->nodeId];
+    if(queueMessages.size() >= MAX_MASTERNODE_SIGVERIFY_QUEUE || nNodeQueued >= MAX_MASTERNODE_SIGVERIFY_QUEUE_PER_NODE) {
+        LogPrint("masternode", "CMasternodeSigVerifier::Push -- queue full, dropping message, peer=%d, queued=%d, from peer=%d\n",
+                    pmessage->nodeId, queueMessages.size(), nNodeQueued);
+        if(nNodeQueued == 0) mapNodeQueued.erase(pmessage->nodeId);
+        return false;
+    }
+    nNodeQueued++;
+    queueMessages.push_back(pmessage);
+    if(!pmessage->fVerify) return true;
+    setInFlight.insert(pmessage->hash);
+    if(nThreads == 0) {
+        // no threads to hand it to, verify it right here
+        Verify(*pmessage);
+        pmessage->fVerify = false;
+        return true;
+    }
+    queueVerify.push_back(pmessage);
+    condWorker.notify_one();
+    return true;
+}
+
+bool CMasternodeSigVerifier::PushBroadcast(NodeId nodeId, const CMasternodeBroadcast& mnb, bool fVerify)
+{
+    std::shared_ptr<CMessage> pmessage = std::make_shared<CMessage>();
+    pmessage->nodeId = nodeId;
+    pmessage->mnb = mnb;
+    pmessage->fVerify = fVerify;
+    if(fVerify) {
+        pmessage->hash = mnb.GetHash();
+    }
+    return Push(pmessage);
+}
+
+bool CMasternodeSigVerifier::PushPing(NodeId nodeId, const CMasternodePing& mnp, const CPubKey& pubKeyMasternode)
+{
+    std::shared_ptr<CMessage> pmessage = std::make_shared<CMessage>();
+    pmessage->nodeId = nodeId;
+    pmessage->fPing = true;
+    pmessage->mnp = mnp;
+    pmessage->pubKeyMasternode = pubKeyMasternode;
+    pmessage->hash = mnp.GetHash();
+    return Push(pmessage);
+}
+
+bool CMasternodeSigVerifier::PushVerification(NodeId nodeId, const CMasternodeVerification& mnv, const std::string& strMessage1, const std::string& strMessage2)
+{
+    std::shared_ptr<CMessage> pmessage = std::make_shared<CMessage>();
+    pmessage->nodeId = nodeId;
+    pmessage->fVerification = true;
+    pmessage->mnv = mnv;
+    pmessage->strMessage1 = strMessage1;
+    pmessage->strMessage2 = strMessage2;
+    pmessage->hash = mnv.GetHash();
+    return Push(pmessage);
+}
+
+void CMasternodeSigVerifier::PopVerified(std::vector<CMessage>& vecRet)
+{
+    boost::unique_lock<boost::mutex> lock(mutex);
+    while(!queueMessages.empty() && !queueMessages.front()->fVerify) {
+        const CMessage& message = *queueMessages.front();
+        if(!message.hash.IsNull()) {
+            setInFlight.erase(message.hash);
+        }
+        std::map<NodeId, size_t>::iterator it = mapNodeQueued.find(message.nodeId);
+        if(it != mapNodeQueued.end() && --it->second == 0) {
+            mapNodeQueued.erase(it);
+        }
+        vecRet.push_back(message);
+        queueMessages.pop_front();
+    }
+}
+
+size_t CMasternodeSigVerifier::size()
+{
+    boost::unique_lock<boost::mutex> lock(mutex);
+    return queueMessages.size();
+}
+
+void CMasternodeSigVerifier::Thread()
+{
+    boost::unique_lock<boost::mutex> lock(mutex);
+    nThreads++;
+    try {
+        while(true) {
+            while(queueVerify.empty())
+                condWorker.wait(lock);
+
+            std::shared_ptr<CMessage> pmessage = queueVerify.front();
+            queueVerify.pop_front();
+
+            lock.unlock();
+            Verify(*pmessage);
+            lock.lock();
+
+            pmessage->fVerify = false;
+        }
+    } catch (const boost::thread_interrupted&) {
+        // the messages left are verified by CMasternodeMan once the last thread is gone
+        if(--nThreads == 0) {
+            for(const auto& pmessage : queueVerify) {
+                pmessage->fVerify = false;
+            }
+            queueVerify.clear();
+        }
+        throw;
+    }
+}
+
+void ThreadMasternodeSigVerify()
+{
+    RenameThread("time-mnsigverify");
+    mnSigVerifier.Thread();
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2014-2017 The TIMECoin Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef MASTERNODE_SIGVERIFY_H
+#define MASTERNODE_SIGVERIFY_H
+
+#include "masternode.h"
+#include "net.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+class CMasternodeSigVerifier;
+
+static const int MAX_MASTERNODE_SIGVERIFY_THREADS = 4;
+// messages queued and not processed yet, from all peers and from a single one; the
+// latter fits a full list diff (MNLISTDIFF_MAX_ENTRIES mnb and as many mnp)
+static const size_t MAX_MASTERNODE_SIGVERIFY_QUEUE = 20000;
+static const size_t MAX_MASTERNODE_SIGVERIFY_QUEUE_PER_NODE = 5000;
+
+extern CMasternodeSigVerifier mnSigVerifier;
+
+//
+// Masternode Signature Verifier
+// Verifies the signatures of incoming mnb, mnp and mnv messages on threads of its own,
+// CMasternodeMan then processes the messages in the order they arrived in
+//
+
+class CMasternodeSigVerifier
+{
+public:
+    struct CMessage
+    {
+        NodeId nodeId;
+        bool fPing;
+        CMasternodeBroadcast mnb;
+        CMasternodePing mnp;
+        // the key a ping is verified against, that of its masternode when the ping arrived
+        CPubKey pubKeyMasternode;
+        // an mnv instead, the reply to our request when vchSig2 is empty, the broadcast of another masternode otherwise
+        bool fVerification;
+        CMasternodeVerification mnv;
+        // what vchSig1 and vchSig2 sign, and the keys that signed them once recovered
+        std::string strMessage1;
+        std::string strMessage2;
+        CKeyID keyIDSigner1;
+        CKeyID keyIDSigner2;
+        bool fSignersRecovered;
+        // whether the signature still has to be verified
+        bool fVerify;
+        // the hash of a message to verify, no other copy of it is queued while it is in flight
+        uint256 hash;
+
+        CMessage() : nodeId(-1), fPing(false), fVerification(false), fSignersRecovered(false), fVerify(true) {}
+    };
+
+private:
+    boost::mutex mutex;
+    boost::condition_variable condWorker;
+
+    // all messages pushed and not popped yet, in arrival order
+    std::deque<std::shared_ptr<CMessage> > queueMessages;
+    // the messages no thread has started to verify yet
+    std::deque<std::shared_ptr<CMessage> > queueVerify;
+    // the hashes of the messages to verify in queueMessages
+    std::set<uint256> setInFlight;
+    // the number of messages in queueMessages from each peer
+    std::map<NodeId, size_t> mapNodeQueued;
+    int nThreads;
+
+    /// Queue a message unless it is in flight already or the queue is full
+    bool Push(const std::shared_ptr<CMessage>& pmessage);
+
+public:
+    CMasternodeSigVerifier() : nThreads(0) {}
+
+    /// Check the signature of a message, which marks it as checked if it is valid
+    static void Verify(CMessage& message);
+
+    /// Queue an mnb. Pass fVerify=false for one that is already known, to keep it in order without verifying it again.
+    /// The Push functions return false for a message they drop: one being verified already, or one over the queue limits.
+    bool PushBroadcast(NodeId nodeId, const CMasternodeBroadcast& mnb, bool fVerify = true);
+    /// Queue an mnp, to be verified against the current key of its masternode
+    bool PushPing(NodeId nodeId, const CMasternodePing& mnp, const CPubKey& pubKeyMasternode);
+    /// Queue an mnv, whose signatures sign strMessage1 and, for a broadcast, strMessage2
+    bool PushVerification(NodeId nodeId, const CMasternodeVerification& mnv, const std::string& strMessage1, const std::string& strMessage2);
+
+    /// Move the verified messages at the front of the queue to vecRet, in the order they were pushed
+    void PopVerified(std::vector<CMessage>& vecRet);
+
+    /// Number of messages pushed and not popped yet
+    size_t size();
+
+    /// Worker thread body, runs until interrupted
+    void Thread();
+};
+
+/// Run a masternode signature verifier thread
+void ThreadMasternodeSigVerify();
+
+#endif
@@ -31,6 +31,18 @@ void CMasternodeSync::Reset()
     nTIMECoinAssetSyncStarted = GetTIMECoin();
     nTIMECoinLastBumped = GetTIMECoin();
     nTIMECoinLastFailure = 0;
+    nTIMECoinAssetSyncStartedMillis = GetTIMECoinMillis();
+    ClearPeers();
+    LOCK(csPeers);
+    mapAssetSyncMillis.clear();
+}
+
+void CMasternodeSync::ClearPeers()
+{
+    LOCK(csPeers);
+    mapPeersRequested.clear();
+    setPeersCompleted.clear();
+    nTIMECoinLastCompleted = 0;
 }
 
 void CMasternodeSync::BumpAssetLastTIMECoin(std::string strFuncName)
@@ -40,9 +52,9 @@ void CMasternodeSync::BumpAssetLastTIMECoin(std::string strFuncName)
     LogPrint("mnsync", "CMasternodeSync::BumpAssetLastTIMECoin -- %s\n", strFuncName);
 }
 
-std::string CMasternodeSync::GetAssetName()
+std::string CMasternodeSync::GetAssetName(int nAsset)
 {
-    switch(nRequestedMasternodeAssets)
+    switch(nAsset)
     {
         case(MASTERNODE_SYNC_INITIAL):      return "MASTERNODE_SYNC_INITIAL";
         case(MASTERNODE_SYNC_WAITING):      return "MASTERNODE_SYNC_WAITING";
@@ -57,6 +69,11 @@ std::string CMasternodeSync::GetAssetName()
 
 void CMasternodeSync::SwitchToNextAsset(CConnman& connman)
 {
+    if(nRequestedMasternodeAssets > MASTERNODE_SYNC_INITIAL) {
+        LOCK(csPeers);
+        mapAssetSyncMillis[nRequestedMasternodeAssets] = GetTIMECoinMillis() - nTIMECoinAssetSyncStartedMillis;
+    }
+
     switch(nRequestedMasternodeAssets)
     {
         case(MASTERNODE_SYNC_FAILED):
@@ -80,6 +97,9 @@ void CMasternodeSync::SwitchToNextAsset(CConnman& connman)
             break;
         case(MASTERNODE_SYNC_MNW):
             LogPrintf("CMasternodeSync::SwitchToNextAsset -- Completed %s in %llds\n", GetAssetName(), GetTIMECoin() - nTIMECoinAssetSyncStarted);
+            // blocks connected before their payment votes arrived count no payments,
+            // rescan the window now that the votes are here
+            mnLastPaidIndex.Clear();
             nRequestedMasternodeAssets = MASTERNODE_SYNC_GOVERNANCE;
             LogPrintf("CMasternodeSync::SwitchToNextAsset -- Starting %s\n", GetAssetName());
             break;
@@ -103,9 +123,17 @@ void CMasternodeSync::SwitchToNextAsset(CConnman& connman)
     }
     nRequestedMasternodeAttempt = 0;
     nTIMECoinAssetSyncStarted = GetTIMECoin();
+    nTIMECoinAssetSyncStartedMillis = GetTIMECoinMillis();
+    ClearPeers();
     BumpAssetLastTIMECoin("CMasternodeSync::SwitchToNextAsset");
 }
 
+std::map<int, int64_t> CMasternodeSync::GetAssetSyncMillis()
+{
+    LOCK(csPeers);
+    return mapAssetSyncMillis;
+}
+
 std::string CMasternodeSync::GetSyncStatus()
 {
     switch (masternodeSync.nRequestedMasternodeAssets) {
@@ -132,7 +160,71 @@ void CMasternodeSync::ProcessMessage(CNode* pfrom, std::string& strCommand, CDat
         vRecv >> nItemID >> nCount;
 
         LogPrintf("SYNCSTATUSCOUNT -- got inventory count: nItemID=%d  nCount=%d  peer=%d\n", nItemID, nCount, pfrom->id);
+        ReceivedAssetFrom(pfrom->id, nItemID);
+    }
+}
+
+void CMasternodeSync::ReceivedAssetFrom(NodeId nodeId, int nAsset)
+{
+    // the votes are the last thing a peer sends in reply to a governance sync request
+    if(nAsset == MASTERNODE_SYNC_GOVOBJ_VOTE) nAsset = MASTERNODE_SYNC_GOVERNANCE;
+
+    LOCK(csPeers);
+    // a late reply for an asset we are done with already
+    if(nAsset != nRequestedMasternodeAssets || !mapPeersRequested.count(nodeId)) return;
+    setPeersCompleted.insert(nodeId);
+    nTIMECoinLastCompleted = GetTIMECoin();
+    LogPrint("mnsync", "CMasternodeSync::ReceivedAssetFrom -- %s completed by peer=%d\n", GetAssetName(nAsset), nodeId);
+}
+
+void CMasternodeSync::RequestedAssetFrom(NodeId nodeId, bool fRequested)
+{
+    LOCK(csPeers);
+    if(fRequested) {
+        mapPeersRequested[nodeId] = GetTIMECoin();
+    } else {
+        mapPeersRequested.erase(nodeId);
+    }
+}
+
+void CMasternodeSync::CountPeers(int& nCompletedRet, int& nPendingRet)
+{
+    LOCK(csPeers);
+    nCompletedRet = setPeersCompleted.size();
+    nPendingRet = 0;
+    for(const auto& peerpair : mapPeersRequested) {
+        // peers that take this long have most likely gone away
+        if(!setPeersCompleted.count(peerpair.first) && GetTIMECoin() - peerpair.second <= MASTERNODE_SYNC_TIMECOUT_SECONDS) {
+            nPendingRet++;
+        }
+    }
+}
+
+bool CMasternodeSync::IsAssetComplete()
+{
+    int nCompleted, nPending;
+    CountPeers(nCompleted, nPending);
+    if(nCompleted == 0 || nPending > 0) return false;
+
+    // a peer reports completion before the inventory it announced has arrived, wait until nothing arrives for a while
+    LOCK(csPeers);
+    return GetTIMECoin() - std::max(nTIMECoinLastBumped, nTIMECoinLastCompleted) >= MASTERNODE_SYNC_SETTLE_SECONDS;
+}
+
+bool CMasternodeSync::IsChainTipReached(const std::vector<CNode*>& vSyncPeers)
+{
+    if(GetTIMECoin() - nTIMECoinLastBumped < MASTERNODE_SYNC_SETTLE_SECONDS) return false;
+
+    int nHeight;
+    {
+        LOCK(cs_main);
+        if(!pindexBestHeader || !chainActive.Tip() || pindexBestHeader != chainActive.Tip()) return false;
+        nHeight = chainActive.Height();
+    }
+    BOOST_FOREACH(CNode* pnode, vSyncPeers) {
+        if(pnode->nStartingHeight > nHeight) return false;
     }
+    return true;
 }
 
 void CMasternodeSync::ClearFulfilledRequests(CConnman& connman)
@@ -152,8 +244,9 @@ void CMasternodeSync::ClearFulfilledRequests(CConnman& connman)
 
 void CMasternodeSync::ProcessTick(CConnman& connman)
 {
+    // called every second, requests go out and assets complete as soon as the peers reply
     static int nTick = 0;
-    if(nTick++ % MASTERNODE_SYNC_TICK_SECONDS != 0) return;
+    nTick++;
 
     // reset the sync process if the last call to this function was more than 60 minutes ago (client was in sleep mode)
     static int64_t nTIMECoinLastProcess = GetTIMECoin();
@@ -178,6 +271,7 @@ void CMasternodeSync::ProcessTick(CConnman& connman)
 
     // gradually request the rest of the votes after sync finished
     if(IsSynced()) {
+        if(nTick % MASTERNODE_SYNC_TICK_SECONDS != 0) return;
         std::vector<CNode*> vNodesCopy = connman.CopyNodeVector();
         governance.RequestGovernanceObjectVotes(vNodesCopy, connman);
         connman.ReleaseNodeVector(vNodesCopy);
@@ -186,10 +280,13 @@ void CMasternodeSync::ProcessTick(CConnman& connman)
 
     // Calculate "progress" for LOG reporting / GUI notification
     double nSyncProgress = double(nRequestedMasternodeAttempt + (nRequestedMasternodeAssets - 1) * 8) / (8*4);
-    LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d nRequestedMasternodeAttempt %d nSyncProgress %f\n", nTick, nRequestedMasternodeAssets, nRequestedMasternodeAttempt, nSyncProgress);
+    if(nTick % MASTERNODE_SYNC_TICK_SECONDS == 0) {
+        LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d nRequestedMasternodeAttempt %d nSyncProgress %f\n", nTick, nRequestedMasternodeAssets, nRequestedMasternodeAttempt, nSyncProgress);
+    }
     uiInterface.NotifyAdditionalDataSyncProgressChanged(nSyncProgress);
 
     std::vector<CNode*> vNodesCopy = connman.CopyNodeVector();
+    std::vector<CNode*> vSyncPeers;
 
     BOOST_FOREACH(CNode* pnode, vNodesCopy)
     {
@@ -219,59 +316,73 @@ void CMasternodeSync::ProcessTick(CConnman& connman)
         }
 
         // NORMAL NETWORK MODE - TESTNET/MAINNET
-        {
-            if(netfulfilledman.HasFulfilledRequest(pnode->addr, "full-sync")) {
-                // We already fully synced from this node recently,
-                // disconnect to free this connection slot for another peer.
-                pnode->fDisconnect = true;
-                LogPrintf("CMasternodeSync::ProcessTick -- disconnecting from recently synced peer %d\n", pnode->id);
-                continue;
-            }
 
-            // SPORK : ALWAYS ASK FOR SPORKS AS WE SYNC
+        if(netfulfilledman.HasFulfilledRequest(pnode->addr, "full-sync")) {
+            // We already fully synced from this node recently,
+            // disconnect to free this connection slot for another peer.
+            pnode->fDisconnect = true;
+            LogPrintf("CMasternodeSync::ProcessTick -- disconnecting from recently synced peer %d\n", pnode->id);
+            continue;
+        }
 
-            if(!netfulfilledman.HasFulfilledRequest(pnode->addr, "spork-sync")) {
-                // always get sporks first, only request once from each peer
-                netfulfilledman.AddFulfilledRequest(pnode->addr, "spork-sync");
-                // get current network sporks
-                connman.PushMessageWithVersion(pnode, INIT_PROTO_VERSION, NetMsgType::GETSPORKS);
-                LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- requesting sporks from peer %d\n", nTick, nRequestedMasternodeAssets, pnode->id);
-            }
+        // SPORK : ALWAYS ASK FOR SPORKS AS WE SYNC
 
-            // INITIAL TIMECOUT
-
-            if(nRequestedMasternodeAssets == MASTERNODE_SYNC_WAITING) {
-                if(GetTIMECoin() - nTIMECoinLastBumped > MASTERNODE_SYNC_TIMECOUT_SECONDS) {
-                    // At this point we know that:
-                    // a) there are peers (because we are looping on at least one of them);
-                    // b) we waited for at least MASTERNODE_SYNC_TIMECOUT_SECONDS since we reached
-                    //    the headers tip the last time (i.e. since we switched from
-                    //     MASTERNODE_SYNC_INITIAL to MASTERNODE_SYNC_WAITING and bumped time);
-                    // c) there were no blocks (UpdatedBlockTip, NotifyHeaderTip) or headers (AcceptedBlockHeader)
-                    //    for at least MASTERNODE_SYNC_TIMECOUT_SECONDS.
-                    // We must be at the tip already, let's move to the next asset.
-                    SwitchToNextAsset(connman);
-                }
-            }
+        if(!netfulfilledman.HasFulfilledRequest(pnode->addr, "spork-sync")) {
+            // always get sporks first, only request once from each peer
+            netfulfilledman.AddFulfilledRequest(pnode->addr, "spork-sync");
+            // get current network sporks
+            connman.PushMessageWithVersion(pnode, INIT_PROTO_VERSION, NetMsgType::GETSPORKS);
+            LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- requesting sporks from peer %d\n", nTick, nRequestedMasternodeAssets, pnode->id);
+        }
 
-            // MNLIST : SYNC MASTERNODE LIST FROM OTHER CONNECTED CLIENTS
-
-            if(nRequestedMasternodeAssets == MASTERNODE_SYNC_LIST) {
-                LogPrint("masternode", "CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d nTIMECoinLastBumped %lld GetTIMECoin() %lld diff %lld\n", nTick, nRequestedMasternodeAssets, nTIMECoinLastBumped, GetTIMECoin(), GetTIMECoin() - nTIMECoinLastBumped);
-                // check for timeout first
-                if(GetTIMECoin() - nTIMECoinLastBumped > MASTERNODE_SYNC_TIMECOUT_SECONDS) {
-                    LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- timeout\n", nTick, nRequestedMasternodeAssets);
-                    if (nRequestedMasternodeAttempt == 0) {
-                        LogPrintf("CMasternodeSync::ProcessTick -- ERROR: failed to sync %s\n", GetAssetName());
-                        // there is no way we can continue without masternode list, fail here and try later
-                        Fail();
-                        connman.ReleaseNodeVector(vNodesCopy);
-                        return;
-                    }
-                    SwitchToNextAsset(connman);
-                    connman.ReleaseNodeVector(vNodesCopy);
-                    return;
-                }
+        vSyncPeers.push_back(pnode);
+    }
+
+    if(vSyncPeers.empty()) {
+        connman.ReleaseNodeVector(vNodesCopy);
+        return;
+    }
+
+    // INITIAL TIMECOUT
+
+    if(nRequestedMasternodeAssets == MASTERNODE_SYNC_WAITING) {
+        if(GetTIMECoin() - nTIMECoinLastBumped > MASTERNODE_SYNC_TIMECOUT_SECONDS || IsChainTipReached(vSyncPeers)) {
+            // At this point we know that:
+            // a) there are peers (because we have at least one of them to sync from);
+            // b) either we waited for at least MASTERNODE_SYNC_TIMECOUT_SECONDS since we reached
+            //    the headers tip the last time (i.e. since we switched from
+            //    MASTERNODE_SYNC_INITIAL to MASTERNODE_SYNC_WAITING and bumped time)
+            //    or we are at the headers tip and none of our peers started out with more blocks;
+            // c) there were no blocks (UpdatedBlockTip, NotifyHeaderTip) or headers (AcceptedBlockHeader)
+            //    for at least MASTERNODE_SYNC_SETTLE_SECONDS.
+            // We must be at the tip already, let's move to the next asset.
+            SwitchToNextAsset(connman);
+        }
+    }
+
+    // MNLIST : SYNC MASTERNODE LIST FROM OTHER CONNECTED CLIENTS
+
+    if(nRequestedMasternodeAssets == MASTERNODE_SYNC_LIST) {
+        LogPrint("masternode", "CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d nTIMECoinLastBumped %lld GetTIMECoin() %lld diff %lld\n", nTick, nRequestedMasternodeAssets, nTIMECoinLastBumped, GetTIMECoin(), GetTIMECoin() - nTIMECoinLastBumped);
+        // check for timeout first
+        if(GetTIMECoin() - nTIMECoinLastBumped > MASTERNODE_SYNC_TIMECOUT_SECONDS) {
+            LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- timeout\n", nTick, nRequestedMasternodeAssets);
+            if (nRequestedMasternodeAttempt == 0) {
+                LogPrintf("CMasternodeSync::ProcessTick -- ERROR: failed to sync %s\n", GetAssetName());
+                // there is no way we can continue without masternode list, fail here and try later
+                Fail();
+                connman.ReleaseNodeVector(vNodesCopy);
+                return;
+            }
+            SwitchToNextAsset(connman);
+        } else if(IsAssetComplete()) {
+            LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- all peers asked sent the list\n", nTick, nRequestedMasternodeAssets);
+            SwitchToNextAsset(connman);
+        } else {
+            int nCompleted, nPending;
+            CountPeers(nCompleted, nPending);
+            BOOST_FOREACH(CNode* pnode, vSyncPeers) {
+                if(nCompleted + nPending >= MASTERNODE_SYNC_PARALLEL_PEERS) break;
 
                 // only request once from each peer
                 if(netfulfilledman.HasFulfilledRequest(pnode->addr, "masternode-list-sync")) continue;
@@ -280,42 +391,44 @@ void CMasternodeSync::ProcessTick(CConnman& connman)
                 if (pnode->nVersion < mnpayments.GetMinMasternodePaymentsProto()) continue;
                 nRequestedMasternodeAttempt++;
 
-                mnodeman.DsegUpdate(pnode, connman);
+                // a peer we asked for the list recently gets no request, there is no reply to wait for then
+                RequestedAssetFrom(pnode->id);
+                if(mnodeman.DsegUpdate(pnode, connman)) {
+                    nPending++;
+                } else {
+                    RequestedAssetFrom(pnode->id, false);
+                }
+            }
+        }
+    }
 
+    // MNW : SYNC MASTERNODE PAYMENT VOTES FROM OTHER CONNECTED CLIENTS
+
+    if(nRequestedMasternodeAssets == MASTERNODE_SYNC_MNW) {
+        LogPrint("mnpayments", "CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d nTIMECoinLastBumped %lld GetTIMECoin() %lld diff %lld\n", nTick, nRequestedMasternodeAssets, nTIMECoinLastBumped, GetTIMECoin(), GetTIMECoin() - nTIMECoinLastBumped);
+        int nCompleted, nPending;
+        CountPeers(nCompleted, nPending);
+        // check for timeout first
+        // This might take a lot longer than MASTERNODE_SYNC_TIMECOUT_SECONDS due to new blocks,
+        // but that should be OK and it should timeout eventually.
+        if(GetTIMECoin() - nTIMECoinLastBumped > MASTERNODE_SYNC_TIMECOUT_SECONDS) {
+            LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- timeout\n", nTick, nRequestedMasternodeAssets);
+            if (nRequestedMasternodeAttempt == 0) {
+                LogPrintf("CMasternodeSync::ProcessTick -- ERROR: failed to sync %s\n", GetAssetName());
+                // probably not a good idea to proceed without winner list
+                Fail();
                 connman.ReleaseNodeVector(vNodesCopy);
-                return; //this will cause each peer to get one request each six seconds for the various assets we need
+                return;
             }
-
-            // MNW : SYNC MASTERNODE PAYMENT VOTES FROM OTHER CONNECTED CLIENTS
-
-            if(nRequestedMasternodeAssets == MASTERNODE_SYNC_MNW) {
-                LogPrint("mnpayments", "CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d nTIMECoinLastBumped %lld GetTIMECoin() %lld diff %lld\n", nTick, nRequestedMasternodeAssets, nTIMECoinLastBumped, GetTIMECoin(), GetTIMECoin() - nTIMECoinLastBumped);
-                // check for timeout first
-                // This might take a lot longer than MASTERNODE_SYNC_TIMECOUT_SECONDS due to new blocks,
-                // but that should be OK and it should timeout eventually.
-                if(GetTIMECoin() - nTIMECoinLastBumped > MASTERNODE_SYNC_TIMECOUT_SECONDS) {
-                    LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- timeout\n", nTick, nRequestedMasternodeAssets);
-                    if (nRequestedMasternodeAttempt == 0) {
-                        LogPrintf("CMasternodeSync::ProcessTick -- ERROR: failed to sync %s\n", GetAssetName());
-                        // probably not a good idea to proceed without winner list
-                        Fail();
-                        connman.ReleaseNodeVector(vNodesCopy);
-                        return;
-                    }
-                    SwitchToNextAsset(connman);
-                    connman.ReleaseNodeVector(vNodesCopy);
-                    return;
-                }
-
-                // check for data
-                // if mnpayments already has enough blocks and votes, switch to the next asset
-                // try to fetch data from at least two peers though
-                if(nRequestedMasternodeAttempt > 1 && mnpayments.IsEnoughData()) {
-                    LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- found enough data\n", nTick, nRequestedMasternodeAssets);
-                    SwitchToNextAsset(connman);
-                    connman.ReleaseNodeVector(vNodesCopy);
-                    return;
-                }
+            SwitchToNextAsset(connman);
+        } else if((nCompleted > 0 && mnpayments.IsEnoughData()) || IsAssetComplete()) {
+            // check for data
+            // if mnpayments already has enough blocks and votes once a peer sent its votes, switch to the next asset
+            LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- found enough data\n", nTick, nRequestedMasternodeAssets);
+            SwitchToNextAsset(connman);
+        } else {
+            BOOST_FOREACH(CNode* pnode, vSyncPeers) {
+                if(nCompleted + nPending >= MASTERNODE_SYNC_PARALLEL_PEERS) break;
 
                 // only request once from each peer
                 if(netfulfilledman.HasFulfilledRequest(pnode->addr, "masternode-payment-sync")) continue;
@@ -323,79 +436,88 @@ void CMasternodeSync::ProcessTick(CConnman& connman)
 
                 if(pnode->nVersion < mnpayments.GetMinMasternodePaymentsProto()) continue;
                 nRequestedMasternodeAttempt++;
+                RequestedAssetFrom(pnode->id);
+                nPending++;
 
                 // ask node for all payment votes it has (new nodes will only return votes for future payments)
                 connman.PushMessage(pnode, NetMsgType::MASTERNODEPAYMENTSYNC, mnpayments.GetStorageLimit());
                 // ask node for missing pieces only (old nodes will not be asked)
                 mnpayments.RequestLowDataPaymentBlocks(pnode, connman);
-
-                connman.ReleaseNodeVector(vNodesCopy);
-                return; //this will cause each peer to get one request each six seconds for the various assets we need
             }
+        }
+    }
 
-            // GOVOBJ : SYNC GOVERNANCE ITEMS FROM OUR PEERS
+    // GOVOBJ : SYNC GOVERNANCE ITEMS FROM OUR PEERS
 
-            if(nRequestedMasternodeAssets == MASTERNODE_SYNC_GOVERNANCE) {
-                LogPrint("gobject", "CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d nTIMECoinLastBumped %lld GetTIMECoin() %lld diff %lld\n", nTick, nRequestedMasternodeAssets, nTIMECoinLastBumped, GetTIMECoin(), GetTIMECoin() - nTIMECoinLastBumped);
+    if(nRequestedMasternodeAssets == MASTERNODE_SYNC_GOVERNANCE) {
+        LogPrint("gobject", "CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d nTIMECoinLastBumped %lld GetTIMECoin() %lld diff %lld\n", nTick, nRequestedMasternodeAssets, nTIMECoinLastBumped, GetTIMECoin(), GetTIMECoin() - nTIMECoinLastBumped);
 
-                // check for timeout first
-                if(GetTIMECoin() - nTIMECoinLastBumped > MASTERNODE_SYNC_TIMECOUT_SECONDS) {
-                    LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- timeout\n", nTick, nRequestedMasternodeAssets);
-                    if(nRequestedMasternodeAttempt == 0) {
-                        LogPrintf("CMasternodeSync::ProcessTick -- WARNING: failed to sync %s\n", GetAssetName());
-                        // it's kind of ok to skip this for now, hopefully we'll catch up later?
-                    }
-                    SwitchToNextAsset(connman);
-                    connman.ReleaseNodeVector(vNodesCopy);
-                    return;
-                }
+        // check for timeout first
+        if(GetTIMECoin() - nTIMECoinLastBumped > MASTERNODE_SYNC_TIMECOUT_SECONDS) {
+            LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- timeout\n", nTick, nRequestedMasternodeAssets);
+            if(nRequestedMasternodeAttempt == 0) {
+                LogPrintf("CMasternodeSync::ProcessTick -- WARNING: failed to sync %s\n", GetAssetName());
+                // it's kind of ok to skip this for now, hopefully we'll catch up later?
+            }
+            SwitchToNextAsset(connman);
+            connman.ReleaseNodeVector(vNodesCopy);
+            return;
+        }
 
-                // only request obj sync once from each peer, then request votes on per-obj basis
-                if(netfulfilledman.HasFulfilledRequest(pnode->addr, "governance-sync")) {
-                    int nObjsLeftToAsk = governance.RequestGovernanceObjectVotes(pnode, connman);
-                    static int64_t nTIMECoinNoObjectsLeft = 0;
-                    // check for data
-                    if(nObjsLeftToAsk == 0) {
-                        static int nLastTick = 0;
-                        static int nLastVotes = 0;
-                        if(nTIMECoinNoObjectsLeft == 0) {
-                            // asked all objects for votes for the first time
-                            nTIMECoinNoObjectsLeft = GetTIMECoin();
-                        }
-                        // make sure the condition below is checked only once per tick
-                        if(nLastTick == nTick) continue;
-                        if(GetTIMECoin() - nTIMECoinNoObjectsLeft > MASTERNODE_SYNC_TIMECOUT_SECONDS &&
-                            governance.GetVoteCount() - nLastVotes < std::max(int(0.0001 * nLastVotes), MASTERNODE_SYNC_TICK_SECONDS)
-                        ) {
-                            // We already asked for all objects, waited for MASTERNODE_SYNC_TIMECOUT_SECONDS
-                            // after that and less then 0.01% or MASTERNODE_SYNC_TICK_SECONDS
-                            // (i.e. 1 per second) votes were recieved during the last tick.
-                            // We can be pretty sure that we are done syncing.
-                            LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- asked for all objects, nothing to do\n", nTick, nRequestedMasternodeAssets);
-                            // reset nTIMECoinNoObjectsLeft to be able to use the same condition on resync
-                            nTIMECoinNoObjectsLeft = 0;
-                            SwitchToNextAsset(connman);
-                            connman.ReleaseNodeVector(vNodesCopy);
-                            return;
-                        }
-                        nLastTick = nTick;
+        int nCompleted, nPending;
+        CountPeers(nCompleted, nPending);
+        BOOST_FOREACH(CNode* pnode, vSyncPeers) {
+            // only request obj sync once from each peer, then request votes on per-obj basis
+            if(netfulfilledman.HasFulfilledRequest(pnode->addr, "governance-sync")) {
+                int nObjsLeftToAsk = governance.RequestGovernanceObjectVotes(pnode, connman);
+                static int64_t nTIMECoinNoObjectsLeft = 0;
+                // check for data
+                if(nObjsLeftToAsk == 0) {
+                    static int nLastTick = 0;
+                    static int nLastVotes = 0;
+                    if(nTIMECoinNoObjectsLeft == 0) {
+                        // asked all objects for votes for the first time
+                        nTIMECoinNoObjectsLeft = GetTIMECoin();
+                    }
+                    // make sure the condition below is checked only once per tick
+                    if(nLastTick == nTick) continue;
+                    bool fQuiet = IsAssetComplete();
+                    // the vote rate is compared over MASTERNODE_SYNC_TICK_SECONDS
+                    bool fSlow = nTick % MASTERNODE_SYNC_TICK_SECONDS == 0 &&
+                        GetTIMECoin() - nTIMECoinNoObjectsLeft > MASTERNODE_SYNC_TIMECOUT_SECONDS &&
+                        governance.GetVoteCount() - nLastVotes < std::max(int(0.0001 * nLastVotes), MASTERNODE_SYNC_TICK_SECONDS);
+                    if(fQuiet || fSlow) {
+                        // We already asked for all objects and either all peers asked sent theirs and nothing
+                        // arrived for MASTERNODE_SYNC_SETTLE_SECONDS since, or we waited for MASTERNODE_SYNC_TIMECOUT_SECONDS
+                        // after that and less then 0.01% or MASTERNODE_SYNC_TICK_SECONDS
+                        // (i.e. 1 per second) votes were recieved during the last tick.
+                        // We can be pretty sure that we are done syncing.
+                        LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nRequestedMasternodeAssets %d -- asked for all objects, nothing to do\n", nTick, nRequestedMasternodeAssets);
+                        // reset nTIMECoinNoObjectsLeft to be able to use the same condition on resync
+                        nTIMECoinNoObjectsLeft = 0;
+                        SwitchToNextAsset(connman);
+                        connman.ReleaseNodeVector(vNodesCopy);
+                        return;
+                    }
+                    nLastTick = nTick;
+                    if(nTick % MASTERNODE_SYNC_TICK_SECONDS == 0) {
                         nLastVotes = governance.GetVoteCount();
                     }
-                    continue;
                 }
-                netfulfilledman.AddFulfilledRequest(pnode->addr, "governance-sync");
-
-                if (pnode->nVersion < MIN_GOVERNANCE_PEER_PROTO_VERSION) continue;
-                nRequestedMasternodeAttempt++;
+                continue;
+            }
+            if(nCompleted + nPending >= MASTERNODE_SYNC_PARALLEL_PEERS) continue;
+            netfulfilledman.AddFulfilledRequest(pnode->addr, "governance-sync");
 
-                SendGovernanceSyncRequest(pnode, connman);
+            if (pnode->nVersion < MIN_GOVERNANCE_PEER_PROTO_VERSION) continue;
+            nRequestedMasternodeAttempt++;
+            RequestedAssetFrom(pnode->id);
+            nPending++;
 
-                connman.ReleaseNodeVector(vNodesCopy);
-                return; //this will cause each peer to get one request each six seconds for the various assets we need
-            }
+            SendGovernanceSyncRequest(pnode, connman);
         }
     }
-    // looped through all nodes, release them
+
     connman.ReleaseNodeVector(vNodesCopy);
 }
 
@@ -6,6 +6,7 @@
 
 #include "chain.h"
 #include "net.h"
+#include "sync.h"
 
 #include <univalue.h>
 
@@ -25,6 +26,8 @@ static const int MASTERNODE_SYNC_TICK_SECONDS    = 6;
 static const int MASTERNODE_SYNC_TIMECOUT_SECONDS = 30; // our blocks are 2.5 minutes so 30 seconds should be fine
 
 static const int MASTERNODE_SYNC_ENOUGH_PEERS    = 6;
+static const int MASTERNODE_SYNC_PARALLEL_PEERS  = 3; // peers an asset is requested from at the same time
+static const int MASTERNODE_SYNC_SETTLE_SECONDS  = 3; // quiet time after the last peer reported an asset complete
 
 extern CMasternodeSync masternodeSync;
 
@@ -46,9 +49,31 @@ private:
     int64_t nTIMECoinLastBumped;
     // ... or failed
     int64_t nTIMECoinLastFailure;
+    // ... and in milliseconds, for the timings below
+    int64_t nTIMECoinAssetSyncStartedMillis;
+
+    // protects the members below, nothing else is locked while it is held
+    CCriticalSection csPeers;
+    // how long each asset took to sync, in milliseconds
+    std::map<int, int64_t> mapAssetSyncMillis;
+    // peers we requested the current asset from and when
+    std::map<NodeId, int64_t> mapPeersRequested;
+    // peers that reported sending us the whole asset (SYNCSTATUSCOUNT, mnlistdiff)
+    std::set<NodeId> setPeersCompleted;
+    int64_t nTIMECoinLastCompleted;
 
     void Fail();
     void ClearFulfilledRequests(CConnman& connman);
+    void ClearPeers();
+
+    /// Record a request for the current asset, before it is sent, or that it wasn't sent after all
+    void RequestedAssetFrom(NodeId nodeId, bool fRequested = true);
+    /// Count the peers that completed the current asset and those we still wait for
+    void CountPeers(int& nCompletedRet, int& nPendingRet);
+    /// Whether every peer asked for the current asset completed it and the data it sent has been taken in
+    bool IsAssetComplete();
+    /// Whether we are at the best header and no peer knows of more blocks
+    bool IsChainTipReached(const std::vector<CNode*>& vSyncPeers);
 
 public:
     CMasternodeSync() { Reset(); }
@@ -66,13 +91,17 @@ public:
     int GetAttempt() { return nRequestedMasternodeAttempt; }
     void BumpAssetLastTIMECoin(std::string strFuncName);
     int64_t GetAssetStartTIMECoin() { return nTIMECoinAssetSyncStarted; }
-    std::string GetAssetName();
+    std::string GetAssetName() { return GetAssetName(nRequestedMasternodeAssets); }
+    static std::string GetAssetName(int nAsset);
+    std::map<int, int64_t> GetAssetSyncMillis();
     std::string GetSyncStatus();
 
     void Reset();
     void SwitchToNextAsset(CConnman& connman);
 
     void ProcessMessage(CNode* pfrom, std::string& strCommand, CDataStream& vRecv);
+    /// A peer sent all it has of an asset, the sync moves on once the peers asked have
+    void ReceivedAssetFrom(NodeId nodeId, int nAsset);
     void ProcessTick(CConnman& connman);
 
     void AcceptedBlockHeader(const CBlockIndex *pindexNew);
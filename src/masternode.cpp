@@ -4,6 +4,8 @@
 
 #include "activemasternode.h"
 #include "base58.h"
+#include "crypto/common.h"
+#include "crypto/sha256.h"
 #include "init.h"
 #include "netbase.h"
 #include "masternode.h"
@@ -33,6 +35,7 @@ CMasternode::CMasternode(CService addr, COutPoint outpoint, CPubKey pubKeyCollat
 
 CMasternode::CMasternode(const CMasternode& other) :
     masternode_info_t{other},
+    scoreMidstate(other.scoreMidstate),
     lastPing(other.lastPing),
     vchSig(other.vchSig),
     nCollateralMinConfBlockHash(other.nCollateralMinConfBlockHash),
@@ -93,12 +96,73 @@ bool CMasternode::UpdateFromNewBroadcast(CMasternodeBroadcast& mnb, CConnman& co
 // the proof of work for that block. The further away they are the better, the furthest will win the election
 // and get paid this block
 //
-arith_uint256 CMasternode::CalculateScore(const uint256& blockHash)
+// The score is the double SHA256 of the serialized collateral outpoint (36 bytes), nCollateralMinConfBlockHash
+// and blockHash. The first 64 of those 100 bytes don't depend on the block, so they are hashed once, and
+// only the last block of the first SHA256 and the second one are left for each score.
+//
+static void MakeScoreMidstate(const COutPoint& outpoint, const uint256& nCollateralMinConfBlockHash, CMasternodeScoreMidstate& midstateRet)
+{
+    CDataStream ss(SER_GETHASH, PROTOCOL_VERSION);
+    ss << outpoint << nCollateralMinConfBlockHash;
+    assert(ss.size() == 68);
+    const unsigned char* pch = (const unsigned char*)&ss[0];
+
+    CSHA256 hasher;
+    hasher.Write(pch, 64);
+    hasher.GetMidstate(midstateRet.state);
+
+    // the rest of nCollateralMinConfBlockHash, room for the block hash, and the padding of 100 bytes
+    memset(midstateRet.finalBlock, 0, sizeof(midstateRet.finalBlock));
+    memcpy(midstateRet.finalBlock, pch + 64, 4);
+    midstateRet.finalBlock[36] = 0x80;
+    WriteBE64(midstateRet.finalBlock + 56, 100 * 8);
+
+    midstateRet.outpoint = outpoint;
+    midstateRet.nCollateralMinConfBlockHash = nCollateralMinConfBlockHash;
+    midstateRet.fValid = true;
+}
+
+static bool IsScoreMidstateFor(const CMasternodeScoreMidstate& midstate, const COutPoint& outpoint, const uint256& nCollateralMinConfBlockHash)
+{
+    return midstate.fValid && midstate.outpoint == outpoint && midstate.nCollateralMinConfBlockHash == nCollateralMinConfBlockHash;
+}
+
+void CMasternode::UpdateScoreMidstate()
 {
-    // Deterministically calculate a "score" for a Masternode based on any given (block)hash
-    CHashWriter ss(SER_GETHASH, PROTOCOL_VERSION);
-    ss << vin.prevout << nCollateralMinConfBlockHash << blockHash;
-    return UintToArith256(ss.GetHash());
+    if(IsScoreMidstateFor(scoreMidstate, vin.prevout, nCollateralMinConfBlockHash)) return;
+    MakeScoreMidstate(vin.prevout, nCollateralMinConfBlockHash, scoreMidstate);
+}
+
+void CMasternode::CalculateScores(const std::vector<CMasternode*>& vecMasternodes, const uint256& blockHash, std::vector<arith_uint256>& vecScoresRet)
+{
+    size_t nCount = vecMasternodes.size();
+    std::vector<uint32_t> vecMidstates(8 * nCount);
+    std::vector<unsigned char> vecBlocks(64 * nCount);
+    for (size_t i = 0; i < nCount; i++) {
+        const CMasternode* pmn = vecMasternodes[i];
+        // the masternodes are shared, a missing midstate is made here rather than stored
+        const CMasternodeScoreMidstate* pmidstate = &pmn->scoreMidstate;
+        CMasternodeScoreMidstate midstateTmp;
+        if(!IsScoreMidstateFor(*pmidstate, pmn->vin.prevout, pmn->nCollateralMinConfBlockHash)) {
+            MakeScoreMidstate(pmn->vin.prevout, pmn->nCollateralMinConfBlockHash, midstateTmp);
+            pmidstate = &midstateTmp;
+        }
+        std::copy(pmidstate->state, pmidstate->state + 8, &vecMidstates[8 * i]);
+        memcpy(&vecBlocks[64 * i], pmidstate->finalBlock, 64);
+        memcpy(&vecBlocks[64 * i + 4], blockHash.begin(), 32);
+    }
+
+    // SHA256DMidstate hashes as many of them at once as the CPU allows
+    std::vector<uint256> vecHashes(nCount);
+    if(nCount) {
+        SHA256DMidstate(vecHashes[0].begin(), vecMidstates.data(), vecBlocks.data(), nCount);
+    }
+
+    vecScoresRet.clear();
+    vecScoresRet.reserve(nCount);
+    for (const auto& hash : vecHashes) {
+        vecScoresRet.push_back(UintToArith256(hash));
+    }
 }
 
 CMasternode::CollateralStatus CMasternode::CheckCollateral(const COutPoint& outpoint)
@@ -124,7 +188,35 @@ CMasternode::CollateralStatus CMasternode::CheckCollateral(const COutPoint& outp
     return COLLATERAL_OK;
 }
 
+CMasternodeCheckContext CMasternodeCheckContext::Get(int nHeight)
+{
+    CMasternodeCheckContext context;
+    context.nHeight = nHeight;
+    context.nMasternodeCount = mnodeman.size();
+    context.nMinPaymentsProto = mnpayments.GetMinMasternodePaymentsProto();
+    context.fMasternodeListSynced = masternodeSync.IsMasternodeListSynced();
+    context.fWatchdogActive = masternodeSync.IsSynced() && mnodeman.IsWatchdogActive();
+    return context;
+}
+
 void CMasternode::Check(bool fForce)
+{
+    CollateralStatus collateralStatus = COLLATERAL_OK;
+    int nHeight = 0;
+    if(!fUnitTest) {
+        TRY_LOCK(cs_main, lockMain);
+        if(!lockMain) return;
+
+        if(!IsOutpointSpent()) {
+            collateralStatus = CheckCollateral(vin.prevout);
+        }
+        nHeight = chainActive.Height();
+    }
+
+    Check(collateralStatus, CMasternodeCheckContext::Get(nHeight), fForce);
+}
+
+void CMasternode::Check(CollateralStatus collateralStatus, const CMasternodeCheckContext& context, bool fForce)
 {
     LOCK(cs);
 
@@ -138,21 +230,14 @@ void CMasternode::Check(bool fForce)
     //once spent, stop doing the checks
     if(IsOutpointSpent()) return;
 
-    int nHeight = 0;
-    if(!fUnitTest) {
-        TRY_LOCK(cs_main, lockMain);
-        if(!lockMain) return;
-
-        CollateralStatus err = CheckCollateral(vin.prevout);
-        if (err == COLLATERAL_UTXO_NOT_FOUND) {
-            nActiveState = MASTERNODE_OUTPOINT_SPENT;
-            LogPrint("masternode", "CMasternode::Check -- Failed to find Masternode UTXO, masternode=%s\n", vin.prevout.ToStringShort());
-            return;
-        }
-
-        nHeight = chainActive.Height();
+    if (collateralStatus == COLLATERAL_UTXO_NOT_FOUND) {
+        nActiveState = MASTERNODE_OUTPOINT_SPENT;
+        LogPrint("masternode", "CMasternode::Check -- Failed to find Masternode UTXO, masternode=%s\n", vin.prevout.ToStringShort());
+        return;
     }
 
+    int nHeight = context.nHeight;
+
     if(IsPoSeBanned()) {
         if(nHeight < nPoSeBanHeight) return; // too early?
         // Otherwise give it a chance to proceed further to do all the usual checks and to change its state.
@@ -163,7 +248,7 @@ void CMasternode::Check(bool fForce)
     } else if(nPoSeBanScore >= MASTERNODE_POSE_BAN_MAX_SCORE) {
         nActiveState = MASTERNODE_POSE_BAN;
         // ban for the whole payment cycle
-        nPoSeBanHeight = nHeight + mnodeman.size();
+        nPoSeBanHeight = nHeight + context.nMasternodeCount;
         LogPrintf("CMasternode::Check -- Masternode %s is banned till block %d now\n", vin.prevout.ToStringShort(), nPoSeBanHeight);
         return;
     }
@@ -172,7 +257,7 @@ void CMasternode::Check(bool fForce)
     bool fOurMasternode = fMasterNode && activeMasternode.pubKeyMasternode == pubKeyMasternode;
 
                    // masternode doesn't meet payment protocol requirements ...
-    bool fRequireUpdate = nProtocolVersion < mnpayments.GetMinMasternodePaymentsProto() ||
+    bool fRequireUpdate = nProtocolVersion < context.nMinPaymentsProto ||
                    // or it's our own node and we just updated it to the new protocol but we are still waiting for activation ...
                    (fOurMasternode && nProtocolVersion < PROTOCOL_VERSION);
 
@@ -185,7 +270,7 @@ void CMasternode::Check(bool fForce)
     }
 
     // keep old masternodes on start, give them a chance to receive updates...
-    bool fWaitForPing = !masternodeSync.IsMasternodeListSynced() && !IsPingedWithin(MASTERNODE_MIN_MNP_SECONDS);
+    bool fWaitForPing = !context.fMasternodeListSynced && !IsPingedWithin(MASTERNODE_MIN_MNP_SECONDS);
 
     if(fWaitForPing && !fOurMasternode) {
         // ...but if it was already expired before the initial check - return right away
@@ -206,8 +291,7 @@ void CMasternode::Check(bool fForce)
             return;
         }
 
-        bool fWatchdogActive = masternodeSync.IsSynced() && mnodeman.IsWatchdogActive();
-        bool fWatchdogExpired = (fWatchdogActive && ((GetAdjustedTIMECoin() - nTIMECoinLastWatchdogVote) > MASTERNODE_WATCHDOG_MAX_SECONDS));
+        bool fWatchdogExpired = (context.fWatchdogActive && ((GetAdjustedTIMECoin() - nTIMECoinLastWatchdogVote) > MASTERNODE_WATCHDOG_MAX_SECONDS));
 
         LogPrint("masternode", "CMasternode::Check -- outpoint=%s, nTIMECoinLastWatchdogVote=%d, GetAdjustedTIMECoin()=%d, fWatchdogExpired=%d\n",
                 vin.prevout.ToStringShort(), nTIMECoinLastWatchdogVote, GetAdjustedTIMECoin(), fWatchdogExpired);
@@ -305,43 +389,17 @@ std::string CMasternode::GetStatus() const
     return GetStateString();
 }
 
-void CMasternode::UpdateLastPaid(const CBlockIndex *pindex, int nMaxBlocksToScanBack)
+void CMasternode::UpdateLastPaid()
 {
-    if(!pindex) return;
-
-    const CBlockIndex *BlockReading = pindex;
-
     CScript mnpayee = GetScriptForDestination(pubKeyCollateralAddress.GetID());
-    // LogPrint("masternode", "CMasternode::UpdateLastPaidBlock -- searching for block with payment to %s\n", vin.prevout.ToStringShort());
-
-    LOCK(cs_mapMasternodeBlocks);
-
-    for (int i = 0; BlockReading && BlockReading->nHeight > nBlockLastPaid && i < nMaxBlocksToScanBack; i++) {
-        if(mnpayments.mapMasternodeBlocks.count(BlockReading->nHeight) &&
-            mnpayments.mapMasternodeBlocks[BlockReading->nHeight].HasPayeeWithVotes(mnpayee, 2))
-        {
-            CBlock block;
-            if(!ReadBlockFromDisk(block, BlockReading, Params().GetConsensus())) // shouldn't really happen
-                continue;
-
-            CAmount nMasternodePayment = GetMasternodePayment(BlockReading->nHeight, block.vtx[0].GetValueOut());
-
-            BOOST_FOREACH(CTxOut txout, block.vtx[0].vout)
-                if(mnpayee == txout.scriptPubKey && nMasternodePayment == txout.nValue) {
-                    nBlockLastPaid = BlockReading->nHeight;
-                    nTIMECoinLastPaid = BlockReading->nTIMECoin;
-                    LogPrint("masternode", "CMasternode::UpdateLastPaidBlock -- searching for block with payment to %s -- found new %d\n", vin.prevout.ToStringShort(), nBlockLastPaid);
-                    return;
-                }
-        }
 
-        if (BlockReading->pprev == NULL) { assert(BlockReading); break; }
-        BlockReading = BlockReading->pprev;
-    }
+    int nHeight;
+    int64_t nTime;
+    if(!mnLastPaidIndex.GetLastPaid(mnpayee, nHeight, nTime) || nHeight <= nBlockLastPaid) return;
 
-    // Last payment for this masternode wasn't found in latest mnpayments blocks
-    // or it was found in mnpayments blocks but wasn't found in the blockchain.
-    // LogPrint("masternode", "CMasternode::UpdateLastPaidBlock -- searching for block with payment to %s -- keeping old %d\n", vin.prevout.ToStringShort(), nBlockLastPaid);
+    nBlockLastPaid = nHeight;
+    nTIMECoinLastPaid = nTime;
+    LogPrint("masternode", "CMasternode::UpdateLastPaid -- payment to %s found in block %d\n", vin.prevout.ToStringShort(), nBlockLastPaid);
 }
 
 #ifdef ENABLE_WALLET
@@ -613,6 +671,7 @@ bool CMasternodeBroadcast::Sign(const CKey& keyCollateralAddress)
     std::string strMessage;
 
     sigTIMECoin = GetAdjustedTIMECoin();
+    fSignatureChecked = false;
 
     strMessage = addr.ToString(false) + boost::lexical_cast<std::string>(sigTIMECoin) +
                     pubKeyCollateralAddress.GetID().ToString() + pubKeyMasternode.GetID().ToString() +
@@ -637,6 +696,8 @@ bool CMasternodeBroadcast::CheckSignature(int& nDos)
     std::string strError = "";
     nDos = 0;
 
+    if(fSignatureChecked) return true;
+
     strMessage = addr.ToString(false) + boost::lexical_cast<std::string>(sigTIMECoin) +
                     pubKeyCollateralAddress.GetID().ToString() + pubKeyMasternode.GetID().ToString() +
                     boost::lexical_cast<std::string>(nProtocolVersion);
@@ -649,6 +710,7 @@ bool CMasternodeBroadcast::CheckSignature(int& nDos)
         return false;
     }
 
+    fSignatureChecked = true;
     return true;
 }
 
@@ -681,6 +743,7 @@ bool CMasternodePing::Sign(const CKey& keyMasternode, const CPubKey& pubKeyMaste
 
     // TODO: add sentinel data
     sigTIMECoin = GetAdjustedTIMECoin();
+    pubKeySignatureChecked = CPubKey();
     std::string strMessage = vin.ToString() + blockHash.ToString() + boost::lexical_cast<std::string>(sigTIMECoin);
 
     if(!CMessageSigner::SignMessage(strMessage, vchSig, keyMasternode)) {
@@ -698,16 +761,21 @@ bool CMasternodePing::Sign(const CKey& keyMasternode, const CPubKey& pubKeyMaste
 
 bool CMasternodePing::CheckSignature(CPubKey& pubKeyMasternode, int &nDos)
 {
+    nDos = 0;
+
+    if(pubKeyMasternode.IsValid() && pubKeyMasternode == pubKeySignatureChecked) return true;
+
     // TODO: add sentinel data
     std::string strMessage = vin.ToString() + blockHash.ToString() + boost::lexical_cast<std::string>(sigTIMECoin);
     std::string strError = "";
-    nDos = 0;
 
     if(!CMessageSigner::VerifyMessage(pubKeyMasternode, vchSig, strMessage, strError)) {
         LogPrintf("CMasternodePing::CheckSignature -- Got bad Masternode ping signature, masternode=%s, error: %s\n", vin.prevout.ToStringShort(), strError);
         nDos = 33;
         return false;
     }
+
+    pubKeySignatureChecked = pubKeyMasternode;
     return true;
 }
 
@@ -39,6 +39,8 @@ public:
     bool fSentinelIsCurrent = false; // true if last sentinel ping was actual
     // MSB is always 0, other 3 bits corresponds to x.x.x version scheme
     uint32_t nSentinelVersion{DEFAULT_SENTINEL_VERSION};
+    // not serialized: the key the signature is known to be valid for, see CMasternodeSigVerifier
+    CPubKey pubKeySignatureChecked{};
 
     CMasternodePing() = default;
 
@@ -52,6 +54,8 @@ public:
         READWRITE(blockHash);
         READWRITE(sigTIMECoin);
         READWRITE(vchSig);
+        if(ser_action.ForRead())
+            pubKeySignatureChecked = CPubKey();
         if(ser_action.ForRead() && (s.size() == 0))
         {
             fSentinelIsCurrent = false;
@@ -124,6 +128,38 @@ struct masternode_info_t
     bool fInfoValid = false; //* not in CMN
 };
 
+//
+// What CMasternode::Check depends on besides the masternode itself. CMasternodeMan::Check
+// gathers it once for a whole batch, so the masternodes can be checked without taking other locks.
+//
+struct CMasternodeCheckContext
+{
+    int nHeight;
+    int nMasternodeCount;
+    int nMinPaymentsProto;
+    bool fMasternodeListSynced;
+    bool fWatchdogActive;
+
+    static CMasternodeCheckContext Get(int nHeight);
+};
+
+//
+// The part of the score hashing that only depends on the collateral, see CMasternode::CalculateScores
+//
+struct CMasternodeScoreMidstate
+{
+    // the collateral it was made for
+    COutPoint outpoint;
+    uint256 nCollateralMinConfBlockHash;
+    // the SHA256 state after the first 64 bytes of the score input
+    uint32_t state[8];
+    // the last block of the first SHA256, the block hash goes in at offset 4
+    unsigned char finalBlock[64];
+    bool fValid;
+
+    CMasternodeScoreMidstate() : fValid(false) {}
+};
+
 //
 // The Masternode Class. For managing the Darksend process. It contains the input of the 10000 TIMEC, signature to prove
 // it's the one who own that ip address and code for calculating the payment election.
@@ -134,6 +170,10 @@ private:
     // critical section to protect the inner data structures
     mutable CCriticalSection cs;
 
+    // made by UpdateScoreMidstate when the masternode is added, under CMasternodeMan::cs,
+    // and only read by the scoring, which may run under other locks
+    CMasternodeScoreMidstate scoreMidstate;
+
 public:
     enum state {
         MASTERNODE_PRE_ENABLED,
@@ -198,14 +238,24 @@ public:
         READWRITE(mapGovernanceObjectsVotedOn);
     }
 
-    // CALCULATE A RANK AGAINST OF GIVEN BLOCK
-    arith_uint256 CalculateScore(const uint256& blockHash);
+    /// Hash the collateral part of the score input, unless that's done for the current collateral already
+    void UpdateScoreMidstate();
+    /// The scores of many masternodes against the same block, hashed several at a time. Doesn't modify them.
+    static void CalculateScores(const std::vector<CMasternode*>& vecMasternodes, const uint256& blockHash, std::vector<arith_uint256>& vecScoresRet);
 
     bool UpdateFromNewBroadcast(CMasternodeBroadcast& mnb, CConnman& connman);
 
     static CollateralStatus CheckCollateral(const COutPoint& outpoint);
     static CollateralStatus CheckCollateral(const COutPoint& outpoint, int& nHeightRet);
     void Check(bool fForce = false);
+    /// Check with the collateral already looked up, under cs_main, at context.nHeight
+    void Check(CollateralStatus collateralStatus, const CMasternodeCheckContext& context, bool fForce = false);
+
+    bool IsCheckDue() const
+    {
+        LOCK(cs);
+        return GetTIMECoin() - nTIMECoinLastChecked >= MASTERNODE_CHECK_SECONDS;
+    }
 
     bool IsBroadcastedWithin(int nSeconds) { return GetAdjustedTIMECoin() - sigTIMECoin < nSeconds; }
 
@@ -267,9 +317,9 @@ public:
     std::string GetStateString() const;
     std::string GetStatus() const;
 
-    int GetLastPaidTIMECoin() { return nTIMECoinLastPaid; }
-    int GetLastPaidBlock() { return nBlockLastPaid; }
-    void UpdateLastPaid(const CBlockIndex *pindex, int nMaxBlocksToScanBack);
+    int GetLastPaidTIMECoin() const { return nTIMECoinLastPaid; }
+    int GetLastPaidBlock() const { return nBlockLastPaid; }
+    void UpdateLastPaid();
 
     // KEEP TRACK OF EACH GOVERNANCE ITEM INCASE THIS NODE GOES OFFLINE, SO WE CAN RECALC THEIR STATUS
     void AddGovernanceVote(uint256 nGovernanceObjectHash);
@@ -286,6 +336,7 @@ public:
         lastPing = from.lastPing;
         vchSig = from.vchSig;
         nCollateralMinConfBlockHash = from.nCollateralMinConfBlockHash;
+        scoreMidstate = from.scoreMidstate;
         nBlockLastPaid = from.nBlockLastPaid;
         nPoSeBanScore = from.nPoSeBanScore;
         nPoSeBanHeight = from.nPoSeBanHeight;
@@ -315,11 +366,13 @@ class CMasternodeBroadcast : public CMasternode
 public:
 
     bool fRecovery;
+    // not serialized: whether the signature is known to be valid, see CMasternodeSigVerifier
+    bool fSignatureChecked;
 
-    CMasternodeBroadcast() : CMasternode(), fRecovery(false) {}
-    CMasternodeBroadcast(const CMasternode& mn) : CMasternode(mn), fRecovery(false) {}
+    CMasternodeBroadcast() : CMasternode(), fRecovery(false), fSignatureChecked(false) {}
+    CMasternodeBroadcast(const CMasternode& mn) : CMasternode(mn), fRecovery(false), fSignatureChecked(false) {}
     CMasternodeBroadcast(CService addrNew, COutPoint outpointNew, CPubKey pubKeyCollateralAddressNew, CPubKey pubKeyMasternodeNew, int nProtocolVersionIn) :
-        CMasternode(addrNew, outpointNew, pubKeyCollateralAddressNew, pubKeyMasternodeNew, nProtocolVersionIn), fRecovery(false) {}
+        CMasternode(addrNew, outpointNew, pubKeyCollateralAddressNew, pubKeyMasternodeNew, nProtocolVersionIn), fRecovery(false), fSignatureChecked(false) {}
 
     ADD_SERIALIZE_METHODS;
 
@@ -333,6 +386,8 @@ public:
         READWRITE(sigTIMECoin);
         READWRITE(nProtocolVersion);
         READWRITE(lastPing);
+        if(ser_action.ForRead())
+            fSignatureChecked = false;
     }
 
     uint256 GetHash() const
@@ -6,6 +6,7 @@
 #include "addrman.h"
 #include "governance.h"
 #include "masternode-payments.h"
+#include "masternode-sigverify.h"
 #include "masternode-sync.h"
 #include "masternodeman.h"
 #include "messagesigner.h"
@@ -16,19 +17,15 @@
 #include "script/standard.h"
 #include "util.h"
 
+#include <algorithm>
+#include <atomic>
+
+#include <boost/thread.hpp>
+
 /** Masternode manager */
 CMasternodeMan mnodeman;
 
-const std::string CMasternodeMan::SERIALIZATION_VERSION_STRING = "CMasternodeMan-Version-7";
-
-struct CompareLastPaidBlock
-{
-    bool operator()(const std::pair<int, CMasternode*>& t1,
-                    const std::pair<int, CMasternode*>& t2) const
-    {
-        return (t1.first != t2.first) ? (t1.first < t2.first) : (t1.second->vin < t2.second->vin);
-    }
-};
+const std::string CMasternodeMan::SERIALIZATION_VERSION_STRING = "CMasternodeMan-Version-9";
 
 struct CompareScoreMN
 {
@@ -39,23 +36,33 @@ struct CompareScoreMN
     }
 };
 
-struct CompareByAddr
-
-{
-    bool operator()(const CMasternode* t1,
-                    const CMasternode* t2) const
-    {
-        return t1->addr < t2->addr;
-    }
-};
-
 CMasternodeMan::CMasternodeMan()
 : cs(),
   mapMasternodes(),
+  mapIndexPubKeyMasternode(),
+  mapIndexPayee(),
+  mapIndexAddr(),
+  pListSnapshot(),
   mAskedUsForMasternodeList(),
   mWeAskedForMasternodeList(),
   mWeAskedForMasternodeListEntry(),
   mWeAskedForVerification(),
+  nPoSeRequestsSent(0),
+  nPoSeRepliesVerified(0),
+  nPoSeRepliesFailed(0),
+  nPoSeReplyMillisTotal(0),
+  nPoSeBroadcastsVerified(0),
+  hashListEpoch(),
+  nListSeq(0),
+  hashListEpochLoaded(),
+  nListSeqLoaded(0),
+  nListSeqMinDiff(0),
+  mapListChanges(),
+  mapListRemoved(),
+  mapPeerListVersions(),
+  mWeAskedForListDiff(),
+  mAskedUsForListDiff(),
+  mWeAskedForListDiffAgain(),
   mMnbRecoveryRequests(),
   mMnbRecoveryGoodReplies(),
   listScheduledMnbRequestConnections(),
@@ -63,6 +70,11 @@ CMasternodeMan::CMasternodeMan()
   fMasternodesRemoved(false),
   vecDirtyGovernanceObjectHashes(),
   nLastWatchdogVoteTIMECoin(0),
+  setPaymentQueue(),
+  fPaymentQueueDirty(false),
+  mapCollateralHeights(),
+  setCollateralHeightsPending(),
+  hashCollateralHeightsTip(),
   mapSeenMasternodeBroadcast(),
   mapSeenMasternodePing(),
   nDsqCount(0)
@@ -75,7 +87,14 @@ bool CMasternodeMan::Add(CMasternode &mn)
     if (Has(mn.vin.prevout)) return false;
 
     LogPrint("masternode", "CMasternodeMan::Add -- Adding new Masternode: addr=%s, %i now\n", mn.addr.ToString(), size() + 1);
-    mapMasternodes[mn.vin.prevout] = mn;
+    CMasternode& mnNew = mapMasternodes[mn.vin.prevout];
+    mnNew = mn;
+    mnNew.UpdateScoreMidstate();
+    IndexMasternode(mnNew);
+    pListSnapshot.reset();
+    ListChanged(mnNew.vin.prevout, true);
+    setPaymentQueue.insert(std::make_pair(mnNew.nBlockLastPaid, &mnNew));
+    setCollateralHeightsPending.insert(mn.vin.prevout);
     fMasternodesAdded = true;
     return true;
 }
@@ -119,6 +138,7 @@ bool CMasternodeMan::AllowMixing(const COutPoint &outpoint)
     nDsqCount++;
     pmn->nLastDsq = nDsqCount;
     pmn->fAllowMixingTx = true;
+    pListSnapshot.reset();
 
     return true;
 }
@@ -131,6 +151,7 @@ bool CMasternodeMan::DisallowMixing(const COutPoint &outpoint)
         return false;
     }
     pmn->fAllowMixingTx = false;
+    pListSnapshot.reset();
 
     return true;
 }
@@ -143,19 +164,72 @@ bool CMasternodeMan::PoSeBan(const COutPoint &outpoint)
         return false;
     }
     pmn->PoSeBan();
+    pListSnapshot.reset();
 
     return true;
 }
 
 void CMasternodeMan::Check()
 {
-    LOCK(cs);
+    // Need LOCK2 here to ensure consistent locking order because the collaterals are looked up under cs_main
+    LOCK2(cs_main, cs);
 
     LogPrint("masternode", "CMasternodeMan::Check -- nLastWatchdogVoteTIMECoin=%d, IsWatchdogActive()=%d\n", nLastWatchdogVoteTIMECoin, IsWatchdogActive());
 
+    int64_t nStart = GetTIMECoinMicros();
+
+    std::vector<std::pair<CMasternode*, CMasternode::CollateralStatus> > vecChecks;
+    vecChecks.reserve(mapMasternodes.size());
     for (auto& mnpair : mapMasternodes) {
-        mnpair.second.Check();
+        // the others would return right away
+        if(!mnpair.second.IsCheckDue()) continue;
+        vecChecks.push_back(std::make_pair(&mnpair.second, CMasternode::COLLATERAL_OK));
+    }
+    // Look up all the collaterals in one go, in outpoint order, which keeps
+    // the reads of those not in the coins cache close together on disk
+    std::sort(vecChecks.begin(), vecChecks.end(), [](const std::pair<CMasternode*, CMasternode::CollateralStatus>& a,
+                                                     const std::pair<CMasternode*, CMasternode::CollateralStatus>& b) {
+        return a.first->vin.prevout < b.first->vin.prevout;
+    });
+    for (auto& check : vecChecks) {
+        if(!check.first->fUnitTest && !check.first->IsOutpointSpent()) {
+            check.second = CMasternode::CheckCollateral(check.first->vin.prevout);
+        }
+    }
+    const CMasternodeCheckContext context = CMasternodeCheckContext::Get(chainActive.Height());
+
+    int64_t nLookedUp = GetTIMECoinMicros();
+
+    // Each masternode only locks itself from here on, so ranges of them can be checked in parallel
+    const size_t nChecks = vecChecks.size();
+    int nThreads = std::max(1, std::min<int>(MAX_CHECK_THREADS, nChecks / MIN_CHECKS_PER_THREAD));
+    std::atomic<bool> fStateChanged(false);
+    boost::thread_group threadGroup;
+    for (int t = 0; t < nThreads; t++) {
+        const size_t nBegin = nChecks * t / nThreads;
+        const size_t nEnd = nChecks * (t + 1) / nThreads;
+        auto checkRange = [&vecChecks, &context, &fStateChanged, nBegin, nEnd]() {
+            for (size_t i = nBegin; i < nEnd; i++) {
+                int nActiveStatePrev = vecChecks[i].first->nActiveState;
+                vecChecks[i].first->Check(vecChecks[i].second, context);
+                if(vecChecks[i].first->nActiveState != nActiveStatePrev) {
+                    fStateChanged = true;
+                }
+            }
+        };
+        if (t + 1 < nThreads) {
+            threadGroup.create_thread(checkRange);
+        } else {
+            checkRange();
+        }
+    }
+    threadGroup.join_all();
+    if(fStateChanged) {
+        pListSnapshot.reset();
     }
+
+    LogPrint("masternode", "CMasternodeMan::Check -- looked up %u collaterals in %.2fms, checked them on %d threads in %.2fms\n",
+                nChecks, (nLookedUp - nStart) * 0.001, nThreads, (GetTIMECoinMicros() - nLookedUp) * 0.001);
 }
 
 void CMasternodeMan::CheckAndRemove(CConnman& connman)
@@ -175,7 +249,7 @@ void CMasternodeMan::CheckAndRemove(CConnman& connman)
         rank_pair_vec_t vecMasternodeRanks;
         // ask for up to MNB_RECOVERY_MAX_ASK_ENTRIES masternode entries at a time
         int nAskForMnbRecovery = MNB_RECOVERY_MAX_ASK_ENTRIES;
-        std::map<COutPoint, CMasternode>::iterator it = mapMasternodes.begin();
+        auto it = mapMasternodes.begin();
         while (it != mapMasternodes.end()) {
             CMasternodeBroadcast mnb = CMasternodeBroadcast(it->second);
             uint256 hash = mnb.GetHash();
@@ -189,7 +263,13 @@ void CMasternodeMan::CheckAndRemove(CConnman& connman)
 
                 // and finally remove it from the list
                 it->second.FlagGovernanceItemsAsDirty();
-                mapMasternodes.erase(it++);
+                setPaymentQueue.erase(std::make_pair(it->second.nBlockLastPaid, &it->second));
+                mapCollateralHeights.erase(it->first);
+                setCollateralHeightsPending.erase(it->first);
+                UnindexMasternode(it->second);
+                pListSnapshot.reset();
+                ListRemoved(it->first);
+                it = mapMasternodes.erase(it);
                 fMasternodesRemoved = true;
             } else {
                 bool fAsk = (nAskForMnbRecovery > 0) &&
@@ -282,6 +362,35 @@ void CMasternodeMan::CheckAndRemove(CConnman& connman)
             }
         }
 
+        // check who we asked for a diff, those that never answered may not know the message
+        std::map<CNetAddr, std::pair<int64_t, CMasternodeListVersion> >::iterator itDiff = mWeAskedForListDiff.begin();
+        while(itDiff != mWeAskedForListDiff.end()) {
+            if(itDiff->second.first < GetTIMECoin()) {
+                mapPeerListVersions.erase(itDiff->first);
+                mWeAskedForListDiff.erase(itDiff++);
+            } else {
+                ++itDiff;
+            }
+        }
+
+        // check who's asked us for a diff and who we asked for one
+        it1 = mAskedUsForListDiff.begin();
+        while(it1 != mAskedUsForListDiff.end()){
+            if((*it1).second < GetTIMECoin()){
+                mAskedUsForListDiff.erase(it1++);
+            } else {
+                ++it1;
+            }
+        }
+        it1 = mWeAskedForListDiffAgain.begin();
+        while(it1 != mWeAskedForListDiffAgain.end()){
+            if((*it1).second < GetTIMECoin()){
+                mWeAskedForListDiffAgain.erase(it1++);
+            } else {
+                ++it1;
+            }
+        }
+
         // check which Masternodes we've asked for
         std::map<COutPoint, std::map<CNetAddr, int64_t> >::iterator it2 = mWeAskedForMasternodeListEntry.begin();
         while(it2 != mWeAskedForMasternodeListEntry.end()){
@@ -300,9 +409,9 @@ void CMasternodeMan::CheckAndRemove(CConnman& connman)
             }
         }
 
-        std::map<CNetAddr, CMasternodeVerification>::iterator it3 = mWeAskedForVerification.begin();
+        std::map<CNetAddr, std::pair<int64_t, CMasternodeVerification> >::iterator it3 = mWeAskedForVerification.begin();
         while(it3 != mWeAskedForVerification.end()){
-            if(it3->second.nBlockHeight < nCachedBlockHeight - MAX_POSE_BLOCKS) {
+            if(it3->second.second.nBlockHeight < nCachedBlockHeight - MAX_POSE_BLOCKS) {
                 mWeAskedForVerification.erase(it3++);
             } else {
                 ++it3;
@@ -344,10 +453,29 @@ void CMasternodeMan::CheckAndRemove(CConnman& connman)
 void CMasternodeMan::Clear()
 {
     LOCK(cs);
+    setPaymentQueue.clear();
+    fPaymentQueueDirty = false;
+    mapCollateralHeights.clear();
+    setCollateralHeightsPending.clear();
     mapMasternodes.clear();
+    mapIndexPubKeyMasternode.clear();
+    mapIndexPayee.clear();
+    mapIndexAddr.clear();
+    pListSnapshot.reset();
     mAskedUsForMasternodeList.clear();
     mWeAskedForMasternodeList.clear();
     mWeAskedForMasternodeListEntry.clear();
+    hashListEpoch.SetNull();
+    nListSeq = 0;
+    hashListEpochLoaded.SetNull();
+    nListSeqLoaded = 0;
+    nListSeqMinDiff = 0;
+    mapListChanges.clear();
+    mapListRemoved.clear();
+    mapPeerListVersions.clear();
+    mWeAskedForListDiff.clear();
+    mAskedUsForListDiff.clear();
+    mWeAskedForListDiffAgain.clear();
     mapSeenMasternodeBroadcast.clear();
     mapSeenMasternodePing.clear();
     nDsqCount = 0;
@@ -399,25 +527,49 @@ int CMasternodeMan::CountByIP(int nNetworkType)
 }
 */
 
-void CMasternodeMan::DsegUpdate(CNode* pnode, CConnman& connman)
+bool CMasternodeMan::DsegUpdate(CNode* pnode, CConnman& connman)
 {
     LOCK(cs);
 
-    if(Params().NetworkIDString() == CBaseChainParams::MAIN) {
-        if(!(pnode->addr.IsRFC1918() || pnode->addr.IsLocal())) {
-            std::map<CNetAddr, int64_t>::iterator it = mWeAskedForMasternodeList.find(pnode->addr);
-            if(it != mWeAskedForMasternodeList.end() && GetTIMECoin() < (*it).second) {
-                LogPrintf("CMasternodeMan::DsegUpdate -- we already asked %s for the list; skipping...\n", pnode->addr.ToString());
-                return;
+    // peers answer dseg and getmnlistd only so often, as we do
+    bool fThrottled = Params().NetworkIDString() == CBaseChainParams::MAIN && !(pnode->addr.IsRFC1918() || pnode->addr.IsLocal());
+
+    // peers that know nothing of mnlistdiff ignore getmnlistd, those that do
+    // reply with the changes since the version of their list we synced to
+    std::map<CNetAddr, CMasternodeListVersion>::iterator itVersion = mapPeerListVersions.find(pnode->addr);
+    CMasternodeListVersion versionFrom = itVersion == mapPeerListVersions.end() ? CMasternodeListVersion() : itVersion->second;
+    if(!versionFrom.IsNull()) {
+        if(fThrottled) {
+            std::map<CNetAddr, int64_t>::iterator it = mWeAskedForListDiffAgain.find(pnode->addr);
+            if(it != mWeAskedForListDiffAgain.end() && GetTIMECoin() < (*it).second) {
+                LogPrintf("CMasternodeMan::DsegUpdate -- we already asked %s for the list changes; skipping...\n", pnode->addr.ToString());
+                return false;
             }
+            mWeAskedForListDiffAgain[pnode->addr] = GetTIMECoin() + DSEG_UPDATE_SECONDS;
         }
+        connman.PushMessage(pnode, NetMsgType::GETMNLISTDIFF, versionFrom);
+        mWeAskedForListDiff[pnode->addr] = std::make_pair(GetTIMECoin() + MNLISTDIFF_WAIT_SECONDS, versionFrom);
+        LogPrint("masternode", "CMasternodeMan::DsegUpdate -- asked %s for the list changes since %s\n", pnode->addr.ToString(), versionFrom.ToString());
+        return true;
     }
 
+    if(fThrottled) {
+        std::map<CNetAddr, int64_t>::iterator it = mWeAskedForMasternodeList.find(pnode->addr);
+        if(it != mWeAskedForMasternodeList.end() && GetTIMECoin() < (*it).second) {
+            LogPrintf("CMasternodeMan::DsegUpdate -- we already asked %s for the list; skipping...\n", pnode->addr.ToString());
+            return false;
+        }
+    }
+
+    // the version of the list the dseg reply brings us to, for diffs next time
+    connman.PushMessage(pnode, NetMsgType::GETMNLISTDIFF, versionFrom);
+    mWeAskedForListDiff[pnode->addr] = std::make_pair(GetTIMECoin() + MNLISTDIFF_WAIT_SECONDS, versionFrom);
     connman.PushMessage(pnode, NetMsgType::DSEG, CTxIn());
     int64_t askAgain = GetTIMECoin() + DSEG_UPDATE_SECONDS;
     mWeAskedForMasternodeList[pnode->addr] = askAgain;
 
     LogPrint("masternode", "CMasternodeMan::DsegUpdate -- asked %s for the list\n", pnode->addr.ToString());
+    return true;
 }
 
 CMasternode* CMasternodeMan::Find(const COutPoint &outpoint)
@@ -454,26 +606,24 @@ bool CMasternodeMan::GetMasternodeInfo(const COutPoint& outpoint, masternode_inf
 bool CMasternodeMan::GetMasternodeInfo(const CPubKey& pubKeyMasternode, masternode_info_t& mnInfoRet)
 {
     LOCK(cs);
-    for (auto& mnpair : mapMasternodes) {
-        if (mnpair.second.pubKeyMasternode == pubKeyMasternode) {
-            mnInfoRet = mnpair.second.GetInfo();
-            return true;
-        }
+    auto it = mapIndexPubKeyMasternode.find(pubKeyMasternode);
+    if (it == mapIndexPubKeyMasternode.end()) {
+        return false;
     }
-    return false;
+    // the one with the lowest outpoint, should several share the key
+    mnInfoRet = Find(*it->second.begin())->GetInfo();
+    return true;
 }
 
 bool CMasternodeMan::GetMasternodeInfo(const CScript& payee, masternode_info_t& mnInfoRet)
 {
     LOCK(cs);
-    for (auto& mnpair : mapMasternodes) {
-        CScript scriptCollateralAddress = GetScriptForDestination(mnpair.second.pubKeyCollateralAddress.GetID());
-        if (scriptCollateralAddress == payee) {
-            mnInfoRet = mnpair.second.GetInfo();
-            return true;
-        }
+    auto it = mapIndexPayee.find(payee);
+    if (it == mapIndexPayee.end()) {
+        return false;
     }
-    return false;
+    mnInfoRet = Find(*it->second.begin())->GetInfo();
+    return true;
 }
 
 bool CMasternodeMan::Has(const COutPoint& outpoint)
@@ -500,70 +650,183 @@ bool CMasternodeMan::GetNextMasternodeInQueueForPayment(int nBlockHeight, bool f
         return false;
     }
 
-    // Need LOCK2 here to ensure consistent locking order because the GetBlockHash call below locks cs_main
-    LOCK2(cs_main,cs);
+    uint256 blockHash;
+    bool fBlockHash;
+    int nTipHeight;
+    {
+        // cs_main is only held to look up the collaterals of masternodes new to the queue
+        LOCK2(cs_main,cs);
+
+        fBlockHash = GetBlockHash(blockHash, nBlockHeight - 101);
+        nTipHeight = chainActive.Height();
+
+        std::set<COutPoint>::iterator it = setCollateralHeightsPending.begin();
+        while (it != setCollateralHeightsPending.end()) {
+            int nCollateralHeight = GetUTXOHeight(*it);
+            if(nCollateralHeight > -1) {
+                mapCollateralHeights[*it] = nCollateralHeight;
+                setCollateralHeightsPending.erase(it++);
+            } else {
+                // not confirmed yet, or spent
+                ++it;
+            }
+        }
+    }
 
-    std::vector<std::pair<int, CMasternode*> > vecMasternodeLastPaid;
+    LOCK(cs);
 
-    /*
-        Make a vector with all of the last paid times
-    */
+    if(fPaymentQueueDirty) {
+        RebuildPaymentQueue();
+    }
 
     int nMnCount = CountMasternodes();
+    CMasternode *pBestMasternode = NULL;
 
-    for (auto& mnpair : mapMasternodes) {
-        if(!mnpair.second.IsValidForPayment()) continue;
+    SelectFromPaymentQueue(nBlockHeight, nTipHeight, nMnCount, blockHash, fFilterSigTIMECoin, nCountRet, pBestMasternode);
+
+    //when the network is in the process of upgrading, don't penalize nodes that recently restarted
+    if(fFilterSigTIMECoin && nCountRet < nMnCount/3)
+        SelectFromPaymentQueue(nBlockHeight, nTipHeight, nMnCount, blockHash, false, nCountRet, pBestMasternode);
+
+    if(!fBlockHash) {
+        LogPrintf("CMasternode::GetNextMasternodeInQueueForPayment -- ERROR: GetBlockHash() failed at nBlockHeight %d\n", nBlockHeight - 101);
+        return false;
+    }
+
+    if (pBestMasternode) {
+        mnInfoRet = pBestMasternode->GetInfo();
+    }
+    return mnInfoRet.fInfoValid;
+}
+
+void CMasternodeMan::SelectFromPaymentQueue(int nBlockHeight, int nTipHeight, int nMnCount, const uint256& blockHash, bool fFilterSigTIMECoin,
+                                            int& nCountRet, CMasternode*& pmnBestRet)
+{
+    nCountRet = 0;
+    pmnBestRet = NULL;
+
+    // Look at 1/10 of the oldest nodes (by last payment), calculate their scores and pay the best one
+    //  -- This doesn't look at who is being paid in the +8-10 blocks, allowing for double payments very rarely
+    //  -- 1/100 payments should be a double payment on mainnet - (1/(3000/10))*2
+    //  -- (chance per block * chances before IsScheduled will fire)
+    int nTenthNetwork = nMnCount/10;
+    int nMinProtocol = mnpayments.GetMinMasternodePaymentsProto();
+    std::vector<CMasternode*> vecToScore;
+
+    for (const auto& entry : setPaymentQueue) {
+        CMasternode* pmn = entry.second;
+
+        if(!pmn->IsValidForPayment()) continue;
 
         //check protocol version
-        if(mnpair.second.nProtocolVersion < mnpayments.GetMinMasternodePaymentsProto()) continue;
+        if(pmn->nProtocolVersion < nMinProtocol) continue;
 
         //it's in the list (up to 8 entries ahead of current block to allow propagation) -- so let's skip it
-        if(mnpayments.IsScheduled(mnpair.second, nBlockHeight)) continue;
+        if(mnpayments.IsScheduled(*pmn, nBlockHeight)) continue;
 
         //it's too new, wait for a cycle
-        if(fFilterSigTIMECoin && mnpair.second.sigTIMECoin + (nMnCount*2.6*60) > GetAdjustedTIMECoin()) continue;
+        if(fFilterSigTIMECoin && pmn->sigTIMECoin + (nMnCount*2.6*60) > GetAdjustedTIMECoin()) continue;
 
         //make sure it has at least as many confirmations as there are masternodes
-        if(GetUTXOConfirmations(mnpair.first) < nMnCount) continue;
+        std::map<COutPoint, int>::const_iterator it = mapCollateralHeights.find(pmn->vin.prevout);
+        if(it == mapCollateralHeights.end() || nTipHeight - it->second + 1 < nMnCount) continue;
 
-        vecMasternodeLastPaid.push_back(std::make_pair(mnpair.second.GetLastPaidBlock(), &mnpair.second));
+        if(nCountRet++ < std::max(nTenthNetwork, 1)) {
+            vecToScore.push_back(pmn);
+        }
     }
 
-    nCountRet = (int)vecMasternodeLastPaid.size();
+    // score them all at once, the first one with the highest score wins
+    std::vector<arith_uint256> vecScores;
+    CMasternode::CalculateScores(vecToScore, blockHash, vecScores);
+    arith_uint256 nHighest = 0;
+    for (size_t i = 0; i < vecToScore.size(); i++) {
+        if(vecScores[i] > nHighest){
+            nHighest = vecScores[i];
+            pmnBestRet = vecToScore[i];
+        }
+    }
+}
 
-    //when the network is in the process of upgrading, don't penalize nodes that recently restarted
-    if(fFilterSigTIMECoin && nCountRet < nMnCount/3)
-        return GetNextMasternodeInQueueForPayment(nBlockHeight, false, nCountRet, mnInfoRet);
+CMasternodeMan::snapshot_t CMasternodeMan::GetListSnapshot()
+{
+    LOCK(cs);
+    if(!pListSnapshot) {
+        std::shared_ptr<std::map<COutPoint, CMasternode> > pSnapshot = std::make_shared<std::map<COutPoint, CMasternode> >();
+        for (const auto& mnpair : mapMasternodes) {
+            // the copy constructor leaves mapGovernanceObjectsVotedOn behind
+            pSnapshot->emplace(mnpair.first, mnpair.second);
+        }
+        pListSnapshot = pSnapshot;
+    }
+    return pListSnapshot;
+}
+
+void CMasternodeMan::IndexMasternode(const CMasternode& mn)
+{
+    const COutPoint& outpoint = mn.vin.prevout;
+    mapIndexPubKeyMasternode[mn.pubKeyMasternode].insert(outpoint);
+    mapIndexPayee[GetScriptForDestination(mn.pubKeyCollateralAddress.GetID())].insert(outpoint);
+    mapIndexAddr[mn.addr].insert(outpoint);
+}
 
-    // Sort them low to high
-    sort(vecMasternodeLastPaid.begin(), vecMasternodeLastPaid.end(), CompareLastPaidBlock());
+template <typename K>
+static void EraseFromIndex(std::map<K, std::set<COutPoint> >& mapIndex, const K& key, const COutPoint& outpoint)
+{
+    auto it = mapIndex.find(key);
+    if (it == mapIndex.end()) return;
+    it->second.erase(outpoint);
+    if (it->second.empty()) {
+        mapIndex.erase(it);
+    }
+}
 
-    uint256 blockHash;
-    if(!GetBlockHash(blockHash, nBlockHeight - 101)) {
-        LogPrintf("CMasternode::GetNextMasternodeInQueueForPayment -- ERROR: GetBlockHash() failed at nBlockHeight %d\n", nBlockHeight - 101);
-        return false;
+void CMasternodeMan::UnindexMasternode(const CMasternode& mn)
+{
+    const COutPoint& outpoint = mn.vin.prevout;
+    EraseFromIndex(mapIndexPubKeyMasternode, mn.pubKeyMasternode, outpoint);
+    EraseFromIndex(mapIndexPayee, GetScriptForDestination(mn.pubKeyCollateralAddress.GetID()), outpoint);
+    EraseFromIndex(mapIndexAddr, mn.addr, outpoint);
+}
+
+void CMasternodeMan::RebuildIndexes()
+{
+    mapIndexPubKeyMasternode.clear();
+    mapIndexPayee.clear();
+    mapIndexAddr.clear();
+    for (const auto& mnpair : mapMasternodes) {
+        IndexMasternode(mnpair.second);
     }
-    // Look at 1/10 of the oldest nodes (by last payment), calculate their scores and pay the best one
-    //  -- This doesn't look at who is being paid in the +8-10 blocks, allowing for double payments very rarely
-    //  -- 1/100 payments should be a double payment on mainnet - (1/(3000/10))*2
-    //  -- (chance per block * chances before IsScheduled will fire)
-    int nTenthNetwork = nMnCount/10;
-    int nCountTenth = 0;
-    arith_uint256 nHighest = 0;
-    CMasternode *pBestMasternode = NULL;
-    BOOST_FOREACH (PAIRTYPE(int, CMasternode*)& s, vecMasternodeLastPaid){
-        arith_uint256 nScore = s.second->CalculateScore(blockHash);
-        if(nScore > nHighest){
-            nHighest = nScore;
-            pBestMasternode = s.second;
+}
+
+std::vector<CMasternode*> CMasternodeMan::GetSortedByAddr()
+{
+    std::vector<CMasternode*> vSortedByAddr;
+    vSortedByAddr.reserve(mapMasternodes.size());
+    for (const auto& addrpair : mapIndexAddr) {
+        for (const auto& outpoint : addrpair.second) {
+            vSortedByAddr.push_back(Find(outpoint));
         }
-        nCountTenth++;
-        if(nCountTenth >= nTenthNetwork) break;
     }
-    if (pBestMasternode) {
-        mnInfoRet = pBestMasternode->GetInfo();
+    return vSortedByAddr;
+}
+
+void CMasternodeMan::RebuildPaymentQueue()
+{
+    setPaymentQueue.clear();
+    for (auto& mnpair : mapMasternodes) {
+        setPaymentQueue.insert(std::make_pair(mnpair.second.nBlockLastPaid, &mnpair.second));
+    }
+    fPaymentQueueDirty = false;
+}
+
+void CMasternodeMan::ResetCollateralHeights()
+{
+    mapCollateralHeights.clear();
+    setCollateralHeightsPending.clear();
+    for (const auto& mnpair : mapMasternodes) {
+        setCollateralHeightsPending.insert(mnpair.first);
     }
-    return mnInfoRet.fInfoValid;
 }
 
 masternode_info_t CMasternodeMan::FindRandomNotInVec(const std::vector<COutPoint> &vecToExclude, int nProtocolVersion)
@@ -622,11 +885,19 @@ bool CMasternodeMan::GetMasternodeScores(const uint256& nBlockHash, CMasternodeM
         return false;
 
     // calculate scores
+    std::vector<CMasternode*> vecToScore;
+    vecToScore.reserve(mapMasternodes.size());
     for (auto& mnpair : mapMasternodes) {
         if (mnpair.second.nProtocolVersion >= nMinProtocol) {
-            vecMasternodeScoresRet.push_back(std::make_pair(mnpair.second.CalculateScore(nBlockHash), &mnpair.second));
+            vecToScore.push_back(&mnpair.second);
         }
     }
+    std::vector<arith_uint256> vecScores;
+    CMasternode::CalculateScores(vecToScore, nBlockHash, vecScores);
+    vecMasternodeScoresRet.reserve(vecToScore.size());
+    for (size_t i = 0; i < vecToScore.size(); i++) {
+        vecMasternodeScoresRet.push_back(std::make_pair(vecScores[i], vecToScore[i]));
+    }
 
     sort(vecMasternodeScoresRet.rbegin(), vecMasternodeScoresRet.rend(), CompareScoreMN());
     return !vecMasternodeScoresRet.empty();
@@ -753,18 +1024,9 @@ void CMasternodeMan::ProcessMessage(CNode* pfrom, std::string& strCommand, CData
 
         LogPrint("masternode", "MNANNOUNCE -- Masternode announce, masternode=%s\n", mnb.vin.prevout.ToStringShort());
 
-        int nDos = 0;
-
-        if (CheckMnbAndUpdateMasternodeList(pfrom, mnb, nDos, connman)) {
-            // use announced Masternode as a peer
-            connman.AddNewAddress(CAddress(mnb.addr, NODE_NETWORK), pfrom->addr, 2*60*60);
-        } else if(nDos > 0) {
-            Misbehaving(pfrom->GetId(), nDos);
-        }
+        QueueBroadcast(pfrom, mnb);
+        ProcessVerifiedMessages(connman);
 
-        if(fMasternodesAdded) {
-            NotifyMasternodeUpdates(connman);
-        }
     } else if (strCommand == NetMsgType::MNPING) { //Masternode Ping
 
         CMasternodePing mnp;
@@ -778,40 +1040,8 @@ void CMasternodeMan::ProcessMessage(CNode* pfrom, std::string& strCommand, CData
 
         LogPrint("masternode", "MNPING -- Masternode ping, masternode=%s\n", mnp.vin.prevout.ToStringShort());
 
-        // Need LOCK2 here to ensure consistent locking order because the CheckAndUpdate call below locks cs_main
-        LOCK2(cs_main, cs);
-
-        if(mapSeenMasternodePing.count(nHash)) return; //seen
-        mapSeenMasternodePing.insert(std::make_pair(nHash, mnp));
-
-        LogPrint("masternode", "MNPING -- Masternode ping, masternode=%s new\n", mnp.vin.prevout.ToStringShort());
-
-        // see if we have this Masternode
-        CMasternode* pmn = Find(mnp.vin.prevout);
-
-        // if masternode uses sentinel ping instead of watchdog
-        // we shoud update nTIMECoinLastWatchdogVote here if sentinel
-        // ping flag is actual
-        if(pmn && mnp.fSentinelIsCurrent)
-            UpdateWatchdogVoteTIMECoin(mnp.vin.prevout, mnp.sigTIMECoin);
-
-        // too late, new MNANNOUNCE is required
-        if(pmn && pmn->IsNewStartRequired()) return;
-
-        int nDos = 0;
-        if(mnp.CheckAndUpdate(pmn, false, nDos, connman)) return;
-
-        if(nDos > 0) {
-            // if anything significant failed, mark that node
-            Misbehaving(pfrom->GetId(), nDos);
-        } else if(pmn != NULL) {
-            // nothing significant failed, mn is a known one too
-            return;
-        }
-
-        // something significant is broken or mn is unknown,
-        // we might have to ask for a masternode entry once
-        AskForMN(pfrom, mnp.vin.prevout, connman);
+        if(!QueuePing(pfrom, mnp)) return; //seen
+        ProcessVerifiedMessages(connman);
 
     } else if (strCommand == NetMsgType::DSEG) { //Get Masternode list or specific entry
         // Ignore such requests until we are fully synced.
@@ -875,10 +1105,66 @@ void CMasternodeMan::ProcessMessage(CNode* pfrom, std::string& strCommand, CData
         // smth weird happen - someone asked us for vin we have no idea about?
         LogPrint("masternode", "DSEG -- No invs sent to peer %d\n", pfrom->id);
 
-    } else if (strCommand == NetMsgType::MNVERIFY) { // Masternode Verify
+    } else if (strCommand == NetMsgType::GETMNLISTDIFF) { //Get the Masternode list changes since a version of it
+        // same as for DSEG, our list has to be complete first
+        if (!masternodeSync.IsSynced()) return;
 
-        // Need LOCK2 here to ensure consistent locking order because the all functions below call GetBlockHash which locks cs_main
-        LOCK2(cs_main, cs);
+        CMasternodeListVersion versionFrom;
+        vRecv >> versionFrom;
+
+        LOCK(cs);
+
+        //local network
+        bool isLocal = (pfrom->addr.IsRFC1918() || pfrom->addr.IsLocal());
+        bool fThrottled = !isLocal && Params().NetworkIDString() == CBaseChainParams::MAIN;
+
+        CMasternodeListDiff diff;
+        if(versionFrom.IsNull()) {
+            // the peer syncs the list with dseg and wants to know which version it gets,
+            // only tell a peer that may ask for the list, it learns the version from it anyway
+            std::map<CNetAddr, int64_t>::iterator it = mAskedUsForMasternodeList.find(pfrom->addr);
+            if(!fThrottled || it == mAskedUsForMasternodeList.end() || it->second <= GetTIMECoin()) {
+                diff.versionTo = GetListVersion();
+            }
+        } else {
+            // a diff can be as large as MNLISTDIFF_MAX_ENTRIES mnb and mnp, throttled like dseg
+            if(fThrottled) {
+                std::map<CNetAddr, int64_t>::iterator it = mAskedUsForListDiff.find(pfrom->addr);
+                if (it != mAskedUsForListDiff.end() && it->second > GetTIMECoin()) {
+                    Misbehaving(pfrom->GetId(), 34);
+                    LogPrintf("GETMNLISTDIFF -- peer already asked me for the list changes, peer=%d\n", pfrom->id);
+                    return;
+                }
+                mAskedUsForListDiff[pfrom->addr] = GetTIMECoin() + DSEG_UPDATE_SECONDS;
+            }
+            if(!GetListDiff(versionFrom, diff)) {
+                LogPrint("masternode", "GETMNLISTDIFF -- can't make a diff since %s for peer %d\n", versionFrom.ToString(), pfrom->id);
+                diff = CMasternodeListDiff();
+                diff.versionFrom = versionFrom;
+            }
+        }
+
+        connman.PushMessage(pfrom, NetMsgType::MNLISTDIFF, diff);
+        LogPrint("masternode", "GETMNLISTDIFF -- Sent %d mnb, %d mnp and %d removals since %s to peer %d\n",
+                diff.vecMnb.size(), diff.vecMnp.size(), diff.vecRemoved.size(), versionFrom.ToString(), pfrom->id);
+
+    } else if (strCommand == NetMsgType::MNLISTDIFF) { //Masternode list changes
+
+        CMasternodeListDiff diff;
+        vRecv >> diff;
+
+        if(!masternodeSync.IsBlockchainSynced()) return;
+
+        if(diff.vecMnb.size() > MNLISTDIFF_MAX_ENTRIES || diff.vecMnp.size() > MNLISTDIFF_MAX_ENTRIES ||
+                diff.vecRemoved.size() > MNLISTDIFF_MAX_REMOVED) {
+            LogPrintf("MNLISTDIFF -- oversized diff, peer=%d\n", pfrom->id);
+            Misbehaving(pfrom->GetId(), 20);
+            return;
+        }
+
+        ProcessListDiff(pfrom, diff, connman);
+
+    } else if (strCommand == NetMsgType::MNVERIFY) { // Masternode Verify
 
         CMasternodeVerification mnv;
         vRecv >> mnv;
@@ -887,16 +1173,25 @@ void CMasternodeMan::ProcessMessage(CNode* pfrom, std::string& strCommand, CData
 
         if(!masternodeSync.IsMasternodeListSynced()) return;
 
-        if(mnv.vchSig1.empty()) {
-            // CASE 1: someone asked me to verify myself /IP we are using/
-            SendVerifyReply(pfrom, mnv, connman);
-        } else if (mnv.vchSig2.empty()) {
-            // CASE 2: we _probably_ got verification we requested from some masternode
-            ProcessVerifyReply(pfrom, mnv);
-        } else {
-            // CASE 3: we _probably_ got verification broadcast signed by some masternode which verified another one
-            ProcessVerifyBroadcast(pfrom, mnv);
+        {
+            // Need LOCK2 here to ensure consistent locking order because the all functions below call GetBlockHash which locks cs_main
+            LOCK2(cs_main, cs);
+
+            if(mnv.vchSig1.empty()) {
+                // CASE 1: someone asked me to verify myself /IP we are using/
+                SendVerifyReply(pfrom, mnv, connman);
+                return;
+            } else if (mnv.vchSig2.empty()) {
+                // CASE 2: we _probably_ got verification we requested from some masternode
+                if(!QueueVerifyReply(pfrom, mnv)) return;
+            } else {
+                // CASE 3: we _probably_ got verification broadcast signed by some masternode which verified another one
+                if(!QueueVerifyBroadcast(pfrom, mnv)) return;
+            }
         }
+
+        // the signatures are checked on the verifier threads, the rest in ProcessVerifiedMessages
+        ProcessVerifiedMessages(connman);
     }
 }
 
@@ -910,10 +1205,8 @@ void CMasternodeMan::DoFullVerificationStep(CConnman& connman)
     rank_pair_vec_t vecMasternodeRanks;
     GetMasternodeRanks(vecMasternodeRanks, nCachedBlockHeight - 1, MIN_POSE_PROTO_VERSION);
 
-    // Need LOCK2 here to ensure consistent locking order because the SendVerifyRequest call below locks cs_main
-    // through GetHeight() signal in ConnectNode
-    LOCK2(cs_main, cs);
-
+    // the ranks are copies, so neither cs_main nor cs is held below: SendVerifyRequest
+    // connects to each masternode, which can block for seconds
     int nCount = 0;
 
     int nMyRank = -1;
@@ -944,13 +1237,6 @@ void CMasternodeMan::DoFullVerificationStep(CConnman& connman)
     int nOffset = MAX_POSE_RANK + nMyRank - 1;
     if(nOffset >= (int)vecMasternodeRanks.size()) return;
 
-    std::vector<CMasternode*> vSortedByAddr;
-    for (auto& mnpair : mapMasternodes) {
-        vSortedByAddr.push_back(&mnpair.second);
-    }
-
-    sort(vSortedByAddr.begin(), vSortedByAddr.end(), CompareByAddr());
-
     it = vecMasternodeRanks.begin() + nOffset;
     while(it != vecMasternodeRanks.end()) {
         if(it->second.IsPoSeVerified() || it->second.IsPoSeBanned()) {
@@ -966,7 +1252,7 @@ void CMasternodeMan::DoFullVerificationStep(CConnman& connman)
         }
         LogPrint("masternode", "CMasternodeMan::DoFullVerificationStep -- Verifying masternode %s rank %d/%d address %s\n",
                     it->second.vin.prevout.ToStringShort(), it->first, nRanksTotal, it->second.addr.ToString());
-        if(SendVerifyRequest(CAddress(it->second.addr, NODE_NETWORK), vSortedByAddr, connman)) {
+        if(SendVerifyRequest(CAddress(it->second.addr, NODE_NETWORK), connman)) {
             nCount++;
             if(nCount >= MAX_POSE_CONNECTIONS) break;
         }
@@ -996,11 +1282,7 @@ void CMasternodeMan::CheckSameAddr()
         CMasternode* pprevMasternode = NULL;
         CMasternode* pverifiedMasternode = NULL;
 
-        for (auto& mnpair : mapMasternodes) {
-            vSortedByAddr.push_back(&mnpair.second);
-        }
-
-        sort(vSortedByAddr.begin(), vSortedByAddr.end(), CompareByAddr());
+        vSortedByAddr = GetSortedByAddr();
 
         BOOST_FOREACH(CMasternode* pmn, vSortedByAddr) {
             // check only (pre)enabled masternodes
@@ -1030,13 +1312,17 @@ void CMasternodeMan::CheckSameAddr()
     }
 
     // ban duplicates
+    LOCK(cs);
     BOOST_FOREACH(CMasternode* pmn, vBan) {
         LogPrintf("CMasternodeMan::CheckSameAddr -- increasing PoSe ban score for masternode %s\n", pmn->vin.prevout.ToStringShort());
         pmn->IncreasePoSeBanScore();
     }
+    if(!vBan.empty()) {
+        pListSnapshot.reset();
+    }
 }
 
-bool CMasternodeMan::SendVerifyRequest(const CAddress& addr, const std::vector<CMasternode*>& vSortedByAddr, CConnman& connman)
+bool CMasternodeMan::SendVerifyRequest(const CAddress& addr, CConnman& connman)
 {
     if(netfulfilledman.HasFulfilledRequest(addr, strprintf("%s", NetMsgType::MNVERIFY)+"-request")) {
         // we already asked for verification, not a good idea to do this too often, skip it
@@ -1051,9 +1337,14 @@ bool CMasternodeMan::SendVerifyRequest(const CAddress& addr, const std::vector<C
     }
 
     netfulfilledman.AddFulfilledRequest(addr, strprintf("%s", NetMsgType::MNVERIFY)+"-request");
-    // use random nonce, store it and require node to reply with correct one later
-    CMasternodeVerification mnv(addr, GetRandInt(999999), nCachedBlockHeight - 1);
-    mWeAskedForVerification[addr] = mnv;
+    CMasternodeVerification mnv;
+    {
+        LOCK(cs);
+        // use random nonce, store it and require node to reply with correct one later
+        mnv = CMasternodeVerification(addr, GetRandInt(999999), nCachedBlockHeight - 1);
+        mWeAskedForVerification[addr] = std::make_pair(GetTIMECoinMillis(), mnv);
+        nPoSeRequestsSent++;
+    }
     LogPrintf("CMasternodeMan::SendVerifyRequest -- verifying node using nonce %d addr=%s\n", mnv.nonce, addr.ToString());
     connman.PushMessage(pnode, NetMsgType::MNVERIFY, mnv);
 
@@ -1100,122 +1391,153 @@ void CMasternodeMan::SendVerifyReply(CNode* pnode, CMasternodeVerification& mnv,
     netfulfilledman.AddFulfilledRequest(pnode->addr, strprintf("%s", NetMsgType::MNVERIFY)+"-reply");
 }
 
-void CMasternodeMan::ProcessVerifyReply(CNode* pnode, CMasternodeVerification& mnv)
+bool CMasternodeMan::QueueVerifyReply(CNode* pnode, CMasternodeVerification& mnv)
 {
-    std::string strError;
-
     // did we even ask for it? if that's the case we should have matching fulfilled request
     if(!netfulfilledman.HasFulfilledRequest(pnode->addr, strprintf("%s", NetMsgType::MNVERIFY)+"-request")) {
         LogPrintf("CMasternodeMan::ProcessVerifyReply -- ERROR: we didn't ask for verification of %s, peer=%d\n", pnode->addr.ToString(), pnode->id);
         Misbehaving(pnode->id, 20);
-        return;
+        return false;
     }
 
+    std::map<CNetAddr, std::pair<int64_t, CMasternodeVerification> >::iterator itAsked = mWeAskedForVerification.find(pnode->addr);
+    const CMasternodeVerification mnvAsked = itAsked != mWeAskedForVerification.end() ? itAsked->second.second : CMasternodeVerification();
+
     // Received nonce for a known address must match the one we sent
-    if(mWeAskedForVerification[pnode->addr].nonce != mnv.nonce) {
+    if(mnvAsked.nonce != mnv.nonce) {
         LogPrintf("CMasternodeMan::ProcessVerifyReply -- ERROR: wrong nounce: requested=%d, received=%d, peer=%d\n",
-                    mWeAskedForVerification[pnode->addr].nonce, mnv.nonce, pnode->id);
+                    mnvAsked.nonce, mnv.nonce, pnode->id);
         Misbehaving(pnode->id, 20);
-        return;
+        return false;
     }
 
     // Received nBlockHeight for a known address must match the one we sent
-    if(mWeAskedForVerification[pnode->addr].nBlockHeight != mnv.nBlockHeight) {
+    if(mnvAsked.nBlockHeight != mnv.nBlockHeight) {
         LogPrintf("CMasternodeMan::ProcessVerifyReply -- ERROR: wrong nBlockHeight: requested=%d, received=%d, peer=%d\n",
-                    mWeAskedForVerification[pnode->addr].nBlockHeight, mnv.nBlockHeight, pnode->id);
+                    mnvAsked.nBlockHeight, mnv.nBlockHeight, pnode->id);
         Misbehaving(pnode->id, 20);
-        return;
+        return false;
     }
 
     uint256 blockHash;
     if(!GetBlockHash(blockHash, mnv.nBlockHeight)) {
         // this shouldn't happen...
         LogPrintf("MasternodeMan::ProcessVerifyReply -- can't get block hash for unknown block height %d, peer=%d\n", mnv.nBlockHeight, pnode->id);
-        return;
+        return false;
     }
 
     // we already verified this address, why node is spamming?
     if(netfulfilledman.HasFulfilledRequest(pnode->addr, strprintf("%s", NetMsgType::MNVERIFY)+"-done")) {
         LogPrintf("CMasternodeMan::ProcessVerifyReply -- ERROR: already verified %s recently\n", pnode->addr.ToString());
         Misbehaving(pnode->id, 20);
-        return;
+        return false;
     }
 
-    {
-        LOCK(cs);
+    // the address the reply is from, it's what the masternode signed and it's needed once the peer may be gone
+    mnv.addr = pnode->addr;
+    std::string strMessage1 = strprintf("%s%d%s", mnv.addr.ToString(false), mnv.nonce, blockHash.ToString());
+    mnSigVerifier.PushVerification(pnode->GetId(), mnv, strMessage1, "");
+    return true;
+}
 
-        CMasternode* prealMasternode = NULL;
-        std::vector<CMasternode*> vpMasternodesToBan;
-        std::string strMessage1 = strprintf("%s%d%s", pnode->addr.ToString(false), mnv.nonce, blockHash.ToString());
-        for (auto& mnpair : mapMasternodes) {
-            if(CAddress(mnpair.second.addr, NODE_NETWORK) == pnode->addr) {
-                if(CMessageSigner::VerifyMessage(mnpair.second.pubKeyMasternode, mnv.vchSig1, strMessage1, strError)) {
-                    // found it!
-                    prealMasternode = &mnpair.second;
-                    if(!mnpair.second.IsPoSeVerified()) {
-                        mnpair.second.DecreasePoSeBanScore();
-                    }
-                    netfulfilledman.AddFulfilledRequest(pnode->addr, strprintf("%s", NetMsgType::MNVERIFY)+"-done");
-
-                    // we can only broadcast it if we are an activated masternode
-                    if(activeMasternode.outpoint == COutPoint()) continue;
-                    // update ...
-                    mnv.addr = mnpair.second.addr;
-                    mnv.vin1 = mnpair.second.vin;
-                    mnv.vin2 = CTxIn(activeMasternode.outpoint);
-                    std::string strMessage2 = strprintf("%s%d%s%s%s", mnv.addr.ToString(false), mnv.nonce, blockHash.ToString(),
-                                            mnv.vin1.prevout.ToStringShort(), mnv.vin2.prevout.ToStringShort());
-                    // ... and sign it
-                    if(!CMessageSigner::SignMessage(strMessage2, mnv.vchSig2, activeMasternode.keyMasternode)) {
-                        LogPrintf("MasternodeMan::ProcessVerifyReply -- SignMessage() failed\n");
-                        return;
-                    }
+void CMasternodeMan::ProcessVerifyReply(NodeId nodeId, CMasternodeVerification& mnv, const CKeyID& keyIDSigner)
+{
+    // Need LOCK2 here to ensure consistent locking order because GetBlockHash and Misbehaving below need cs_main
+    LOCK2(cs_main, cs);
 
-                    std::string strError;
+    CAddress addr(mnv.addr, NODE_NONE);
 
-                    if(!CMessageSigner::VerifyMessage(activeMasternode.pubKeyMasternode, mnv.vchSig2, strMessage2, strError)) {
-                        LogPrintf("MasternodeMan::ProcessVerifyReply -- VerifyMessage() failed, error: %s\n", strError);
-                        return;
-                    }
+    // another reply may have verified the address since this one was queued
+    if(netfulfilledman.HasFulfilledRequest(addr, strprintf("%s", NetMsgType::MNVERIFY)+"-done")) {
+        LogPrintf("CMasternodeMan::ProcessVerifyReply -- ERROR: already verified %s recently\n", addr.ToString());
+        Misbehaving(nodeId, 20);
+        return;
+    }
+
+    uint256 blockHash;
+    if(!GetBlockHash(blockHash, mnv.nBlockHeight)) {
+        // this shouldn't happen...
+        LogPrintf("MasternodeMan::ProcessVerifyReply -- can't get block hash for unknown block height %d, peer=%d\n", mnv.nBlockHeight, nodeId);
+        return;
+    }
+
+    CMasternode* prealMasternode = NULL;
+    std::vector<CMasternode*> vpMasternodesToBan;
+    auto itAddr = mapIndexAddr.find(addr);
+    if(itAddr != mapIndexAddr.end()) {
+        for (const auto& outpoint : itAddr->second) {
+            CMasternode* pmn = Find(outpoint);
+            if(!keyIDSigner.IsNull() && pmn->pubKeyMasternode.GetID() == keyIDSigner) {
+                // found it!
+                prealMasternode = pmn;
+                if(!pmn->IsPoSeVerified()) {
+                    pmn->DecreasePoSeBanScore();
+                }
+                netfulfilledman.AddFulfilledRequest(addr, strprintf("%s", NetMsgType::MNVERIFY)+"-done");
+
+                // we can only broadcast it if we are an activated masternode
+                if(activeMasternode.outpoint == COutPoint()) continue;
+                // update ...
+                mnv.addr = pmn->addr;
+                mnv.vin1 = pmn->vin;
+                mnv.vin2 = CTxIn(activeMasternode.outpoint);
+                std::string strMessage2 = strprintf("%s%d%s%s%s", mnv.addr.ToString(false), mnv.nonce, blockHash.ToString(),
+                                        mnv.vin1.prevout.ToStringShort(), mnv.vin2.prevout.ToStringShort());
+                // ... and sign it
+                if(!CMessageSigner::SignMessage(strMessage2, mnv.vchSig2, activeMasternode.keyMasternode)) {
+                    LogPrintf("MasternodeMan::ProcessVerifyReply -- SignMessage() failed\n");
+                    return;
+                }
 
-                    mWeAskedForVerification[pnode->addr] = mnv;
-                    mapSeenMasternodeVerification.insert(std::make_pair(mnv.GetHash(), mnv));
-                    mnv.Relay();
+                std::string strError;
 
-                } else {
-                    vpMasternodesToBan.push_back(&mnpair.second);
+                if(!CMessageSigner::VerifyMessage(activeMasternode.pubKeyMasternode, mnv.vchSig2, strMessage2, strError)) {
+                    LogPrintf("MasternodeMan::ProcessVerifyReply -- VerifyMessage() failed, error: %s\n", strError);
+                    return;
                 }
+
+                mWeAskedForVerification[addr].second = mnv;
+                mapSeenMasternodeVerification.insert(std::make_pair(mnv.GetHash(), mnv));
+                mnv.Relay();
+
+            } else {
+                vpMasternodesToBan.push_back(pmn);
             }
         }
-        // no real masternode found?...
-        if(!prealMasternode) {
-            // this should never be the case normally,
-            // only if someone is trying to game the system in some way or smth like that
-            LogPrintf("CMasternodeMan::ProcessVerifyReply -- ERROR: no real masternode found for addr %s\n", pnode->addr.ToString());
-            Misbehaving(pnode->id, 20);
-            return;
-        }
-        LogPrintf("CMasternodeMan::ProcessVerifyReply -- verified real masternode %s for addr %s\n",
-                    prealMasternode->vin.prevout.ToStringShort(), pnode->addr.ToString());
-        // increase ban score for everyone else
-        BOOST_FOREACH(CMasternode* pmn, vpMasternodesToBan) {
-            pmn->IncreasePoSeBanScore();
-            LogPrint("masternode", "CMasternodeMan::ProcessVerifyReply -- increased PoSe ban score for %s addr %s, new score %d\n",
-                        prealMasternode->vin.prevout.ToStringShort(), pnode->addr.ToString(), pmn->nPoSeBanScore);
-        }
-        if(!vpMasternodesToBan.empty())
-            LogPrintf("CMasternodeMan::ProcessVerifyReply -- PoSe score increased for %d fake masternodes, addr %s\n",
-                        (int)vpMasternodesToBan.size(), pnode->addr.ToString());
     }
+    // no real masternode found?...
+    if(!prealMasternode) {
+        // this should never be the case normally,
+        // only if someone is trying to game the system in some way or smth like that
+        LogPrintf("CMasternodeMan::ProcessVerifyReply -- ERROR: no real masternode found for addr %s\n", addr.ToString());
+        Misbehaving(nodeId, 20);
+        nPoSeRepliesFailed++;
+        return;
+    }
+    std::map<CNetAddr, std::pair<int64_t, CMasternodeVerification> >::iterator itAsked = mWeAskedForVerification.find(addr);
+    if(itAsked != mWeAskedForVerification.end()) {
+        nPoSeReplyMillisTotal += GetTIMECoinMillis() - itAsked->second.first;
+    }
+    nPoSeRepliesVerified++;
+    pListSnapshot.reset();
+    LogPrintf("CMasternodeMan::ProcessVerifyReply -- verified real masternode %s for addr %s\n",
+                prealMasternode->vin.prevout.ToStringShort(), addr.ToString());
+    // increase ban score for everyone else
+    BOOST_FOREACH(CMasternode* pmn, vpMasternodesToBan) {
+        pmn->IncreasePoSeBanScore();
+        LogPrint("masternode", "CMasternodeMan::ProcessVerifyReply -- increased PoSe ban score for %s addr %s, new score %d\n",
+                    prealMasternode->vin.prevout.ToStringShort(), addr.ToString(), pmn->nPoSeBanScore);
+    }
+    if(!vpMasternodesToBan.empty())
+        LogPrintf("CMasternodeMan::ProcessVerifyReply -- PoSe score increased for %d fake masternodes, addr %s\n",
+                    (int)vpMasternodesToBan.size(), addr.ToString());
 }
 
-void CMasternodeMan::ProcessVerifyBroadcast(CNode* pnode, const CMasternodeVerification& mnv)
+bool CMasternodeMan::QueueVerifyBroadcast(CNode* pnode, const CMasternodeVerification& mnv)
 {
-    std::string strError;
-
     if(mapSeenMasternodeVerification.find(mnv.GetHash()) != mapSeenMasternodeVerification.end()) {
         // we already have one
-        return;
+        return false;
     }
     mapSeenMasternodeVerification[mnv.GetHash()] = mnv;
 
@@ -1223,7 +1545,7 @@ void CMasternodeMan::ProcessVerifyBroadcast(CNode* pnode, const CMasternodeVerif
     if(mnv.nBlockHeight < nCachedBlockHeight - MAX_POSE_BLOCKS) {
         LogPrint("masternode", "CMasternodeMan::ProcessVerifyBroadcast -- Outdated: current block %d, verification block %d, peer=%d\n",
                     nCachedBlockHeight, mnv.nBlockHeight, pnode->id);
-        return;
+        return false;
     }
 
     if(mnv.vin1.prevout == mnv.vin2.prevout) {
@@ -1232,14 +1554,14 @@ void CMasternodeMan::ProcessVerifyBroadcast(CNode* pnode, const CMasternodeVerif
         // that was NOT a good idea to cheat and verify itself,
         // ban the node we received such message from
         Misbehaving(pnode->id, 100);
-        return;
+        return false;
     }
 
     uint256 blockHash;
     if(!GetBlockHash(blockHash, mnv.nBlockHeight)) {
         // this shouldn't happen...
         LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- Can't get block hash for unknown block height %d, peer=%d\n", mnv.nBlockHeight, pnode->id);
-        return;
+        return false;
     }
 
     int nRank;
@@ -1247,70 +1569,77 @@ void CMasternodeMan::ProcessVerifyBroadcast(CNode* pnode, const CMasternodeVerif
     if (!GetMasternodeRank(mnv.vin2.prevout, nRank, mnv.nBlockHeight, MIN_POSE_PROTO_VERSION)) {
         LogPrint("masternode", "CMasternodeMan::ProcessVerifyBroadcast -- Can't calculate rank for masternode %s\n",
                     mnv.vin2.prevout.ToStringShort());
-        return;
+        return false;
     }
 
     if(nRank > MAX_POSE_RANK) {
         LogPrint("masternode", "CMasternodeMan::ProcessVerifyBroadcast -- Masternode %s is not in top %d, current rank %d, peer=%d\n",
                     mnv.vin2.prevout.ToStringShort(), (int)MAX_POSE_RANK, nRank, pnode->id);
-        return;
+        return false;
     }
 
-    {
-        LOCK(cs);
+    std::string strMessage1 = strprintf("%s%d%s", mnv.addr.ToString(false), mnv.nonce, blockHash.ToString());
+    std::string strMessage2 = strprintf("%s%d%s%s%s", mnv.addr.ToString(false), mnv.nonce, blockHash.ToString(),
+                            mnv.vin1.prevout.ToStringShort(), mnv.vin2.prevout.ToStringShort());
+    mnSigVerifier.PushVerification(pnode->GetId(), mnv, strMessage1, strMessage2);
+    return true;
+}
 
-        std::string strMessage1 = strprintf("%s%d%s", mnv.addr.ToString(false), mnv.nonce, blockHash.ToString());
-        std::string strMessage2 = strprintf("%s%d%s%s%s", mnv.addr.ToString(false), mnv.nonce, blockHash.ToString(),
-                                mnv.vin1.prevout.ToStringShort(), mnv.vin2.prevout.ToStringShort());
+void CMasternodeMan::ProcessVerifyBroadcast(NodeId nodeId, const CMasternodeVerification& mnv, const CKeyID& keyIDSigner1, const CKeyID& keyIDSigner2)
+{
+    LOCK(cs);
 
-        CMasternode* pmn1 = Find(mnv.vin1.prevout);
-        if(!pmn1) {
-            LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- can't find masternode1 %s\n", mnv.vin1.prevout.ToStringShort());
-            return;
-        }
+    CMasternode* pmn1 = Find(mnv.vin1.prevout);
+    if(!pmn1) {
+        LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- can't find masternode1 %s\n", mnv.vin1.prevout.ToStringShort());
+        return;
+    }
 
-        CMasternode* pmn2 = Find(mnv.vin2.prevout);
-        if(!pmn2) {
-            LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- can't find masternode2 %s\n", mnv.vin2.prevout.ToStringShort());
-            return;
-        }
+    CMasternode* pmn2 = Find(mnv.vin2.prevout);
+    if(!pmn2) {
+        LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- can't find masternode2 %s\n", mnv.vin2.prevout.ToStringShort());
+        return;
+    }
 
-        if(pmn1->addr != mnv.addr) {
-            LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- addr %s does not match %s\n", mnv.addr.ToString(), pmn1->addr.ToString());
-            return;
-        }
+    if(pmn1->addr != mnv.addr) {
+        LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- addr %s does not match %s\n", mnv.addr.ToString(), pmn1->addr.ToString());
+        return;
+    }
 
-        if(!CMessageSigner::VerifyMessage(pmn1->pubKeyMasternode, mnv.vchSig1, strMessage1, strError)) {
-            LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- VerifyMessage() for masternode1 failed, error: %s\n", strError);
-            return;
-        }
+    if(keyIDSigner1.IsNull() || pmn1->pubKeyMasternode.GetID() != keyIDSigner1) {
+        LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- signature of masternode1 %s is invalid, peer=%d\n", mnv.vin1.prevout.ToStringShort(), nodeId);
+        return;
+    }
 
-        if(!CMessageSigner::VerifyMessage(pmn2->pubKeyMasternode, mnv.vchSig2, strMessage2, strError)) {
-            LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- VerifyMessage() for masternode2 failed, error: %s\n", strError);
-            return;
-        }
+    if(keyIDSigner2.IsNull() || pmn2->pubKeyMasternode.GetID() != keyIDSigner2) {
+        LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- signature of masternode2 %s is invalid, peer=%d\n", mnv.vin2.prevout.ToStringShort(), nodeId);
+        return;
+    }
 
-        if(!pmn1->IsPoSeVerified()) {
-            pmn1->DecreasePoSeBanScore();
-        }
-        mnv.Relay();
+    if(!pmn1->IsPoSeVerified()) {
+        pmn1->DecreasePoSeBanScore();
+    }
+    nPoSeBroadcastsVerified++;
+    pListSnapshot.reset();
+    mnv.Relay();
 
-        LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- verified masternode %s for addr %s\n",
-                    pmn1->vin.prevout.ToStringShort(), pmn1->addr.ToString());
+    LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- verified masternode %s for addr %s\n",
+                pmn1->vin.prevout.ToStringShort(), pmn1->addr.ToString());
 
-        // increase ban score for everyone else with the same addr
-        int nCount = 0;
-        for (auto& mnpair : mapMasternodes) {
-            if(mnpair.second.addr != mnv.addr || mnpair.first == mnv.vin1.prevout) continue;
-            mnpair.second.IncreasePoSeBanScore();
-            nCount++;
-            LogPrint("masternode", "CMasternodeMan::ProcessVerifyBroadcast -- increased PoSe ban score for %s addr %s, new score %d\n",
-                        mnpair.first.ToStringShort(), mnpair.second.addr.ToString(), mnpair.second.nPoSeBanScore);
-        }
-        if(nCount)
-            LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- PoSe score increased for %d fake masternodes, addr %s\n",
-                        nCount, pmn1->addr.ToString());
+    // increase ban score for everyone else with the same addr
+    // (pmn1 has that addr, so the index has an entry for it)
+    int nCount = 0;
+    for (const auto& outpoint : mapIndexAddr[mnv.addr]) {
+        if(outpoint == mnv.vin1.prevout) continue;
+        CMasternode* pmn = Find(outpoint);
+        pmn->IncreasePoSeBanScore();
+        nCount++;
+        LogPrint("masternode", "CMasternodeMan::ProcessVerifyBroadcast -- increased PoSe ban score for %s addr %s, new score %d\n",
+                    outpoint.ToStringShort(), pmn->addr.ToString(), pmn->nPoSeBanScore);
     }
+    if(nCount)
+        LogPrintf("CMasternodeMan::ProcessVerifyBroadcast -- PoSe score increased for %d fake masternodes, addr %s\n",
+                    nCount, pmn1->addr.ToString());
 }
 
 std::string CMasternodeMan::ToString() const
@@ -1321,6 +1650,12 @@ std::string CMasternodeMan::ToString() const
             ", peers who asked us for Masternode list: " << (int)mAskedUsForMasternodeList.size() <<
             ", peers we asked for Masternode list: " << (int)mWeAskedForMasternodeList.size() <<
             ", entries in Masternode list we asked for: " << (int)mWeAskedForMasternodeListEntry.size() <<
+            ", list version: " << hashListEpoch.ToString() << ":" << nListSeq <<
+            ", PoSe requests sent: " << nPoSeRequestsSent <<
+            ", replies verified: " << nPoSeRepliesVerified <<
+            " (avg " << (nPoSeRepliesVerified ? nPoSeReplyMillisTotal / nPoSeRepliesVerified : 0) << "ms)" <<
+            ", replies failed: " << nPoSeRepliesFailed <<
+            ", broadcasts verified: " << nPoSeBroadcastsVerified <<
             ", nDsqCount: " << (int)nDsqCount;
 
     return info.str();
@@ -1341,13 +1676,278 @@ void CMasternodeMan::UpdateMasternodeList(CMasternodeBroadcast mnb, CConnman& co
         }
     } else {
         CMasternodeBroadcast mnbOld = mapSeenMasternodeBroadcast[CMasternodeBroadcast(*pmn).GetHash()].second;
-        if(pmn->UpdateFromNewBroadcast(mnb, connman)) {
+        // the new broadcast can change the keys and the address the MN is indexed by
+        UnindexMasternode(*pmn);
+        bool fUpdated = pmn->UpdateFromNewBroadcast(mnb, connman);
+        IndexMasternode(*pmn);
+        if(fUpdated) {
+            pListSnapshot.reset();
+            ListChanged(mnb.vin.prevout, true);
             masternodeSync.BumpAssetLastTIMECoin("CMasternodeMan::UpdateMasternodeList - seen");
             mapSeenMasternodeBroadcast.erase(mnbOld.GetHash());
         }
     }
 }
 
+bool CMasternodeMan::QueueBroadcast(CNode* pfrom, const CMasternodeBroadcast& mnb)
+{
+    bool fSeen;
+    {
+        LOCK(cs);
+        fSeen = mapSeenMasternodeBroadcast.count(mnb.GetHash()) && !mnb.fRecovery;
+    }
+
+    // the signature is verified on the verifier threads, the rest in ProcessVerifiedMessages
+    return mnSigVerifier.PushBroadcast(pfrom->GetId(), mnb, !fSeen) && !fSeen;
+}
+
+bool CMasternodeMan::QueuePing(CNode* pfrom, const CMasternodePing& mnp)
+{
+    CPubKey pubKeyMasternode;
+    {
+        LOCK(cs);
+        if(mapSeenMasternodePing.count(mnp.GetHash())) return false;
+        CMasternode* pmn = Find(mnp.vin.prevout);
+        if(pmn) {
+            pubKeyMasternode = pmn->pubKeyMasternode;
+        }
+    }
+
+    return mnSigVerifier.PushPing(pfrom->GetId(), mnp, pubKeyMasternode);
+}
+
+void CMasternodeMan::ProcessVerifiedMessages(CConnman& connman)
+{
+    // one thread at a time, so the messages are processed in the order they arrived in
+    TRY_LOCK(csProcessVerified, lockProcessVerified);
+    if(!lockProcessVerified) return;
+
+    std::vector<CMasternodeSigVerifier::CMessage> vecMessages;
+    mnSigVerifier.PopVerified(vecMessages);
+
+    for (auto& message : vecMessages) {
+        CNode* pfrom = NULL;
+        connman.ForNode(message.nodeId, [&pfrom](CNode* pnode){
+            pfrom = pnode->AddRef();
+            return true;
+        });
+
+        if(message.fVerification) {
+            // verified right here if the verifier threads are gone already
+            if(!message.fSignersRecovered) {
+                CMasternodeSigVerifier::Verify(message);
+            }
+            if(message.mnv.vchSig2.empty()) {
+                ProcessVerifyReply(message.nodeId, message.mnv, message.keyIDSigner1);
+            } else {
+                ProcessVerifyBroadcast(message.nodeId, message.mnv, message.keyIDSigner1, message.keyIDSigner2);
+            }
+        } else if(message.fPing) {
+            ProcessPing(pfrom, message.nodeId, message.mnp, connman);
+        } else {
+            ProcessBroadcast(pfrom, message.nodeId, message.mnb, connman);
+        }
+
+        if(pfrom) {
+            pfrom->Release();
+        }
+    }
+
+    if(fMasternodesAdded) {
+        NotifyMasternodeUpdates(connman);
+    }
+}
+
+void CMasternodeMan::ProcessBroadcast(CNode* pfrom, NodeId nodeId, const CMasternodeBroadcast& mnb, CConnman& connman)
+{
+    int nDos = 0;
+
+    if (CheckMnbAndUpdateMasternodeList(pfrom, mnb, nDos, connman)) {
+        // use announced Masternode as a peer
+        if(pfrom) {
+            connman.AddNewAddress(CAddress(mnb.addr, NODE_NETWORK), pfrom->addr, 2*60*60);
+        }
+    } else if(nDos > 0) {
+        Misbehaving(nodeId, nDos);
+    }
+}
+
+void CMasternodeMan::ProcessPing(CNode* pfrom, NodeId nodeId, CMasternodePing& mnp, CConnman& connman)
+{
+    uint256 nHash = mnp.GetHash();
+
+    // Need LOCK2 here to ensure consistent locking order because the CheckAndUpdate call below locks cs_main
+    LOCK2(cs_main, cs);
+
+    if(mapSeenMasternodePing.count(nHash)) return; //seen
+    mapSeenMasternodePing.insert(std::make_pair(nHash, mnp));
+
+    LogPrint("masternode", "MNPING -- Masternode ping, masternode=%s new\n", mnp.vin.prevout.ToStringShort());
+
+    // see if we have this Masternode
+    CMasternode* pmn = Find(mnp.vin.prevout);
+
+    // if masternode uses sentinel ping instead of watchdog
+    // we shoud update nTIMECoinLastWatchdogVote here if sentinel
+    // ping flag is actual
+    if(pmn && mnp.fSentinelIsCurrent)
+        UpdateWatchdogVoteTIMECoin(mnp.vin.prevout, mnp.sigTIMECoin);
+
+    // too late, new MNANNOUNCE is required
+    if(pmn && pmn->IsNewStartRequired()) return;
+
+    int nDos = 0;
+    uint256 hashPingOld = pmn ? pmn->lastPing.GetHash() : uint256();
+    bool fUpdated = mnp.CheckAndUpdate(pmn, false, nDos, connman);
+    if(pmn) {
+        pListSnapshot.reset();
+        // the ping is taken even if the MN turns out not to be enabled
+        if(pmn->lastPing.GetHash() != hashPingOld) {
+            ListChanged(mnp.vin.prevout, false);
+        }
+    }
+    if(fUpdated) return;
+
+    if(nDos > 0) {
+        // if anything significant failed, mark that node
+        Misbehaving(nodeId, nDos);
+    } else if(pmn != NULL) {
+        // nothing significant failed, mn is a known one too
+        return;
+    }
+
+    // something significant is broken or mn is unknown,
+    // we might have to ask for a masternode entry once
+    AskForMN(pfrom, mnp.vin.prevout, connman);
+}
+
+CMasternodeListVersion CMasternodeMan::GetListVersion()
+{
+    LOCK(cs);
+    if(hashListEpoch.IsNull()) {
+        hashListEpoch = GetRandHash();
+    }
+    return CMasternodeListVersion(hashListEpoch, nListSeq);
+}
+
+void CMasternodeMan::ListChanged(const COutPoint& outpoint, bool fBroadcast)
+{
+    LOCK(cs);
+    std::pair<int64_t, int64_t>& changes = mapListChanges[outpoint];
+    ++nListSeq;
+    if(fBroadcast) {
+        changes.first = nListSeq;
+    }
+    changes.second = nListSeq;
+}
+
+void CMasternodeMan::ListRemoved(const COutPoint& outpoint)
+{
+    LOCK(cs);
+    mapListChanges.erase(outpoint);
+    mapListRemoved[++nListSeq] = outpoint;
+    if(mapListRemoved.size() > MNLISTDIFF_MAX_REMOVED) {
+        // a diff from before the removal we forget would miss it
+        nListSeqMinDiff = mapListRemoved.begin()->first;
+        mapListRemoved.erase(mapListRemoved.begin());
+    }
+}
+
+bool CMasternodeMan::GetListDiff(const CMasternodeListVersion& versionFrom, CMasternodeListDiff& diffRet)
+{
+    LOCK(cs);
+
+    if(versionFrom.IsNull() || versionFrom.nSeq < nListSeqMinDiff) return false;
+    bool fKnown = (versionFrom.hashEpoch == hashListEpoch && versionFrom.nSeq <= nListSeq) ||
+                  (versionFrom.hashEpoch == hashListEpochLoaded && versionFrom.nSeq <= nListSeqLoaded);
+    if(!fKnown) return false;
+
+    diffRet = CMasternodeListDiff();
+    diffRet.versionFrom = versionFrom;
+
+    for (const auto& changepair : mapListChanges) {
+        // a new mnb comes with a new mnp, so the mnp sequence number is the latest
+        if(changepair.second.second <= versionFrom.nSeq) continue;
+        CMasternode* pmn = Find(changepair.first);
+        if(!pmn) continue;
+        // same masternodes as dseg sends
+        if(pmn->addr.IsRFC1918() || pmn->addr.IsLocal() || pmn->IsUpdateRequired()) continue;
+
+        if((int)diffRet.vecMnb.size() >= MNLISTDIFF_MAX_ENTRIES || (int)diffRet.vecMnp.size() >= MNLISTDIFF_MAX_ENTRIES) return false;
+        if(changepair.second.first > versionFrom.nSeq) {
+            diffRet.vecMnb.push_back(CMasternodeBroadcast(*pmn));
+        }
+        // also for a new mnb, in case the peer has seen it with an older ping
+        if(pmn->lastPing != CMasternodePing()) {
+            diffRet.vecMnp.push_back(pmn->lastPing);
+        }
+    }
+
+    for (auto it = mapListRemoved.upper_bound(versionFrom.nSeq); it != mapListRemoved.end(); ++it) {
+        diffRet.vecRemoved.push_back(it->second);
+    }
+
+    diffRet.versionTo = GetListVersion();
+    return true;
+}
+
+void CMasternodeMan::ProcessListDiff(CNode* pfrom, const CMasternodeListDiff& diff, CConnman& connman)
+{
+    {
+        LOCK(cs);
+        std::map<CNetAddr, std::pair<int64_t, CMasternodeListVersion> >::iterator it = mWeAskedForListDiff.find(pfrom->addr);
+        if(it == mWeAskedForListDiff.end() ||
+                it->second.second.hashEpoch != diff.versionFrom.hashEpoch || it->second.second.nSeq != diff.versionFrom.nSeq) {
+            LogPrint("masternode", "MNLISTDIFF -- we didn't ask for this diff, peer=%d\n", pfrom->id);
+            return;
+        }
+        mWeAskedForListDiff.erase(it);
+        if(diff.versionTo.IsNull()) {
+            mapPeerListVersions.erase(pfrom->addr);
+        }
+    }
+
+    if(diff.versionTo.IsNull()) {
+        // the peer can't tell what changed since we synced from it, get the whole list instead
+        LogPrintf("MNLISTDIFF -- no diff since %s, asking peer %d for the list\n", diff.versionFrom.ToString(), pfrom->id);
+        if(!diff.versionFrom.IsNull()) {
+            DsegUpdate(pfrom, connman);
+        }
+        return;
+    }
+
+    for (const auto& mnb : diff.vecMnb) {
+        QueueBroadcast(pfrom, mnb);
+    }
+    for (const auto& mnp : diff.vecMnp) {
+        QueuePing(pfrom, mnp);
+    }
+    ProcessVerifiedMessages(connman);
+
+    {
+        // Need LOCK2 here to ensure consistent locking order because the Check call below locks cs_main
+        LOCK2(cs_main, cs);
+        // anyone can claim a MN was removed, so only look at its collateral ourselves,
+        // CheckAndRemove drops it once it is found spent
+        for (const auto& outpoint : diff.vecRemoved) {
+            CMasternode* pmn = Find(outpoint);
+            if(pmn) {
+                pmn->Check(true);
+                pListSnapshot.reset();
+            }
+        }
+        mapPeerListVersions[pfrom->addr] = diff.versionTo;
+    }
+
+    masternodeSync.BumpAssetLastTIMECoin("CMasternodeMan::ProcessListDiff");
+    if(!diff.versionFrom.IsNull()) {
+        // the diff is the whole reply, after dseg the peer sends SYNCSTATUSCOUNT instead
+        masternodeSync.ReceivedAssetFrom(pfrom->id, MASTERNODE_SYNC_LIST);
+    }
+    LogPrintf("MNLISTDIFF -- got %d mnb, %d mnp and %d removals since %s from peer %d\n",
+            diff.vecMnb.size(), diff.vecMnp.size(), diff.vecRemoved.size(), diff.versionFrom.ToString(), pfrom->id);
+}
+
 bool CMasternodeMan::CheckMnbAndUpdateMasternodeList(CNode* pfrom, CMasternodeBroadcast mnb, int& nDos, CConnman& connman)
 {
     // Need to lock cs_main here to ensure consistent locking order because the SimpleCheck call below locks cs_main
@@ -1403,10 +2003,16 @@ bool CMasternodeMan::CheckMnbAndUpdateMasternodeList(CNode* pfrom, CMasternodeBr
         CMasternode* pmn = Find(mnb.vin.prevout);
         if(pmn) {
             CMasternodeBroadcast mnbOld = mapSeenMasternodeBroadcast[CMasternodeBroadcast(*pmn).GetHash()].second;
-            if(!mnb.Update(pmn, nDos, connman)) {
+            // the update can change the keys and the address the MN is indexed by
+            UnindexMasternode(*pmn);
+            bool fUpdated = mnb.Update(pmn, nDos, connman);
+            IndexMasternode(*pmn);
+            pListSnapshot.reset();
+            if(!fUpdated) {
                 LogPrint("masternode", "CMasternodeMan::CheckMnbAndUpdateMasternodeList -- Update() failed, masternode=%s\n", mnb.vin.prevout.ToStringShort());
                 return false;
             }
+            ListChanged(mnb.vin.prevout, true);
             if(hash != mnbOld.GetHash()) {
                 mapSeenMasternodeBroadcast.erase(mnbOld.GetHash());
             }
@@ -1443,23 +2049,28 @@ bool CMasternodeMan::CheckMnbAndUpdateMasternodeList(CNode* pfrom, CMasternodeBr
 
 void CMasternodeMan::UpdateLastPaid(const CBlockIndex* pindex)
 {
-    LOCK(cs);
+    // the index only counts payments to payees with enough votes, which are
+    // not there before the winners list is synced
+    if(fLiteMode || !pindex || !masternodeSync.IsWinnersListSynced()) return;
 
-    if(fLiteMode || !masternodeSync.IsWinnersListSynced() || mapMasternodes.empty()) return;
+    // cheap once built, the index then follows ConnectTip/DisconnectTip;
+    // must be called without cs held, it takes cs_main
+    if(!mnLastPaidIndex.Initialize(mnpayments.GetStorageLimit())) return;
 
-    static bool IsFirstRun = true;
-    // Do full scan on first run or if we are not a masternode
-    // (MNs should update this info on every block, so limited scan should be enough for them)
-    int nMaxBlocksToScanBack = (IsFirstRun || !fMasterNode) ? mnpayments.GetStorageLimit() : LAST_PAID_SCAN_BLOCKS;
-
-    // LogPrint("mnpayments", "CMasternodeMan::UpdateLastPaid -- nHeight=%d, nMaxBlocksToScanBack=%d, IsFirstRun=%s\n",
-    //                         nCachedBlockHeight, nMaxBlocksToScanBack, IsFirstRun ? "true" : "false");
+    LOCK(cs);
 
     for (auto& mnpair: mapMasternodes) {
-        mnpair.second.UpdateLastPaid(pindex, nMaxBlocksToScanBack);
+        int nBlockLastPaidOld = mnpair.second.nBlockLastPaid;
+        mnpair.second.UpdateLastPaid();
+        if(mnpair.second.nBlockLastPaid != nBlockLastPaidOld) {
+            pListSnapshot.reset();
+        }
+        if(mnpair.second.nBlockLastPaid != nBlockLastPaidOld && !fPaymentQueueDirty) {
+            // move it to its new place in the payment queue
+            setPaymentQueue.erase(std::make_pair(nBlockLastPaidOld, &mnpair.second));
+            setPaymentQueue.insert(std::make_pair(mnpair.second.nBlockLastPaid, &mnpair.second));
+        }
     }
-
-    IsFirstRun = false;
 }
 
 void CMasternodeMan::UpdateWatchdogVoteTIMECoin(const COutPoint& outpoint, uint64_t nVoteTIMECoin)
@@ -1470,6 +2081,7 @@ void CMasternodeMan::UpdateWatchdogVoteTIMECoin(const COutPoint& outpoint, uint6
         return;
     }
     pmn->UpdateWatchdogVoteTIMECoin(nVoteTIMECoin);
+    pListSnapshot.reset();
     nLastWatchdogVoteTIMECoin = GetTIMECoin();
 }
 
@@ -1502,12 +2114,12 @@ void CMasternodeMan::RemoveGovernanceObject(uint256 nGovernanceObjectHash)
 void CMasternodeMan::CheckMasternode(const CPubKey& pubKeyMasternode, bool fForce)
 {
     LOCK(cs);
-    for (auto& mnpair : mapMasternodes) {
-        if (mnpair.second.pubKeyMasternode == pubKeyMasternode) {
-            mnpair.second.Check(fForce);
-            return;
-        }
+    auto it = mapIndexPubKeyMasternode.find(pubKeyMasternode);
+    if (it == mapIndexPubKeyMasternode.end()) {
+        return;
     }
+    Find(*it->second.begin())->Check(fForce);
+    pListSnapshot.reset();
 }
 
 bool CMasternodeMan::IsMasternodePingedWithin(const COutPoint& outpoint, int nSeconds, int64_t nTIMECoinToCheckAt)
@@ -1525,6 +2137,8 @@ void CMasternodeMan::SetMasternodeLastPing(const COutPoint& outpoint, const CMas
         return;
     }
     pmn->lastPing = mnp;
+    pListSnapshot.reset();
+    ListChanged(outpoint, false);
     // if masternode uses sentinel ping instead of watchdog
     // we shoud update nTIMECoinLastWatchdogVote here if sentinel
     // ping flag is actual
@@ -1545,11 +2159,33 @@ void CMasternodeMan::UpdatedBlockTip(const CBlockIndex *pindex)
     nCachedBlockHeight = pindex->nHeight;
     LogPrint("masternode", "CMasternodeMan::UpdatedBlockTip -- nCachedBlockHeight=%d\n", nCachedBlockHeight);
 
+    {
+        LOCK(cs);
+        // collateral heights stay valid as long as blocks are only added on top
+        if(!pindex->pprev || pindex->pprev->GetBlockHash() != hashCollateralHeightsTip) {
+            ResetCollateralHeights();
+        }
+        hashCollateralHeightsTip = pindex->GetBlockHash();
+    }
+
     CheckSameAddr();
 
-    if(fMasterNode) {
-        // normal wallet does not need to update this every block, doing update on rpc call should be enough
-        UpdateLastPaid(pindex);
+    UpdateLastPaid(pindex);
+}
+
+void CMasternodeMan::BlockConnected(const CBlock& block)
+{
+    LOCK(cs);
+    if(mapCollateralHeights.empty()) return;
+
+    // look spent collaterals up again: they stay pending, and out of the payment
+    // queue, until the masternode is removed or a reorganization brings them back
+    BOOST_FOREACH(const CTransaction& tx, block.vtx) {
+        BOOST_FOREACH(const CTxIn& txin, tx.vin) {
+            if(mapCollateralHeights.erase(txin.prevout)) {
+                setCollateralHeightsPending.insert(txin.prevout);
+            }
+        }
     }
 }
 
@@ -5,9 +5,14 @@
 #ifndef MASTERNODEMAN_H
 #define MASTERNODEMAN_H
 
+#include "coins.h"
 #include "masternode.h"
+#include "pooledmap.h"
+#include "random.h"
 #include "sync.h"
 
+#include <memory>
+
 using namespace std;
 
 class CMasternodeMan;
@@ -15,6 +20,69 @@ class CConnman;
 
 extern CMasternodeMan mnodeman;
 
+struct CompareLastPaidBlock
+{
+    bool operator()(const std::pair<int, CMasternode*>& t1,
+                    const std::pair<int, CMasternode*>& t2) const
+    {
+        return (t1.first != t2.first) ? (t1.first < t2.first) : (t1.second->vin < t2.second->vin);
+    }
+};
+
+/**
+ * A version of a peer's masternode list: the number of changes made to it
+ * since the epoch began, which it does anew whenever the list is cleared or loaded.
+ */
+class CMasternodeListVersion
+{
+public:
+    uint256 hashEpoch;
+    int64_t nSeq;
+
+    CMasternodeListVersion() : hashEpoch(), nSeq(0) {}
+    CMasternodeListVersion(const uint256& hashEpochIn, int64_t nSeqIn) : hashEpoch(hashEpochIn), nSeq(nSeqIn) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion) {
+        READWRITE(hashEpoch);
+        READWRITE(nSeq);
+    }
+
+    bool IsNull() const { return hashEpoch.IsNull(); }
+    std::string ToString() const { return strprintf("%s:%d", hashEpoch.ToString(), nSeq); }
+};
+
+/**
+ * The masternodes that changed in a peer's list since versionFrom (mnlistdiff).
+ * versionTo is null when the peer can't tell what changed since versionFrom,
+ * the whole list has to be synced from it with dseg then.
+ */
+class CMasternodeListDiff
+{
+public:
+    CMasternodeListVersion versionFrom;
+    CMasternodeListVersion versionTo;
+    // new and re-announced masternodes
+    std::vector<CMasternodeBroadcast> vecMnb;
+    // the last ping of every masternode in the diff
+    std::vector<CMasternodePing> vecMnp;
+    // masternodes removed from the list as their collateral was spent
+    std::vector<COutPoint> vecRemoved;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion) {
+        READWRITE(versionFrom);
+        READWRITE(versionTo);
+        READWRITE(vecMnb);
+        READWRITE(vecMnp);
+        READWRITE(vecRemoved);
+    }
+};
+
 class CMasternodeMan
 {
 public:
@@ -22,14 +90,14 @@ public:
     typedef std::vector<score_pair_t> score_pair_vec_t;
     typedef std::pair<int, CMasternode> rank_pair_t;
     typedef std::vector<rank_pair_t> rank_pair_vec_t;
+    /// A copy of the masternode list, ordered by collateral outpoint, that readers share until the list changes
+    typedef std::shared_ptr<const std::map<COutPoint, CMasternode> > snapshot_t;
 
 private:
     static const std::string SERIALIZATION_VERSION_STRING;
 
     static const int DSEG_UPDATE_SECONDS        = 3 * 60 * 60;
 
-    static const int LAST_PAID_SCAN_BLOCKS      = 100;
-
     static const int MIN_POSE_PROTO_VERSION     = 70203;
     static const int MAX_POSE_CONNECTIONS       = 10;
     static const int MAX_POSE_RANK              = 10;
@@ -41,6 +109,16 @@ private:
     static const int MNB_RECOVERY_WAIT_SECONDS      = 60;
     static const int MNB_RECOVERY_RETRY_SECONDS     = 3 * 60 * 60;
 
+    static const int MAX_CHECK_THREADS              = 4;
+    static const int MIN_CHECKS_PER_THREAD          = 500;
+
+    // a diff with more masternodes than this is not sent, the list is synced with dseg instead
+    static const int MNLISTDIFF_MAX_ENTRIES         = 2000;
+    // removals remembered for diffs, diffs from before the oldest of them can't be made
+    static const int MNLISTDIFF_MAX_REMOVED         = 1000;
+    // a peer that doesn't answer getmnlistd in time is synced from with dseg next time
+    static const int MNLISTDIFF_WAIT_SECONDS        = 60;
+
 
     // critical section to protect the inner data structures
     mutable CCriticalSection cs;
@@ -48,16 +126,50 @@ private:
     // Keep track of current block height
     int nCachedBlockHeight;
 
-    // map to hold all MNs
-    std::map<COutPoint, CMasternode> mapMasternodes;
+    // map to hold all MNs, by collateral outpoint. Entries never move, so the
+    // CMasternode pointers handed around below stay valid until the MN is removed.
+    pooledmap<COutPoint, CMasternode, SaltedOutpointHasher> mapMasternodes;
+    // the MNs by pubKeyMasternode, payee script and address, several MNs can share each of them
+    std::map<CPubKey, std::set<COutPoint> > mapIndexPubKeyMasternode;
+    std::map<CScript, std::set<COutPoint> > mapIndexPayee;
+    std::map<CService, std::set<COutPoint> > mapIndexAddr;
+    // the list as last handed out by GetListSnapshot, reset whenever a MN changes
+    snapshot_t pListSnapshot;
     // who's asked for the Masternode list and the last time
     std::map<CNetAddr, int64_t> mAskedUsForMasternodeList;
     // who we asked for the Masternode list and the last time
     std::map<CNetAddr, int64_t> mWeAskedForMasternodeList;
     // which Masternodes we've asked for
     std::map<COutPoint, std::map<CNetAddr, int64_t> > mWeAskedForMasternodeListEntry;
-    // who we asked for the masternode verification
-    std::map<CNetAddr, CMasternodeVerification> mWeAskedForVerification;
+    // who we asked for the masternode verification, when (in milliseconds) and with which request
+    std::map<CNetAddr, std::pair<int64_t, CMasternodeVerification> > mWeAskedForVerification;
+    // PoSe verification counters: our requests, the replies that verified a masternode or none
+    // and their total round trip, and the broadcasts of other masternodes we accepted
+    int64_t nPoSeRequestsSent;
+    int64_t nPoSeRepliesVerified;
+    int64_t nPoSeRepliesFailed;
+    int64_t nPoSeReplyMillisTotal;
+    int64_t nPoSeBroadcastsVerified;
+
+    // the version of our list: every new mnb, new mnp and removal takes the next sequence number
+    uint256 hashListEpoch;
+    int64_t nListSeq;
+    // the version of the list we loaded, diffs from that epoch are made up to where it ended
+    uint256 hashListEpochLoaded;
+    int64_t nListSeqLoaded;
+    // diffs can only be made from this sequence number on, older removals are forgotten
+    int64_t nListSeqMinDiff;
+    // the sequence numbers of the last new mnb and the last new mnp of each MN
+    std::map<COutPoint, std::pair<int64_t, int64_t> > mapListChanges;
+    // removed MNs by the sequence number of their removal
+    std::map<int64_t, COutPoint> mapListRemoved;
+    // the version of each peer's list we synced to last
+    std::map<CNetAddr, CMasternodeListVersion> mapPeerListVersions;
+    // who we asked for a diff, until when we wait for it and since which version
+    std::map<CNetAddr, std::pair<int64_t, CMasternodeListVersion> > mWeAskedForListDiff;
+    // who's asked us for a diff and who we asked for one, and when they may ask or be asked again
+    std::map<CNetAddr, int64_t> mAskedUsForListDiff;
+    std::map<CNetAddr, int64_t> mWeAskedForListDiffAgain;
 
     // these maps are used for masternode recovery from MASTERNODE_NEW_START_REQUIRED state
     std::map<uint256, std::pair< int64_t, std::set<CNetAddr> > > mMnbRecoveryRequests;
@@ -74,12 +186,55 @@ private:
 
     int64_t nLastWatchdogVoteTIMECoin;
 
+    // held while processing the messages mnSigVerifier has verified
+    CCriticalSection csProcessVerified;
+
+    // all masternodes ordered by the block they were last paid in, the order
+    // GetNextMasternodeInQueueForPayment considers them for payment in
+    std::set<std::pair<int, CMasternode*>, CompareLastPaidBlock> setPaymentQueue;
+    bool fPaymentQueueDirty;
+    // the height of each masternode's unspent collateral, as long as the chain only grows from hashCollateralHeightsTip
+    std::map<COutPoint, int> mapCollateralHeights;
+    // masternodes whose collateral height has to be looked up
+    std::set<COutPoint> setCollateralHeightsPending;
+    uint256 hashCollateralHeightsTip;
+
     friend class CMasternodeSync;
     /// Find an entry
     CMasternode* Find(const COutPoint& outpoint);
 
+    void IndexMasternode(const CMasternode& mn);
+    void UnindexMasternode(const CMasternode& mn);
+    void RebuildIndexes();
+    /// Masternodes ordered by address, those sharing one by outpoint
+    std::vector<CMasternode*> GetSortedByAddr();
+
+    void RebuildPaymentQueue();
+    void ResetCollateralHeights();
+    /// Walk the payment queue, counting the masternodes that qualify for payment and scoring the oldest tenth of them
+    void SelectFromPaymentQueue(int nBlockHeight, int nTipHeight, int nMnCount, const uint256& blockHash, bool fFilterSigTIMECoin,
+                                int& nCountRet, CMasternode*& pmnBestRet);
+
     bool GetMasternodeScores(const uint256& nBlockHash, score_pair_vec_t& vecMasternodeScoresRet, int nMinProtocol = 0);
 
+    /// Queue an mnb or mnp received from pfrom for mnSigVerifier, false if it is one we've seen already or it was dropped
+    bool QueueBroadcast(CNode* pfrom, const CMasternodeBroadcast& mnb);
+    bool QueuePing(CNode* pfrom, const CMasternodePing& mnp);
+    void ProcessBroadcast(CNode* pfrom, NodeId nodeId, const CMasternodeBroadcast& mnb, CConnman& connman);
+    void ProcessPing(CNode* pfrom, NodeId nodeId, CMasternodePing& mnp, CConnman& connman);
+
+    CMasternodeListVersion GetListVersion();
+    /// Record that a MN got a new mnb (fBroadcast) or a new mnp, for the diffs
+    void ListChanged(const COutPoint& outpoint, bool fBroadcast);
+    void ListRemoved(const COutPoint& outpoint);
+    /// The changes since versionFrom, false if they aren't known or too many for one diff
+    bool GetListDiff(const CMasternodeListVersion& versionFrom, CMasternodeListDiff& diffRet);
+    void ProcessListDiff(CNode* pfrom, const CMasternodeListDiff& diff, CConnman& connman);
+
+    /// Check an mnv reply or broadcast up to its signatures and queue it for mnSigVerifier, false if it was dropped
+    bool QueueVerifyReply(CNode* pnode, CMasternodeVerification& mnv);
+    bool QueueVerifyBroadcast(CNode* pnode, const CMasternodeVerification& mnv);
+
 public:
     // Keep track of all broadcasts I've seen
     std::map<uint256, std::pair<int64_t, CMasternodeBroadcast> > mapSeenMasternodeBroadcast;
@@ -105,7 +260,25 @@ public:
             READWRITE(strVersion);
         }
 
-        READWRITE(mapMasternodes);
+        if(ser_action.ForRead()) {
+            std::map<COutPoint, CMasternode> mapRead;
+            READWRITE(mapRead);
+            mapMasternodes.clear();
+            mapMasternodes.reserve(mapRead.size());
+            for (const auto& mnpair : mapRead) {
+                // operator= rather than the copy constructor, to keep mapGovernanceObjectsVotedOn
+                CMasternode& mn = mapMasternodes[mnpair.first];
+                mn = mnpair.second;
+                mn.UpdateScoreMidstate();
+            }
+        } else {
+            // same format as a std::map, in whichever order the entries are stored
+            WriteCompactSize(s, mapMasternodes.size());
+            for (const auto& mnpair : mapMasternodes) {
+                ::Serialize(s, mnpair.first, nType, nVersion);
+                ::Serialize(s, mnpair.second, nType, nVersion);
+            }
+        }
         READWRITE(mAskedUsForMasternodeList);
         READWRITE(mWeAskedForMasternodeList);
         READWRITE(mWeAskedForMasternodeListEntry);
@@ -116,9 +289,30 @@ public:
 
         READWRITE(mapSeenMasternodeBroadcast);
         READWRITE(mapSeenMasternodePing);
+        READWRITE(hashListEpoch);
+        READWRITE(nListSeq);
+        READWRITE(nListSeqMinDiff);
+        READWRITE(mapListChanges);
+        READWRITE(mapListRemoved);
+        READWRITE(mapPeerListVersions);
+        READWRITE(mAskedUsForListDiff);
+        READWRITE(mWeAskedForListDiffAgain);
         if(ser_action.ForRead() && (strVersion != SERIALIZATION_VERSION_STRING)) {
             Clear();
         }
+        if(ser_action.ForRead()) {
+            // changes made after the list was saved are lost if we crashed since, so peers
+            // that synced to the saved epoch get diffs up to where it was saved only
+            hashListEpochLoaded = hashListEpoch;
+            nListSeqLoaded = nListSeq;
+            hashListEpoch = GetRandHash();
+            // the queue points into the list just replaced, the indexes and the snapshot describe it
+            RebuildIndexes();
+            pListSnapshot.reset();
+            setPaymentQueue.clear();
+            fPaymentQueueDirty = true;
+            ResetCollateralHeights();
+        }
     }
 
     CMasternodeMan();
@@ -155,7 +349,8 @@ public:
     /// Count Masternodes by network type - NET_IPV4, NET_IPV6, NET_TOR
     // int CountByIP(int nNetworkType);
 
-    void DsegUpdate(CNode* pnode, CConnman& connman);
+    /// Ask pnode for the list, or the changes to it since we synced from it. False if we asked it for the list too recently.
+    bool DsegUpdate(CNode* pnode, CConnman& connman);
 
     /// Versions of Find that are safe to use from outside the class
     bool Get(const COutPoint& outpoint, CMasternode& masternodeRet);
@@ -173,7 +368,8 @@ public:
     /// Find a random entry
     masternode_info_t FindRandomNotInVec(const std::vector<COutPoint> &vecToExclude, int nProtocolVersion = -1);
 
-    std::map<COutPoint, CMasternode> GetFullMasternodeMap() { return mapMasternodes; }
+    /// The whole list, copied only if it changed since the last call. Masternodes in it carry no mapGovernanceObjectsVotedOn.
+    snapshot_t GetListSnapshot();
 
     bool GetMasternodeRanks(rank_pair_vec_t& vecMasternodeRanksRet, int nBlockHeight = -1, int nMinProtocol = 0);
     bool GetMasternodeRank(const COutPoint &outpoint, int& nRankRet, int nBlockHeight = -1, int nMinProtocol = 0);
@@ -182,13 +378,17 @@ public:
     std::pair<CService, std::set<uint256> > PopScheduledMnbRequestConnection();
 
     void ProcessMessage(CNode* pfrom, std::string& strCommand, CDataStream& vRecv, CConnman& connman);
+    /// Process the mnb, mnp and mnv messages whose signatures mnSigVerifier has verified, in the order they arrived in
+    void ProcessVerifiedMessages(CConnman& connman);
 
     void DoFullVerificationStep(CConnman& connman);
     void CheckSameAddr();
-    bool SendVerifyRequest(const CAddress& addr, const std::vector<CMasternode*>& vSortedByAddr, CConnman& connman);
+    bool SendVerifyRequest(const CAddress& addr, CConnman& connman);
     void SendVerifyReply(CNode* pnode, CMasternodeVerification& mnv, CConnman& connman);
-    void ProcessVerifyReply(CNode* pnode, CMasternodeVerification& mnv);
-    void ProcessVerifyBroadcast(CNode* pnode, const CMasternodeVerification& mnv);
+    /// Process a reply to our request, keyIDSigner being the key that signed it
+    void ProcessVerifyReply(NodeId nodeId, CMasternodeVerification& mnv, const CKeyID& keyIDSigner);
+    /// Process a broadcast, keyIDSigner1 and keyIDSigner2 being the keys of the verified and the verifying masternode
+    void ProcessVerifyBroadcast(NodeId nodeId, const CMasternodeVerification& mnv, const CKeyID& keyIDSigner1, const CKeyID& keyIDSigner2);
 
     /// Return the number of (unique) Masternodes
     int size() { return mapMasternodes.size(); }
@@ -228,6 +428,8 @@ public:
     void SetMasternodeLastPing(const COutPoint& outpoint, const CMasternodePing& mnp);
 
     void UpdatedBlockTip(const CBlockIndex *pindex);
+    /// Called by ConnectTip with cs_main held: collaterals the block spends are no longer eligible for payment
+    void BlockConnected(const CBlock& block);
 
     /**
      * Called to notify CGovernanceManager that the masternode index has been updated.
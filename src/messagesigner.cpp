@@ -39,6 +39,15 @@ bool CMessageSigner::VerifyMessage(const CPubKey pubkey, const std::vector<unsig
     return CHashSigner::VerifyHash(ss.GetHash(), pubkey, vchSig, strErrorRet);
 }
 
+bool CMessageSigner::RecoverMessageSigner(const std::vector<unsigned char>& vchSig, const std::string& strMessage, CKeyID& keyIDRet)
+{
+    CHashWriter ss(SER_GETHASH, 0);
+    ss << strMessageMagic;
+    ss << strMessage;
+
+    return CHashSigner::RecoverHashSigner(ss.GetHash(), vchSig, keyIDRet);
+}
+
 bool CHashSigner::SignHash(const uint256& hash, const CKey key, std::vector<unsigned char>& vchSigRet)
 {
     return key.SignCompact(hash, vchSigRet);
@@ -61,3 +70,14 @@ bool CHashSigner::VerifyHash(const uint256& hash, const CPubKey pubkey, const st
 
     return true;
 }
+
+bool CHashSigner::RecoverHashSigner(const uint256& hash, const std::vector<unsigned char>& vchSig, CKeyID& keyIDRet)
+{
+    CPubKey pubkeyFromSig;
+    if(!pubkeyFromSig.RecoverCompact(hash, vchSig)) {
+        return false;
+    }
+
+    keyIDRet = pubkeyFromSig.GetID();
+    return true;
+}
@@ -18,6 +18,8 @@ public:
     static bool SignMessage(const std::string strMessage, std::vector<unsigned char>& vchSigRet, const CKey key);
     /// Verify the message signature, returns true if succcessful
     static bool VerifyMessage(const CPubKey pubkey, const std::vector<unsigned char>& vchSig, const std::string strMessage, std::string& strErrorRet);
+    /// Get the ID of the key that signed the message, to match it against several keys at once, returns true if successful
+    static bool RecoverMessageSigner(const std::vector<unsigned char>& vchSig, const std::string& strMessage, CKeyID& keyIDRet);
 };
 
 /** Helper class for signing hashes and checking their signatures
@@ -29,6 +31,8 @@ public:
     static bool SignHash(const uint256& hash, const CKey key, std::vector<unsigned char>& vchSigRet);
     /// Verify the hash signature, returns true if succcessful
     static bool VerifyHash(const uint256& hash, const CPubKey pubkey, const std::vector<unsigned char>& vchSig, std::string& strErrorRet);
+    /// Get the ID of the key that signed the hash, returns true if successful
+    static bool RecoverHashSigner(const uint256& hash, const std::vector<unsigned char>& vchSig, CKeyID& keyIDRet);
 };
 
 #endif
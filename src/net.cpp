@@ -26,6 +26,8 @@
 #include "masternode-sync.h"
 #include "masternodeman.h"
 #include "privatesend.h"
+#include "txmempool.h"
+#include "validation.h"
 
 #ifdef WIN32
 #include <string.h>
@@ -81,7 +83,7 @@ static bool vfLimited[NET_MAX] = {};
 static CNode* pnodeLocalHost = NULL;
 std::string strSubVersion;
 
-std::map<CInv, CDataStream> mapRelay;
+std::map<CInv, CTransactionRef> mapRelay;
 std::deque<pair<int64_t, CInv> > vRelayExpiration;
 CCriticalSection cs_mapRelay;
 limitedmap<uint256, int64_t> mapAlreadyAskedFor(MAX_INV_SZ);
@@ -2475,28 +2477,27 @@ bool CConnman::DisconnectNode(NodeId id)
 
 void CConnman::RelayTransaction(const CTransaction& tx)
 {
-    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
-    ss.reserve(10000);
+    // Share the copy the mempool or InstantSend already hold rather than make another
     uint256 hash = tx.GetHash();
+    CTransactionRef ptx = mempool.get(hash);
     CTxLockRequest txLockRequest;
-    CDarksendBroadcastTx dstx = CPrivateSend::GetDSTX(hash);
-    if(dstx) { // MSG_DSTX
-        ss << dstx;
-    } else if(instantsend.GetTxLockRequest(hash, txLockRequest)) { // MSG_TXLOCK_REQUEST
-        ss << txLockRequest;
-    } else { // MSG_TX
-        ss << tx;
-    }
-    RelayTransaction(tx, ss);
+    if (!ptx && instantsend.GetTxLockRequest(hash, txLockRequest))
+        ptx = txLockRequest.tx;
+    if (!ptx)
+        ptx = MakeTransactionRef(tx);
+    RelayTransaction(ptx);
 }
 
-void CConnman::RelayTransaction(const CTransaction& tx, const CDataStream& ss)
+void CConnman::RelayTransaction(const CTransactionRef& ptx)
 {
+    const CTransaction& tx = *ptx;
     uint256 hash = tx.GetHash();
-    int nInv = static_cast<bool>(CPrivateSend::GetDSTX(hash)) ? MSG_DSTX :
+    CDarksendBroadcastTx dstx = CPrivateSend::GetDSTX(hash);
+    int nInv = static_cast<bool>(dstx) ? MSG_DSTX :
                 (instantsend.HasTxLockRequest(hash) ? MSG_TXLOCK_REQUEST : MSG_TX);
     CInv inv(nInv, hash);
-    {
+    // A DSTX carries the masternode's signature as well, getdata serves it from CPrivateSend
+    if (nInv != MSG_DSTX) {
         LOCK(cs_mapRelay);
         // Expire old relay messages
         while (!vRelayExpiration.empty() && vRelayExpiration.front().first < GetTIMECoin())
@@ -2505,8 +2506,8 @@ void CConnman::RelayTransaction(const CTransaction& tx, const CDataStream& ss)
             vRelayExpiration.pop_front();
         }
 
-        // Save original serialized message so newer versions are preserved
-        mapRelay.insert(std::make_pair(inv, ss));
+        // Keep the transaction itself so getdata can serve it after it leaves the mempool
+        mapRelay.insert(std::make_pair(inv, ptx));
         vRelayExpiration.push_back(std::make_pair(GetTIMECoin() + 15 * 60, inv));
     }
     LOCK(cs_vNodes);
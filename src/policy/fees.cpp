@@ -12,41 +12,54 @@
 #include "txmempool.h"
 #include "util.h"
 
+#include <algorithm>
+
 void TxConfirmStats::Initialize(std::vector<double>& defaultBuckets,
-                                unsigned int maxConfirms, double _decay, std::string _dataTypeString)
+                                unsigned int _maxConfirms, double _decay, std::string _dataTypeString)
 {
     decay = _decay;
+    decayScale = 1;
+    maxConfirms = _maxConfirms;
     dataTypeString = _dataTypeString;
-    for (unsigned int i = 0; i < defaultBuckets.size(); i++) {
-        buckets.push_back(defaultBuckets[i]);
-        bucketMap[defaultBuckets[i]] = i;
-    }
-    confAvg.resize(maxConfirms);
-    curBlockConf.resize(maxConfirms);
-    unconfTxs.resize(maxConfirms);
-    for (unsigned int i = 0; i < maxConfirms; i++) {
-        confAvg[i].resize(buckets.size());
-        curBlockConf[i].resize(buckets.size());
-        unconfTxs[i].resize(buckets.size());
-    }
+    buckets = defaultBuckets;
+
+    confAvg.assign(maxConfirms * buckets.size(), 0);
+    unconfTxs.assign(maxConfirms * buckets.size(), 0);
+    oldUnconfTxs.assign(buckets.size(), 0);
+    txCtAvg.assign(buckets.size(), 0);
+    avg.assign(buckets.size(), 0);
+    estimateCache.clear();
+}
 
-    oldUnconfTxs.resize(buckets.size());
-    curBlockTxCt.resize(buckets.size());
-    txCtAvg.resize(buckets.size());
-    curBlockVal.resize(buckets.size());
-    avg.resize(buckets.size());
+unsigned int TxConfirmStats::FindBucketIndex(double val) const
+{
+    // The last bucket is an "infinite" upper bound, so every value has a bucket
+    std::vector<double>::const_iterator it = std::lower_bound(buckets.begin(), buckets.end(), val);
+    if (it == buckets.end())
+        --it;
+    return it - buckets.begin();
 }
 
-// Zero out the data for the current block
+void TxConfirmStats::Normalize()
+{
+    if (decayScale == 1)
+        return;
+    for (unsigned int i = 0; i < confAvg.size(); i++)
+        confAvg[i] *= decayScale;
+    for (unsigned int j = 0; j < buckets.size(); j++) {
+        avg[j] *= decayScale;
+        txCtAvg[j] *= decayScale;
+    }
+    decayScale = 1;
+}
+
+// Move the mempool counts that are about to be reused for the new block
 void TxConfirmStats::ClearCurrent(unsigned int nBlockHeight)
 {
+    unsigned int rowStart = (nBlockHeight % maxConfirms) * buckets.size();
     for (unsigned int j = 0; j < buckets.size(); j++) {
-        oldUnconfTxs[j] += unconfTxs[nBlockHeight%unconfTxs.size()][j];
-        unconfTxs[nBlockHeight%unconfTxs.size()][j] = 0;
-        for (unsigned int i = 0; i < curBlockConf.size(); i++)
-            curBlockConf[i][j] = 0;
-        curBlockTxCt[j] = 0;
-        curBlockVal[j] = 0;
+        oldUnconfTxs[j] += unconfTxs[rowStart + j];
+        unconfTxs[rowStart + j] = 0;
     }
 }
 
@@ -56,22 +69,26 @@ void TxConfirmStats::Record(int blocksToConfirm, double val)
     // blocksToConfirm is 1-based
     if (blocksToConfirm < 1)
         return;
-    unsigned int bucketindex = bucketMap.lower_bound(val)->second;
-    for (size_t i = blocksToConfirm; i <= curBlockConf.size(); i++) {
-        curBlockConf[i - 1][bucketindex]++;
+    unsigned int bucketindex = FindBucketIndex(val);
+    double inc = 1 / decayScale;
+    for (size_t i = blocksToConfirm; i <= maxConfirms; i++) {
+        confAvg[(i - 1) * buckets.size() + bucketindex] += inc;
     }
-    curBlockTxCt[bucketindex]++;
-    curBlockVal[bucketindex] += val;
+    txCtAvg[bucketindex] += inc;
+    avg[bucketindex] += val * inc;
 }
 
 void TxConfirmStats::UpdateMovingAverages()
 {
-    for (unsigned int j = 0; j < buckets.size(); j++) {
-        for (unsigned int i = 0; i < confAvg.size(); i++)
-            confAvg[i][j] = confAvg[i][j] * decay + curBlockConf[i][j];
-        avg[j] = avg[j] * decay + curBlockVal[j];
-        txCtAvg[j] = txCtAvg[j] * decay + curBlockTxCt[j];
-    }
+    decayScale *= decay;
+    // Keep 1 / decayScale well inside double range (about every 11000 blocks at the default decay)
+    if (decayScale < 1e-10)
+        Normalize();
+}
+
+void TxConfirmStats::ClearEstimateCache()
+{
+    estimateCache.clear();
 }
 
 // returns -1 on error conditions
@@ -79,6 +96,14 @@ double TxConfirmStats::EstimateMedianVal(int confTarget, double sufficientTxVal,
                                          double successBreakPoint, bool requireGreater,
                                          unsigned int nBlockHeight)
 {
+    for (unsigned int i = 0; i < estimateCache.size(); i++) {
+        const CachedEstimate& cached = estimateCache[i];
+        if (cached.confTarget == confTarget && cached.sufficientTxVal == sufficientTxVal &&
+            cached.successBreakPoint == successBreakPoint && cached.requireGreater == requireGreater &&
+            cached.nBlockHeight == nBlockHeight)
+            return cached.median;
+    }
+
     // Counters for a bucket (or range of buckets)
     double nConf = 0; // Number of tx's confirmed within the confTarget
     double totalNum = 0; // Total number of tx's that were ever confirmed
@@ -104,15 +129,17 @@ double TxConfirmStats::EstimateMedianVal(int confTarget, double sufficientTxVal,
     unsigned int bestFarBucket = startbucket;
 
     bool foundAnswer = false;
-    unsigned int bins = unconfTxs.size();
+    unsigned int bins = maxConfirms;
+    unsigned int nBuckets = buckets.size();
+    const double* confRow = &confAvg[(confTarget - 1) * nBuckets];
 
     // Start counting from highest(default) or lowest fee/pri transactions
     for (int bucket = startbucket; bucket >= 0 && bucket <= maxbucketindex; bucket += step) {
         curFarBucket = bucket;
-        nConf += confAvg[confTarget - 1][bucket];
-        totalNum += txCtAvg[bucket];
-        for (unsigned int confct = confTarget; confct < GetMaxConfirms(); confct++)
-            extraNum += unconfTxs[(nBlockHeight - confct)%bins][bucket];
+        nConf += confRow[bucket] * decayScale;
+        totalNum += txCtAvg[bucket] * decayScale;
+        for (unsigned int confct = confTarget; confct < maxConfirms; confct++)
+            extraNum += unconfTxs[((nBlockHeight - confct)%bins) * nBuckets + bucket];
         extraNum += oldUnconfTxs[bucket];
         // If we have enough transaction data points in this range of buckets,
         // we can test for success
@@ -148,6 +175,7 @@ double TxConfirmStats::EstimateMedianVal(int confTarget, double sufficientTxVal,
     // Find the bucket with the median transaction and then report the average fee from that bucket
     // This is a compromise between finding the median which we can't since we don't save all tx's
     // and reporting the average which is less accurate
+    // (decayScale cancels out here, so the stored values are compared directly)
     unsigned int minBucket = bestNearBucket < bestFarBucket ? bestNearBucket : bestFarBucket;
     unsigned int maxBucket = bestNearBucket > bestFarBucket ? bestNearBucket : bestFarBucket;
     for (unsigned int j = minBucket; j <= maxBucket; j++) {
@@ -170,16 +198,24 @@ double TxConfirmStats::EstimateMedianVal(int confTarget, double sufficientTxVal,
              requireGreater ? ">" : "<", median, buckets[minBucket], buckets[maxBucket],
              100 * nConf / (totalNum + extraNum), nConf, totalNum, extraNum);
 
+    CachedEstimate cached = {confTarget, sufficientTxVal, successBreakPoint, requireGreater, nBlockHeight, median};
+    estimateCache.push_back(cached);
     return median;
 }
 
 void TxConfirmStats::Write(CAutoFile& fileout)
 {
+    Normalize();
+    // The file keeps the original nested confAvg[Y][X] layout
+    std::vector<std::vector<double> > fileConfAvg(maxConfirms);
+    for (unsigned int i = 0; i < maxConfirms; i++)
+        fileConfAvg[i].assign(confAvg.begin() + i * buckets.size(), confAvg.begin() + (i + 1) * buckets.size());
+
     fileout << decay;
     fileout << buckets;
     fileout << avg;
     fileout << txCtAvg;
-    fileout << confAvg;
+    fileout << fileConfAvg;
 }
 
 void TxConfirmStats::Read(CAutoFile& filein)
@@ -190,7 +226,7 @@ void TxConfirmStats::Read(CAutoFile& filein)
     std::vector<std::vector<double> > fileConfAvg;
     std::vector<double> fileTxCtAvg;
     double fileDecay;
-    size_t maxConfirms;
+    size_t fileMaxConfirms;
     size_t numBuckets;
 
     filein >> fileDecay;
@@ -207,39 +243,31 @@ void TxConfirmStats::Read(CAutoFile& filein)
     if (fileTxCtAvg.size() != numBuckets)
         throw std::runtime_error("Corrupt estimates file. Mismatch in tx count bucket count");
     filein >> fileConfAvg;
-    maxConfirms = fileConfAvg.size();
-    if (maxConfirms <= 0 || maxConfirms > 6 * 24 * 7) // one week
+    fileMaxConfirms = fileConfAvg.size();
+    if (fileMaxConfirms <= 0 || fileMaxConfirms > 6 * 24 * 7) // one week
         throw std::runtime_error("Corrupt estimates file.  Must maintain estimates for between 1 and 1008 (one week) confirms");
-    for (unsigned int i = 0; i < maxConfirms; i++) {
+    for (unsigned int i = 0; i < fileMaxConfirms; i++) {
         if (fileConfAvg[i].size() != numBuckets)
             throw std::runtime_error("Corrupt estimates file. Mismatch in fee/pri conf average bucket count");
     }
     // Now that we've processed the entire fee estimate data file and not
     // thrown any errors, we can copy it to our data structures
     decay = fileDecay;
+    decayScale = 1;
+    maxConfirms = fileMaxConfirms;
     buckets = fileBuckets;
     avg = fileAvg;
-    confAvg = fileConfAvg;
     txCtAvg = fileTxCtAvg;
-    bucketMap.clear();
+    confAvg.clear();
+    confAvg.reserve(maxConfirms * numBuckets);
+    for (unsigned int i = 0; i < maxConfirms; i++)
+        confAvg.insert(confAvg.end(), fileConfAvg[i].begin(), fileConfAvg[i].end());
 
-    // Resize the current block variables which aren't stored in the data file
+    // Resize the mempool counters which aren't stored in the data file
     // to match the number of confirms and buckets
-    curBlockConf.resize(maxConfirms);
-    for (unsigned int i = 0; i < maxConfirms; i++) {
-        curBlockConf[i].resize(buckets.size());
-    }
-    curBlockTxCt.resize(buckets.size());
-    curBlockVal.resize(buckets.size());
-
-    unconfTxs.resize(maxConfirms);
-    for (unsigned int i = 0; i < maxConfirms; i++) {
-        unconfTxs[i].resize(buckets.size());
-    }
-    oldUnconfTxs.resize(buckets.size());
-
-    for (unsigned int i = 0; i < buckets.size(); i++)
-        bucketMap[buckets[i]] = i;
+    unconfTxs.assign(maxConfirms * numBuckets, 0);
+    oldUnconfTxs.assign(numBuckets, 0);
+    estimateCache.clear();
 
     LogPrint("estimatefee", "Reading estimates: %u %s buckets counting confirms up to %u blocks\n",
              numBuckets, dataTypeString, maxConfirms);
@@ -247,9 +275,9 @@ void TxConfirmStats::Read(CAutoFile& filein)
 
 unsigned int TxConfirmStats::NewTx(unsigned int nBlockHeight, double val)
 {
-    unsigned int bucketindex = bucketMap.lower_bound(val)->second;
-    unsigned int blockIndex = nBlockHeight % unconfTxs.size();
-    unconfTxs[blockIndex][bucketindex]++;
+    unsigned int bucketindex = FindBucketIndex(val);
+    unsigned int blockIndex = nBlockHeight % maxConfirms;
+    unconfTxs[blockIndex * buckets.size() + bucketindex]++;
     LogPrint("estimatefee", "adding to %s", dataTypeString);
     return bucketindex;
 }
@@ -265,7 +293,7 @@ void TxConfirmStats::removeTx(unsigned int entryHeight, unsigned int nBestSeenHe
         return;  //This can't happen because we call this with our best seen height, no entries can have higher
     }
 
-    if (blocksAgo >= (int)unconfTxs.size()) {
+    if (blocksAgo >= (int)maxConfirms) {
         if (oldUnconfTxs[bucketindex] > 0)
             oldUnconfTxs[bucketindex]--;
         else
@@ -273,9 +301,9 @@ void TxConfirmStats::removeTx(unsigned int entryHeight, unsigned int nBestSeenHe
                      bucketindex);
     }
     else {
-        unsigned int blockIndex = entryHeight % unconfTxs.size();
-        if (unconfTxs[blockIndex][bucketindex] > 0)
-            unconfTxs[blockIndex][bucketindex]--;
+        unsigned int blockIndex = entryHeight % maxConfirms;
+        if (unconfTxs[blockIndex * buckets.size() + bucketindex] > 0)
+            unconfTxs[blockIndex * buckets.size() + bucketindex]--;
         else
             LogPrint("estimatefee", "Blockpolicy error, mempool tx removed from blockIndex=%u,bucketIndex=%u already\n",
                      blockIndex, bucketindex);
@@ -284,6 +312,7 @@ void TxConfirmStats::removeTx(unsigned int entryHeight, unsigned int nBestSeenHe
 
 void CBlockPolicyEstimator::removeTx(uint256 hash)
 {
+    LOCK(cs);
     std::map<uint256, TxStatsInfo>::iterator pos = mapMemPoolTxs.find(hash);
     if (pos == mapMemPoolTxs.end()) {
         LogPrint("estimatefee", "Blockpolicy error mempool tx %s not found for removeTx\n", hash.ToString());
@@ -343,6 +372,7 @@ bool CBlockPolicyEstimator::isPriDataPoint(const CFeeRate &fee, double pri)
 
 void CBlockPolicyEstimator::processTransaction(const CTxMemPoolEntry& entry, bool fCurrentEstimate)
 {
+    LOCK(cs);
     unsigned int txHeight = entry.GetHeight();
     uint256 hash = entry.GetTx().GetHash();
     if (mapMemPoolTxs[hash].stats != NULL) {
@@ -396,6 +426,7 @@ void CBlockPolicyEstimator::processTransaction(const CTxMemPoolEntry& entry, boo
 
 void CBlockPolicyEstimator::processBlockTx(unsigned int nBlockHeight, const CTxMemPoolEntry& entry)
 {
+    LOCK(cs);
     if (!entry.WasClearAtEntry()) {
         // This transaction depended on other transactions in the mempool to
         // be included in a block before it was able to be included, so
@@ -434,6 +465,7 @@ void CBlockPolicyEstimator::processBlockTx(unsigned int nBlockHeight, const CTxM
 void CBlockPolicyEstimator::processBlock(unsigned int nBlockHeight,
                                          std::vector<CTxMemPoolEntry>& entries, bool fCurrentEstimate)
 {
+    LOCK(cs);
     if (nBlockHeight <= nBestSeenHeight) {
         // Ignore side chains and re-orgs; assuming they are random
         // they don't affect the estimate.
@@ -477,13 +509,17 @@ void CBlockPolicyEstimator::processBlock(unsigned int nBlockHeight,
     feeStats.ClearCurrent(nBlockHeight);
     priStats.ClearCurrent(nBlockHeight);
 
-    // Repopulate the current block states
+    // Decay all exponential averages for the new block
+    feeStats.UpdateMovingAverages();
+    priStats.UpdateMovingAverages();
+
+    // Add the transactions confirmed in this block
     for (unsigned int i = 0; i < entries.size(); i++)
         processBlockTx(nBlockHeight, entries[i]);
 
-    // Update all exponential averages with the current block states
-    feeStats.UpdateMovingAverages();
-    priStats.UpdateMovingAverages();
+    // Estimates are cached per block, the mempool counts changing in between don't invalidate them
+    feeStats.ClearEstimateCache();
+    priStats.ClearEstimateCache();
 
     LogPrint("estimatefee", "Blockpolicy after updating estimates for %u confirmed entries, new mempool map size %u\n",
              entries.size(), mapMemPoolTxs.size());
@@ -491,6 +527,7 @@ void CBlockPolicyEstimator::processBlock(unsigned int nBlockHeight,
 
 CFeeRate CBlockPolicyEstimator::estimateFee(int confTarget)
 {
+    LOCK(cs);
     // Return failure if trying to analyze a target we're not tracking
     if (confTarget <= 0 || (unsigned int)confTarget > feeStats.GetMaxConfirms())
         return CFeeRate(0);
@@ -505,6 +542,10 @@ CFeeRate CBlockPolicyEstimator::estimateFee(int confTarget)
 
 CFeeRate CBlockPolicyEstimator::estimateSmartFee(int confTarget, int *answerFoundAtTarget, const CTxMemPool& pool)
 {
+    // Takes pool.cs, so query it before taking our own lock
+    CAmount minPoolFee = pool.GetMinFee(GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000).GetFeePerK();
+
+    LOCK(cs);
     if (answerFoundAtTarget)
         *answerFoundAtTarget = confTarget;
     // Return failure if trying to analyze a target we're not tracking
@@ -520,7 +561,6 @@ CFeeRate CBlockPolicyEstimator::estimateSmartFee(int confTarget, int *answerFoun
         *answerFoundAtTarget = confTarget - 1;
 
     // If mempool is limiting txs , return at least the min fee from the mempool
-    CAmount minPoolFee = pool.GetMinFee(GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000).GetFeePerK();
     if (minPoolFee > 0 && minPoolFee > median)
         return CFeeRate(minPoolFee);
 
@@ -532,6 +572,7 @@ CFeeRate CBlockPolicyEstimator::estimateSmartFee(int confTarget, int *answerFoun
 
 double CBlockPolicyEstimator::estimatePriority(int confTarget)
 {
+    LOCK(cs);
     // Return failure if trying to analyze a target we're not tracking
     if (confTarget <= 0 || (unsigned int)confTarget > priStats.GetMaxConfirms())
         return -1;
@@ -541,6 +582,10 @@ double CBlockPolicyEstimator::estimatePriority(int confTarget)
 
 double CBlockPolicyEstimator::estimateSmartPriority(int confTarget, int *answerFoundAtTarget, const CTxMemPool& pool)
 {
+    // Takes pool.cs, so query it before taking our own lock
+    CAmount minPoolFee = pool.GetMinFee(GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000).GetFeePerK();
+
+    LOCK(cs);
     if (answerFoundAtTarget)
         *answerFoundAtTarget = confTarget;
     // Return failure if trying to analyze a target we're not tracking
@@ -548,7 +593,6 @@ double CBlockPolicyEstimator::estimateSmartPriority(int confTarget, int *answerF
         return -1;
 
     // If mempool is limiting txs, no priority txs are allowed
-    CAmount minPoolFee = pool.GetMinFee(GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000).GetFeePerK();
     if (minPoolFee > 0)
         return INF_PRIORITY;
 
@@ -565,6 +609,7 @@ double CBlockPolicyEstimator::estimateSmartPriority(int confTarget, int *answerF
 
 void CBlockPolicyEstimator::Write(CAutoFile& fileout)
 {
+    LOCK(cs);
     fileout << nBestSeenHeight;
     feeStats.Write(fileout);
     priStats.Write(fileout);
@@ -572,6 +617,7 @@ void CBlockPolicyEstimator::Write(CAutoFile& fileout)
 
 void CBlockPolicyEstimator::Read(CAutoFile& filein)
 {
+    LOCK(cs);
     int nFileBestSeenHeight;
     filein >> nFileBestSeenHeight;
     feeStats.Read(filein);
@@ -6,6 +6,7 @@
 #define BITCOIN_POLICYESTIMATOR_H
 
 #include "amount.h"
+#include "sync.h"
 #include "uint256.h"
 
 #include <map>
@@ -80,41 +81,64 @@ class TxConfirmStats
 {
 private:
     //Define the buckets we will group transactions into (both fee buckets and priority buckets)
-    std::vector<double> buckets;              // The upper-bound of the range for the bucket (inclusive)
-    std::map<double, unsigned int> bucketMap; // Map of bucket upper-bound to index into all vectors by bucket
+    std::vector<double> buckets;              // The upper-bound of the range for the bucket (inclusive), sorted
+
+    // All per-(Y,X) counters are stored in flat arrays indexed by Y * buckets.size() + X,
+    // so a bucket scan touches contiguous memory.
 
     // For each bucket X:
     // Count the total # of txs in each bucket
     // Track the historical moving average of this total over blocks
     std::vector<double> txCtAvg;
-    // and calculate the total for the current block to update the moving average
-    std::vector<int> curBlockTxCt;
 
     // Count the total # of txs confirmed within Y blocks in each bucket
     // Track the historical moving average of theses totals over blocks
-    std::vector<std::vector<double> > confAvg; // confAvg[Y][X]
-    // and calculate the totals for the current block to update the moving averages
-    std::vector<std::vector<int> > curBlockConf; // curBlockConf[Y][X]
+    std::vector<double> confAvg; // confAvg[Y * buckets.size() + X]
 
     // Sum the total priority/fee of all tx's in each bucket
     // Track the historical moving average of this total over blocks
     std::vector<double> avg;
-    // and calculate the total for the current block to update the moving average
-    std::vector<double> curBlockVal;
 
     // Combine the conf counts with tx counts to calculate the confirmation % for each Y,X
     // Combine the total value with the tx counts to calculate the avg fee/priority per bucket
 
     std::string dataTypeString;
     double decay;
+    unsigned int maxConfirms;
+
+    // The moving averages above are stored unscaled: their real value is the
+    // stored value times decayScale.  Decaying every average for a new block is
+    // then a single multiplication of decayScale, and a new data point is added
+    // as 1 / decayScale.  Normalize() folds the scale back into the arrays.
+    double decayScale;
 
     // Mempool counts of outstanding transactions
     // For each bucket X, track the number of transactions in the mempool
     // that are unconfirmed for each possible confirmation value Y
-    std::vector<std::vector<int> > unconfTxs;  //unconfTxs[Y][X]
+    std::vector<int> unconfTxs;  //unconfTxs[Y * buckets.size() + X]
     // transactions still unconfirmed after MAX_CONFIRMS for each bucket
     std::vector<int> oldUnconfTxs;
 
+    // Results of EstimateMedianVal for the current block, cleared by the next one.
+    // Transactions entering or leaving the mempool in between don't clear them, so
+    // the mempool counts an estimate uses are those of its first query in the block.
+    struct CachedEstimate
+    {
+        int confTarget;
+        double sufficientTxVal;
+        double successBreakPoint;
+        bool requireGreater;
+        unsigned int nBlockHeight;
+        double median;
+    };
+    std::vector<CachedEstimate> estimateCache;
+
+    /** Return the index of the bucket val falls into */
+    unsigned int FindBucketIndex(double val) const;
+
+    /** Apply decayScale to all moving averages and reset it to 1 */
+    void Normalize();
+
 public:
     /**
      * Initialize the data structures.  This is called by BlockPolicyEstimator's
@@ -126,11 +150,12 @@ public:
      */
     void Initialize(std::vector<double>& defaultBuckets, unsigned int maxConfirms, double decay, std::string dataTypeString);
 
-    /** Clear the state of the curBlock variables to start counting for the new block */
+    /** Move the mempool counters that fell out of the tracked range for the new block */
     void ClearCurrent(unsigned int nBlockHeight);
 
     /**
-     * Record a new transaction data point in the current block stats
+     * Record a new transaction data point in the current block stats.
+     * Must be called after UpdateMovingAverages for the block.
      * @param blocksToConfirm the number of blocks it took this transaction to confirm
      * @param val either the fee or the priority when entered of the transaction
      * @warning blocksToConfirm is 1-based and has to be >= 1
@@ -144,10 +169,13 @@ public:
     void removeTx(unsigned int entryHeight, unsigned int nBestSeenHeight,
                   unsigned int bucketIndex);
 
-    /** Update our estimates by decaying our historical moving average and updating
-        with the data gathered from the current block */
+    /** Decay our historical moving averages for a new block.  Data points for
+        the block are then added with Record */
     void UpdateMovingAverages();
 
+    /** Forget the estimates cached for the previous block, once the stats are updated for a new one */
+    void ClearEstimateCache();
+
     /**
      * Calculate a fee or priority estimate.  Find the lowest value bucket (or range of buckets
      * to make sure we have enough data points) whose transactions still have sufficient likelihood
@@ -163,7 +191,7 @@ public:
                              double minSuccess, bool requireGreater, unsigned int nBlockHeight);
 
     /** Return the max number of confirms we're tracking */
-    unsigned int GetMaxConfirms() { return confAvg.size(); }
+    unsigned int GetMaxConfirms() { return maxConfirms; }
 
     /** Write state of estimation data to a file*/
     void Write(CAutoFile& fileout);
@@ -265,6 +293,9 @@ public:
     void Read(CAutoFile& filein);
 
 private:
+    /** Protects everything below, so estimates can be served without holding the mempool lock */
+    CCriticalSection cs;
+
     CFeeRate minTrackedFee; //! Passed to constructor to avoid dependency on main
     double minTrackedPriority; //! Set to AllowFreeThreshold
     unsigned int nBestSeenHeight;
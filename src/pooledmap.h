@@ -0,0 +1,380 @@
+// Copyright (c) 2017 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_POOLEDMAP_H
+#define BITCOIN_POOLEDMAP_H
+
+#include "memusage.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * STL-like hash map for caches with many small entries, such as the coins cache.
+ *
+ * Elements live in nodes carved out of large chunks, so an entry costs no
+ * allocation of its own, and erased nodes are reused by later inserts.
+ * Lookups probe an open-addressing table of node pointers, next to which a
+ * control byte per bucket holds 7 bits of the element's hash, so a probe
+ * only touches a node when those bits match.
+ *
+ * Like std::unordered_map, references to elements stay valid until they
+ * are erased, and iterators stay valid until the next insert. Unlike it,
+ * erasing never moves other elements, so iterating while erasing is safe.
+ * All memory is released by clear().
+ */
+template <typename K, typename V, typename Hash>
+class pooledmap
+{
+public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<const K, V> value_type;
+    typedef size_t size_type;
+
+private:
+    /** Storage for one element, or a link in the free list while unused */
+    union Node {
+        Node* next;
+        typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type storage;
+
+        value_type& value() { return *reinterpret_cast<value_type*>(&storage); }
+    };
+
+    enum {
+        //! Control byte of a bucket that never held an element; ends a probe sequence
+        CTRL_EMPTY = 0,
+        //! Control byte of a bucket whose element was erased; probes continue past it
+        CTRL_DELETED = 1,
+        //! Set in the control byte of a bucket holding an element, with 7 hash bits below it
+        CTRL_FULL = 0x80,
+    };
+
+    enum {
+        //! Buckets in the smallest table
+        MIN_BUCKETS = 16,
+        //! Nodes in the first chunk, doubled for each further chunk up to MAX_CHUNK_NODES
+        MIN_CHUNK_NODES = 16,
+        MAX_CHUNK_NODES = 4096,
+    };
+
+    Hash hasher;
+
+    //! Control bytes and node pointers of the table, both empty or of a power of two size
+    std::vector<unsigned char> ctrl;
+    std::vector<Node*> slots;
+
+    //! Elements stored, and buckets marked CTRL_DELETED
+    size_t nSize;
+    size_t nDeleted;
+
+    //! Chunks of nodes with their sizes. Nodes of the last chunk from nChunkUsed on were never used.
+    std::vector<std::pair<Node*, size_t> > chunks;
+    size_t nChunkUsed;
+
+    //! Nodes of erased elements
+    Node* freeList;
+
+    static unsigned char GetTag(size_t hash)
+    {
+        return CTRL_FULL | (hash >> (sizeof(size_t) * 8 - 7));
+    }
+
+    Node* AllocateNode()
+    {
+        if (freeList) {
+            Node* node = freeList;
+            freeList = node->next;
+            return node;
+        }
+        if (chunks.empty() || nChunkUsed == chunks.back().second) {
+            size_t nNodes = MIN_CHUNK_NODES;
+            if (!chunks.empty())
+                nNodes = std::min<size_t>(chunks.back().second * 2, MAX_CHUNK_NODES);
+            chunks.push_back(std::make_pair(static_cast<Node*>(::operator new(sizeof(Node) * nNodes)), nNodes));
+            nChunkUsed = 0;
+        }
+        return &chunks.back().first[nChunkUsed++];
+    }
+
+    void FreeNode(Node* node)
+    {
+        node->next = freeList;
+        freeList = node;
+    }
+
+    /** Find the bucket holding key, or return ctrl.size() */
+    size_t FindBucket(const key_type& key, size_t hash) const
+    {
+        if (ctrl.empty())
+            return 0;
+        const size_t mask = ctrl.size() - 1;
+        const unsigned char tag = GetTag(hash);
+        // Triangular probing visits every bucket of a power of two sized table
+        for (size_t pos = hash & mask, step = 1; ; pos = (pos + step++) & mask) {
+            if (ctrl[pos] == CTRL_EMPTY)
+                return ctrl.size();
+            if (ctrl[pos] == tag && slots[pos]->value().first == key)
+                return pos;
+        }
+    }
+
+    /** Rebuild the table at most half full with nElements, dropping the deleted markers */
+    void Rehash(size_t nElements)
+    {
+        size_t nBuckets = MIN_BUCKETS;
+        while (nBuckets / 2 < nElements + 1)
+            nBuckets *= 2;
+        std::vector<unsigned char> ctrlNew(nBuckets, CTRL_EMPTY);
+        std::vector<Node*> slotsNew(nBuckets, nullptr);
+        const size_t mask = nBuckets - 1;
+        for (size_t i = 0; i < ctrl.size(); i++) {
+            if (!(ctrl[i] & CTRL_FULL))
+                continue;
+            size_t hash = hasher(slots[i]->value().first);
+            size_t pos = hash & mask;
+            for (size_t step = 1; ctrlNew[pos] != CTRL_EMPTY; pos = (pos + step++) & mask) {}
+            ctrlNew[pos] = GetTag(hash);
+            slotsNew[pos] = slots[i];
+        }
+        ctrl.swap(ctrlNew);
+        slots.swap(slotsNew);
+        nDeleted = 0;
+    }
+
+    pooledmap(const pooledmap&) = delete;
+    pooledmap& operator=(const pooledmap&) = delete;
+
+public:
+    template <bool fConst>
+    class iter
+    {
+    private:
+        friend class pooledmap;
+        template <bool> friend class iter;
+
+        const unsigned char* ctrl;
+        Node* const* slots;
+        size_t pos;
+        size_t end;
+
+        iter(const unsigned char* ctrlIn, Node* const* slotsIn, size_t posIn, size_t endIn) : ctrl(ctrlIn), slots(slotsIn), pos(posIn), end(endIn) {}
+
+        void SkipUnused()
+        {
+            while (pos != end && !(ctrl[pos] & CTRL_FULL))
+                pos++;
+        }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename pooledmap::value_type value_type;
+        typedef ptrdiff_t difference_type;
+        typedef typename std::conditional<fConst, const value_type*, value_type*>::type pointer;
+        typedef typename std::conditional<fConst, const value_type&, value_type&>::type reference;
+
+        iter() : ctrl(nullptr), slots(nullptr), pos(0), end(0) {}
+        iter(const iter&) = default;
+        iter& operator=(const iter&) = default;
+        // An iterator converts to a const_iterator. A template, so it is never the copy constructor.
+        template <bool fOtherConst, typename = typename std::enable_if<fConst && !fOtherConst>::type>
+        iter(const iter<fOtherConst>& it) : ctrl(it.ctrl), slots(it.slots), pos(it.pos), end(it.end) {}
+
+        reference operator*() const { return slots[pos]->value(); }
+        pointer operator->() const { return &slots[pos]->value(); }
+        iter& operator++() { pos++; SkipUnused(); return *this; }
+        iter operator++(int) { iter copy(*this); ++(*this); return copy; }
+        template <bool fOtherConst> bool operator==(const iter<fOtherConst>& other) const { return pos == other.pos; }
+        template <bool fOtherConst> bool operator!=(const iter<fOtherConst>& other) const { return pos != other.pos; }
+    };
+
+    typedef iter<false> iterator;
+    typedef iter<true> const_iterator;
+
+    pooledmap() : nSize(0), nDeleted(0), nChunkUsed(0), freeList(nullptr) {}
+
+    pooledmap(pooledmap&& other) : pooledmap() { swap(other); }
+
+    pooledmap& operator=(pooledmap&& other)
+    {
+        clear();
+        swap(other);
+        return *this;
+    }
+
+    ~pooledmap() { clear(); }
+
+    iterator begin() { iterator it(ctrl.data(), slots.data(), 0, ctrl.size()); it.SkipUnused(); return it; }
+    iterator end() { return iterator(ctrl.data(), slots.data(), ctrl.size(), ctrl.size()); }
+    const_iterator begin() const { return const_cast<pooledmap*>(this)->begin(); }
+    const_iterator end() const { return const_cast<pooledmap*>(this)->end(); }
+
+    size_type size() const { return nSize; }
+    bool empty() const { return nSize == 0; }
+
+    iterator find(const key_type& key)
+    {
+        return iterator(ctrl.data(), slots.data(), FindBucket(key, hasher(key)), ctrl.size());
+    }
+
+    const_iterator find(const key_type& key) const { return const_cast<pooledmap*>(this)->find(key); }
+
+    size_type count(const key_type& key) const { return find(key) != end() ? 1 : 0; }
+
+    /** Construct an element from args and insert it, unless its key is present already */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        Node* node = AllocateNode();
+        try {
+            new (&node->storage) value_type(std::forward<Args>(args)...);
+        } catch (...) {
+            FreeNode(node);
+            throw;
+        }
+
+        if (nSize + nDeleted + 1 > ctrl.size() * 3 / 4)
+            Rehash(nSize);
+        const key_type& key = node->value().first;
+        const size_t hash = hasher(key);
+        const unsigned char tag = GetTag(hash);
+        const size_t mask = ctrl.size() - 1;
+        size_t posFree = ctrl.size();
+        size_t pos = hash & mask;
+        for (size_t step = 1; ctrl[pos] != CTRL_EMPTY; pos = (pos + step++) & mask) {
+            if (ctrl[pos] == tag && slots[pos]->value().first == key) {
+                node->value().~value_type();
+                FreeNode(node);
+                return std::make_pair(iterator(ctrl.data(), slots.data(), pos, ctrl.size()), false);
+            }
+            if (ctrl[pos] == CTRL_DELETED && posFree == ctrl.size())
+                posFree = pos;
+        }
+        // Reuse the first deleted bucket on the way, keeping probe sequences short
+        if (posFree != ctrl.size()) {
+            pos = posFree;
+            nDeleted--;
+        }
+        ctrl[pos] = tag;
+        slots[pos] = node;
+        nSize++;
+        return std::make_pair(iterator(ctrl.data(), slots.data(), pos, ctrl.size()), true);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) { return emplace(value); }
+
+    /** Make room for n elements in all, so inserting up to that many neither rehashes nor allocates per chunk */
+    void reserve(size_type n)
+    {
+        if (n <= nSize)
+            return;
+        if (n + 1 > ctrl.size() / 2)
+            Rehash(n);
+        // One chunk for all the nodes still missing; what is left of the current chunk goes on the free list
+        size_t nNeeded = n - nSize;
+        size_t nFree = chunks.empty() ? 0 : chunks.back().second - nChunkUsed;
+        for (Node* node = freeList; node && nFree < nNeeded; node = node->next)
+            nFree++;
+        if (nFree >= nNeeded || nNeeded - nFree <= MAX_CHUNK_NODES)
+            return;
+        while (!chunks.empty() && nChunkUsed < chunks.back().second)
+            FreeNode(&chunks.back().first[nChunkUsed++]);
+        nNeeded -= nFree;
+        chunks.push_back(std::make_pair(static_cast<Node*>(::operator new(sizeof(Node) * nNeeded)), nNeeded));
+        nChunkUsed = 0;
+    }
+
+    mapped_type& operator[](const key_type& key)
+    {
+        iterator it = find(key);
+        if (it != end())
+            return it->second;
+        return emplace(std::piecewise_construct, std::forward_as_tuple(key), std::tuple<>()).first->second;
+    }
+
+    /** Erase an element. Other iterators, including the returned one to the next element, stay valid. */
+    iterator erase(const_iterator it)
+    {
+        assert(it.pos < ctrl.size() && (ctrl[it.pos] & CTRL_FULL));
+        Node* node = slots[it.pos];
+        node->value().~value_type();
+        FreeNode(node);
+        ctrl[it.pos] = CTRL_DELETED;
+        slots[it.pos] = nullptr;
+        nSize--;
+        nDeleted++;
+        iterator next(ctrl.data(), slots.data(), it.pos, ctrl.size());
+        return ++next;
+    }
+
+    size_type erase(const key_type& key)
+    {
+        const_iterator it = find(key);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    /** Erase all elements and free all memory */
+    void clear()
+    {
+        for (size_t i = 0; i < ctrl.size(); i++) {
+            if (ctrl[i] & CTRL_FULL)
+                slots[i]->value().~value_type();
+        }
+        for (size_t i = 0; i < chunks.size(); i++)
+            ::operator delete(chunks[i].first);
+        std::vector<unsigned char>().swap(ctrl);
+        std::vector<Node*>().swap(slots);
+        std::vector<std::pair<Node*, size_t> >().swap(chunks);
+        nSize = 0;
+        nDeleted = 0;
+        nChunkUsed = 0;
+        freeList = nullptr;
+    }
+
+    void swap(pooledmap& other)
+    {
+        std::swap(hasher, other.hasher);
+        ctrl.swap(other.ctrl);
+        slots.swap(other.slots);
+        std::swap(nSize, other.nSize);
+        std::swap(nDeleted, other.nDeleted);
+        chunks.swap(other.chunks);
+        std::swap(nChunkUsed, other.nChunkUsed);
+        std::swap(freeList, other.freeList);
+    }
+
+    /** Memory allocated by the map: the table and every node chunk, whether its nodes are in use or not */
+    size_t DynamicMemoryUsage() const
+    {
+        size_t nUsage = memusage::DynamicUsage(ctrl) + memusage::DynamicUsage(slots) + memusage::DynamicUsage(chunks);
+        for (size_t i = 0; i < chunks.size(); i++)
+            nUsage += memusage::MallocUsage(sizeof(Node) * chunks[i].second);
+        return nUsage;
+    }
+};
+
+namespace memusage
+{
+
+template<typename X, typename Y, typename Z>
+static inline size_t DynamicUsage(const pooledmap<X, Y, Z>& m)
+{
+    return m.DynamicMemoryUsage();
+}
+
+}
+
+#endif // BITCOIN_POOLEDMAP_H
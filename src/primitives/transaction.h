@@ -11,6 +11,8 @@
 #include "serialize.h"
 #include "uint256.h"
 
+#include <memory>
+
 /** An outpoint - a combination of a transaction hash and an index n into its vout */
 class COutPoint
 {
@@ -339,6 +341,15 @@ struct CMutableTransaction
 
 };
 
+/** A shared, immutable transaction. The mempool, relay and block connection
+ *  code pass these around so a transaction is stored once no matter how many
+ *  owners hold on to it. MakeTransactionRef allocates the transaction and its
+ *  reference count in a single block.
+ */
+typedef std::shared_ptr<const CTransaction> CTransactionRef;
+static inline CTransactionRef MakeTransactionRef() { return std::make_shared<const CTransaction>(); }
+template <typename Tx> static inline CTransactionRef MakeTransactionRef(Tx&& txIn) { return std::make_shared<const CTransaction>(std::forward<Tx>(txIn)); }
+
 /** Implementation of BIP69
  * https://github.com/bitcoin/bips/blob/master/bip-0069.mediawiki
  */
@@ -460,6 +460,9 @@ void ThreadCheckPrivateSend(CConnman& connman)
 
             nTick++;
 
+            // pick up the mnb/mnp/mnv messages verified since the last one arrived
+            mnodeman.ProcessVerifiedMessages(connman);
+
             // make sure to check all masternodes first
             mnodeman.Check();
 
@@ -273,12 +273,12 @@ void MasternodeList::updateNodeList()
     ui->tableWidgetMasternodes->setSortingEnabled(false);
     ui->tableWidgetMasternodes->clearContents();
     ui->tableWidgetMasternodes->setRowCount(0);
-    std::map<COutPoint, CMasternode> mapMasternodes = mnodeman.GetFullMasternodeMap();
+    CMasternodeMan::snapshot_t pMasternodes = mnodeman.GetListSnapshot();
     int offsetFromUtc = GetOffsetFromUtc();
 
-    for(auto& mnpair : mapMasternodes)
+    for(const auto& mnpair : *pMasternodes)
     {
-        CMasternode mn = mnpair.second;
+        const CMasternode& mn = mnpair.second;
         // populate list
         // Address, Protocol, Status, Active Seconds, Last Seen, Pub Key
         QTableWidgetItem *addressItem = new QTableWidgetItem(QString::fromStdString(mn.addr.ToString()));
@@ -0,0 +1,314 @@
+// Copyright (c) 2017 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "reindex.h"
+
+#include "chain.h"
+#include "chainparams.h"
+#include "clientversion.h"
+#include "consensus/consensus.h"
+#include "consensus/validation.h"
+#include "primitives/block.h"
+#include "streams.h"
+#include "util.h"
+#include "utiltime.h"
+#include "validation.h"
+
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
+
+namespace {
+
+/** A block found in a block file, on its way from the reader to the storing thread */
+struct CReindexBlock
+{
+    CDiskBlockPos pos;
+    //! The serialized block, freed once decoded
+    std::vector<char> vchData;
+    //! NULL if the block failed to deserialize
+    std::shared_ptr<CBlock> pblock;
+    //! Bytes counted against REINDEX_MAX_BUFFERED_BYTES
+    size_t nBytes;
+    bool fDecoded;
+
+    CReindexBlock() : nBytes(0), fDecoded(false) {}
+};
+
+struct CReindexFile
+{
+    //! The blocks found so far, in file order. A deque, so they never move.
+    std::deque<CReindexBlock> blocks;
+    //! Whether the reader got to the end of the file
+    bool fRead;
+
+    CReindexFile() : fRead(false) {}
+};
+
+class CReindexPipeline
+{
+private:
+    const CChainParams& chainparams;
+
+    //! Protects everything below
+    boost::mutex mutex;
+    boost::condition_variable condReader;
+    boost::condition_variable condDecoder;
+    boost::condition_variable condConnector;
+
+    std::map<int, CReindexFile> mapFiles;
+    std::deque<CReindexBlock*> queueDecode;
+
+    //! The next file to read, the file being stored and the first file that does not exist
+    int nReadFile;
+    int nConnectFile;
+    int nEndFile;
+
+    size_t nBufferedBytes;
+    bool fStop;
+
+    /** Hand a block over to the decoders. Returns false if the pipeline is stopping. */
+    bool PushBlock(int nFile, uint64_t nPos, std::vector<char>& vchData)
+    {
+        boost::unique_lock<boost::mutex> lock(mutex);
+        // Only readers ahead of the file being stored wait for room, so that file always makes progress
+        while (!fStop && nFile != nConnectFile && nBufferedBytes + vchData.size() > REINDEX_MAX_BUFFERED_BYTES)
+            condReader.wait(lock);
+        if (fStop)
+            return false;
+        CReindexFile& file = mapFiles[nFile];
+        file.blocks.push_back(CReindexBlock());
+        CReindexBlock& block = file.blocks.back();
+        block.pos = CDiskBlockPos(nFile, nPos);
+        block.nBytes = vchData.size();
+        block.vchData.swap(vchData);
+        nBufferedBytes += block.nBytes;
+        queueDecode.push_back(&block);
+        condDecoder.notify_one();
+        return true;
+    }
+
+    /** Scan a block file for blocks, as LoadExternalBlockFile does. Returns false if the file does not exist. */
+    bool ReadFile(int nFile)
+    {
+        CDiskBlockPos pos(nFile, 0);
+        FILE* fileIn = NULL;
+        if (boost::filesystem::exists(GetBlockPosFilename(pos, "blk")))
+            fileIn = OpenBlockFile(pos, true);
+        if (!fileIn) {
+            // No block files left to reindex, or an error logged in OpenBlockFile
+            boost::unique_lock<boost::mutex> lock(mutex);
+            nEndFile = std::min(nEndFile, nFile);
+            condConnector.notify_all();
+            condReader.notify_all();
+            return false;
+        }
+
+        LogPrintf("Reindexing block file blk%05u.dat...\n", (unsigned int)nFile);
+        try {
+            unsigned int nMaxBlockSize = MaxBlockSize(true);
+            // This takes over fileIn and calls fclose() on it in the CBufferedFile destructor
+            CBufferedFile blkdat(fileIn, 2*nMaxBlockSize, nMaxBlockSize+8, SER_DISK, CLIENT_VERSION);
+            uint64_t nRewind = blkdat.GetPos();
+            while (!blkdat.eof()) {
+                blkdat.SetPos(nRewind);
+                nRewind++; // start one byte further next time, in case of failure
+                blkdat.SetLimit(); // remove former limit
+                unsigned int nSize = 0;
+                try {
+                    // locate a header
+                    unsigned char buf[MESSAGE_START_SIZE];
+                    blkdat.FindByte(chainparams.MessageStart()[0]);
+                    nRewind = blkdat.GetPos()+1;
+                    blkdat >> FLATDATA(buf);
+                    if (memcmp(buf, chainparams.MessageStart(), MESSAGE_START_SIZE))
+                        continue;
+                    // read size
+                    blkdat >> nSize;
+                    if (nSize < 80 || nSize > nMaxBlockSize)
+                        continue;
+                } catch (const std::exception&) {
+                    // no valid block header found; don't complain
+                    break;
+                }
+                try {
+                    // read block
+                    uint64_t nBlockPos = blkdat.GetPos();
+                    blkdat.SetLimit(nBlockPos + nSize);
+                    std::vector<char> vchData(nSize);
+                    blkdat.read(vchData.data(), nSize);
+                    nRewind = blkdat.GetPos();
+                    if (!PushBlock(nFile, nBlockPos, vchData))
+                        return true;
+                } catch (const std::exception& e) {
+                    LogPrintf("%s: I/O error - %s\n", __func__, e.what());
+                }
+            }
+        } catch (const std::runtime_error& e) {
+            error("%s: System error: %s", __func__, e.what());
+            Stop();
+            return true;
+        }
+
+        boost::unique_lock<boost::mutex> lock(mutex);
+        mapFiles[nFile].fRead = true;
+        condConnector.notify_all();
+        return true;
+    }
+
+public:
+    CReindexPipeline(const CChainParams& chainparamsIn) : chainparams(chainparamsIn), nReadFile(0), nConnectFile(0),
+        nEndFile(std::numeric_limits<int>::max()), nBufferedBytes(0), fStop(false) {}
+
+    void ReaderThread()
+    {
+        RenameThread("time-reindexrd");
+        while (true) {
+            int nFile;
+            {
+                boost::unique_lock<boost::mutex> lock(mutex);
+                while (!fStop && nReadFile < nEndFile && nReadFile >= nConnectFile + REINDEX_READ_AHEAD_FILES)
+                    condReader.wait(lock);
+                if (fStop || nReadFile >= nEndFile)
+                    return;
+                nFile = nReadFile++;
+            }
+            if (!ReadFile(nFile))
+                return;
+        }
+    }
+
+    void DecoderThread()
+    {
+        RenameThread("time-reindexdec");
+        while (true) {
+            CReindexBlock* pentry;
+            std::vector<char> vchData;
+            {
+                boost::unique_lock<boost::mutex> lock(mutex);
+                while (!fStop && queueDecode.empty())
+                    condDecoder.wait(lock);
+                if (fStop)
+                    return;
+                pentry = queueDecode.front();
+                queueDecode.pop_front();
+                vchData.swap(pentry->vchData);
+            }
+
+            std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
+            try {
+                CDataStream ssBlock(vchData, SER_DISK, CLIENT_VERSION);
+                ssBlock >> *pblock;
+                // Hash the header, transactions and merkle root here rather than
+                // on the storing thread: a block that passes is marked checked,
+                // so AcceptBlock does not check it again
+                CValidationState state;
+                CheckBlock(*pblock, state);
+            } catch (const std::exception& e) {
+                LogPrintf("%s: Deserialize error - %s\n", __func__, e.what());
+                pblock.reset();
+            }
+            std::vector<char>().swap(vchData);
+
+            boost::unique_lock<boost::mutex> lock(mutex);
+            pentry->pblock = pblock;
+            pentry->fDecoded = true;
+            condConnector.notify_all();
+        }
+    }
+
+    /** Store the blocks in file order on the calling thread. Returns false if a reader failed. */
+    bool Connect()
+    {
+        int64_t nStart = GetTIMECoinMillis();
+        int nLoaded = 0;
+        for (int nFile = 0; ; nFile++) {
+            int64_t nFileStart = GetTIMECoinMillis();
+            int nFileLoaded = 0;
+            bool fSkip = false;
+            size_t nBlocks = 0;
+            while (true) {
+                CReindexBlock* pentry;
+                {
+                    boost::unique_lock<boost::mutex> lock(mutex);
+                    CReindexFile& file = mapFiles[nFile];
+                    while (!fStop && nFile < nEndFile && !(nBlocks < file.blocks.size() && file.blocks[nBlocks].fDecoded) &&
+                           !(file.fRead && nBlocks == file.blocks.size()))
+                        condConnector.wait(lock);
+                    if (fStop)
+                        return false;
+                    if (nFile >= nEndFile) {
+                        LogPrintf("Reindexing stored %d blocks in %ds (%.1f blocks/s)\n", nLoaded, (GetTIMECoinMillis() - nStart) / 1000,
+                            nLoaded * 1000.0 / std::max<int64_t>(GetTIMECoinMillis() - nStart, 1));
+                        return true;
+                    }
+                    if (nBlocks == file.blocks.size())
+                        break;
+                    pentry = &file.blocks[nBlocks];
+                }
+
+                // As in LoadExternalBlockFile, an error ends the file being stored
+                if (!fSkip && pentry->pblock) {
+                    int nLoadedBefore = nLoaded;
+                    fSkip = !ImportBlock(chainparams, *pentry->pblock, &pentry->pos, nLoaded);
+                    nFileLoaded += nLoaded - nLoadedBefore;
+                }
+                nBlocks++;
+
+                boost::unique_lock<boost::mutex> lock(mutex);
+                pentry->pblock.reset();
+                nBufferedBytes -= pentry->nBytes;
+                condReader.notify_all();
+            }
+
+            int64_t nFileTime = GetTIMECoinMillis() - nFileStart;
+            LogPrintf("Reindexed blk%05u.dat: %u blocks found, %d stored in %dms (%.1f blocks/s), %d stored in total\n",
+                (unsigned int)nFile, nBlocks, nFileLoaded, nFileTime, nFileLoaded * 1000.0 / std::max<int64_t>(nFileTime, 1), nLoaded);
+
+            boost::unique_lock<boost::mutex> lock(mutex);
+            mapFiles.erase(nFile);
+            nConnectFile = nFile + 1;
+            condReader.notify_all();
+        }
+    }
+
+    void Stop()
+    {
+        boost::unique_lock<boost::mutex> lock(mutex);
+        fStop = true;
+        condReader.notify_all();
+        condDecoder.notify_all();
+        condConnector.notify_all();
+    }
+};
+
+}
+
+bool ReindexBlockFiles(const CChainParams& chainparams, int nThreads)
+{
+    CReindexPipeline pipeline(chainparams);
+    boost::thread_group threads;
+    for (int i = 0; i < REINDEX_READ_AHEAD_FILES; i++)
+        threads.create_thread(boost::bind(&CReindexPipeline::ReaderThread, &pipeline));
+    for (int i = 0; i < std::max(nThreads, 1); i++)
+        threads.create_thread(boost::bind(&CReindexPipeline::DecoderThread, &pipeline));
+
+    bool fResult;
+    try {
+        fResult = pipeline.Connect();
+    } catch (...) {
+        pipeline.Stop();
+        threads.join_all();
+        throw;
+    }
+    pipeline.Stop();
+    threads.join_all();
+    return fResult;
+}
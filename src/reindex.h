@@ -0,0 +1,33 @@
+// Copyright (c) 2017 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_REINDEX_H
+#define BITCOIN_REINDEX_H
+
+#include <stddef.h>
+
+class CChainParams;
+
+/** Most threads decoding and checking blocks during -reindex */
+static const int MAX_REINDEX_THREADS = 8;
+/** Block files being read at the same time, the one being stored included */
+static const int REINDEX_READ_AHEAD_FILES = 3;
+/** Bytes of blocks read ahead of the block file being stored, beyond which the readers of later files wait */
+static const size_t REINDEX_MAX_BUFFERED_BYTES = 256 << 20;
+
+/**
+ * Rebuild the block index from the blk?????.dat files (-reindex).
+ *
+ * Each block file is scanned for blocks by a reader thread of its own, up to
+ * REINDEX_READ_AHEAD_FILES files at a time. nThreads threads deserialize the
+ * blocks found and run CheckBlock on them, which hashes their transactions
+ * and merkle root, and the calling thread stores them in file order, exactly
+ * as LoadExternalBlockFile would have.
+ *
+ * Returns false if a block file could not be read, in which case the reindex
+ * is left to be resumed on the next start.
+ */
+bool ReindexBlockFiles(const CChainParams& chainparams, int nThreads);
+
+#endif // BITCOIN_REINDEX_H
@@ -9,6 +9,7 @@
 #include "chainparams.h"
 #include "checkpoints.h"
 #include "coins.h"
+#include "coinstats.h"
 #include "consensus/validation.h"
 #include "validation.h"
 #include "policy/policy.h"
@@ -20,12 +21,16 @@
 #include "txmempool.h"
 #include "util.h"
 #include "utilstrencodings.h"
+#include "utxosnapshot.h"
 #include "hash.h"
+#include "indexwriter.h"
 
 #include <stdint.h>
 
 #include <univalue.h>
 
+#include <boost/filesystem.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/thread/thread.hpp> // boost::thread::interrupt
 
 using namespace std;
@@ -554,107 +559,315 @@ UniValue getblock(const UniValue& params, bool fHelp)
     return blockToJSON(block, pblockindex);
 }
 
-struct CCoinsStats
+UniValue gettxoutsetinfo(const UniValue& params, bool fHelp)
 {
-    int nHeight;
-    uint256 hashBlock;
-    uint64_t nTransactions;
-    uint64_t nTransactionOutputs;
-    uint256 hashSerialized;
-    uint64_t nDiskSize;
-    CAmount nTotalAmount;
-
-    CCoinsStats() : nHeight(0), nTransactions(0), nTransactionOutputs(0), nTotalAmount(0) {}
-};
+    if (fHelp || params.size() > 1)
+        throw runtime_error(
+            "gettxoutsetinfo ( \"hash_type\" )\n"
+            "\nReturns statistics about the unspent transaction output set.\n"
+            "Note this call may take some time, unless -coinstatsindex answers it.\n"
+            "\nArguments:\n"
+            "1. \"hash_type\"  (string, optional, default=\"hash_serialized_2\") Which UTXO set hash to calculate: \"hash_serialized_2\" or \"muhash\".\n"
+            "                 With -coinstatsindex synced, \"muhash\" is read from the index instead of scanning the set.\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"height\":n,     (numeric) The current block height (index)\n"
+            "  \"bestblock\": \"hex\",   (string) the best block hash hex\n"
+            "  \"transactions\": n,      (numeric) The number of transactions, unless read from the index\n"
+            "  \"txouts\": n,            (numeric) The number of output transactions\n"
+            "  \"hash_serialized_2\": \"hash\",   (string) The serialized hash, for hash_type \"hash_serialized_2\"\n"
+            "  \"muhash\": \"hash\",      (string) The MuHash of the set, for hash_type \"muhash\"\n"
+            "  \"disk_size\": n,         (numeric) The estimated size of the chainstate on disk\n"
+            "  \"total_amount\": x.xxx          (numeric) The total amount\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("gettxoutsetinfo", "")
+            + HelpExampleCli("gettxoutsetinfo", "\"muhash\"")
+            + HelpExampleRpc("gettxoutsetinfo", "")
+        );
 
-static void ApplyStats(CCoinsStats &stats, CHashWriter& ss, const uint256& hash, const std::map<uint32_t, Coin>& outputs)
-{
-    assert(!outputs.empty());
-    ss << hash;
-    ss << VARINT(outputs.begin()->second.nHeight * 2 + outputs.begin()->second.fCoinBase);
-    stats.nTransactions++;
-    for (const auto output : outputs) {
-        ss << VARINT(output.first + 1);
-        ss << *(const CScriptBase*)(&output.second.out.scriptPubKey);
-        ss << VARINT(output.second.out.nValue);
-        stats.nTransactionOutputs++;
-        stats.nTotalAmount += output.second.out.nValue;
+    CoinStatsHashType hashType = COINSTATS_HASH_SERIALIZED;
+    if (params.size() > 0) {
+        const std::string strHashType = params[0].get_str();
+        if (strHashType == "muhash")
+            hashType = COINSTATS_HASH_MUHASH;
+        else if (strHashType != "hash_serialized_2")
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Unknown hash_type " + strHashType);
+    }
+
+    UniValue ret(UniValue::VOBJ);
+
+    CCoinsStats stats;
+    bool fFromIndex = hashType == COINSTATS_HASH_MUHASH && GetUTXOStatsFromIndex(stats);
+    if (!fFromIndex) {
+        FlushStateToDisk();
+        if (!GetUTXOStats(pcoinsdbview, stats, hashType, GetNumCores()))
+            return ret;
     }
-    ss << VARINT(0);
+    ret.push_back(Pair("height", (int64_t)stats.nHeight));
+    ret.push_back(Pair("bestblock", stats.hashBlock.GetHex()));
+    if (!fFromIndex)
+        ret.push_back(Pair("transactions", (int64_t)stats.nTransactions));
+    ret.push_back(Pair("txouts", (int64_t)stats.nTransactionOutputs));
+    if (hashType == COINSTATS_HASH_SERIALIZED)
+        ret.push_back(Pair("hash_serialized_2", stats.hashSerialized.GetHex()));
+    else
+        ret.push_back(Pair("muhash", stats.hashMuHash.GetHex()));
+    ret.push_back(Pair("disk_size", stats.nDiskSize));
+    ret.push_back(Pair("total_amount", ValueFromAmount(stats.nTotalAmount)));
+    return ret;
 }
 
-//! Calculate statistics about the unspent transaction output set
-static bool GetUTXOStats(CCoinsView *view, CCoinsStats &stats)
+static UniValue SnapshotToJSON(const CUTXOSnapshotHeader& header, const boost::filesystem::path& path)
 {
-    boost::scoped_ptr<CCoinsViewCursor> pcursor(view->Cursor());
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("path", path.string()));
+    ret.push_back(Pair("base_hash", header.hashBlock.GetHex()));
+    ret.push_back(Pair("base_height", (int64_t)header.nHeight));
+    ret.push_back(Pair("coins", (int64_t)header.nCoins));
+    ret.push_back(Pair("chunks", (int64_t)header.nChunks));
+    ret.push_back(Pair("hash_serialized_2", header.hashSerialized.GetHex()));
+    return ret;
+}
+
+UniValue dumptxoutset(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() != 1)
+        throw runtime_error(
+            "dumptxoutset \"path\"\n"
+            "\nWrites the unspent transaction output set at the current tip to a file, which loadtxoutset can load.\n"
+            "Note this call may take some time.\n"
+            "\nArguments:\n"
+            "1. \"path\"      (string, required) The file to write, relative to the data directory unless absolute. It must not exist.\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"path\": \"path\",            (string) The file written\n"
+            "  \"base_hash\": \"hash\",       (string) The block the set was taken at\n"
+            "  \"base_height\": n,          (numeric) Its height\n"
+            "  \"coins\": n,                (numeric) The number of unspent outputs written\n"
+            "  \"chunks\": n,               (numeric) The number of chunks they were written in\n"
+            "  \"hash_serialized_2\": \"hash\" (string) The hash gettxoutsetinfo reports at the base block\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("dumptxoutset", "\"utxo.dat\"")
+            + HelpExampleRpc("dumptxoutset", "\"utxo.dat\"")
+        );
+
+    boost::filesystem::path path = boost::filesystem::absolute(params[0].get_str(), GetDataDir());
+
+    CUTXOSnapshotHeader header;
+    CCoinsStats stats;
+    std::string strError;
+    if (!DumpUTXOSnapshot(pcoinsdbview, path, header, stats, strError))
+        throw JSONRPCError(RPC_MISC_ERROR, strError);
+    return SnapshotToJSON(header, path);
+}
+
+UniValue loadtxoutset(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() < 1 || params.size() > 2)
+        throw runtime_error(
+            "loadtxoutset \"path\" ( \"expected_hash\" )\n"
+            "\nLoads an unspent transaction output set written by dumptxoutset and makes its block the tip,\n"
+            "so the node only has to download and validate the blocks after it.\n"
+            "The node must have the snapshot block's header, an empty chainstate and no -txindex or explorer indexes.\n"
+            "The blocks below the snapshot are never downloaded: they cannot be served to peers or reorganized away.\n"
+            "Without expected_hash the file is only checked for consistency with itself, so only load files from a trusted source.\n"
+            "\nArguments:\n"
+            "1. \"path\"          (string, required) The file to load, relative to the data directory unless absolute\n"
+            "2. \"expected_hash\" (string, optional) The hash_serialized_2 a trusted node's gettxoutsetinfo reports at the snapshot block\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"path\": \"path\",            (string) The file loaded\n"
+            "  \"base_hash\": \"hash\",       (string) The new tip\n"
+            "  \"base_height\": n,          (numeric) Its height\n"
+            "  \"coins\": n,                (numeric) The number of unspent outputs loaded\n"
+            "  \"chunks\": n,               (numeric) The number of chunks they were loaded from\n"
+            "  \"hash_serialized_2\": \"hash\" (string) The hash of the set loaded\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("loadtxoutset", "\"utxo.dat\"")
+            + HelpExampleRpc("loadtxoutset", "\"utxo.dat\", \"a2b3...\"")
+        );
 
-    CHashWriter ss(SER_GETHASH, PROTOCOL_VERSION);
-    stats.hashBlock = pcursor->GetBestBlock();
+    boost::filesystem::path path = boost::filesystem::absolute(params[0].get_str(), GetDataDir());
+    uint256 hashExpected;
+    if (params.size() > 1)
+        hashExpected = ParseHashV(params[1], "expected_hash");
+
+    if (fTxIndex || fAddressIndex || fSpentIndex || fTIMECoinstampIndex || fAddressBalanceIndex || fCoinStatsIndex)
+        throw JSONRPCError(RPC_MISC_ERROR, "Cannot load a UTXO snapshot with -txindex or an explorer index enabled");
+
+    CUTXOSnapshotHeader header;
+    std::string strError;
+    if (!ReadUTXOSnapshotHeader(path, header, strError))
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strError);
+
+    CBlockIndex* pindexBase;
     {
         LOCK(cs_main);
-        stats.nHeight = mapBlockIndex.find(stats.hashBlock)->second->nHeight;
-    }
-    ss << stats.hashBlock;
-    uint256 prevkey;
-    std::map<uint32_t, Coin> outputs;
-    while (pcursor->Valid()) {
-        boost::this_thread::interruption_point();
-        COutPoint key;
-        Coin coin;
-        if (pcursor->GetKey(key) && pcursor->GetValue(coin)) {
-            if (!outputs.empty() && key.hash != prevkey) {
-                ApplyStats(stats, ss, prevkey, outputs);
-                outputs.clear();
-            }
-            prevkey = key.hash;
-            outputs[key.n] = std::move(coin);
-        } else {
-            return error("%s: unable to read value", __func__);
+        if (chainActive.Height() > 0)
+            throw JSONRPCError(RPC_MISC_ERROR, "The chainstate is past the genesis block; start with an empty data directory");
+        BlockMap::iterator it = mapBlockIndex.find(header.hashBlock);
+        if (it == mapBlockIndex.end() || !it->second->IsValid(BLOCK_VALID_TREE))
+            throw JSONRPCError(RPC_MISC_ERROR, "The snapshot block's header is not known yet; wait for the headers to sync");
+        pindexBase = it->second;
+        if (pindexBase->nHeight != header.nHeight)
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "The snapshot header does not match the block index");
+        if (!CheckUTXOSnapshotBase(pindexBase, header.nTx, header.nChainTx, strError))
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid snapshot: " + strError);
+
+        FlushStateToDisk();
+        {
+            boost::scoped_ptr<CCoinsViewCursor> pcursor(pcoinsdbview->Cursor());
+            if (pcursor->Valid())
+                throw JSONRPCError(RPC_MISC_ERROR, "The chainstate is not empty");
         }
-        pcursor->Next();
+        // From here on no block is connected and nothing is flushed to the chainstate, which the
+        // load writes to without cs_main, so the node carries on syncing headers and blocks meanwhile
+        if (fLoadingUTXOSnapshot.exchange(true))
+            throw JSONRPCError(RPC_MISC_ERROR, "A snapshot is already being loaded");
+    }
+
+    CCoinsStats stats;
+    bool fLoaded;
+    try {
+        fLoaded = LoadUTXOSnapshot(pcoinsdbview, path, hashExpected, header, stats, strError);
+    } catch (...) {
+        fLoadingUTXOSnapshot = false;
+        throw;
     }
-    if (!outputs.empty()) {
-        ApplyStats(stats, ss, prevkey, outputs);
+
+    CValidationState state;
+    {
+        LOCK(cs_main);
+        fLoadingUTXOSnapshot = false;
+        if (!fLoaded)
+            throw JSONRPCError(RPC_MISC_ERROR, strError);
+        if (!ActivateUTXOSnapshot(pindexBase, header.nTx, header.nChainTx))
+            throw JSONRPCError(RPC_DATABASE_ERROR, "Loaded the snapshot but could not make it the tip");
     }
-    stats.hashSerialized = ss.GetHash();
-    stats.nDiskSize = view->EstimateSize();
-    return true;
+    // Connect the blocks that arrived during the load
+    ActivateBestChain(state, Params());
+    return SnapshotToJSON(header, path);
 }
 
-UniValue gettxoutsetinfo(const UniValue& params, bool fHelp)
+UniValue getflushinfo(const UniValue& params, bool fHelp)
 {
     if (fHelp || params.size() != 0)
         throw runtime_error(
-            "gettxoutsetinfo\n"
-            "\nReturns statistics about the unspent transaction output set.\n"
-            "Note this call may take some time.\n"
+            "getflushinfo\n"
+            "\nReturns how long writing the chainstate to disk took, and how much was written.\n"
             "\nResult:\n"
             "{\n"
-            "  \"height\":n,     (numeric) The current block height (index)\n"
-            "  \"bestblock\": \"hex\",   (string) the best block hash hex\n"
-            "  \"transactions\": n,      (numeric) The number of transactions\n"
-            "  \"txouts\": n,            (numeric) The number of output transactions\n"
-            "  \"hash_serialized\": \"hash\",   (string) The serialized hash\n"
-            "  \"disk_size\": n,         (numeric) The estimated size of the chainstate on disk\n"
-            "  \"total_amount\": x.xxx          (numeric) The total amount\n"
+            "  \"background\": true|false,  (boolean) Whether a background flush is being written\n"
+            "  \"flushes\": n,              (numeric) The number of flushes written since startup\n"
+            "  \"last_duration_ms\": n,     (numeric) How long writing the last flush took\n"
+            "  \"last_changed\": n,         (numeric) The number of coins the last flush wrote or erased\n"
+            "  \"total_wait_ms\": n,        (numeric) How long block processing waited for background flushes to finish\n"
+            "  \"duration_ms\": [           (array) Histogram of flush durations\n"
+            "    {\n"
+            "      \"below\": n,            (numeric) Upper bound of the bucket in ms, absent for the last bucket\n"
+            "      \"count\": n             (numeric) The number of flushes in the bucket\n"
+            "    }, ...\n"
+            "  ],\n"
+            "  \"changed\": [ ... ]         (array) Histogram of coins written per flush, in the same format\n"
             "}\n"
             "\nExamples:\n"
-            + HelpExampleCli("gettxoutsetinfo", "")
-            + HelpExampleRpc("gettxoutsetinfo", "")
+            + HelpExampleCli("getflushinfo", "")
+            + HelpExampleRpc("getflushinfo", "")
         );
 
+    LOCK(cs_main);
+    CCoinsFlushStats stats = pcoinsdbview->GetFlushStats();
+
+    UniValue durations(UniValue::VARR);
+    UniValue changed(UniValue::VARR);
+    for (int i = 0; i < COINS_FLUSH_HISTOGRAM_BUCKETS; i++) {
+        UniValue duration(UniValue::VOBJ);
+        UniValue change(UniValue::VOBJ);
+        if (i < COINS_FLUSH_HISTOGRAM_BUCKETS - 1) {
+            duration.push_back(Pair("below", (int64_t)1 << i));
+            change.push_back(Pair("below", (int64_t)1000 << i));
+        }
+        duration.push_back(Pair("count", (uint64_t)stats.vDuration[i]));
+        change.push_back(Pair("count", (uint64_t)stats.vChanged[i]));
+        durations.push_back(duration);
+        changed.push_back(change);
+    }
+
     UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("background", pcoinsdbview->IsFlushing()));
+    ret.push_back(Pair("flushes", (uint64_t)stats.nFlushes));
+    ret.push_back(Pair("last_duration_ms", stats.nLastDuration));
+    ret.push_back(Pair("last_changed", (uint64_t)stats.nLastChanged));
+    ret.push_back(Pair("total_wait_ms", stats.nTotalWait));
+    ret.push_back(Pair("duration_ms", durations));
+    ret.push_back(Pair("changed", changed));
+    return ret;
+}
 
-    CCoinsStats stats;
-    FlushStateToDisk();
-    if (GetUTXOStats(pcoinsdbview, stats)) {
-        ret.push_back(Pair("height", (int64_t)stats.nHeight));
-        ret.push_back(Pair("bestblock", stats.hashBlock.GetHex()));
-        ret.push_back(Pair("transactions", (int64_t)stats.nTransactions));
-        ret.push_back(Pair("txouts", (int64_t)stats.nTransactionOutputs));
-        ret.push_back(Pair("hash_serialized_2", stats.hashSerialized.GetHex()));
-        ret.push_back(Pair("disk_size", stats.nDiskSize));
-        ret.push_back(Pair("total_amount", ValueFromAmount(stats.nTotalAmount)));
+static UniValue DBInfoToJSON(const CDBWrapper& db)
+{
+    const CDBOptions& options = db.GetDBOptions();
+    UniValue settings(UniValue::VOBJ);
+    settings.push_back(Pair("cache", (uint64_t)db.GetCacheSize()));
+    settings.push_back(Pair("compression", options.fCompression));
+    settings.push_back(Pair("bloombits", options.nBloomBits));
+    settings.push_back(Pair("writebuffer", (uint64_t)(options.nWriteBufferSize ? options.nWriteBufferSize : db.GetCacheSize() / 4)));
+    settings.push_back(Pair("maxopenfiles", options.nMaxOpenFiles));
+    settings.push_back(Pair("blocksize", (uint64_t)options.nBlockSize));
+
+    UniValue files(UniValue::VARR);
+    for (int nLevel = 0; ; nLevel++) {
+        std::string strFiles = db.GetProperty(strprintf("leveldb.num-files-at-level%d", nLevel));
+        if (strFiles.empty())
+            break;
+        files.push_back(atoi(strFiles));
+    }
+
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("options", settings));
+    ret.push_back(Pair("approximate_size", (uint64_t)db.EstimateTotalSize()));
+    ret.push_back(Pair("files_per_level", files));
+    ret.push_back(Pair("stats", db.GetProperty("leveldb.stats")));
+    return ret;
+}
+
+UniValue getdbinfo(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() != 0)
+        throw runtime_error(
+            "getdbinfo\n"
+            "\nReturns the settings and LevelDB statistics of the chainstate, block index and explorer index databases.\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"name\": {                 (object) The database: chainstate, blockindex, or the name of an explorer index\n"
+            "    \"options\": {            (object) The settings in use, see -dboption\n"
+            "      \"cache\": n,           (numeric) Bytes of cache given to the database\n"
+            "      \"compression\": true|false,\n"
+            "      \"bloombits\": n,\n"
+            "      \"writebuffer\": n,     (numeric) In bytes\n"
+            "      \"maxopenfiles\": n,\n"
+            "      \"blocksize\": n        (numeric) In bytes\n"
+            "    },\n"
+            "    \"approximate_size\": n,  (numeric) Approximate size on disk in bytes\n"
+            "    \"files_per_level\": [ n, ... ], (array) The number of table files at each level\n"
+            "    \"stats\": \"...\"          (string) The leveldb.stats report of compactions per level\n"
+            "  }, ...\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getdbinfo", "")
+            + HelpExampleRpc("getdbinfo", "")
+        );
+
+    LOCK(cs_main);
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("chainstate", DBInfoToJSON(pcoinsdbview->GetDB())));
+    ret.push_back(Pair("blockindex", DBInfoToJSON(*pblocktree)));
+    for (int i = 0; i < INDEX_COUNT; i++) {
+        if (explorerIndexes[i].pdb)
+            ret.push_back(Pair(explorerIndexes[i].name, DBInfoToJSON(*explorerIndexes[i].pdb)));
     }
     return ret;
 }
@@ -6,11 +6,13 @@
 
 #include "base58.h"
 #include "clientversion.h"
+#include "indexwriter.h"
 #include "init.h"
 #include "net.h"
 #include "netbase.h"
 #include "rpc/server.h"
 #include "timedata.h"
+#include "txdb.h"
 #include "txmempool.h"
 #include "util.h"
 #include "utilstrencodings.h"
@@ -32,6 +34,9 @@
 
 using namespace std;
 
+/** Largest page getaddressdeltas, getaddresstxids and getaddressutxos return */
+static const int MAX_ADDRESS_PAGE_LIMIT = 100000;
+
 /**
  * @note Do not add or change anything in the information returned by this
  * method. `getinfo` exists for backwards-compatibility only. It combines
@@ -162,6 +167,12 @@ UniValue mnsync(const UniValue& params, bool fHelp)
         objStatus.push_back(Pair("IsWinnersListSynced", masternodeSync.IsWinnersListSynced()));
         objStatus.push_back(Pair("IsSynced", masternodeSync.IsSynced()));
         objStatus.push_back(Pair("IsFailed", masternodeSync.IsFailed()));
+        // milliseconds each asset completed in so far
+        UniValue objAssetSyncMillis(UniValue::VOBJ);
+        for(const auto& assetpair : masternodeSync.GetAssetSyncMillis()) {
+            objAssetSyncMillis.push_back(Pair(CMasternodeSync::GetAssetName(assetpair.first), assetpair.second));
+        }
+        objStatus.push_back(Pair("AssetSyncMillis", objAssetSyncMillis));
         return objStatus;
     }
 
@@ -589,6 +600,109 @@ bool timestampSort(std::pair<CMempoolAddressDeltaKey, CMempoolAddressDelta> a,
     return a.second.time < b.second.time;
 }
 
+/**
+ * Read the optional "limit" and "cursor" paging parameters. Returns whether a page was requested.
+ * The cursor is where the previous page ended, serialized as a Key.
+ */
+template<typename Key>
+static bool getPageLimitFromParams(const UniValue& params, size_t& nLimit, bool& fCursor, Key& cursor)
+{
+    nLimit = 0;
+    fCursor = false;
+    if (!params[0].isObject())
+        return false;
+
+    UniValue limitValue = find_value(params[0].get_obj(), "limit");
+    UniValue cursorValue = find_value(params[0].get_obj(), "cursor");
+    if (limitValue.isNull()) {
+        if (!cursorValue.isNull())
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "cursor requires limit");
+        return false;
+    }
+
+    int limit = limitValue.get_int();
+    if (limit < 1 || limit > MAX_ADDRESS_PAGE_LIMIT)
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("limit must be between 1 and %d", MAX_ADDRESS_PAGE_LIMIT));
+    nLimit = limit;
+
+    if (!cursorValue.isNull()) {
+        std::vector<unsigned char> data(ParseHexV(cursorValue, "cursor"));
+        CDataStream ssCursor(data, SER_DISK, CLIENT_VERSION);
+        try {
+            ssCursor >> cursor;
+        } catch (const std::exception&) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid cursor");
+        }
+        fCursor = true;
+    }
+    return true;
+}
+
+/**
+ * As getPageLimitFromParams, for a cursor that is the database key of the last entry of the previous
+ * page. nFirstAddress is set to the address it belongs to, where the page resumes.
+ */
+template<typename Key>
+static bool getPageFromParams(const UniValue& params, const std::vector<std::pair<uint160, int> >& addresses,
+                              size_t& nLimit, bool& fCursor, Key& cursor, size_t& nFirstAddress)
+{
+    nFirstAddress = 0;
+    if (!getPageLimitFromParams(params, nLimit, fCursor, cursor))
+        return false;
+
+    if (fCursor) {
+        for (nFirstAddress = 0; nFirstAddress < addresses.size(); nFirstAddress++) {
+            if (addresses[nFirstAddress].first == cursor.hashBytes && addresses[nFirstAddress].second == (int)cursor.type)
+                break;
+        }
+        if (nFirstAddress == addresses.size())
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Cursor does not belong to any of the addresses");
+    }
+    return true;
+}
+
+template<typename Key>
+static std::string encodePageCursor(const Key& key)
+{
+    CDataStream ssCursor(SER_DISK, CLIENT_VERSION);
+    ssCursor << key;
+    return HexStr(ssCursor.begin(), ssCursor.end());
+}
+
+static UniValue addressDeltaToJSON(const CAddressIndexKey& key, CAmount amount)
+{
+    std::string address;
+    if (!getAddressFromIndex(key.type, key.hashBytes, address)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Unknown address type");
+    }
+
+    UniValue delta(UniValue::VOBJ);
+    delta.push_back(Pair("satoshis", amount));
+    delta.push_back(Pair("txid", key.txhash.GetHex()));
+    delta.push_back(Pair("index", (int)key.index));
+    delta.push_back(Pair("blockindex", (int)key.txindex));
+    delta.push_back(Pair("height", key.blockHeight));
+    delta.push_back(Pair("address", address));
+    return delta;
+}
+
+static UniValue addressUnspentToJSON(const CAddressUnspentKey& key, const CAddressUnspentValue& value)
+{
+    std::string address;
+    if (!getAddressFromIndex(key.type, key.hashBytes, address)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Unknown address type");
+    }
+
+    UniValue output(UniValue::VOBJ);
+    output.push_back(Pair("address", address));
+    output.push_back(Pair("txid", key.txhash.GetHex()));
+    output.push_back(Pair("outputIndex", (int)key.index));
+    output.push_back(Pair("script", HexStr(value.script.begin(), value.script.end())));
+    output.push_back(Pair("satoshis", value.satoshis));
+    output.push_back(Pair("height", value.blockHeight));
+    return output;
+}
+
 UniValue getaddressmempool(const UniValue& params, bool fHelp)
 {
     if (fHelp || params.size() != 1)
@@ -673,6 +787,8 @@ UniValue getaddressutxos(const UniValue& params, bool fHelp)
             "      \"address\"  (string) The base58check encoded address\n"
             "      ,...\n"
             "    ]\n"
+            "  \"limit\" (number, optional) Return a page of at most this many outputs\n"
+            "  \"cursor\" (string, optional) The cursor returned with the previous page\n"
             "}\n"
             "\nResult\n"
             "[\n"
@@ -685,8 +801,14 @@ UniValue getaddressutxos(const UniValue& params, bool fHelp)
             "    \"height\"  (number) The block height\n"
             "  }\n"
             "]\n"
+            "\nResult (with limit)\n"
+            "{\n"
+            "  \"utxos\"  (array) The outputs as above, per address in index order rather than by height\n"
+            "  \"cursor\"  (string) Pass this to get the next page; only present if there are more outputs\n"
+            "}\n"
             "\nExamples:\n"
             + HelpExampleCli("getaddressutxos", "'{\"addresses\": [\"XwnLY9Tf7Zsef8gMGL2fhWA9ZmMjt4KPwg\"]}'")
+            + HelpExampleCli("getaddressutxos", "'{\"addresses\": [\"XwnLY9Tf7Zsef8gMGL2fhWA9ZmMjt4KPwg\"], \"limit\": 1000}'")
             + HelpExampleRpc("getaddressutxos", "{\"addresses\": [\"XwnLY9Tf7Zsef8gMGL2fhWA9ZmMjt4KPwg\"]}")
         );
 
@@ -696,6 +818,37 @@ UniValue getaddressutxos(const UniValue& params, bool fHelp)
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address");
     }
 
+    size_t nLimit, nFirstAddress;
+    bool fCursor;
+    CAddressUnspentKey cursor;
+    if (getPageFromParams(params, addresses, nLimit, fCursor, cursor, nFirstAddress)) {
+        // Read no further into the index than the page needs
+        UniValue utxos(UniValue::VARR);
+        CAddressUnspentKey keyLast;
+        bool fMore = false;
+        for (size_t i = nFirstAddress; i < addresses.size() && !fMore; i++) {
+            bool fOk = ForEachAddressUnspent(addresses[i].first, addresses[i].second, fCursor && i == nFirstAddress ? &cursor : NULL,
+                [&](const CAddressUnspentKey& key, const CAddressUnspentValue& value) {
+                    if (utxos.size() >= nLimit) {
+                        fMore = true;
+                        return false;
+                    }
+                    utxos.push_back(addressUnspentToJSON(key, value));
+                    keyLast = key;
+                    return true;
+                });
+            if (!fOk) {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
+            }
+        }
+
+        UniValue result(UniValue::VOBJ);
+        result.push_back(Pair("utxos", utxos));
+        if (fMore)
+            result.push_back(Pair("cursor", encodePageCursor(keyLast)));
+        return result;
+    }
+
     std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > unspentOutputs;
 
     for (std::vector<std::pair<uint160, int> >::iterator it = addresses.begin(); it != addresses.end(); it++) {
@@ -709,19 +862,7 @@ UniValue getaddressutxos(const UniValue& params, bool fHelp)
     UniValue result(UniValue::VARR);
 
     for (std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> >::const_iterator it=unspentOutputs.begin(); it!=unspentOutputs.end(); it++) {
-        UniValue output(UniValue::VOBJ);
-        std::string address;
-        if (!getAddressFromIndex(it->first.type, it->first.hashBytes, address)) {
-            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Unknown address type");
-        }
-
-        output.push_back(Pair("address", address));
-        output.push_back(Pair("txid", it->first.txhash.GetHex()));
-        output.push_back(Pair("outputIndex", (int)it->first.index));
-        output.push_back(Pair("script", HexStr(it->second.script.begin(), it->second.script.end())));
-        output.push_back(Pair("satoshis", it->second.satoshis));
-        output.push_back(Pair("height", it->second.blockHeight));
-        result.push_back(output);
+        result.push_back(addressUnspentToJSON(it->first, it->second));
     }
 
     return result;
@@ -742,6 +883,8 @@ UniValue getaddressdeltas(const UniValue& params, bool fHelp)
             "    ]\n"
             "  \"start\" (number) The start block height\n"
             "  \"end\" (number) The end block height\n"
+            "  \"limit\" (number, optional) Return a page of at most this many deltas\n"
+            "  \"cursor\" (string, optional) The cursor returned with the previous page\n"
             "}\n"
             "\nResult:\n"
             "[\n"
@@ -754,8 +897,14 @@ UniValue getaddressdeltas(const UniValue& params, bool fHelp)
             "    \"address\"  (string) The base58check encoded address\n"
             "  }\n"
             "]\n"
+            "\nResult (with limit):\n"
+            "{\n"
+            "  \"deltas\"  (array) The deltas as above\n"
+            "  \"cursor\"  (string) Pass this to get the next page; only present if there are more deltas\n"
+            "}\n"
             "\nExamples:\n"
             + HelpExampleCli("getaddressdeltas", "'{\"addresses\": [\"XwnLY9Tf7Zsef8gMGL2fhWA9ZmMjt4KPwg\"]}'")
+            + HelpExampleCli("getaddressdeltas", "'{\"addresses\": [\"XwnLY9Tf7Zsef8gMGL2fhWA9ZmMjt4KPwg\"], \"limit\": 1000}'")
             + HelpExampleRpc("getaddressdeltas", "{\"addresses\": [\"XwnLY9Tf7Zsef8gMGL2fhWA9ZmMjt4KPwg\"]}")
         );
 
@@ -780,38 +929,43 @@ UniValue getaddressdeltas(const UniValue& params, bool fHelp)
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address");
     }
 
-    std::vector<std::pair<CAddressIndexKey, CAmount> > addressIndex;
-
-    for (std::vector<std::pair<uint160, int> >::iterator it = addresses.begin(); it != addresses.end(); it++) {
-        if (start > 0 && end > 0) {
-            if (!GetAddressIndex((*it).first, (*it).second, addressIndex, start, end)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
-            }
-        } else {
-            if (!GetAddressIndex((*it).first, (*it).second, addressIndex)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
-            }
-        }
+    if (start <= 0 || end <= 0) {
+        start = 0;
+        end = 0;
     }
 
-    UniValue result(UniValue::VARR);
-
-    for (std::vector<std::pair<CAddressIndexKey, CAmount> >::const_iterator it=addressIndex.begin(); it!=addressIndex.end(); it++) {
-        std::string address;
-        if (!getAddressFromIndex(it->first.type, it->first.hashBytes, address)) {
-            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Unknown address type");
+    size_t nLimit, nFirstAddress;
+    bool fCursor;
+    CAddressIndexKey cursor;
+    bool fPaged = getPageFromParams(params, addresses, nLimit, fCursor, cursor, nFirstAddress);
+
+    // Deltas are turned into JSON straight from the index, without collecting them first
+    UniValue deltas(UniValue::VARR);
+    CAddressIndexKey keyLast;
+    bool fMore = false;
+    for (size_t i = nFirstAddress; i < addresses.size() && !fMore; i++) {
+        bool fOk = ForEachAddressIndex(addresses[i].first, addresses[i].second, start, end, fCursor && i == nFirstAddress ? &cursor : NULL,
+            [&](const CAddressIndexKey& key, CAmount amount) {
+                if (fPaged && deltas.size() >= nLimit) {
+                    fMore = true;
+                    return false;
+                }
+                deltas.push_back(addressDeltaToJSON(key, amount));
+                keyLast = key;
+                return true;
+            });
+        if (!fOk) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
         }
-
-        UniValue delta(UniValue::VOBJ);
-        delta.push_back(Pair("satoshis", it->second));
-        delta.push_back(Pair("txid", it->first.txhash.GetHex()));
-        delta.push_back(Pair("index", (int)it->first.index));
-        delta.push_back(Pair("blockindex", (int)it->first.txindex));
-        delta.push_back(Pair("height", it->first.blockHeight));
-        delta.push_back(Pair("address", address));
-        result.push_back(delta);
     }
 
+    if (!fPaged)
+        return deltas;
+
+    UniValue result(UniValue::VOBJ);
+    result.push_back(Pair("deltas", deltas));
+    if (fMore)
+        result.push_back(Pair("cursor", encodePageCursor(keyLast)));
     return result;
 }
 
@@ -833,6 +987,7 @@ UniValue getaddressbalance(const UniValue& params, bool fHelp)
             "{\n"
             "  \"balance\"  (string) The current balance in duffs\n"
             "  \"received\"  (string) The total number of duffs received (including change)\n"
+            "  \"txcount\"  (number) The number of transactions involving the address(es), counted per address\n"
             "}\n"
             "\nExamples:\n"
             + HelpExampleCli("getaddressbalance", "'{\"addresses\": [\"XwnLY9Tf7Zsef8gMGL2fhWA9ZmMjt4KPwg\"]}'")
@@ -845,27 +1000,39 @@ UniValue getaddressbalance(const UniValue& params, bool fHelp)
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address");
     }
 
-    std::vector<std::pair<CAddressIndexKey, CAmount> > addressIndex;
+    CAddressBalanceValue total;
 
     for (std::vector<std::pair<uint160, int> >::iterator it = addresses.begin(); it != addresses.end(); it++) {
-        if (!GetAddressIndex((*it).first, (*it).second, addressIndex)) {
-            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
+        // Use the running totals when -addressbalanceindex has them
+        CAddressBalanceValue value;
+        if (GetAddressBalance((*it).first, (*it).second, value)) {
+            total += value;
+            continue;
         }
-    }
 
-    CAmount balance = 0;
-    CAmount received = 0;
-
-    for (std::vector<std::pair<CAddressIndexKey, CAmount> >::const_iterator it=addressIndex.begin(); it!=addressIndex.end(); it++) {
-        if (it->second > 0) {
-            received += it->second;
+        uint256 txhashLast;
+        bool fOk = ForEachAddressIndex((*it).first, (*it).second, 0, 0, NULL,
+            [&](const CAddressIndexKey& key, CAmount amount) {
+                if (amount > 0) {
+                    total.received += amount;
+                }
+                total.balance += amount;
+                // A transaction's entries for an address are adjacent
+                if (key.txhash != txhashLast) {
+                    total.txCount++;
+                    txhashLast = key.txhash;
+                }
+                return true;
+            });
+        if (!fOk) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
         }
-        balance += it->second;
     }
 
     UniValue result(UniValue::VOBJ);
-    result.push_back(Pair("balance", balance));
-    result.push_back(Pair("received", received));
+    result.push_back(Pair("balance", total.balance));
+    result.push_back(Pair("received", total.received));
+    result.push_back(Pair("txcount", total.txCount));
 
     return result;
 
@@ -886,14 +1053,22 @@ UniValue getaddresstxids(const UniValue& params, bool fHelp)
             "    ]\n"
             "  \"start\" (number) The start block height\n"
             "  \"end\" (number) The end block height\n"
+            "  \"limit\" (number, optional) Return a page of at most this many txids\n"
+            "  \"cursor\" (string, optional) The cursor returned with the previous page\n"
             "}\n"
             "\nResult:\n"
             "[\n"
             "  \"transactionid\"  (string) The transaction id\n"
             "  ,...\n"
             "]\n"
+            "\nResult (with limit):\n"
+            "{\n"
+            "  \"txids\"  (array) The transaction ids, in the same order as without limit\n"
+            "  \"cursor\"  (string) Pass this to get the next page; only present if there are more txids\n"
+            "}\n"
             "\nExamples:\n"
             + HelpExampleCli("getaddresstxids", "'{\"addresses\": [\"XwnLY9Tf7Zsef8gMGL2fhWA9ZmMjt4KPwg\"]}'")
+            + HelpExampleCli("getaddresstxids", "'{\"addresses\": [\"XwnLY9Tf7Zsef8gMGL2fhWA9ZmMjt4KPwg\"], \"limit\": 1000}'")
             + HelpExampleRpc("getaddresstxids", "{\"addresses\": [\"XwnLY9Tf7Zsef8gMGL2fhWA9ZmMjt4KPwg\"]}")
         );
 
@@ -914,6 +1089,100 @@ UniValue getaddresstxids(const UniValue& params, bool fHelp)
         }
     }
 
+    if (addresses.size() == 1) {
+        // A single address keeps its index order, by height and position in the block, as
+        // without a limit. The cursor is the key of the last index entry of the page.
+        size_t nLimit, nFirstAddress;
+        bool fCursor;
+        CAddressIndexKey cursor;
+        if (getPageFromParams(params, addresses, nLimit, fCursor, cursor, nFirstAddress)) {
+            if (start <= 0 || end <= 0) {
+                start = 0;
+                end = 0;
+            }
+
+            UniValue txids(UniValue::VARR);
+            CAddressIndexKey keyLast;
+            bool fMore = false;
+            bool fOk = ForEachAddressIndex(addresses[0].first, addresses[0].second, start, end, fCursor ? &cursor : NULL,
+                [&](const CAddressIndexKey& key, CAmount amount) {
+                    // a transaction's entries for an address are adjacent, and a page ends after the last of them
+                    if (txids.size() == 0 || key.txhash != keyLast.txhash) {
+                        if (txids.size() >= nLimit) {
+                            fMore = true;
+                            return false;
+                        }
+                        txids.push_back(key.txhash.GetHex());
+                    }
+                    keyLast = key;
+                    return true;
+                });
+            if (!fOk) {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
+            }
+
+            UniValue result(UniValue::VOBJ);
+            result.push_back(Pair("txids", txids));
+            if (fMore)
+                result.push_back(Pair("cursor", encodePageCursor(keyLast)));
+            return result;
+        }
+    }
+
+    size_t nLimit;
+    bool fCursor;
+    std::pair<int, uint256> cursor;
+    if (getPageLimitFromParams(params, nLimit, fCursor, cursor)) {
+        if (start <= 0 || end <= 0) {
+            start = 0;
+            end = 0;
+        }
+
+        // Several addresses are paged as they are without a limit: ordered by height and txid across
+        // all the addresses, with each txid once. The cursor is the (height, txid) of the last
+        // txid of the page, and each address is read from that height on. Its index entries
+        // are ordered by position in the block instead, so an address is read up to the end
+        // of the height at which it has more than a page of txids after the cursor.
+        std::pair<int, std::string> posAfter(-1, "");
+        if (fCursor)
+            posAfter = std::make_pair(cursor.first, cursor.second.GetHex());
+        std::set<std::pair<int, std::string> > txidsAfter;
+        for (size_t i = 0; i < addresses.size(); i++) {
+            size_t nFound = 0;
+            CAddressIndexKey keyLast;
+            CAddressIndexKey seek(addresses[i].second, addresses[i].first, std::max(start, cursor.first), 0, uint256(), 0, false);
+            bool fOk = ForEachAddressIndex(addresses[i].first, addresses[i].second, start, end, fCursor ? &seek : NULL,
+                [&](const CAddressIndexKey& key, CAmount amount) {
+                    if (nFound > nLimit && key.blockHeight != keyLast.blockHeight)
+                        return false;
+                    std::pair<int, std::string> pos(key.blockHeight, key.txhash.GetHex());
+                    // a transaction's entries for an address are adjacent
+                    if (pos > posAfter && (nFound == 0 || key.txhash != keyLast.txhash)) {
+                        txidsAfter.insert(pos);
+                        nFound++;
+                    }
+                    keyLast = key;
+                    return true;
+                });
+            if (!fOk) {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
+            }
+        }
+
+        UniValue txids(UniValue::VARR);
+        std::set<std::pair<int, std::string> >::const_iterator it = txidsAfter.begin();
+        for (; it != txidsAfter.end() && txids.size() < nLimit; it++)
+            txids.push_back(it->second);
+
+        UniValue result(UniValue::VOBJ);
+        result.push_back(Pair("txids", txids));
+        if (it != txidsAfter.end()) {
+            --it;
+            result.push_back(Pair("cursor", encodePageCursor(std::make_pair(it->first, uint256S(it->second)))));
+        }
+        return result;
+    }
+
     std::vector<std::pair<CAddressIndexKey, CAmount> > addressIndex;
 
     for (std::vector<std::pair<uint160, int> >::iterator it = addresses.begin(); it != addresses.end(); it++) {
@@ -1001,3 +1270,43 @@ UniValue getspentinfo(const UniValue& params, bool fHelp)
 
     return obj;
 }
+
+UniValue getindexinfo(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() != 0)
+        throw runtime_error(
+            "getindexinfo\n"
+            "\nReturns the status of the enabled explorer indexes (-addressindex, -spentindex, -timestampindex).\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"name\" : {                    (json object) The index: address, spent or timestamp\n"
+            "    \"synced\" : true|false,       (boolean) Whether the index is caught up with the chain and can be queried\n"
+            "    \"best_block_height\" : n,     (numeric) The height the index is built up to\n"
+            "    \"best_block_hash\" : \"hash\",  (string) The block the index is built up to\n"
+            "    \"size_on_disk\" : n           (numeric) The estimated size of the index database in bytes\n"
+            "  }\n"
+            "  ,...\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getindexinfo", "")
+            + HelpExampleRpc("getindexinfo", "")
+        );
+
+    UniValue result(UniValue::VOBJ);
+
+    LOCK(cs_main);
+    for (int nIndex = 0; nIndex < INDEX_COUNT; nIndex++) {
+        const CExplorerIndexState& index = explorerIndexes[nIndex];
+        if (!index.pdb)
+            continue;
+
+        UniValue obj(UniValue::VOBJ);
+        obj.push_back(Pair("synced", index.fSynced));
+        obj.push_back(Pair("best_block_height", index.pindexBest ? index.pindexBest->nHeight : -1));
+        obj.push_back(Pair("best_block_hash", index.pindexBest ? index.pindexBest->GetBlockHash().GetHex() : uint256().GetHex()));
+        obj.push_back(Pair("size_on_disk", (uint64_t)index.pdb->EstimateSize()));
+        result.push_back(Pair(index.name, obj));
+    }
+
+    return result;
+}
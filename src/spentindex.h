@@ -235,6 +235,49 @@ struct CAddressUnspentValue {
     }
 };
 
+/** Running totals of an address, kept by the address balance index */
+struct CAddressBalanceValue {
+    CAmount balance;
+    CAmount received;
+    int64_t txCount;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion) {
+        READWRITE(balance);
+        READWRITE(received);
+        READWRITE(txCount);
+    }
+
+    CAddressBalanceValue(CAmount balanceIn, CAmount receivedIn, int64_t txCountIn) {
+        balance = balanceIn;
+        received = receivedIn;
+        txCount = txCountIn;
+    }
+
+    CAddressBalanceValue() {
+        SetNull();
+    }
+
+    void SetNull() {
+        balance = 0;
+        received = 0;
+        txCount = 0;
+    }
+
+    bool IsNull() const {
+        return balance == 0 && received == 0 && txCount == 0;
+    }
+
+    CAddressBalanceValue& operator+=(const CAddressBalanceValue& other) {
+        balance += other.balance;
+        received += other.received;
+        txCount += other.txCount;
+        return *this;
+    }
+};
+
 struct CAddressIndexKey {
     unsigned int type;
     uint160 hashBytes;
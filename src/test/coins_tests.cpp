@@ -2,19 +2,26 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include "chainparams.h"
 #include "coins.h"
+#include "coinstats.h"
+#include "indexwriter.h"
+#include "key.h"
 #include "random.h"
 #include "script/standard.h"
 #include "uint256.h"
 #include "undo.h"
 #include "utilstrencodings.h"
 #include "test/test_time.h"
+#include "txdb.h"
+#include "utxosnapshot.h"
 #include "validation.h"
 #include "consensus/validation.h"
 
 #include <vector>
 #include <map>
 
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 int ApplyTxInUndo(Coin&& undo, CCoinsViewCache& view, const COutPoint& out);
@@ -860,4 +867,199 @@ BOOST_AUTO_TEST_CASE(ccoins_write)
                     CheckWriteCoins(parent_value, child_value, parent_value, parent_flags, child_flags, parent_flags);
 }
 
+BOOST_FIXTURE_TEST_CASE(ccoins_background_flush, TestingSetup)
+{
+    CCoinsViewDB db(1 << 20, true, true);
+    db.StartBackgroundFlush();
+    CCoinsViewCache cache(&db);
+
+    std::vector<COutPoint> outpoints;
+    for (int round = 0; round < 10; round++) {
+        // Spend the coins of the previous round and add new ones
+        for (const COutPoint& outpoint : outpoints)
+            BOOST_CHECK(cache.SpendCoin(outpoint));
+        outpoints.clear();
+        for (int i = 0; i < 1000; i++) {
+            Coin coin;
+            coin.out.nValue = insecure_rand() + 1;
+            coin.nHeight = round + 1;
+            outpoints.push_back(COutPoint(GetRandHash(), i));
+            cache.AddCoin(outpoints.back(), std::move(coin), false);
+        }
+        uint256 hashBlock = GetRandHash();
+        cache.SetBestBlock(hashBlock);
+        BOOST_CHECK(cache.Flush());
+
+        // Whether or not the write is done, the database view reflects the flush
+        BOOST_CHECK(db.GetBestBlock() == hashBlock);
+        for (const COutPoint& outpoint : outpoints)
+            BOOST_CHECK(db.HaveCoin(outpoint));
+    }
+
+    BOOST_CHECK(db.WaitForFlush());
+    BOOST_CHECK(!db.IsFlushing());
+    BOOST_CHECK_EQUAL(db.GetFlushStats().nFlushes, 10U);
+    for (const COutPoint& outpoint : outpoints)
+        BOOST_CHECK(db.HaveCoin(outpoint));
+}
+
+BOOST_FIXTURE_TEST_CASE(utxo_snapshot, TestingSetup)
+{
+    const uint256 hashGenesis = chainActive.Genesis()->GetBlockHash();
+    CCoinsViewDB db(1 << 20, true, true);
+    {
+        CCoinsViewCache cache(&db);
+        // Enough coins for several chunks, with several outputs per transaction
+        for (int i = 0; i < 40000; i++) {
+            uint256 txid = GetRandHash();
+            for (int n = 0; n < 3; n++) {
+                Coin coin;
+                coin.out.nValue = insecure_rand() + 1;
+                coin.out.scriptPubKey = CScript() << OP_DUP << OP_HASH160 << ToByteVector(GetRandHash()) << OP_EQUALVERIFY << OP_CHECKSIG;
+                coin.nHeight = 1;
+                coin.fCoinBase = n == 0;
+                cache.AddCoin(COutPoint(txid, n * 2), std::move(coin), false);
+            }
+        }
+        cache.SetBestBlock(hashGenesis);
+        BOOST_CHECK(cache.Flush());
+    }
+    CCoinsStats stats;
+    BOOST_CHECK(GetUTXOStats(&db, stats));
+
+    boost::filesystem::path path = pathTemp / "utxo.dat";
+    CUTXOSnapshotHeader header;
+    CCoinsStats statsDump;
+    std::string strError;
+    BOOST_CHECK(DumpUTXOSnapshot(&db, path, header, statsDump, strError));
+    BOOST_CHECK(header.hashBlock == hashGenesis);
+    BOOST_CHECK_EQUAL(header.nCoins, 120000U);
+    BOOST_CHECK_EQUAL(header.nChunks, 3U);
+    BOOST_CHECK(header.hashSerialized == stats.hashSerialized);
+    BOOST_CHECK(statsDump.nTotalAmount == stats.nTotalAmount);
+    // An existing file is never overwritten
+    BOOST_CHECK(!DumpUTXOSnapshot(&db, path, header, statsDump, strError));
+
+    {
+        // The loaded set hashes the same as the original
+        CCoinsViewDB dbLoad(1 << 20, true, true);
+        CCoinsStats statsLoad;
+        BOOST_CHECK(LoadUTXOSnapshot(&dbLoad, path, stats.hashSerialized, header, statsLoad, strError));
+        BOOST_CHECK(!dbLoad.IsSnapshotLoading());
+        BOOST_CHECK(dbLoad.GetBestBlock() == hashGenesis);
+        CCoinsStats statsCheck;
+        BOOST_CHECK(GetUTXOStats(&dbLoad, statsCheck));
+        BOOST_CHECK(statsCheck.hashSerialized == stats.hashSerialized);
+        BOOST_CHECK_EQUAL(statsCheck.nTransactionOutputs, 120000U);
+    }
+    {
+        // A snapshot other than the expected one is refused
+        CCoinsViewDB dbLoad(1 << 20, true, true);
+        CCoinsStats statsLoad;
+        BOOST_CHECK(!LoadUTXOSnapshot(&dbLoad, path, GetRandHash(), header, statsLoad, strError));
+        BOOST_CHECK(dbLoad.GetBestBlock().IsNull());
+    }
+    {
+        // A corrupt chunk makes the load fail, and leaves the database empty
+        std::vector<char> data;
+        {
+            CAutoFile filein(fopen(path.string().c_str(), "rb"), SER_DISK, CLIENT_VERSION);
+            data.resize(boost::filesystem::file_size(path));
+            filein.read(&data[0], data.size());
+        }
+        data[data.size() / 2] ^= 1;
+        boost::filesystem::path pathCorrupt = pathTemp / "corrupt.dat";
+        {
+            CAutoFile fileout(fopen(pathCorrupt.string().c_str(), "wb"), SER_DISK, CLIENT_VERSION);
+            fileout.write(&data[0], data.size());
+        }
+        CCoinsViewDB dbLoad(1 << 20, true, true);
+        CCoinsStats statsLoad;
+        BOOST_CHECK(!LoadUTXOSnapshot(&dbLoad, pathCorrupt, uint256(), header, statsLoad, strError));
+        BOOST_CHECK(!dbLoad.IsSnapshotLoading());
+        boost::scoped_ptr<CCoinsViewCursor> pcursor(dbLoad.Cursor());
+        BOOST_CHECK(!pcursor->Valid());
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(coinstats_index, TestChain100Setup)
+{
+    // Spend a coinbase so there are coins to take out of the UTXO set too
+    CScript scriptPubKey = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    std::vector<CMutableTransaction> spends(1);
+    spends[0].vin.resize(1);
+    spends[0].vin[0].prevout = COutPoint(coinbaseTxns[0].GetHash(), 0);
+    spends[0].vout.resize(2);
+    spends[0].vout[0].nValue = 11*CENT;
+    spends[0].vout[0].scriptPubKey = scriptPubKey;
+    spends[0].vout[1].nValue = 0;
+    spends[0].vout[1].scriptPubKey = CScript() << OP_RETURN;
+    std::vector<unsigned char> vchSig;
+    uint256 hash = SignatureHash(scriptPubKey, spends[0], 0, SIGHASH_ALL);
+    BOOST_CHECK(coinbaseKey.Sign(hash, vchSig));
+    vchSig.push_back((unsigned char)SIGHASH_ALL);
+    spends[0].vin[0].scriptSig << vchSig;
+    CBlock blockSpend = CreateAndProcessBlock(spends, scriptPubKey);
+    BOOST_CHECK(chainActive.Tip()->GetBlockHash() == blockSpend.GetHash());
+    FlushStateToDisk();
+
+    // Connect the whole chain, genesis included, the way the index builder does
+    LOCK(cs_main);
+    const Consensus::Params& consensusParams = Params().GetConsensus();
+    CCoinStatsIndexValue rolling, rollingPrev;
+    for (const CBlockIndex* pindex = chainActive.Genesis(); pindex; pindex = chainActive.Next(pindex)) {
+        CBlock block;
+        CBlockUndo blockundo;
+        BOOST_CHECK(ReadBlockFromDisk(block, pindex, consensusParams));
+        if (pindex->pprev)
+            BOOST_CHECK(UndoReadFromDisk(blockundo, pindex->GetUndoPos(), pindex->pprev->GetBlockHash()));
+        CIndexBlockUpdate update;
+        BOOST_CHECK(BuildIndexBlockUpdate(block, blockundo, pindex, false, 1 << INDEX_COINSTATS, update));
+        rollingPrev = rolling;
+        ApplyCoinStatsUpdate(rolling, update);
+    }
+    BOOST_CHECK(rolling.hashBlock == chainActive.Tip()->GetBlockHash());
+    BOOST_CHECK_EQUAL(rolling.nHeight, chainActive.Height());
+
+    // The index matches a full scan of the UTXO set, on one thread or several
+    uint256 hashRolling;
+    rolling.muhash.Finalize(hashRolling.begin());
+    for (int nThreads = 1; nThreads <= 4; nThreads += 3) {
+        CCoinsStats stats;
+        BOOST_CHECK(GetUTXOStats(pcoinsdbview, stats, COINSTATS_HASH_MUHASH, nThreads));
+        BOOST_CHECK(stats.hashBlock == rolling.hashBlock);
+        BOOST_CHECK(stats.hashMuHash == hashRolling);
+        BOOST_CHECK_EQUAL(stats.nTransactionOutputs, rolling.nTransactionOutputs);
+        BOOST_CHECK(stats.nTotalAmount == rolling.nTotalAmount);
+    }
+
+    // Disconnecting the tip brings back the state before it
+    {
+        CBlock block;
+        CBlockUndo blockundo;
+        const CBlockIndex* pindex = chainActive.Tip();
+        BOOST_CHECK(ReadBlockFromDisk(block, pindex, consensusParams));
+        BOOST_CHECK(UndoReadFromDisk(blockundo, pindex->GetUndoPos(), pindex->pprev->GetBlockHash()));
+        CIndexBlockUpdate update;
+        BOOST_CHECK(BuildIndexBlockUpdate(block, blockundo, pindex, true, 1 << INDEX_COINSTATS, update));
+        ApplyCoinStatsUpdate(rolling, update);
+    }
+    uint256 hashPrev;
+    rollingPrev.muhash.Finalize(hashPrev.begin());
+    rolling.muhash.Finalize(hashRolling.begin());
+    BOOST_CHECK(hashRolling == hashPrev);
+    BOOST_CHECK(rolling.hashBlock == rollingPrev.hashBlock);
+    BOOST_CHECK_EQUAL(rolling.nTransactionOutputs, rollingPrev.nTransactionOutputs);
+    BOOST_CHECK(rolling.nTotalAmount == rollingPrev.nTotalAmount);
+
+    // The rolling state survives serialization
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << rolling;
+    CCoinStatsIndexValue restored;
+    ss >> restored;
+    uint256 hashRestored;
+    restored.muhash.Finalize(hashRestored.begin());
+    BOOST_CHECK(hashRestored == hashRolling);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
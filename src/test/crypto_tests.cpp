@@ -2,12 +2,15 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include "crypto/common.h"
 #include "crypto/ripemd160.h"
 #include "crypto/sha1.h"
 #include "crypto/sha256.h"
 #include "crypto/sha512.h"
 #include "crypto/hmac_sha256.h"
 #include "crypto/hmac_sha512.h"
+#include "crypto/muhash.h"
+#include "hash.h"
 #include "random.h"
 #include "utilstrencodings.h"
 #include "test/test_time.h"
@@ -273,4 +276,121 @@ BOOST_AUTO_TEST_CASE(pbkdf2_hmac_sha512_test) {
     BOOST_CHECK(HexStr(k, k + 64) == "8c0511f4c6e597c6ac6315d8f0362e225f3c501495ba23b868c005174dc4ee71115b59f9e60cd9532fa33e0f75aefe30225c583a186cd82bd4daea9724a3d3b8");
 }
 
+static Num3072 RandomNum3072()
+{
+    unsigned char data[Num3072::BYTE_SIZE];
+    GetRandBytes(data, sizeof(data));
+    return Num3072(data);
+}
+
+static uint256 FinalizeMuHash(MuHash3072 muhash)
+{
+    uint256 hash;
+    muhash.Finalize(hash.begin());
+    return hash;
+}
+
+BOOST_AUTO_TEST_CASE(muhash_tests) {
+    unsigned char bytes[Num3072::BYTE_SIZE];
+    unsigned char one[Num3072::BYTE_SIZE] = {1};
+
+    // A number times its inverse is one
+    for (int i = 0; i < 3; i++) {
+        Num3072 x = RandomNum3072();
+        Num3072 y = x.GetInverse();
+        y.Multiply(x);
+        y.ToBytes(bytes);
+        BOOST_CHECK(memcmp(bytes, one, sizeof(bytes)) == 0);
+    }
+    // p itself is reduced to zero, and 2^3072 - 1 to 2^3072 - 1 - p
+    memset(bytes, 0xff, sizeof(bytes));
+    Num3072(bytes).ToBytes(bytes);
+    BOOST_CHECK(ReadLE32(bytes) == 1103716 && bytes[4] == 0 && bytes[sizeof(bytes) - 1] == 0);
+
+    const unsigned char a[] = {1, 2, 3}, b[] = {4, 5}, c[] = {6};
+    MuHash3072 empty;
+    const uint256 hashEmpty = FinalizeMuHash(empty);
+
+    // The order elements are added and removed in makes no difference
+    MuHash3072 acb;
+    acb.Insert(a, sizeof(a)).Insert(c, sizeof(c)).Insert(b, sizeof(b)).Remove(b, sizeof(b));
+    MuHash3072 ca;
+    ca.Insert(c, sizeof(c)).Insert(a, sizeof(a));
+    BOOST_CHECK(FinalizeMuHash(acb) == FinalizeMuHash(ca));
+    BOOST_CHECK(FinalizeMuHash(ca) != hashEmpty);
+    MuHash3072 aOnly;
+    aOnly.Insert(a, sizeof(a));
+    BOOST_CHECK(FinalizeMuHash(aOnly) != FinalizeMuHash(ca));
+
+    // Removing what was inserted gives the empty set, even before the insert
+    MuHash3072 removed;
+    removed.Remove(c, sizeof(c)).Insert(c, sizeof(c));
+    BOOST_CHECK(FinalizeMuHash(removed) == hashEmpty);
+
+    // Sets hashed in parts combine
+    MuHash3072 cOnly;
+    cOnly.Insert(c, sizeof(c));
+    MuHash3072 combined = aOnly;
+    combined *= cOnly;
+    BOOST_CHECK(FinalizeMuHash(combined) == FinalizeMuHash(ca));
+    combined /= aOnly;
+    BOOST_CHECK(FinalizeMuHash(combined) == FinalizeMuHash(cOnly));
+
+    // The state survives a round trip through bytes
+    unsigned char state[MuHash3072::SERIALIZED_SIZE];
+    acb.ToBytes(state);
+    MuHash3072 restored;
+    restored.FromBytes(state);
+    BOOST_CHECK(FinalizeMuHash(restored) == FinalizeMuHash(ca));
+}
+
+BOOST_AUTO_TEST_CASE(sha256d64)
+{
+    // Counts around the 4-way and 8-way batches, with and without the output overwriting the input
+    for (int blocks = 0; blocks <= 33; blocks++) {
+        std::vector<unsigned char> in(64 * blocks);
+        for (size_t i = 0; i < in.size(); i++)
+            in[i] = insecure_rand();
+        std::vector<unsigned char> expected(32 * blocks);
+        for (int i = 0; i < blocks; i++)
+            CHash256().Write(&in[64 * i], 64).Finalize(&expected[32 * i]);
+
+        std::vector<unsigned char> out(32 * blocks);
+        SHA256D64(out.data(), in.data(), blocks);
+        BOOST_CHECK(out == expected);
+
+        SHA256D64(in.data(), in.data(), blocks);
+        BOOST_CHECK(std::equal(expected.begin(), expected.end(), in.begin()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sha256dmidstate)
+{
+    // Counts around the 4-way and 8-way batches, of messages of every length the final block can hold
+    for (int blocks = 0; blocks <= 33; blocks++) {
+        std::vector<uint32_t> midstates(8 * blocks);
+        std::vector<unsigned char> in(64 * blocks, 0);
+        std::vector<unsigned char> expected(32 * blocks);
+        for (int i = 0; i < blocks; i++) {
+            size_t nLen = 65 + (i * 7) % 55;
+            std::vector<unsigned char> msg(nLen);
+            for (size_t j = 0; j < nLen; j++)
+                msg[j] = insecure_rand();
+            CHash256().Write(msg.data(), nLen).Finalize(&expected[32 * i]);
+
+            CSHA256 hasher;
+            hasher.Write(msg.data(), 64);
+            hasher.GetMidstate(&midstates[8 * i]);
+            unsigned char* block = &in[64 * i];
+            std::copy(msg.begin() + 64, msg.end(), block);
+            block[nLen - 64] = 0x80;
+            WriteBE64(block + 56, nLen * 8);
+        }
+
+        std::vector<unsigned char> out(32 * blocks);
+        SHA256DMidstate(out.data(), midstates.data(), in.data(), blocks);
+        BOOST_CHECK(out == expected);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
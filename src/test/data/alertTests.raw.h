@@ -0,0 +1,3 @@
+namespace alert_tests{
+static unsigned const char alertTests[] = {
+};};
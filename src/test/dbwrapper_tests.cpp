@@ -324,4 +324,48 @@ BOOST_AUTO_TEST_CASE(iterator_string_ordering)
 
 
 
+BOOST_AUTO_TEST_CASE(dbwrapper_options)
+{
+    mapMultiArgs["-dboption"].clear();
+    mapMultiArgs["-dboption"].push_back("chainstate.bloombits=16");
+    mapMultiArgs["-dboption"].push_back("chainstate.compression=0");
+    mapMultiArgs["-dboption"].push_back("coinstats.bloombits=0");
+    mapMultiArgs["-dboption"].push_back("blockindex.blocksize=16");
+    mapMultiArgs["-dboption"].push_back("address.writebuffer=8");
+
+    std::string strError;
+    CDBOptions options;
+    BOOST_CHECK(ParseDBOptions("chainstate", options, strError));
+    BOOST_CHECK_EQUAL(options.nBloomBits, 16);
+    BOOST_CHECK(!options.fCompression);
+    BOOST_CHECK_EQUAL(options.nBlockSize, 4096U);
+
+    options = GetDBOptions("blockindex");
+    BOOST_CHECK_EQUAL(options.nBlockSize, 16U << 10);
+    BOOST_CHECK_EQUAL(options.nBloomBits, 10);
+    BOOST_CHECK_EQUAL(GetDBOptions("address").nWriteBufferSize, 8U << 20);
+    BOOST_CHECK_EQUAL(GetDBOptions("coinstats").nBloomBits, 0);
+
+    // A database opened with the settings works as usual, and reports them
+    options.nBloomBits = 0;
+    CDBWrapper dbw(temp_directory_path() / unique_path(), 1 << 20, true, false, false, options);
+    uint256 in = GetRandHash(), res;
+    BOOST_CHECK(dbw.Write('k', in));
+    BOOST_CHECK(dbw.Read('k', res));
+    BOOST_CHECK_EQUAL(res.ToString(), in.ToString());
+    BOOST_CHECK_EQUAL(dbw.GetDBOptions().nBlockSize, 16U << 10);
+    BOOST_CHECK(!dbw.GetProperty("leveldb.stats").empty());
+    BOOST_CHECK(dbw.GetProperty("leveldb.nonexistent").empty());
+
+    // Malformed settings are rejected, whichever database they are for, as are unknown databases
+    // and compression, which LevelDB is built without
+    const char* vInvalid[] = {"chainstate", "chainstate.bloombits", "spent.bloombits=x", "spent.unknown=1", "balance.compression=2",
+                              "timestamp.maxopenfiles=1", "chainstat.bloombits=16", "chainstate.compression=1"};
+    for (const char* strInvalid : vInvalid) {
+        mapMultiArgs["-dboption"].assign(1, strInvalid);
+        BOOST_CHECK(!ParseDBOptions("chainstate", options, strError));
+    }
+    mapMultiArgs.erase("-dboption");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
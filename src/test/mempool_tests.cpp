@@ -54,7 +54,7 @@ BOOST_AUTO_TEST_CASE(MempoolRemoveTest)
 
 
     CTxMemPool testPool(CFeeRate(0));
-    std::list<CTransaction> removed;
+    std::list<CTransactionRef> removed;
 
     // Nothing in pool, remove should do nothing:
     testPool.remove(txParent, removed, true);
@@ -62,8 +62,13 @@ BOOST_AUTO_TEST_CASE(MempoolRemoveTest)
 
     // Just the parent:
     testPool.addUnchecked(txParent.GetHash(), entry.FromTx(txParent));
+    CTransactionRef sharedParent = testPool.get(txParent.GetHash());
+    BOOST_CHECK(sharedParent);
     testPool.remove(txParent, removed, true);
     BOOST_CHECK_EQUAL(removed.size(), 1);
+    // The removed transaction is the pool's own instance, not a copy:
+    BOOST_CHECK(removed.front() == sharedParent);
+    BOOST_CHECK(!testPool.get(txParent.GetHash()));
     removed.clear();
     
     // Parent, children, grandchildren:
@@ -280,7 +285,7 @@ BOOST_AUTO_TEST_CASE(MempoolIndexingTest)
     BOOST_CHECK_EQUAL(pool.size(), 10);
 
     // Now try removing tx10 and verify the sort order returns to normal
-    std::list<CTransaction> removed;
+    std::list<CTransactionRef> removed;
     pool.remove(pool.mapTx.find(tx10.GetHash())->GetTx(), removed, true);
     CheckSort<1>(pool, snapshotOrder);
 
@@ -444,7 +449,7 @@ BOOST_AUTO_TEST_CASE(MempoolSizeLimitTest)
     pool.addUnchecked(tx7.GetHash(), entry.Fee(9000LL).FromTx(tx7, &pool));
 
     std::vector<CTransaction> vtx;
-    std::list<CTransaction> conflicts;
+    std::list<CTransactionRef> conflicts;
     SetMockTIMECoin(42);
     SetMockTIMECoin(42 + CTxMemPool::ROLLING_FEE_HALFLIFE);
     BOOST_CHECK_EQUAL(pool.GetMinFee(1).GetFeePerK(), maxFeeRateRemoved.GetFeePerK() + 1000);
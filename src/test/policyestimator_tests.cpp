@@ -2,7 +2,10 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include "clientversion.h"
 #include "policy/fees.h"
+#include "random.h"
+#include "streams.h"
 #include "txmempool.h"
 #include "uint256.h"
 #include "util.h"
@@ -45,7 +48,7 @@ BOOST_AUTO_TEST_CASE(BlockPolicyEstimates)
     for (unsigned int i = 0; i < 128; i++)
         garbage.push_back('X');
     CMutableTransaction tx;
-    std::list<CTransaction> dummyConflicted;
+    std::list<CTransactionRef> dummyConflicted;
     tx.vin.resize(1);
     tx.vin[0].scriptSig = garbage;
     tx.vout.resize(1);
@@ -207,4 +210,137 @@ BOOST_AUTO_TEST_CASE(BlockPolicyEstimates)
     }
 }
 
+/** Moving averages decayed eagerly every block, as TxConfirmStats did before it kept them scaled */
+struct EagerConfirmStats
+{
+    std::vector<double> buckets;
+    std::vector<double> txCtAvg;
+    std::vector<std::vector<double> > confAvg;
+    std::vector<double> avg;
+    double decay;
+
+    EagerConfirmStats(const std::vector<double>& bucketsIn, unsigned int maxConfirms, double decayIn)
+        : buckets(bucketsIn), txCtAvg(bucketsIn.size()), confAvg(maxConfirms, std::vector<double>(bucketsIn.size())),
+          avg(bucketsIn.size()), decay(decayIn) {}
+
+    void UpdateMovingAverages()
+    {
+        for (unsigned int j = 0; j < buckets.size(); j++) {
+            for (unsigned int i = 0; i < confAvg.size(); i++)
+                confAvg[i][j] *= decay;
+            avg[j] *= decay;
+            txCtAvg[j] *= decay;
+        }
+    }
+
+    void Record(int blocksToConfirm, double val)
+    {
+        unsigned int bucketindex = std::lower_bound(buckets.begin(), buckets.end(), val) - buckets.begin();
+        for (unsigned int i = blocksToConfirm; i <= confAvg.size(); i++)
+            confAvg[i - 1][bucketindex]++;
+        txCtAvg[bucketindex]++;
+        avg[bucketindex] += val;
+    }
+
+    /** Load into a TxConfirmStats through the fee_estimates.dat layout */
+    void LoadInto(TxConfirmStats& stats)
+    {
+        CAutoFile file(tmpfile(), SER_DISK, CLIENT_VERSION);
+        file << decay << buckets << avg << txCtAvg << confAvg;
+        rewind(file.Get());
+        stats.Read(file);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(TxConfirmStatsLazyDecay)
+{
+    std::vector<double> buckets;
+    for (double bucketBoundary = 1000; bucketBoundary <= 1e5; bucketBoundary *= 1.1)
+        buckets.push_back(bucketBoundary);
+    buckets.push_back(INF_FEERATE);
+    const unsigned int maxConfirms = 25;
+    // Decays fast enough for the scale to be folded back into the averages several times
+    const double decay = 0.6;
+
+    TxConfirmStats lazy;
+    lazy.Initialize(buckets, maxConfirms, decay, "FeeRate");
+    EagerConfirmStats eager(buckets, maxConfirms, decay);
+
+    seed_insecure_rand(true);
+    for (unsigned int nBlockHeight = 1; nBlockHeight <= 300; nBlockHeight++) {
+        lazy.ClearCurrent(nBlockHeight);
+        lazy.UpdateMovingAverages();
+        eager.UpdateMovingAverages();
+        for (int k = 0; k < 50; k++) {
+            int blocksToConfirm = 1 + insecure_rand() % maxConfirms;
+            double val = 900 + insecure_rand() % 100000;
+            lazy.Record(blocksToConfirm, val);
+            eager.Record(blocksToConfirm, val);
+        }
+        lazy.ClearEstimateCache();
+
+        if (nBlockHeight % 10 != 0)
+            continue;
+        TxConfirmStats reference;
+        eager.LoadInto(reference);
+        for (int confTarget = 1; confTarget <= (int)maxConfirms; confTarget++) {
+            BOOST_CHECK_CLOSE(lazy.EstimateMedianVal(confTarget, 1, 0.85, true, nBlockHeight),
+                              reference.EstimateMedianVal(confTarget, 1, 0.85, true, nBlockHeight), 1e-6);
+            BOOST_CHECK_CLOSE(lazy.EstimateMedianVal(confTarget, 1, 0.5, false, nBlockHeight),
+                              reference.EstimateMedianVal(confTarget, 1, 0.5, false, nBlockHeight), 1e-6);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TxConfirmStatsNormalize)
+{
+    std::vector<double> buckets;
+    for (double bucketBoundary = 1000; bucketBoundary <= 1e5; bucketBoundary *= 1.1)
+        buckets.push_back(bucketBoundary);
+    buckets.push_back(INF_FEERATE);
+    const unsigned int maxConfirms = 25;
+
+    TxConfirmStats stats;
+    stats.Initialize(buckets, maxConfirms, DEFAULT_DECAY, "FeeRate");
+    EagerConfirmStats eager(buckets, maxConfirms, DEFAULT_DECAY);
+    seed_insecure_rand(true);
+    for (unsigned int nBlockHeight = 1; nBlockHeight <= 100; nBlockHeight++) {
+        stats.UpdateMovingAverages();
+        eager.UpdateMovingAverages();
+        for (int k = 0; k < 20; k++) {
+            int blocksToConfirm = 1 + insecure_rand() % maxConfirms;
+            double val = 900 + insecure_rand() % 100000;
+            stats.Record(blocksToConfirm, val);
+            eager.Record(blocksToConfirm, val);
+        }
+    }
+
+    // Writing folds the scale into the averages, which must then be those decayed eagerly
+    CAutoFile file(tmpfile(), SER_DISK, CLIENT_VERSION);
+    stats.Write(file);
+    rewind(file.Get());
+    double fileDecay;
+    std::vector<double> fileBuckets, fileAvg, fileTxCtAvg;
+    std::vector<std::vector<double> > fileConfAvg;
+    file >> fileDecay >> fileBuckets >> fileAvg >> fileTxCtAvg >> fileConfAvg;
+    BOOST_CHECK_EQUAL(fileDecay, DEFAULT_DECAY);
+    BOOST_CHECK(fileBuckets == buckets);
+    BOOST_REQUIRE_EQUAL(fileConfAvg.size(), maxConfirms);
+    for (unsigned int j = 0; j < buckets.size(); j++) {
+        BOOST_CHECK_CLOSE(fileAvg[j], eager.avg[j], 1e-9);
+        BOOST_CHECK_CLOSE(fileTxCtAvg[j], eager.txCtAvg[j], 1e-9);
+        for (unsigned int i = 0; i < maxConfirms; i++)
+            BOOST_CHECK_CLOSE(fileConfAvg[i][j], eager.confAvg[i][j], 1e-9);
+    }
+
+    // and the estimates are the same before and after
+    TxConfirmStats reloaded;
+    rewind(file.Get());
+    reloaded.Read(file);
+    for (int confTarget = 1; confTarget <= (int)maxConfirms; confTarget++) {
+        BOOST_CHECK_CLOSE(stats.EstimateMedianVal(confTarget, 1, 0.85, true, 100),
+                          reloaded.EstimateMedianVal(confTarget, 1, 0.85, true, 100), 1e-9);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+// Copyright (c) 2017 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "pooledmap.h"
+#include "random.h"
+
+#include "test/test_time.h"
+
+#include <map>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(pooledmap_tests, BasicTestingSetup)
+
+namespace {
+
+struct IntHasher
+{
+    // Few distinct hashes, so that probing and the deleted markers get exercised
+    size_t operator()(int n) const { return (size_t)(n % 97) * 0x9E3779B97F4A7C15ULL; }
+};
+
+typedef pooledmap<int, std::string, IntHasher> TestMap;
+
+void CheckEqual(const TestMap& map, const std::map<int, std::string>& expected)
+{
+    BOOST_CHECK_EQUAL(map.size(), expected.size());
+    size_t count = 0;
+    for (TestMap::const_iterator it = map.begin(); it != map.end(); ++it) {
+        std::map<int, std::string>::const_iterator itExpected = expected.find(it->first);
+        BOOST_CHECK(itExpected != expected.end() && itExpected->second == it->second);
+        count++;
+    }
+    BOOST_CHECK_EQUAL(count, expected.size());
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(pooledmap_random)
+{
+    TestMap map;
+    std::map<int, std::string> expected;
+    for (int i = 0; i < 20000; i++) {
+        int key = insecure_rand() % 2000;
+        switch (insecure_rand() % 4) {
+        case 0: {
+            std::string value = std::to_string(i);
+            bool inserted = map.emplace(key, value).second;
+            BOOST_CHECK_EQUAL(inserted, expected.emplace(key, value).second);
+            break;
+        }
+        case 1:
+            map[key] = std::to_string(i);
+            expected[key] = std::to_string(i);
+            break;
+        case 2:
+            BOOST_CHECK_EQUAL(map.erase(key), expected.erase(key));
+            break;
+        case 3: {
+            TestMap::iterator it = map.find(key);
+            BOOST_CHECK_EQUAL(it != map.end(), expected.count(key) == 1);
+            if (it != map.end())
+                BOOST_CHECK(it->second == expected[key]);
+            break;
+        }
+        }
+    }
+    CheckEqual(map, expected);
+
+    // Erasing while iterating visits every element exactly once
+    size_t count = 0, nBefore = map.size();
+    for (TestMap::iterator it = map.begin(); it != map.end(); ) {
+        if (it->first % 2)
+            expected.erase(it->first);
+        TestMap::iterator itOld = it++;
+        if (itOld->first % 2)
+            map.erase(itOld);
+        count++;
+    }
+    BOOST_CHECK_EQUAL(count, nBefore);
+    CheckEqual(map, expected);
+
+    map.clear();
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(map.begin() == map.end());
+    BOOST_CHECK_EQUAL(map.DynamicMemoryUsage(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(pooledmap_stable_references)
+{
+    TestMap map;
+    std::string& first = map[-1];
+    first = "first";
+    for (int i = 0; i < 10000; i++)
+        map.emplace(i, "x");
+    BOOST_CHECK(&map.find(-1)->second == &first);
+    BOOST_CHECK_EQUAL(first, "first");
+
+    // Erased nodes are reused, so churn does not grow the pool
+    size_t usage = map.DynamicMemoryUsage();
+    for (int i = 0; i < 10000; i++) {
+        map.erase(i);
+        map.emplace(i + 10000, "y");
+    }
+    BOOST_CHECK_EQUAL(map.size(), 10001U);
+    BOOST_CHECK(map.DynamicMemoryUsage() <= usage);
+
+    TestMap moved(std::move(map));
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(&moved.find(-1)->second == &first);
+}
+
+BOOST_AUTO_TEST_CASE(pooledmap_reserve)
+{
+    TestMap map;
+    for (int i = 0; i < 100; i++)
+        map.insert(std::make_pair(i, "x"));
+    std::string& first = map.find(0)->second;
+
+    // After reserving, inserting up to the reserved size allocates nothing more
+    map.reserve(50000);
+    size_t usage = map.DynamicMemoryUsage();
+    for (int i = 100; i < 50000; i++)
+        BOOST_CHECK(map.insert(std::make_pair(i, "y")).second);
+    BOOST_CHECK_EQUAL(map.DynamicMemoryUsage(), usage);
+    BOOST_CHECK(!map.insert(std::make_pair(0, "z")).second);
+    BOOST_CHECK(&map.find(0)->second == &first);
+    BOOST_CHECK_EQUAL(first, "x");
+    BOOST_CHECK_EQUAL(map.size(), 50000U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -44,6 +44,42 @@ BOOST_AUTO_TEST_CASE(skiplist_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(skiplist_arena_test)
+{
+    // Entries from the arena link by position, across chunk boundaries too
+    const int nLength = CBlockIndexArena::CHUNK_SIZE * 2 + 100;
+    std::vector<CBlockIndex*> vpindex;
+    for (int i = 0; i < nLength; i++) {
+        CBlockIndex* pindex = CBlockIndexArena::Allocate();
+        pindex->nHeight = i;
+        pindex->pprev = i ? vpindex.back() : NULL;
+        pindex->BuildSkip();
+        vpindex.push_back(pindex);
+    }
+
+    for (int i = 0; i < nLength; i++) {
+        BOOST_CHECK(vpindex[i]->pprev == (i ? vpindex[i - 1] : NULL));
+        BOOST_CHECK(i == 0 || vpindex[i]->pskip == vpindex[vpindex[i]->pskip->nHeight]);
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        int from = insecure_rand() % nLength;
+        int to = insecure_rand() % (from + 1);
+        BOOST_CHECK(vpindex[from]->GetAncestor(to) == vpindex[to]);
+    }
+
+    // A chain can hold entries from the arena and from anywhere else
+    CBlockIndex indexTip;
+    indexTip.nHeight = nLength;
+    indexTip.pprev = vpindex.back();
+    CChain chain;
+    chain.SetTip(&indexTip);
+    BOOST_CHECK(chain.Tip() == &indexTip);
+    BOOST_CHECK(chain.Genesis() == vpindex[0]);
+    BOOST_CHECK(chain[CBlockIndexArena::CHUNK_SIZE] == vpindex[CBlockIndexArena::CHUNK_SIZE]);
+    BOOST_CHECK(chain.Contains(vpindex[nLength / 2]));
+}
+
 BOOST_AUTO_TEST_CASE(getlocator_test)
 {
     // Build a main chain 100000 blocks long.
@@ -26,12 +26,17 @@ static const char DB_ADDRESSINDEX = 'a';
 static const char DB_ADDRESSUNSPENTINDEX = 'u';
 static const char DB_TIMECSTAMPINDEX = 's';
 static const char DB_SPENTINDEX = 'p';
+static const char DB_ADDRESSBALANCEINDEX = 'w';
+static const char DB_COINSTATS = 'm';
 static const char DB_BLOCK_INDEX = 'b';
+static const char DB_INDEX_BEST_BLOCK = 'I';
+static const char DB_SNAPSHOT_BASE = 'S';
 
 static const char DB_BEST_BLOCK = 'B';
 static const char DB_FLAG = 'F';
 static const char DB_REINDEX_FLAG = 'R';
 static const char DB_LAST_BLOCK = 'l';
+static const char DB_SNAPSHOT_LOADING = 'L';
 
 namespace {
 
@@ -57,56 +62,248 @@ struct CoinEntry {
 
 }
 
-CCoinsViewDB::CCoinsViewDB(size_t nCacheSize, bool fMemory, bool fWipe) : db(GetDataDir() / "chainstate", nCacheSize, fMemory, fWipe, true) 
+CCoinsViewDB::CCoinsViewDB(size_t nCacheSize, bool fMemory, bool fWipe) : db(GetDataDir() / "chainstate", nCacheSize, fMemory, fWipe, true, GetDBOptions("chainstate")), fBackgroundFlush(false), fStopFlush(false), fFlushPending(false), fFlushFailed(false)
 {
 }
 
+CCoinsViewDB::~CCoinsViewDB()
+{
+    {
+        boost::unique_lock<boost::mutex> lock(csFlush);
+        fStopFlush = true;
+        condFlush.notify_all();
+    }
+    if (threadFlush.joinable())
+        threadFlush.join();
+}
+
 bool CCoinsViewDB::GetCoin(const COutPoint &outpoint, Coin &coin) const {
+    {
+        boost::unique_lock<boost::mutex> lock(csFlush);
+        if (fFlushPending) {
+            CCoinsMap::const_iterator it = mapFlushing.find(outpoint);
+            if (it != mapFlushing.end()) {
+                coin = it->second.coin;
+                return !coin.IsSpent();
+            }
+        }
+    }
     return db.Read(CoinEntry(&outpoint), coin);
 }
 
 bool CCoinsViewDB::HaveCoin(const COutPoint &outpoint) const {
+    {
+        boost::unique_lock<boost::mutex> lock(csFlush);
+        if (fFlushPending) {
+            CCoinsMap::const_iterator it = mapFlushing.find(outpoint);
+            if (it != mapFlushing.end())
+                return !it->second.coin.IsSpent();
+        }
+    }
     return db.Exists(CoinEntry(&outpoint));
 }
 
 uint256 CCoinsViewDB::GetBestBlock() const {
+    {
+        boost::unique_lock<boost::mutex> lock(csFlush);
+        if (fFlushPending && !hashFlushing.IsNull())
+            return hashFlushing;
+    }
     uint256 hashBestChain;
     if (!db.Read(DB_BEST_BLOCK, hashBestChain))
         return uint256();
     return hashBestChain;
 }
 
-bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) {
+bool CCoinsViewDB::WriteCoins(const CCoinsMap &mapCoins, const uint256 &hashBlock, size_t &nChanged) {
     CDBBatch batch(db);
-    size_t count = 0;
-    size_t changed = 0;
-    for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end();) {
+    nChanged = 0;
+    for (CCoinsMap::const_iterator it = mapCoins.begin(); it != mapCoins.end(); it++) {
         if (it->second.flags & CCoinsCacheEntry::DIRTY) {
             CoinEntry entry(&it->first);
             if (it->second.coin.IsSpent())
                 batch.Erase(entry);
             else
                 batch.Write(entry, it->second.coin);
-            changed++;
+            nChanged++;
         }
-        count++;
-        CCoinsMap::iterator itOld = it++;
-        mapCoins.erase(itOld);
     }
     if (!hashBlock.IsNull())
         batch.Write(DB_BEST_BLOCK, hashBlock);
 
     bool ret = db.WriteBatch(batch);
-    LogPrint("coindb", "Committed %u changed transaction outputs (out of %u) to coin database...\n", (unsigned int)changed, (unsigned int)count);
+    LogPrint("coindb", "Committed %u changed transaction outputs (out of %u) to coin database...\n", (unsigned int)nChanged, (unsigned int)mapCoins.size());
     return ret;
 }
 
+static void RecordFlush(CCoinsFlushStats& stats, int64_t nDuration, size_t nChanged)
+{
+    int nDurationBucket = 0;
+    while (nDurationBucket < COINS_FLUSH_HISTOGRAM_BUCKETS - 1 && nDuration >= ((int64_t)1 << nDurationBucket))
+        nDurationBucket++;
+    int nChangedBucket = 0;
+    while (nChangedBucket < COINS_FLUSH_HISTOGRAM_BUCKETS - 1 && nChanged >= ((size_t)1000 << nChangedBucket))
+        nChangedBucket++;
+    stats.nFlushes++;
+    stats.nLastDuration = nDuration;
+    stats.nLastChanged = nChanged;
+    stats.vDuration[nDurationBucket]++;
+    stats.vChanged[nChangedBucket]++;
+}
+
+bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) {
+    boost::unique_lock<boost::mutex> lock(csFlush);
+    if (!fBackgroundFlush) {
+        lock.unlock();
+        int64_t nStart = GetTIMECoinMillis();
+        size_t nChanged;
+        bool ret = WriteCoins(mapCoins, hashBlock, nChanged);
+        mapCoins.clear();
+        lock.lock();
+        RecordFlush(flushStats, GetTIMECoinMillis() - nStart, nChanged);
+        return ret;
+    }
+
+    // Only one set of entries is written at a time
+    int64_t nWaitStart = GetTIMECoinMillis();
+    while (fFlushPending && !fFlushFailed)
+        condFlush.wait(lock);
+    flushStats.nTotalWait += GetTIMECoinMillis() - nWaitStart;
+    if (fFlushFailed)
+        return false;
+
+    mapFlushing.swap(mapCoins);
+    mapCoins.clear();
+    hashFlushing = hashBlock;
+    fFlushPending = true;
+    condFlush.notify_all();
+    return true;
+}
+
+void CCoinsViewDB::ThreadFlush()
+{
+    RenameThread("time-coinsflush");
+
+    boost::unique_lock<boost::mutex> lock(csFlush);
+    while (true) {
+        while (!fFlushPending && !fStopFlush)
+            condFlush.wait(lock);
+        if (!fFlushPending)
+            break;
+
+        // BatchWrite does not touch mapFlushing while a write is pending, and
+        // readers only look entries up, so it can be read without the lock.
+        lock.unlock();
+        int64_t nStart = GetTIMECoinMillis();
+        size_t nChanged;
+        bool fOk = WriteCoins(mapFlushing, hashFlushing, nChanged);
+        int64_t nDuration = GetTIMECoinMillis() - nStart;
+        lock.lock();
+
+        if (!fOk) {
+            // Keep answering reads from the entries, which are still not on disk
+            LogPrintf("%s: failed to write to coin database\n", __func__);
+            fFlushFailed = true;
+            condFlush.notify_all();
+            break;
+        }
+        RecordFlush(flushStats, nDuration, nChanged);
+        mapFlushing.clear();
+        hashFlushing.SetNull();
+        fFlushPending = false;
+        condFlush.notify_all();
+    }
+}
+
+void CCoinsViewDB::StartBackgroundFlush()
+{
+    boost::unique_lock<boost::mutex> lock(csFlush);
+    if (fBackgroundFlush)
+        return;
+    fBackgroundFlush = true;
+    threadFlush = boost::thread(boost::bind(&CCoinsViewDB::ThreadFlush, this));
+}
+
+bool CCoinsViewDB::WaitForFlush() const
+{
+    boost::unique_lock<boost::mutex> lock(csFlush);
+    while (fFlushPending && !fFlushFailed)
+        condFlush.wait(lock);
+    return !fFlushFailed;
+}
+
+bool CCoinsViewDB::IsFlushing() const
+{
+    boost::unique_lock<boost::mutex> lock(csFlush);
+    return fFlushPending;
+}
+
+size_t CCoinsViewDB::FlushingMemoryUsage() const
+{
+    boost::unique_lock<boost::mutex> lock(csFlush);
+    return fFlushPending ? memusage::DynamicUsage(mapFlushing) : 0;
+}
+
+CCoinsFlushStats CCoinsViewDB::GetFlushStats() const
+{
+    boost::unique_lock<boost::mutex> lock(csFlush);
+    return flushStats;
+}
+
+bool CCoinsViewDB::WriteSnapshotCoins(const std::vector<std::pair<COutPoint, Coin> > &coins)
+{
+    CDBBatch batch(db);
+    for (std::vector<std::pair<COutPoint, Coin> >::const_iterator it = coins.begin(); it != coins.end(); it++)
+        batch.Write(CoinEntry(&it->first), it->second);
+    return db.WriteBatch(batch);
+}
+
+bool CCoinsViewDB::SetSnapshotLoading()
+{
+    return db.Write(DB_SNAPSHOT_LOADING, '1', true);
+}
+
+bool CCoinsViewDB::IsSnapshotLoading() const
+{
+    return db.Exists(DB_SNAPSHOT_LOADING);
+}
+
+bool CCoinsViewDB::FinishSnapshotLoading(const uint256 &hashBlock)
+{
+    CDBBatch batch(db);
+    batch.Erase(DB_SNAPSHOT_LOADING);
+    batch.Write(DB_BEST_BLOCK, hashBlock);
+    return db.WriteBatch(batch, true);
+}
+
+bool CCoinsViewDB::AbortSnapshotLoading()
+{
+    boost::scoped_ptr<CDBIterator> pcursor(db.NewIterator());
+    pcursor->Seek(DB_COIN);
+    CDBBatch batch(db);
+    while (pcursor->Valid()) {
+        COutPoint outpoint;
+        CoinEntry entry(&outpoint);
+        if (!pcursor->GetKey(entry) || entry.key != DB_COIN)
+            break;
+        batch.Erase(entry);
+        if (batch.SizeEstimate() > (size_t)16 << 20) {
+            if (!db.WriteBatch(batch))
+                return false;
+            batch.Clear();
+        }
+        pcursor->Next();
+    }
+    batch.Erase(DB_SNAPSHOT_LOADING);
+    return db.WriteBatch(batch, true);
+}
+
 size_t CCoinsViewDB::EstimateSize() const
 {
     return db.EstimateSize(DB_COIN, (char)(DB_COIN+1));
 }
 
-CBlockTreeDB::CBlockTreeDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(GetDataDir() / "blocks" / "index", nCacheSize, fMemory, fWipe) {
+CBlockTreeDB::CBlockTreeDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(GetDataDir() / "blocks" / "index", nCacheSize, fMemory, fWipe, false, ::GetDBOptions("blockindex")) {
 }
 
 bool CBlockTreeDB::ReadBlockFileInfo(int nFile, CBlockFileInfo &info) {
@@ -125,17 +322,37 @@ bool CBlockTreeDB::ReadReindexing(bool &fReindexing) {
     return true;
 }
 
+bool CBlockTreeDB::WriteSnapshotBase(const uint256 &hash, unsigned int nChainTx) {
+    return Write(DB_SNAPSHOT_BASE, std::make_pair(hash, nChainTx), true);
+}
+
+bool CBlockTreeDB::ReadSnapshotBase(uint256 &hash, unsigned int &nChainTx) {
+    std::pair<uint256, unsigned int> base;
+    if (!Read(DB_SNAPSHOT_BASE, base))
+        return false;
+    hash = base.first;
+    nChainTx = base.second;
+    return true;
+}
+
 bool CBlockTreeDB::ReadLastBlockFile(int &nFile) {
     return Read(DB_LAST_BLOCK, nFile);
 }
 
 CCoinsViewCursor *CCoinsViewDB::Cursor() const
 {
+    return Cursor(COutPoint(uint256(), 0));
+}
+
+CCoinsViewCursor *CCoinsViewDB::Cursor(const COutPoint &start) const
+{
+    // Iterate over the database only once it holds every entry handed to BatchWrite
+    WaitForFlush();
     CCoinsViewDBCursor *i = new CCoinsViewDBCursor(const_cast<CDBWrapper*>(&db)->NewIterator(), GetBestBlock());
     /* It seems that there are no "const iterators" for LevelDB.  Since we
        only need read operations on it, use a const-cast to get around
        that restriction.  */
-    i->pcursor->Seek(DB_COIN);
+    i->pcursor->Seek(CoinEntry(&start));
     // Cache key of first record
     if (i->pcursor->Valid()) {
         CoinEntry entry(&i->keyTmp.second);
@@ -206,132 +423,112 @@ bool CBlockTreeDB::WriteTxIndex(const std::vector<std::pair<uint256, CDiskTxPos>
     return WriteBatch(batch);
 }
 
-bool CBlockTreeDB::ReadSpentIndex(CSpentIndexKey &key, CSpentIndexValue &value) {
-    return Read(make_pair(DB_SPENTINDEX, key), value);
-}
-
-bool CBlockTreeDB::UpdateSpentIndex(const std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> >&vect) {
-    CDBBatch batch(*this);
-    for (std::vector<std::pair<CSpentIndexKey,CSpentIndexValue> >::const_iterator it=vect.begin(); it!=vect.end(); it++) {
-        if (it->second.IsNull()) {
-            batch.Erase(make_pair(DB_SPENTINDEX, it->first));
-        } else {
-            batch.Write(make_pair(DB_SPENTINDEX, it->first), it->second);
-        }
-    }
-    return WriteBatch(batch);
-}
-
-bool CBlockTreeDB::UpdateAddressUnspentIndex(const std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue > >&vect) {
-    CDBBatch batch(*this);
-    for (std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> >::const_iterator it=vect.begin(); it!=vect.end(); it++) {
-        if (it->second.IsNull()) {
-            batch.Erase(make_pair(DB_ADDRESSUNSPENTINDEX, it->first));
-        } else {
-            batch.Write(make_pair(DB_ADDRESSUNSPENTINDEX, it->first), it->second);
-        }
-    }
-    return WriteBatch(batch);
-}
-
-bool CBlockTreeDB::ReadAddressUnspentIndex(uint160 addressHash, int type,
-                                           std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > &unspentOutputs) {
-
-    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
-
-    pcursor->Seek(make_pair(DB_ADDRESSUNSPENTINDEX, CAddressIndexIteratorKey(type, addressHash)));
-
-    while (pcursor->Valid()) {
+/** Copy the entries of type chType, each a K mapped to a V, into the database batch is for; the caller writes the last batch */
+template <typename K, typename V>
+static bool CopyKeysOfType(CDBWrapper& dbFrom, CDBWrapper& dbTo, CDBBatch& batch, char chType, size_t& nCopiedRet)
+{
+    boost::scoped_ptr<CDBIterator> pcursor(dbFrom.NewIterator());
+    for (pcursor->Seek(chType); pcursor->Valid(); pcursor->Next()) {
         boost::this_thread::interruption_point();
-        std::pair<char,CAddressUnspentKey> key;
-        if (pcursor->GetKey(key) && key.first == DB_ADDRESSUNSPENTINDEX && key.second.hashBytes == addressHash) {
-            CAddressUnspentValue nValue;
-            if (pcursor->GetValue(nValue)) {
-                unspentOutputs.push_back(make_pair(key.second, nValue));
-                pcursor->Next();
-            } else {
-                return error("failed to get address unspent value");
-            }
-        } else {
+        std::pair<char, K> key;
+        V value;
+        if (!pcursor->GetKey(key) || key.first != chType)
             break;
+        if (!pcursor->GetValue(value))
+            return error("%s: failed to read an entry of type %c", __func__, chType);
+        batch.Write(key, value);
+        nCopiedRet++;
+        if (batch.SizeEstimate() > (size_t)16 << 20) {
+            if (!dbTo.WriteBatch(batch))
+                return false;
+            batch.Clear();
         }
     }
-
     return true;
 }
 
-bool CBlockTreeDB::WriteAddressIndex(const std::vector<std::pair<CAddressIndexKey, CAmount > >&vect) {
-    CDBBatch batch(*this);
-    for (std::vector<std::pair<CAddressIndexKey, CAmount> >::const_iterator it=vect.begin(); it!=vect.end(); it++)
-        batch.Write(make_pair(DB_ADDRESSINDEX, it->first), it->second);
-    return WriteBatch(batch);
-}
-
-bool CBlockTreeDB::EraseAddressIndex(const std::vector<std::pair<CAddressIndexKey, CAmount > >&vect) {
-    CDBBatch batch(*this);
-    for (std::vector<std::pair<CAddressIndexKey, CAmount> >::const_iterator it=vect.begin(); it!=vect.end(); it++)
-        batch.Erase(make_pair(DB_ADDRESSINDEX, it->first));
-    return WriteBatch(batch);
-}
-
-bool CBlockTreeDB::ReadAddressIndex(uint160 addressHash, int type,
-                                    std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex,
-                                    int start, int end) {
-
-    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
-
-    if (start > 0 && end > 0) {
-        pcursor->Seek(make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorHeightKey(type, addressHash, start)));
-    } else {
-        pcursor->Seek(make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorKey(type, addressHash)));
-    }
-
-    while (pcursor->Valid()) {
+/** Erase the entries of type chType, each keyed by a K */
+template <typename K>
+static bool EraseKeysOfType(CDBWrapper& db, char chType)
+{
+    boost::scoped_ptr<CDBIterator> pcursor(db.NewIterator());
+    CDBBatch batch(db);
+    bool fErased = false;
+    for (pcursor->Seek(chType); pcursor->Valid(); pcursor->Next()) {
         boost::this_thread::interruption_point();
-        std::pair<char,CAddressIndexKey> key;
-        if (pcursor->GetKey(key) && key.first == DB_ADDRESSINDEX && key.second.hashBytes == addressHash) {
-            if (end > 0 && key.second.blockHeight > end) {
-                break;
-            }
-            CAmount nValue;
-            if (pcursor->GetValue(nValue)) {
-                addressIndex.push_back(make_pair(key.second, nValue));
-                pcursor->Next();
-            } else {
-                return error("failed to get address index value");
-            }
-        } else {
+        std::pair<char, K> key;
+        if (!pcursor->GetKey(key) || key.first != chType)
             break;
+        batch.Erase(key);
+        fErased = true;
+        if (batch.SizeEstimate() > (size_t)16 << 20) {
+            if (!db.WriteBatch(batch))
+                return false;
+            batch.Clear();
         }
     }
-
+    if (!db.WriteBatch(batch))
+        return false;
+    if (fErased)
+        db.CompactRange(chType, (char)(chType + 1));
     return true;
 }
 
-bool CBlockTreeDB::WriteTIMECoinstampIndex(const CTIMECoinstampIndexKey &timestampIndex) {
-    CDBBatch batch(*this);
-    batch.Write(make_pair(DB_TIMECSTAMPINDEX, timestampIndex), 0);
-    return WriteBatch(batch);
+bool CBlockTreeDB::ReadLegacyIndexBestBlock(uint256 &hashBlock, int &nHeight) {
+    std::pair<uint256, int> best;
+    if (!Read(DB_INDEX_BEST_BLOCK, best))
+        return false;
+    hashBlock = best.first;
+    nHeight = best.second;
+    return true;
 }
 
-bool CBlockTreeDB::ReadTIMECoinstampIndex(const unsigned int &high, const unsigned int &low, std::vector<uint256> &hashes) {
-
-    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
+bool CBlockTreeDB::MoveLegacyExplorerIndex(const std::string &name, CExplorerIndexDB *pdbTo, const uint256 &hashBest, int nBestHeight, size_t &nMovedRet) {
+    nMovedRet = 0;
+    if (pdbTo) {
+        CDBBatch batch(*pdbTo);
+        bool fCopied;
+        if (name == "address")
+            fCopied = CopyKeysOfType<CAddressIndexKey, CAmount>(*this, *pdbTo, batch, DB_ADDRESSINDEX, nMovedRet) &&
+                      CopyKeysOfType<CAddressUnspentKey, CAddressUnspentValue>(*this, *pdbTo, batch, DB_ADDRESSUNSPENTINDEX, nMovedRet);
+        else if (name == "spent")
+            fCopied = CopyKeysOfType<CSpentIndexKey, CSpentIndexValue>(*this, *pdbTo, batch, DB_SPENTINDEX, nMovedRet);
+        else if (name == "timestamp")
+            fCopied = CopyKeysOfType<CTIMECoinstampIndexKey, int>(*this, *pdbTo, batch, DB_TIMECSTAMPINDEX, nMovedRet);
+        else
+            return error("%s: %s is not an index older versions kept here", __func__, name);
+        // The best block goes in last, so a move cut short leaves an index without one
+        pdbTo->BatchBestBlock(batch, hashBest, nBestHeight);
+        if (!fCopied || !pdbTo->WriteBatch(batch, true))
+            return false;
+    }
 
-    pcursor->Seek(make_pair(DB_TIMECSTAMPINDEX, CTIMECoinstampIndexIteratorKey(low)));
+    // Only now that the copy is on disk can the entries here go
+    bool fErased;
+    if (name == "address")
+        fErased = EraseKeysOfType<CAddressIndexKey>(*this, DB_ADDRESSINDEX) &&
+                  EraseKeysOfType<CAddressUnspentKey>(*this, DB_ADDRESSUNSPENTINDEX);
+    else if (name == "spent")
+        fErased = EraseKeysOfType<CSpentIndexKey>(*this, DB_SPENTINDEX);
+    else
+        fErased = EraseKeysOfType<CTIMECoinstampIndexKey>(*this, DB_TIMECSTAMPINDEX);
+    if (!fErased)
+        return false;
+    CDBBatch batch(*this);
+    batch.Erase(std::make_pair(DB_FLAG, name + "index"));
+    return WriteBatch(batch, true);
+}
 
-    while (pcursor->Valid()) {
-        boost::this_thread::interruption_point();
-        std::pair<char, CTIMECoinstampIndexKey> key;
-        if (pcursor->GetKey(key) && key.first == DB_TIMECSTAMPINDEX && key.second.timestamp <= high) {
-            hashes.push_back(key.second.blockHash);
-            pcursor->Next();
-        } else {
-            break;
-        }
-    }
+bool CBlockTreeDB::ReadLegacyExplorerIndexesMoved() {
+    bool fMoved = false;
+    return ReadFlag("explorerindexdbs", fMoved) && fMoved;
+}
 
-    return true;
+bool CBlockTreeDB::WriteLegacyExplorerIndexesMoved() {
+    CDBBatch batch(*this);
+    batch.Erase(DB_INDEX_BEST_BLOCK);
+    batch.Write(std::make_pair(DB_FLAG, std::string("explorerindexdbs")), '1');
+    return WriteBatch(batch, true);
 }
 
 bool CBlockTreeDB::WriteFlag(const std::string &name, bool fValue) {
@@ -346,47 +543,77 @@ bool CBlockTreeDB::ReadFlag(const std::string &name, bool &fValue) {
     return true;
 }
 
-bool CBlockTreeDB::LoadBlockIndexGuts(boost::function<CBlockIndex*(const uint256&)> insertBlockIndex)
+/** Decode the block index entries [nBegin, nEnd) of the raw values read by LoadBlockIndexGuts */
+static bool DecodeBlockIndexEntries(const std::vector<char>& vchValues, const std::vector<size_t>& vOffsets, const std::vector<unsigned char>& obfuscateKey,
+                                    std::vector<CDiskBlockIndex>& vEntries, size_t nBegin, size_t nEnd)
 {
-    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
-
-    pcursor->Seek(make_pair(DB_BLOCK_INDEX, uint256()));
+    const Consensus::Params& consensusParams = Params().GetConsensus();
+    for (size_t i = nBegin; i < nEnd; i++) {
+        CDiskBlockIndex& diskindex = vEntries[i];
+        try {
+            CDataStream ssValue(vchValues.data() + vOffsets[i], vchValues.data() + vOffsets[i + 1], SER_DISK, CLIENT_VERSION);
+            ssValue.Xor(obfuscateKey);
+            ssValue >> diskindex;
+        } catch (const std::exception&) {
+            return error("%s: failed to read value", __func__);
+        }
+        // Entries written before the hash was stored have to hash their header; do it here, once
+        diskindex.hash = diskindex.GetBlockHash();
 
-    // Load mapBlockIndex
-    while (pcursor->Valid()) {
-        boost::this_thread::interruption_point();
-        std::pair<char, uint256> key;
-        if (pcursor->GetKey(key) && key.first == DB_BLOCK_INDEX) {
-            CDiskBlockIndex diskindex;
-            if (pcursor->GetValue(diskindex)) {
-                // Construct block index object
-                CBlockIndex* pindexNew = insertBlockIndex(diskindex.GetBlockHash());
-                pindexNew->pprev          = insertBlockIndex(diskindex.hashPrev);
-                pindexNew->nHeight        = diskindex.nHeight;
-                pindexNew->nFile          = diskindex.nFile;
-                pindexNew->nDataPos       = diskindex.nDataPos;
-                pindexNew->nUndoPos       = diskindex.nUndoPos;
-                pindexNew->nVersion       = diskindex.nVersion;
-                pindexNew->hashMerkleRoot = diskindex.hashMerkleRoot;
-                pindexNew->nTIMECoin          = diskindex.nTIMECoin;
-                pindexNew->nBits          = diskindex.nBits;
-                pindexNew->nNonce         = diskindex.nNonce;
-                pindexNew->nStatus        = diskindex.nStatus;
-                pindexNew->nTx            = diskindex.nTx;
-
-                if (!CheckProofOfWork(pindexNew->GetBlockHash(), pindexNew->nBits, Params().GetConsensus()))
-                    return error("%s: CheckProofOfWork failed: %s", __func__, pindexNew->ToString());
+        if (!CheckProofOfWork(diskindex.hash, diskindex.nBits, consensusParams))
+            return error("%s: CheckProofOfWork failed: %s", __func__, diskindex.ToString());
+    }
+    return true;
+}
 
-                pcursor->Next();
-            } else {
-                return error("%s: failed to read value", __func__);
-            }
+bool CBlockTreeDB::LoadBlockIndexGuts(std::vector<CDiskBlockIndex>& vEntries, int nThreads)
+{
+    int64_t nStart = GetTIMECoinMillis();
+
+    // Copy the values out of LevelDB in one pass, so decoding them does not
+    // hold up the iterator and can be split between threads
+    std::vector<char> vchValues;
+    std::vector<size_t> vOffsets(1, 0);
+    {
+        boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
+        pcursor->Seek(make_pair(DB_BLOCK_INDEX, uint256()));
+        while (pcursor->Valid()) {
+            boost::this_thread::interruption_point();
+            std::pair<char, uint256> key;
+            if (!pcursor->GetKey(key) || key.first != DB_BLOCK_INDEX)
+                break;
+            pcursor->AppendRawValue(vchValues);
+            vOffsets.push_back(vchValues.size());
+            pcursor->Next();
+        }
+    }
+    const size_t nEntries = vOffsets.size() - 1;
+    int64_t nRead = GetTIMECoinMillis();
+
+    vEntries.clear();
+    vEntries.resize(nEntries);
+    nThreads = std::max(1, std::min<int>(nThreads, nEntries / BLOCK_INDEX_LOAD_MIN_ENTRIES_PER_THREAD));
+    const std::vector<unsigned char>& obfuscateKey = dbwrapper_private::GetObfuscateKey(*this);
+
+    // Each thread decodes a contiguous range; the calling thread takes the last one
+    std::vector<char> vResults(nThreads, false);
+    boost::thread_group threadGroup;
+    for (int t = 0; t < nThreads; t++) {
+        const size_t nBegin = nEntries * t / nThreads;
+        const size_t nEnd = nEntries * (t + 1) / nThreads;
+        if (t + 1 < nThreads) {
+            threadGroup.create_thread([&, t, nBegin, nEnd]() {
+                vResults[t] = DecodeBlockIndexEntries(vchValues, vOffsets, obfuscateKey, vEntries, nBegin, nEnd);
+            });
         } else {
-            break;
+            vResults[t] = DecodeBlockIndexEntries(vchValues, vOffsets, obfuscateKey, vEntries, nBegin, nEnd);
         }
     }
+    threadGroup.join_all();
 
-    return true;
+    LogPrintf("%s: read %u entries in %dms, decoded them on %d threads in %dms\n", __func__,
+        nEntries, nRead - nStart, nThreads, GetTIMECoinMillis() - nRead);
+    return std::find(vResults.begin(), vResults.end(), false) == vResults.end();
 }
 
 namespace {
@@ -511,3 +738,206 @@ bool CCoinsViewDB::Upgrade() {
     LogPrintf("[%s].\n", ShutdownRequested() ? "CANCELLED" : "DONE");
     return !ShutdownRequested();
 }
+
+CExplorerIndexDB::CExplorerIndexDB(const std::string& nameIn, size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(GetDataDir() / "indexes" / nameIn, nCacheSize, fMemory, fWipe, false, ::GetDBOptions(nameIn)), name(nameIn) {
+}
+
+bool CExplorerIndexDB::ReadSpentIndex(CSpentIndexKey &key, CSpentIndexValue &value) {
+    return Read(make_pair(DB_SPENTINDEX, key), value);
+}
+
+void CExplorerIndexDB::BatchSpentIndex(CDBBatch &batch, const std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> >&vect) {
+    for (std::vector<std::pair<CSpentIndexKey,CSpentIndexValue> >::const_iterator it=vect.begin(); it!=vect.end(); it++) {
+        if (it->second.IsNull()) {
+            batch.Erase(make_pair(DB_SPENTINDEX, it->first));
+        } else {
+            batch.Write(make_pair(DB_SPENTINDEX, it->first), it->second);
+        }
+    }
+}
+
+void CExplorerIndexDB::BatchAddressUnspentIndex(CDBBatch &batch, const std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue > >&vect) {
+    for (std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> >::const_iterator it=vect.begin(); it!=vect.end(); it++) {
+        if (it->second.IsNull()) {
+            batch.Erase(make_pair(DB_ADDRESSUNSPENTINDEX, it->first));
+        } else {
+            batch.Write(make_pair(DB_ADDRESSUNSPENTINDEX, it->first), it->second);
+        }
+    }
+}
+
+bool CExplorerIndexDB::ReadAddressUnspentIndex(uint160 addressHash, int type,
+                                               std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > &unspentOutputs) {
+    return ForEachAddressUnspent(addressHash, type, NULL,
+        [&unspentOutputs](const CAddressUnspentKey& key, const CAddressUnspentValue& value) {
+            unspentOutputs.push_back(make_pair(key, value));
+            return true;
+        });
+}
+
+/** Whether two index keys are the same, i.e. serialize to the same database key */
+template<typename K>
+static bool IsSameKey(const K& a, const K& b) {
+    CDataStream ssA(SER_DISK, CLIENT_VERSION), ssB(SER_DISK, CLIENT_VERSION);
+    ssA << a;
+    ssB << b;
+    return ssA.str() == ssB.str();
+}
+
+bool CExplorerIndexDB::ForEachAddressUnspent(uint160 addressHash, int type, const CAddressUnspentKey* pafter,
+                                             boost::function<bool(const CAddressUnspentKey&, const CAddressUnspentValue&)> fn) {
+
+    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
+
+    if (pafter) {
+        pcursor->Seek(make_pair(DB_ADDRESSUNSPENTINDEX, *pafter));
+    } else {
+        pcursor->Seek(make_pair(DB_ADDRESSUNSPENTINDEX, CAddressIndexIteratorKey(type, addressHash)));
+    }
+
+    while (pcursor->Valid()) {
+        boost::this_thread::interruption_point();
+        std::pair<char,CAddressUnspentKey> key;
+        if (pcursor->GetKey(key) && key.first == DB_ADDRESSUNSPENTINDEX && key.second.type == (unsigned int)type && key.second.hashBytes == addressHash) {
+            if (pafter && IsSameKey(key.second, *pafter)) {
+                pcursor->Next();
+                continue;
+            }
+            CAddressUnspentValue nValue;
+            if (pcursor->GetValue(nValue)) {
+                if (!fn(key.second, nValue))
+                    break;
+                pcursor->Next();
+            } else {
+                return error("failed to get address unspent value");
+            }
+        } else {
+            break;
+        }
+    }
+
+    return true;
+}
+
+void CExplorerIndexDB::BatchAddressIndex(CDBBatch &batch, const std::vector<std::pair<CAddressIndexKey, CAmount > >&vect, bool fErase) {
+    for (std::vector<std::pair<CAddressIndexKey, CAmount> >::const_iterator it=vect.begin(); it!=vect.end(); it++) {
+        if (fErase)
+            batch.Erase(make_pair(DB_ADDRESSINDEX, it->first));
+        else
+            batch.Write(make_pair(DB_ADDRESSINDEX, it->first), it->second);
+    }
+}
+
+bool CExplorerIndexDB::ReadAddressIndex(uint160 addressHash, int type,
+                                        std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex,
+                                        int start, int end) {
+    return ForEachAddressIndex(addressHash, type, start, end, NULL,
+        [&addressIndex](const CAddressIndexKey& key, CAmount value) {
+            addressIndex.push_back(make_pair(key, value));
+            return true;
+        });
+}
+
+bool CExplorerIndexDB::ForEachAddressIndex(uint160 addressHash, int type, int start, int end, const CAddressIndexKey* pafter,
+                                           boost::function<bool(const CAddressIndexKey&, CAmount)> fn) {
+
+    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
+
+    if (pafter) {
+        pcursor->Seek(make_pair(DB_ADDRESSINDEX, *pafter));
+    } else if (start > 0 && end > 0) {
+        pcursor->Seek(make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorHeightKey(type, addressHash, start)));
+    } else {
+        pcursor->Seek(make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorKey(type, addressHash)));
+    }
+
+    while (pcursor->Valid()) {
+        boost::this_thread::interruption_point();
+        std::pair<char,CAddressIndexKey> key;
+        if (pcursor->GetKey(key) && key.first == DB_ADDRESSINDEX && key.second.type == (unsigned int)type && key.second.hashBytes == addressHash) {
+            if (end > 0 && key.second.blockHeight > end) {
+                break;
+            }
+            if (pafter && IsSameKey(key.second, *pafter)) {
+                pcursor->Next();
+                continue;
+            }
+            CAmount nValue;
+            if (pcursor->GetValue(nValue)) {
+                if (!fn(key.second, nValue))
+                    break;
+                pcursor->Next();
+            } else {
+                return error("failed to get address index value");
+            }
+        } else {
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool CExplorerIndexDB::ReadAddressBalance(uint160 addressHash, int type, CAddressBalanceValue &value) {
+    value.SetNull();
+    if (!Exists(make_pair(DB_ADDRESSBALANCEINDEX, CAddressIndexIteratorKey(type, addressHash))))
+        return true;
+    return Read(make_pair(DB_ADDRESSBALANCEINDEX, CAddressIndexIteratorKey(type, addressHash)), value);
+}
+
+void CExplorerIndexDB::BatchAddressBalance(CDBBatch &batch, uint160 addressHash, int type, const CAddressBalanceValue &value) {
+    if (value.IsNull()) {
+        batch.Erase(make_pair(DB_ADDRESSBALANCEINDEX, CAddressIndexIteratorKey(type, addressHash)));
+    } else {
+        batch.Write(make_pair(DB_ADDRESSBALANCEINDEX, CAddressIndexIteratorKey(type, addressHash)), value);
+    }
+}
+
+void CExplorerIndexDB::BatchTIMECoinstampIndex(CDBBatch &batch, const CTIMECoinstampIndexKey &timestampIndex) {
+    batch.Write(make_pair(DB_TIMECSTAMPINDEX, timestampIndex), 0);
+}
+
+void CExplorerIndexDB::BatchCoinStats(CDBBatch &batch, const CCoinStatsIndexValue &value) {
+    batch.Write(DB_COINSTATS, value);
+}
+
+bool CExplorerIndexDB::ReadCoinStats(CCoinStatsIndexValue &value) {
+    return Read(DB_COINSTATS, value);
+}
+
+void CExplorerIndexDB::BatchBestBlock(CDBBatch &batch, const uint256 &hashBlock, int nHeight) {
+    batch.Write(DB_INDEX_BEST_BLOCK, make_pair(hashBlock, nHeight));
+}
+
+bool CExplorerIndexDB::ReadBestBlock(uint256 &hashBlock, int &nHeight) {
+    std::pair<uint256, int> best;
+    if (!Read(DB_INDEX_BEST_BLOCK, best))
+        return false;
+    hashBlock = best.first;
+    nHeight = best.second;
+    return true;
+}
+
+bool CExplorerIndexDB::ReadTIMECoinstampIndex(const unsigned int &high, const unsigned int &low, std::vector<uint256> &hashes) {
+
+    boost::scoped_ptr<CDBIterator> pcursor(NewIterator());
+
+    pcursor->Seek(make_pair(DB_TIMECSTAMPINDEX, CTIMECoinstampIndexIteratorKey(low)));
+
+    while (pcursor->Valid()) {
+        boost::this_thread::interruption_point();
+        std::pair<char, CTIMECoinstampIndexKey> key;
+        if (pcursor->GetKey(key) && key.first == DB_TIMECSTAMPINDEX && key.second.timestamp <= high) {
+            hashes.push_back(key.second.blockHash);
+            pcursor->Next();
+        } else {
+            break;
+        }
+    }
+
+    return true;
+}
+
+size_t CExplorerIndexDB::EstimateSize() const {
+    return CDBWrapper::EstimateSize((char)0, (char)0xff);
+}
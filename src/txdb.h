@@ -7,6 +7,7 @@
 #define BITCOIN_TXDB_H
 
 #include "coins.h"
+#include "coinstats.h"
 #include "dbwrapper.h"
 #include "chain.h"
 #include "spentindex.h"
@@ -17,9 +18,13 @@
 #include <vector>
 
 #include <boost/function.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 
 class CBlockIndex;
 class CCoinsViewDBCursor;
+class CExplorerIndexDB;
 class uint256;
 
 //! Compensate for extra memory peak (x1.5-x1.9) at flush time.
@@ -40,6 +45,16 @@ static const int64_t nMaxBlockDBCache = 2;
 static const int64_t nMaxBlockDBAndTxIndexCache = 1024;
 //! Max memory allocated to coin DB specific cache (MiB)
 static const int64_t nMaxCoinsDBCache = 8;
+//! Max memory allocated to each explorer index DB specific cache (MiB)
+static const int64_t nMaxIndexDBCache = 64;
+//! -backgroundflush default
+static const bool DEFAULT_BACKGROUND_FLUSH = true;
+//! Buckets of the chainstate flush histograms
+static const int COINS_FLUSH_HISTOGRAM_BUCKETS = 16;
+//! Most threads decoding the block index at startup
+static const int MAX_BLOCK_INDEX_LOAD_THREADS = 8;
+//! Fewest block index entries worth giving a thread of their own
+static const size_t BLOCK_INDEX_LOAD_MIN_ENTRIES_PER_THREAD = 20000;
 
 struct CDiskTxPos : public CDiskBlockPos
 {
@@ -66,23 +81,104 @@ struct CDiskTxPos : public CDiskBlockPos
     }
 };
 
-/** CCoinsView backed by the coin database (chainstate/) */
+/** How long chainstate flushes took and how much they wrote */
+struct CCoinsFlushStats
+{
+    uint64_t nFlushes;
+    //! Time spent writing and number of coins written by the last flush
+    int64_t nLastDuration;
+    size_t nLastChanged;
+    //! Time BatchWrite callers spent waiting for an earlier flush to finish
+    int64_t nTotalWait;
+    //! Flushes that took under 2^i ms (the last bucket also counts longer ones)
+    uint64_t vDuration[COINS_FLUSH_HISTOGRAM_BUCKETS];
+    //! Flushes that wrote under 1000 * 2^i coins (the last bucket also counts more)
+    uint64_t vChanged[COINS_FLUSH_HISTOGRAM_BUCKETS];
+
+    CCoinsFlushStats() : nFlushes(0), nLastDuration(0), nLastChanged(0), nTotalWait(0)
+    {
+        std::fill(vDuration, vDuration + COINS_FLUSH_HISTOGRAM_BUCKETS, 0);
+        std::fill(vChanged, vChanged + COINS_FLUSH_HISTOGRAM_BUCKETS, 0);
+    }
+};
+
+/**
+ * CCoinsView backed by the coin database (chainstate/)
+ *
+ * With StartBackgroundFlush(), BatchWrite takes over the caller's dirty
+ * entries and returns, and a thread writes them while validation carries on
+ * with an emptied cache. Until the write is done, reads are answered from
+ * the entries being written first, so the view never goes back in time.
+ * The coins and the best block marker are written in one LevelDB batch, so
+ * the database on disk always describes the chainstate at some block.
+ */
 class CCoinsViewDB : public CCoinsView
 {
 protected:
     CDBWrapper db;
+
+    //! Protects the fields below, and the flush thread's access to mapFlushing
+    mutable boost::mutex csFlush;
+    mutable boost::condition_variable condFlush;
+    boost::thread threadFlush;
+    bool fBackgroundFlush;
+    bool fStopFlush;
+
+    //! Entries handed over by BatchWrite that are not on disk yet. Only read while fFlushPending.
+    CCoinsMap mapFlushing;
+    uint256 hashFlushing;
+    bool fFlushPending;
+
+    //! Set once a background write failed; every later BatchWrite fails
+    bool fFlushFailed;
+
+    CCoinsFlushStats flushStats;
+
+    //! Write the coins of mapCoins and the best block marker in one batch
+    bool WriteCoins(const CCoinsMap &mapCoins, const uint256 &hashBlock, size_t &nChanged);
+    void ThreadFlush();
+
 public:
     CCoinsViewDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
+    ~CCoinsViewDB();
 
     bool GetCoin(const COutPoint &outpoint, Coin &coin) const override;
     bool HaveCoin(const COutPoint &outpoint) const override;
     uint256 GetBestBlock() const override;
     bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) override;
     CCoinsViewCursor *Cursor() const override;
+    //! A cursor starting at the first coin at or after start
+    CCoinsViewCursor *Cursor(const COutPoint &start) const;
 
     //! Attempt to update from an older database format. Returns whether an error occurred.
     bool Upgrade();
     size_t EstimateSize() const override;
+
+    const CDBWrapper& GetDB() const { return db; }
+
+    //! Write later BatchWrite calls from a background thread
+    void StartBackgroundFlush();
+
+    //! Wait until the entries handed to BatchWrite are on disk. Returns false if writing them failed.
+    bool WaitForFlush() const;
+
+    //! Whether a background write is in progress
+    bool IsFlushing() const;
+
+    //! Memory held by the entries being written, not counting large scripts
+    size_t FlushingMemoryUsage() const;
+
+    CCoinsFlushStats GetFlushStats() const;
+
+    //! Write coins of a UTXO snapshot being loaded. Several threads may call this at once.
+    bool WriteSnapshotCoins(const std::vector<std::pair<COutPoint, Coin> > &coins);
+    //! Mark the database as holding a partly loaded snapshot, until FinishSnapshotLoading or AbortSnapshotLoading
+    bool SetSnapshotLoading();
+    bool IsSnapshotLoading() const;
+    //! Clear the mark and make hashBlock the best block, in one batch
+    bool FinishSnapshotLoading(const uint256 &hashBlock);
+    //! Erase the coins written so far and clear the mark
+    bool AbortSnapshotLoading();
 };
 
 /** Specialization of CCoinsViewCursor to iterate over a CCoinsViewDB */
@@ -123,21 +219,70 @@ public:
     bool ReadReindexing(bool &fReindex);
     bool ReadTxIndex(const uint256 &txid, CDiskTxPos &pos);
     bool WriteTxIndex(const std::vector<std::pair<uint256, CDiskTxPos> > &list);
+    bool WriteFlag(const std::string &name, bool fValue);
+    bool ReadFlag(const std::string &name, bool &fValue);
+    //! The block the explorer indexes kept here by older versions were written up to
+    bool ReadLegacyIndexBestBlock(uint256 &hashBlock, int &nHeight);
+    //! Copy the explorer index older versions kept here into its own database, as of the given block, and erase
+    //! it here once the copy is committed; without a database to copy into it is only erased
+    bool MoveLegacyExplorerIndex(const std::string &name, CExplorerIndexDB *pdbTo, const uint256 &hashBest, int nBestHeight, size_t &nMovedRet);
+    //! Whether the explorer indexes kept here have all been moved out, so there is nothing left to look for
+    bool ReadLegacyExplorerIndexesMoved();
+    bool WriteLegacyExplorerIndexesMoved();
+    //! The block a UTXO snapshot was loaded at, and its nChainTx, which its unavailable ancestors cannot provide
+    bool WriteSnapshotBase(const uint256 &hash, unsigned int nChainTx);
+    bool ReadSnapshotBase(uint256 &hash, unsigned int &nChainTx);
+    /** Read every block index entry, decoding and checking them on up to nThreads threads */
+    bool LoadBlockIndexGuts(std::vector<CDiskBlockIndex>& vEntries, int nThreads);
+};
+
+/**
+ * Access to one of the explorer index databases (indexes/<name>/).
+ *
+ * Each of -addressindex, -spentindex, -timestampindex and -addressbalanceindex
+ * is kept in its own database, together with the block it was last written up
+ * to, so it can be built, caught up or dropped without touching the block tree.
+ */
+class CExplorerIndexDB : public CDBWrapper
+{
+public:
+    CExplorerIndexDB(const std::string& nameIn, size_t nCacheSize, bool fMemory = false, bool fWipe = false);
+private:
+    CExplorerIndexDB(const CExplorerIndexDB&);
+    void operator=(const CExplorerIndexDB&);
+public:
+    const std::string name;
+
     bool ReadSpentIndex(CSpentIndexKey &key, CSpentIndexValue &value);
-    bool UpdateSpentIndex(const std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> >&vect);
-    bool UpdateAddressUnspentIndex(const std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue > >&vect);
     bool ReadAddressUnspentIndex(uint160 addressHash, int type,
                                  std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > &vect);
-    bool WriteAddressIndex(const std::vector<std::pair<CAddressIndexKey, CAmount> > &vect);
-    bool EraseAddressIndex(const std::vector<std::pair<CAddressIndexKey, CAmount> > &vect);
     bool ReadAddressIndex(uint160 addressHash, int type,
                           std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex,
                           int start = 0, int end = 0);
-    bool WriteTIMECoinstampIndex(const CTIMECoinstampIndexKey &timestampIndex);
     bool ReadTIMECoinstampIndex(const unsigned int &high, const unsigned int &low, std::vector<uint256> &vect);
-    bool WriteFlag(const std::string &name, bool fValue);
-    bool ReadFlag(const std::string &name, bool &fValue);
-    bool LoadBlockIndexGuts(boost::function<CBlockIndex*(const uint256&)> insertBlockIndex);
+    //! Visit an address's index entries in key order without loading them all: from the start height
+    //! (when start and end are set) or right after the key *pafter, up to the end height or until fn returns false
+    bool ForEachAddressIndex(uint160 addressHash, int type, int start, int end, const CAddressIndexKey* pafter,
+                             boost::function<bool(const CAddressIndexKey&, CAmount)> fn);
+    //! Visit an address's unspent outputs in key order, right after the key *pafter if given, until fn returns false
+    bool ForEachAddressUnspent(uint160 addressHash, int type, const CAddressUnspentKey* pafter,
+                               boost::function<bool(const CAddressUnspentKey&, const CAddressUnspentValue&)> fn);
+    //! The running totals of an address; all zero for an address never seen
+    bool ReadAddressBalance(uint160 addressHash, int type, CAddressBalanceValue &value);
+    //! Append index updates to a batch, so several blocks can be committed at once
+    void BatchSpentIndex(CDBBatch &batch, const std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> > &vect);
+    void BatchAddressUnspentIndex(CDBBatch &batch, const std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue > > &vect);
+    void BatchAddressIndex(CDBBatch &batch, const std::vector<std::pair<CAddressIndexKey, CAmount> > &vect, bool fErase);
+    void BatchTIMECoinstampIndex(CDBBatch &batch, const CTIMECoinstampIndexKey &timestampIndex);
+    void BatchAddressBalance(CDBBatch &batch, uint160 addressHash, int type, const CAddressBalanceValue &value);
+    //! The UTXO set state of the coinstats index
+    void BatchCoinStats(CDBBatch &batch, const CCoinStatsIndexValue &value);
+    bool ReadCoinStats(CCoinStatsIndexValue &value);
+    //! The block the index is written up to, stored with the index data it describes
+    void BatchBestBlock(CDBBatch &batch, const uint256 &hashBlock, int nHeight);
+    bool ReadBestBlock(uint256 &hashBlock, int &nHeight);
+    //! Approximate size of the database on disk
+    size_t EstimateSize() const;
 };
 
 #endif // BITCOIN_TXDB_H
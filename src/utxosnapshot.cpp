@@ -0,0 +1,361 @@
+// Copyright (c) 2017 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "utxosnapshot.h"
+
+#include "chain.h"
+#include "chainparams.h"
+#include "checkqueue.h"
+#include "clientversion.h"
+#include "coins.h"
+#include "coinstats.h"
+#include "hash.h"
+#include "streams.h"
+#include "sync.h"
+#include "txdb.h"
+#include "util.h"
+#include "utiltime.h"
+#include "validation.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+
+typedef std::vector<std::pair<COutPoint, Coin> > SnapshotCoins;
+
+namespace {
+
+/** Serialize coins as a chunk payload, grouping consecutive coins of the same transaction */
+void SerializeChunk(const SnapshotCoins& coins, CDataStream& ss)
+{
+    size_t i = 0;
+    while (i < coins.size()) {
+        size_t nEnd = i + 1;
+        while (nEnd < coins.size() && coins[nEnd].first.hash == coins[i].first.hash)
+            nEnd++;
+        ss << coins[i].first.hash;
+        WriteCompactSize(ss, nEnd - i);
+        for (; i < nEnd; i++) {
+            ss << VARINT(coins[i].first.n);
+            ss << coins[i].second;
+        }
+    }
+}
+
+/** Inverse of SerializeChunk. Throws on malformed data. */
+void DeserializeChunk(CDataStream& ss, SnapshotCoins& coins)
+{
+    while (!ss.empty()) {
+        uint256 txid;
+        ss >> txid;
+        uint64_t nOutputs = ReadCompactSize(ss);
+        if (nOutputs == 0 || nOutputs > ss.size())
+            throw std::ios_base::failure("invalid output count");
+        for (uint64_t i = 0; i < nOutputs; i++) {
+            COutPoint outpoint(txid, 0);
+            ss >> VARINT(outpoint.n);
+            Coin coin;
+            ss >> coin;
+            if (coin.IsSpent())
+                throw std::ios_base::failure("spent coin");
+            coins.push_back(std::make_pair(outpoint, coin));
+        }
+    }
+}
+
+/** Check a chunk's hash and write its coins, on a CCheckQueue worker */
+class CSnapshotChunkWriter
+{
+private:
+    CCoinsViewDB* view;
+    std::vector<char> payload;
+    uint256 hashChunk;
+    SnapshotCoins coins;
+
+public:
+    CSnapshotChunkWriter() : view(NULL) {}
+    CSnapshotChunkWriter(CCoinsViewDB* viewIn, std::vector<char>& payloadIn, const uint256& hashChunkIn, SnapshotCoins& coinsIn) : view(viewIn), hashChunk(hashChunkIn)
+    {
+        payload.swap(payloadIn);
+        coins.swap(coinsIn);
+    }
+
+    bool operator()()
+    {
+        if (Hash(payload.begin(), payload.end()) != hashChunk) {
+            LogPrintf("%s: chunk hash mismatch\n", __func__);
+            return false;
+        }
+        try {
+            return view->WriteSnapshotCoins(coins);
+        } catch (const std::exception& e) {
+            LogPrintf("%s: %s\n", __func__, e.what());
+            return false;
+        }
+    }
+
+    void swap(CSnapshotChunkWriter& other)
+    {
+        std::swap(view, other.view);
+        payload.swap(other.payload);
+        std::swap(hashChunk, other.hashChunk);
+        coins.swap(other.coins);
+    }
+};
+
+}
+
+bool DumpUTXOSnapshot(CCoinsViewDB* view, const boost::filesystem::path& path, CUTXOSnapshotHeader& header, CCoinsStats& stats, std::string& strError)
+{
+    if (boost::filesystem::exists(path)) {
+        strError = strprintf("%s already exists", path.string());
+        return false;
+    }
+
+    header.SetNull();
+    memcpy(header.pchMessageStart, Params().MessageStart(), sizeof(header.pchMessageStart));
+
+    // LevelDB iterators read from an implicit snapshot, so once the cursor
+    // exists the chainstate can move on while it is written out
+    boost::scoped_ptr<CCoinsViewCursor> pcursor;
+    {
+        LOCK(cs_main);
+        FlushStateToDisk();
+        pcursor.reset(view->Cursor());
+        BlockMap::const_iterator it = mapBlockIndex.find(pcursor->GetBestBlock());
+        if (it == mapBlockIndex.end()) {
+            strError = "chainstate best block is not in the block index";
+            return false;
+        }
+        header.hashBlock = it->second->GetBlockHash();
+        header.nHeight = it->second->nHeight;
+        header.nTx = it->second->nTx;
+        header.nChainTx = it->second->nChainTx;
+    }
+
+    boost::filesystem::path pathTmp = path;
+    pathTmp += ".incomplete";
+    FILE* file = fopen(pathTmp.string().c_str(), "wb");
+    if (!file) {
+        strError = strprintf("unable to open %s for writing", pathTmp.string());
+        return false;
+    }
+    CAutoFile fileout(file, SER_DISK, CLIENT_VERSION);
+
+    int64_t nStart = GetTIMECoinMillis();
+    CCoinsStatsHasher hasher(stats, header.hashBlock);
+    stats.nHeight = header.nHeight;
+    CHashWriter hashChunks(SER_GETHASH, PROTOCOL_VERSION);
+    try {
+        // Written again below with the totals
+        fileout << header;
+
+        SnapshotCoins coins;
+        coins.reserve(UTXO_SNAPSHOT_CHUNK_COINS);
+        CDataStream ssPayload(SER_DISK, CLIENT_VERSION);
+        while (true) {
+            bool fValid = pcursor->Valid();
+            if (fValid) {
+                boost::this_thread::interruption_point();
+                COutPoint outpoint;
+                Coin coin;
+                if (!pcursor->GetKey(outpoint) || !pcursor->GetValue(coin)) {
+                    strError = "unable to read the chainstate";
+                    fileout.fclose();
+                    boost::filesystem::remove(pathTmp);
+                    return false;
+                }
+                hasher.Add(outpoint, coin);
+                coins.push_back(std::make_pair(outpoint, coin));
+                pcursor->Next();
+            }
+            if (coins.size() >= UTXO_SNAPSHOT_CHUNK_COINS || (!fValid && !coins.empty())) {
+                ssPayload.clear();
+                SerializeChunk(coins, ssPayload);
+                uint256 hashChunk = Hash(ssPayload.begin(), ssPayload.end());
+                fileout << (uint32_t)coins.size() << (uint32_t)ssPayload.size();
+                fileout.write(&ssPayload[0], ssPayload.size());
+                fileout << hashChunk;
+                hashChunks << hashChunk;
+                header.nCoins += coins.size();
+                header.nChunks++;
+                coins.clear();
+            }
+            if (!fValid)
+                break;
+        }
+        hasher.Finalize();
+        header.hashChunks = hashChunks.GetHash();
+        header.hashSerialized = stats.hashSerialized;
+
+        if (fseek(fileout.Get(), 0, SEEK_SET) != 0)
+            throw std::ios_base::failure("unable to seek");
+        fileout << header;
+        FileCommit(fileout.Get());
+    } catch (const std::exception& e) {
+        strError = strprintf("unable to write %s: %s", pathTmp.string(), e.what());
+        fileout.fclose();
+        boost::filesystem::remove(pathTmp);
+        return false;
+    }
+    fileout.fclose();
+    if (!RenameOver(pathTmp, path)) {
+        strError = strprintf("unable to rename %s to %s", pathTmp.string(), path.string());
+        return false;
+    }
+    LogPrintf("Wrote %u coins at %s (height %d) to %s in %dms\n", header.nCoins, header.hashBlock.ToString(), header.nHeight, path.string(), GetTIMECoinMillis() - nStart);
+    return true;
+}
+
+static bool ReadHeader(CAutoFile& filein, const boost::filesystem::path& path, CUTXOSnapshotHeader& header, std::string& strError)
+{
+    try {
+        filein >> header;
+    } catch (const std::exception& e) {
+        strError = strprintf("unable to read the header of %s", path.string());
+        return false;
+    }
+    if (header.nMagic != CUTXOSnapshotHeader::MAGIC) {
+        strError = strprintf("%s is not a UTXO snapshot", path.string());
+        return false;
+    }
+    if (header.nVersion != CUTXOSnapshotHeader::CURRENT_VERSION) {
+        strError = strprintf("unsupported UTXO snapshot version %u", header.nVersion);
+        return false;
+    }
+    if (memcmp(header.pchMessageStart, Params().MessageStart(), sizeof(header.pchMessageStart)) != 0) {
+        strError = "the snapshot was taken on a different network";
+        return false;
+    }
+    return true;
+}
+
+bool ReadUTXOSnapshotHeader(const boost::filesystem::path& path, CUTXOSnapshotHeader& header, std::string& strError)
+{
+    CAutoFile filein(fopen(path.string().c_str(), "rb"), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull()) {
+        strError = strprintf("unable to open %s", path.string());
+        return false;
+    }
+    return ReadHeader(filein, path, header, strError);
+}
+
+bool LoadUTXOSnapshot(CCoinsViewDB* view, const boost::filesystem::path& path, const uint256& hashExpected, CUTXOSnapshotHeader& header, CCoinsStats& stats, std::string& strError)
+{
+    CAutoFile filein(fopen(path.string().c_str(), "rb"), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull()) {
+        strError = strprintf("unable to open %s", path.string());
+        return false;
+    }
+    if (!ReadHeader(filein, path, header, strError))
+        return false;
+    if (!hashExpected.IsNull() && header.hashSerialized != hashExpected) {
+        strError = strprintf("the snapshot's UTXO set hash %s is not the expected %s", header.hashSerialized.ToString(), hashExpected.ToString());
+        return false;
+    }
+    if (!view->SetSnapshotLoading()) {
+        strError = "unable to write to the chainstate";
+        return false;
+    }
+
+    LogPrintf("Loading %u coins at %s (height %d) from %s\n", header.nCoins, header.hashBlock.ToString(), header.nHeight, path.string());
+    int64_t nStart = GetTIMECoinMillis();
+
+    // This thread reads, parses and hashes the chunks in order, which the
+    // UTXO set hash requires; checking the chunk hashes and writing the coins
+    // is spread over the queue. Waiting for the queue every few chunks bounds
+    // the memory held by chunks read ahead.
+    CCheckQueue<CSnapshotChunkWriter> queue(1);
+    boost::thread_group workers;
+    for (int i = 0; i < UTXO_SNAPSHOT_LOAD_THREADS - 1; i++)
+        workers.create_thread(boost::bind(&CCheckQueue<CSnapshotChunkWriter>::Thread, &queue));
+
+    CCoinsStatsHasher hasher(stats, header.hashBlock);
+    stats.nHeight = header.nHeight;
+    CHashWriter hashChunks(SER_GETHASH, PROTOCOL_VERSION);
+    uint64_t nCoins = 0;
+    bool fOk = true;
+    try {
+        std::vector<CSnapshotChunkWriter> vWriters;
+        for (uint64_t nChunk = 0; nChunk < header.nChunks && fOk; nChunk++) {
+            boost::this_thread::interruption_point();
+            uint32_t nChunkCoins, nSize;
+            filein >> nChunkCoins >> nSize;
+            if (nSize == 0 || nSize > UTXO_SNAPSHOT_MAX_CHUNK_SIZE || nChunkCoins > nSize)
+                throw std::ios_base::failure("invalid chunk size");
+            std::vector<char> payload(nSize);
+            filein.read(&payload[0], nSize);
+            uint256 hashChunk;
+            filein >> hashChunk;
+            hashChunks << hashChunk;
+
+            SnapshotCoins coins;
+            coins.reserve(nChunkCoins);
+            CDataStream ssPayload(payload, SER_DISK, CLIENT_VERSION);
+            DeserializeChunk(ssPayload, coins);
+            if (coins.size() != nChunkCoins)
+                throw std::ios_base::failure("chunk coin count mismatch");
+            for (SnapshotCoins::const_iterator it = coins.begin(); it != coins.end(); it++)
+                hasher.Add(it->first, it->second);
+            nCoins += coins.size();
+
+            vWriters.push_back(CSnapshotChunkWriter(view, payload, hashChunk, coins));
+            queue.Add(vWriters);
+            vWriters.clear();
+            if ((nChunk + 1) % (2 * UTXO_SNAPSHOT_LOAD_THREADS) == 0)
+                fOk = queue.Wait();
+        }
+        if (fOk) {
+            fOk = queue.Wait();
+            if (!fOk)
+                strError = "a chunk is corrupt or could not be written";
+        } else {
+            strError = "a chunk is corrupt or could not be written";
+        }
+    } catch (const boost::thread_interrupted&) {
+        queue.Wait();
+        workers.interrupt_all();
+        workers.join_all();
+        view->AbortSnapshotLoading();
+        throw;
+    } catch (const std::exception& e) {
+        strError = strprintf("unable to read %s: %s", path.string(), e.what());
+        fOk = false;
+    }
+    // Let the workers finish what is queued before stopping them
+    queue.Wait();
+    workers.interrupt_all();
+    workers.join_all();
+
+    if (fOk) {
+        hasher.Finalize();
+        if (nCoins != header.nCoins) {
+            strError = strprintf("the snapshot holds %u coins instead of %u", nCoins, header.nCoins);
+            fOk = false;
+        } else if (hashChunks.GetHash() != header.hashChunks) {
+            strError = "the chunk hashes do not match the header";
+            fOk = false;
+        } else if (stats.hashSerialized != header.hashSerialized) {
+            strError = strprintf("the coins hash to %s instead of %s", stats.hashSerialized.ToString(), header.hashSerialized.ToString());
+            fOk = false;
+        }
+    }
+    if (!fOk) {
+        LogPrintf("%s: %s, erasing the coins loaded\n", __func__, strError);
+        if (!view->AbortSnapshotLoading())
+            LogPrintf("%s: unable to erase the coins loaded\n", __func__);
+        return false;
+    }
+    if (!view->FinishSnapshotLoading(header.hashBlock)) {
+        strError = "unable to write to the chainstate";
+        return false;
+    }
+    LogPrintf("Loaded %u coins in %dms\n", nCoins, GetTIMECoinMillis() - nStart);
+    return true;
+}
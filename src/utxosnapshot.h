@@ -0,0 +1,119 @@
+// Copyright (c) 2017 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTXOSNAPSHOT_H
+#define BITCOIN_UTXOSNAPSHOT_H
+
+#include "serialize.h"
+#include "uint256.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+
+#include <boost/filesystem/path.hpp>
+
+class CCoinsViewDB;
+struct CCoinsStats;
+
+/** Coins per chunk of a UTXO snapshot file */
+static const unsigned int UTXO_SNAPSHOT_CHUNK_COINS = 50000;
+/** Largest chunk payload a snapshot file may declare */
+static const unsigned int UTXO_SNAPSHOT_MAX_CHUNK_SIZE = 64 << 20;
+/** Threads writing the chunks of a snapshot being loaded, including the reading thread */
+static const int UTXO_SNAPSHOT_LOAD_THREADS = 4;
+
+/**
+ * Header of a UTXO snapshot file, as written by dumptxoutset.
+ *
+ * The header is followed by nChunks chunks, each made of its coin count, the
+ * size of its payload, the payload and the double SHA256 of the payload. A
+ * payload lists the coins grouped by transaction: the txid, the number of
+ * coins and then each coin's output index and the coin itself, in the order
+ * of the chainstate database.
+ *
+ * All fields have a fixed size, so the header can be rewritten in place once
+ * the chunks are written.
+ */
+class CUTXOSnapshotHeader
+{
+public:
+    static const uint32_t MAGIC = 0x6f787475; // "utxo"
+    static const uint32_t CURRENT_VERSION = 1;
+
+    uint32_t nMagic;
+    uint32_t nVersion;
+    //! Network the snapshot was taken on
+    unsigned char pchMessageStart[4];
+    //! The block the coins are the outputs unspent at
+    uint256 hashBlock;
+    int32_t nHeight;
+    //! Transactions in the block, and in the chain up to and including it
+    uint32_t nTx;
+    uint32_t nChainTx;
+    uint64_t nCoins;
+    uint64_t nChunks;
+    //! Double SHA256 over the hashes of all chunks
+    uint256 hashChunks;
+    //! hash_serialized_2 of gettxoutsetinfo at hashBlock
+    uint256 hashSerialized;
+
+    CUTXOSnapshotHeader()
+    {
+        SetNull();
+    }
+
+    void SetNull()
+    {
+        nMagic = MAGIC;
+        nVersion = CURRENT_VERSION;
+        memset(pchMessageStart, 0, sizeof(pchMessageStart));
+        hashBlock.SetNull();
+        nHeight = 0;
+        nTx = 0;
+        nChainTx = 0;
+        nCoins = 0;
+        nChunks = 0;
+        hashChunks.SetNull();
+        hashSerialized.SetNull();
+    }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersionIn) {
+        READWRITE(nMagic);
+        READWRITE(nVersion);
+        READWRITE(FLATDATA(pchMessageStart));
+        READWRITE(hashBlock);
+        READWRITE(nHeight);
+        READWRITE(nTx);
+        READWRITE(nChainTx);
+        READWRITE(nCoins);
+        READWRITE(nChunks);
+        READWRITE(hashChunks);
+        READWRITE(hashSerialized);
+    }
+};
+
+/**
+ * Write the chainstate to a snapshot file. The chainstate is flushed first
+ * and then read from a consistent view, so validation carries on meanwhile.
+ */
+bool DumpUTXOSnapshot(CCoinsViewDB* view, const boost::filesystem::path& path, CUTXOSnapshotHeader& header, CCoinsStats& stats, std::string& strError);
+
+/** Read and check the header of a snapshot file */
+bool ReadUTXOSnapshotHeader(const boost::filesystem::path& path, CUTXOSnapshotHeader& header, std::string& strError);
+
+/**
+ * Load a snapshot file into an empty chainstate database. Chunks are checked
+ * against their hashes and written by several threads while the file is
+ * read. Unless the coins hash to header.hashSerialized, and to hashExpected
+ * when that is set, everything written is erased again. On success the
+ * database's best block is the snapshot's block.
+ */
+bool LoadUTXOSnapshot(CCoinsViewDB* view, const boost::filesystem::path& path, const uint256& hashExpected, CUTXOSnapshotHeader& header, CCoinsStats& stats, std::string& strError);
+
+#endif // BITCOIN_UTXOSNAPSHOT_H
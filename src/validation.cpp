@@ -15,6 +15,7 @@
 #include "consensus/merkle.h"
 #include "consensus/validation.h"
 #include "hash.h"
+#include "indexwriter.h"
 #include "init.h"
 #include "policy/policy.h"
 #include "pow.h"
@@ -73,6 +74,8 @@ bool fTxIndex = true;
 bool fAddressIndex = false;
 bool fTIMECoinstampIndex = false;
 bool fSpentIndex = false;
+bool fAddressBalanceIndex = false;
+bool fCoinStatsIndex = false;
 bool fHavePruned = false;
 bool fPruneMode = false;
 bool fIsBareMultisigStd = DEFAULT_PERMIT_BAREMULTISIG;
@@ -87,6 +90,7 @@ bool fEnableReplacement = DEFAULT_ENABLE_REPLACEMENT;
 
 std::atomic<bool> fDIP0001WasLockedIn{false};
 std::atomic<bool> fDIP0001ActiveAtTip{false};
+std::atomic<bool> fLoadingUTXOSnapshot{false};
 
 uint256 hashAssumeValid;
 
@@ -591,7 +595,8 @@ bool AcceptToMemoryPoolWorker(CTxMemPool& pool, CValidationState &state, const C
         return state.Invalid(false, REJECT_ALREADY_KNOWN, "txn-already-in-mempool");
 
     // If this is a Transaction Lock Request check to see if it's valid
-    if(instantsend.HasTxLockRequest(hash) && !CTxLockRequest(tx).IsValid())
+    CTxLockRequest txLockRequest;
+    if(instantsend.GetTxLockRequest(hash, txLockRequest) && !txLockRequest.IsValid())
         return state.DoS(10, error("AcceptToMemoryPool : CTxLockRequest %s is invalid", hash.ToString()),
                             REJECT_INVALID, "bad-txlockrequest");
 
@@ -1037,7 +1042,10 @@ bool GetTIMECoinstampIndex(const unsigned int &high, const unsigned int &low, st
     if (!fTIMECoinstampIndex)
         return error("TIMECoinstamp index not enabled");
 
-    if (!pblocktree->ReadTIMECoinstampIndex(high, low, hashes))
+    if (!IsExplorerIndexSynced(INDEX_TIMESTAMP))
+        return error("TIMECoinstamp index is still being built");
+
+    if (!indexWriter.Sync() || !explorerIndexes[INDEX_TIMESTAMP].pdb->ReadTIMECoinstampIndex(high, low, hashes))
         return error("Unable to get hashes for timestamps");
 
     return true;
@@ -1051,7 +1059,10 @@ bool GetSpentIndex(CSpentIndexKey &key, CSpentIndexValue &value)
     if (mempool.getSpentIndex(key, value))
         return true;
 
-    if (!pblocktree->ReadSpentIndex(key, value))
+    if (!IsExplorerIndexSynced(INDEX_SPENT))
+        return false;
+
+    if (!indexWriter.Sync() || !explorerIndexes[INDEX_SPENT].pdb->ReadSpentIndex(key, value))
         return false;
 
     return true;
@@ -1063,7 +1074,10 @@ bool GetAddressIndex(uint160 addressHash, int type,
     if (!fAddressIndex)
         return error("address index not enabled");
 
-    if (!pblocktree->ReadAddressIndex(addressHash, type, addressIndex, start, end))
+    if (!IsExplorerIndexSynced(INDEX_ADDRESS))
+        return error("address index is still being built");
+
+    if (!indexWriter.Sync() || !explorerIndexes[INDEX_ADDRESS].pdb->ReadAddressIndex(addressHash, type, addressIndex, start, end))
         return error("unable to get txids for address");
 
     return true;
@@ -1075,7 +1089,51 @@ bool GetAddressUnspent(uint160 addressHash, int type,
     if (!fAddressIndex)
         return error("address index not enabled");
 
-    if (!pblocktree->ReadAddressUnspentIndex(addressHash, type, unspentOutputs))
+    if (!IsExplorerIndexSynced(INDEX_ADDRESS))
+        return error("address index is still being built");
+
+    if (!indexWriter.Sync() || !explorerIndexes[INDEX_ADDRESS].pdb->ReadAddressUnspentIndex(addressHash, type, unspentOutputs))
+        return error("unable to get txids for address");
+
+    return true;
+}
+
+bool GetAddressBalance(uint160 addressHash, int type, CAddressBalanceValue &value)
+{
+    if (!IsExplorerIndexSynced(INDEX_BALANCE))
+        return false;
+
+    if (!indexWriter.Sync() || !explorerIndexes[INDEX_BALANCE].pdb->ReadAddressBalance(addressHash, type, value))
+        return error("unable to get balance for address");
+
+    return true;
+}
+
+bool ForEachAddressIndex(uint160 addressHash, int type, int start, int end, const CAddressIndexKey* pafter,
+                         boost::function<bool(const CAddressIndexKey&, CAmount)> fn)
+{
+    if (!fAddressIndex)
+        return error("address index not enabled");
+
+    if (!IsExplorerIndexSynced(INDEX_ADDRESS))
+        return error("address index is still being built");
+
+    if (!indexWriter.Sync() || !explorerIndexes[INDEX_ADDRESS].pdb->ForEachAddressIndex(addressHash, type, start, end, pafter, fn))
+        return error("unable to get txids for address");
+
+    return true;
+}
+
+bool ForEachAddressUnspent(uint160 addressHash, int type, const CAddressUnspentKey* pafter,
+                           boost::function<bool(const CAddressUnspentKey&, const CAddressUnspentValue&)> fn)
+{
+    if (!fAddressIndex)
+        return error("address index not enabled");
+
+    if (!IsExplorerIndexSynced(INDEX_ADDRESS))
+        return error("address index is still being built");
+
+    if (!indexWriter.Sync() || !explorerIndexes[INDEX_ADDRESS].pdb->ForEachAddressUnspent(addressHash, type, pafter, fn))
         return error("unable to get txids for address");
 
     return true;
@@ -1592,6 +1650,8 @@ bool UndoWriteToDisk(const CBlockUndo& blockundo, CDiskBlockPos& pos, const uint
     return true;
 }
 
+} // anon namespace
+
 bool UndoReadFromDisk(CBlockUndo& blockundo, const CDiskBlockPos& pos, const uint256& hashBlock)
 {
     // Open history file to read
@@ -1618,6 +1678,8 @@ bool UndoReadFromDisk(CBlockUndo& blockundo, const CDiskBlockPos& pos, const uin
     return true;
 }
 
+namespace {
+
 /** Abort with a message */
 bool AbortNode(const std::string& strMessage, const std::string& userMessage="")
 {
@@ -1676,8 +1738,9 @@ int ApplyTxInUndo(Coin&& undo, CCoinsViewCache& view, const COutPoint& out)
 }
 
 /** Undo the effects of this block (with given index) on the UTXO set represented by coins.
- *  When UNCLEAN or FAILED is returned, view is left in an indeterminate state. */
-static DisconnectResult DisconnectBlock(const CBlock& block, CValidationState& state, const CBlockIndex* pindex, CCoinsViewCache& view)
+ *  When UNCLEAN or FAILED is returned, view is left in an indeterminate state.
+ *  With fJustCheck the on-disk explorer indexes are left untouched. */
+static DisconnectResult DisconnectBlock(const CBlock& block, CValidationState& state, const CBlockIndex* pindex, CCoinsViewCache& view, bool fJustCheck = false)
 {
     assert(pindex->GetBlockHash() == view.GetBestBlock());
 
@@ -1699,9 +1762,13 @@ static DisconnectResult DisconnectBlock(const CBlock& block, CValidationState& s
         return DISCONNECT_FAILED;
     }
 
-    std::vector<std::pair<CAddressIndexKey, CAmount> > addressIndex;
-    std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > addressUnspentIndex;
-    std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> > spentIndex;
+    // The explorer index changes are taken from the undo data before it is moved into the view
+    CIndexBlockUpdate indexUpdate;
+    const unsigned int nIndexes = fJustCheck ? 0 : GetSyncedExplorerIndexes(pindex);
+    if (nIndexes && !BuildIndexBlockUpdate(block, blockUndo, pindex, true, nIndexes, indexUpdate)) {
+        error("DisconnectBlock(): failed to build explorer index changes");
+        return DISCONNECT_FAILED;
+    }
 
     // undo transactions in reverse order
     for (int i = block.vtx.size() - 1; i >= 0; i--) {
@@ -1709,37 +1776,6 @@ static DisconnectResult DisconnectBlock(const CBlock& block, CValidationState& s
         uint256 hash = tx.GetHash();
         bool is_coinbase = tx.IsCoinBase();
 
-        if (fAddressIndex) {
-
-            for (unsigned int k = tx.vout.size(); k-- > 0;) {
-                const CTxOut &out = tx.vout[k];
-
-                if (out.scriptPubKey.IsPayToScriptHash()) {
-                    vector<unsigned char> hashBytes(out.scriptPubKey.begin()+2, out.scriptPubKey.begin()+22);
-
-                    // undo receiving activity
-                    addressIndex.push_back(make_pair(CAddressIndexKey(2, uint160(hashBytes), pindex->nHeight, i, hash, k, false), out.nValue));
-
-                    // undo unspent index
-                    addressUnspentIndex.push_back(make_pair(CAddressUnspentKey(2, uint160(hashBytes), hash, k), CAddressUnspentValue()));
-
-                } else if (out.scriptPubKey.IsPayToPublicKeyHash()) {
-                    vector<unsigned char> hashBytes(out.scriptPubKey.begin()+3, out.scriptPubKey.begin()+23);
-
-                    // undo receiving activity
-                    addressIndex.push_back(make_pair(CAddressIndexKey(1, uint160(hashBytes), pindex->nHeight, i, hash, k, false), out.nValue));
-
-                    // undo unspent index
-                    addressUnspentIndex.push_back(make_pair(CAddressUnspentKey(1, uint160(hashBytes), hash, k), CAddressUnspentValue()));
-
-                } else {
-                    continue;
-                }
-
-            }
-
-        }
-
         // Check that all outputs are available and match the outputs in the block itself
         // exactly.
         for (size_t o = 0; o < tx.vout.size(); o++) {
@@ -1762,45 +1798,9 @@ static DisconnectResult DisconnectBlock(const CBlock& block, CValidationState& s
             }
             for (unsigned int j = tx.vin.size(); j-- > 0;) {
                 const COutPoint &out = tx.vin[j].prevout;
-                int undoHeight = txundo.vprevout[j].nHeight;
                 int res = ApplyTxInUndo(std::move(txundo.vprevout[j]), view, out);
                 if (res == DISCONNECT_FAILED) return DISCONNECT_FAILED;
                 fClean = fClean && res != DISCONNECT_UNCLEAN;
-
-                const CTxIn input = tx.vin[j];
-
-                if (fSpentIndex) {
-                    // undo and delete the spent index
-                    spentIndex.push_back(make_pair(CSpentIndexKey(input.prevout.hash, input.prevout.n), CSpentIndexValue()));
-                }
-
-                if (fAddressIndex) {
-                    const Coin &coin = view.AccessCoin(tx.vin[j].prevout);
-                    const CTxOut &prevout = coin.out;
-                    if (prevout.scriptPubKey.IsPayToScriptHash()) {
-                        vector<unsigned char> hashBytes(prevout.scriptPubKey.begin()+2, prevout.scriptPubKey.begin()+22);
-
-                        // undo spending activity
-                        addressIndex.push_back(make_pair(CAddressIndexKey(2, uint160(hashBytes), pindex->nHeight, i, hash, j, true), prevout.nValue * -1));
-
-                        // restore unspent index
-                        addressUnspentIndex.push_back(make_pair(CAddressUnspentKey(2, uint160(hashBytes), input.prevout.hash, input.prevout.n), CAddressUnspentValue(prevout.nValue, prevout.scriptPubKey, undoHeight)));
-
-
-                    } else if (prevout.scriptPubKey.IsPayToPublicKeyHash()) {
-                        vector<unsigned char> hashBytes(prevout.scriptPubKey.begin()+3, prevout.scriptPubKey.begin()+23);
-
-                        // undo spending activity
-                        addressIndex.push_back(make_pair(CAddressIndexKey(1, uint160(hashBytes), pindex->nHeight, i, hash, j, true), prevout.nValue * -1));
-
-                        // restore unspent index
-                        addressUnspentIndex.push_back(make_pair(CAddressUnspentKey(1, uint160(hashBytes), input.prevout.hash, input.prevout.n), CAddressUnspentValue(prevout.nValue, prevout.scriptPubKey, undoHeight)));
-
-                    } else {
-                        continue;
-                    }
-                }
-
             }
             // At this point, all of txundo.vprevout should have been moved out.
         }
@@ -1810,15 +1810,9 @@ static DisconnectResult DisconnectBlock(const CBlock& block, CValidationState& s
     // move best block pointer to prevout block
     view.SetBestBlock(pindex->pprev->GetBlockHash());
 
-    if (fAddressIndex) {
-        if (!pblocktree->EraseAddressIndex(addressIndex)) {
-            AbortNode(state, "Failed to delete address index");
-            return DISCONNECT_FAILED;
-        }
-        if (!pblocktree->UpdateAddressUnspentIndex(addressUnspentIndex)) {
-            AbortNode(state, "Failed to write address unspent index");
-            return DISCONNECT_FAILED;
-        }
+    if (nIndexes && !PushExplorerIndexUpdate(indexUpdate, pindex->pprev)) {
+        AbortNode(state, "Failed to write explorer indexes");
+        return DISCONNECT_FAILED;
     }
 
     return fClean ? DISCONNECT_OK : DISCONNECT_UNCLEAN;
@@ -1958,8 +1952,15 @@ static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockInd
     // Special case for the genesis block, skipping connection of its transactions
     // (its coinbase is unspendable)
     if (block.GetHash() == chainparams.GetConsensus().hashGenesisBlock) {
-        if (!fJustCheck)
+        if (!fJustCheck) {
             view.SetBestBlock(pindex->GetBlockHash());
+            // Empty explorer indexes start from here
+            const unsigned int nIndexes = GetSyncedExplorerIndexes(NULL);
+            CIndexBlockUpdate indexUpdate;
+            if (nIndexes && (!BuildIndexBlockUpdate(block, CBlockUndo(), pindex, false, nIndexes, indexUpdate) ||
+                             !PushExplorerIndexUpdate(indexUpdate, pindex)))
+                return AbortNode(state, "Failed to write explorer indexes");
+        }
         return true;
     }
 
@@ -2069,16 +2070,12 @@ static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockInd
     std::vector<std::pair<uint256, CDiskTxPos> > vPos;
     vPos.reserve(block.vtx.size());
     blockundo.vtxundo.reserve(block.vtx.size() - 1);
-    std::vector<std::pair<CAddressIndexKey, CAmount> > addressIndex;
-    std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > addressUnspentIndex;
-    std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> > spentIndex;
 
     bool fDIP0001Active_context = (VersionBitsState(pindex->pprev, chainparams.GetConsensus(), Consensus::DEPLOYMENT_DIP0001, versionbitscache) == THRESHOLD_ACTIVE);
 
     for (unsigned int i = 0; i < block.vtx.size(); i++)
     {
         const CTransaction &tx = block.vtx[i];
-        const uint256 txhash = tx.GetHash();
 
         nInputs += tx.vin.size();
         nSigOps += GetLegacySigOpCount(tx);
@@ -2105,43 +2102,6 @@ static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockInd
                                  REJECT_INVALID, "bad-txns-nonfinal");
             }
 
-            if (fAddressIndex || fSpentIndex)
-            {
-                for (size_t j = 0; j < tx.vin.size(); j++) {
-                    const CTxIn input = tx.vin[j];
-                    const Coin& coin = view.AccessCoin(tx.vin[j].prevout);
-                    const CTxOut &prevout = coin.out;
-                    uint160 hashBytes;
-                    int addressType;
-
-                    if (prevout.scriptPubKey.IsPayToScriptHash()) {
-                        hashBytes = uint160(vector <unsigned char>(prevout.scriptPubKey.begin()+2, prevout.scriptPubKey.begin()+22));
-                        addressType = 2;
-                    } else if (prevout.scriptPubKey.IsPayToPublicKeyHash()) {
-                        hashBytes = uint160(vector <unsigned char>(prevout.scriptPubKey.begin()+3, prevout.scriptPubKey.begin()+23));
-                        addressType = 1;
-                    } else {
-                        hashBytes.SetNull();
-                        addressType = 0;
-                    }
-
-                    if (fAddressIndex && addressType > 0) {
-                        // record spending activity
-                        addressIndex.push_back(make_pair(CAddressIndexKey(addressType, hashBytes, pindex->nHeight, i, txhash, j, true), prevout.nValue * -1));
-
-                        // remove address from unspent index
-                        addressUnspentIndex.push_back(make_pair(CAddressUnspentKey(addressType, hashBytes, input.prevout.hash, input.prevout.n), CAddressUnspentValue()));
-                    }
-
-                    if (fSpentIndex) {
-                        // add the spent index to determine the txid and input that spent an output
-                        // and to find the amount and address from an input
-                        spentIndex.push_back(make_pair(CSpentIndexKey(input.prevout.hash, input.prevout.n), CSpentIndexValue(txhash, j, pindex->nHeight, prevout.nValue, addressType, hashBytes)));
-                    }
-                }
-
-            }
-
             if (fStrictPayToScriptHash)
             {
                 // Add in sigops done by pay-to-script-hash inputs;
@@ -2163,35 +2123,6 @@ static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockInd
             control.Add(vChecks);
         }
 
-        if (fAddressIndex) {
-            for (unsigned int k = 0; k < tx.vout.size(); k++) {
-                const CTxOut &out = tx.vout[k];
-
-                if (out.scriptPubKey.IsPayToScriptHash()) {
-                    vector<unsigned char> hashBytes(out.scriptPubKey.begin()+2, out.scriptPubKey.begin()+22);
-
-                    // record receiving activity
-                    addressIndex.push_back(make_pair(CAddressIndexKey(2, uint160(hashBytes), pindex->nHeight, i, txhash, k, false), out.nValue));
-
-                    // record unspent output
-                    addressUnspentIndex.push_back(make_pair(CAddressUnspentKey(2, uint160(hashBytes), txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
-
-                } else if (out.scriptPubKey.IsPayToPublicKeyHash()) {
-                    vector<unsigned char> hashBytes(out.scriptPubKey.begin()+3, out.scriptPubKey.begin()+23);
-
-                    // record receiving activity
-                    addressIndex.push_back(make_pair(CAddressIndexKey(1, uint160(hashBytes), pindex->nHeight, i, txhash, k, false), out.nValue));
-
-                    // record unspent output
-                    addressUnspentIndex.push_back(make_pair(CAddressUnspentKey(1, uint160(hashBytes), txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
-
-                } else {
-                    continue;
-                }
-
-            }
-        }
-
         CTxUndo undoDummy;
         if (i > 0) {
             blockundo.vtxundo.push_back(CTxUndo());
@@ -2256,24 +2187,17 @@ static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockInd
         if (!pblocktree->WriteTxIndex(vPos))
             return AbortNode(state, "Failed to write transaction index");
 
-    if (fAddressIndex) {
-        if (!pblocktree->WriteAddressIndex(addressIndex)) {
-            return AbortNode(state, "Failed to write address index");
-        }
-
-        if (!pblocktree->UpdateAddressUnspentIndex(addressUnspentIndex)) {
-            return AbortNode(state, "Failed to write address unspent index");
-        }
+    // The explorer indexes are written by the index writer thread; indexes
+    // still being built are caught up by the index builder instead
+    const unsigned int nIndexes = GetSyncedExplorerIndexes(pindex->pprev);
+    if (nIndexes) {
+        CIndexBlockUpdate indexUpdate;
+        if (!BuildIndexBlockUpdate(block, blockundo, pindex, false, nIndexes, indexUpdate))
+            return error("ConnectBlock(): failed to build explorer index changes");
+        if (!PushExplorerIndexUpdate(indexUpdate, pindex))
+            return AbortNode(state, "Failed to write explorer indexes");
     }
 
-    if (fSpentIndex)
-        if (!pblocktree->UpdateSpentIndex(spentIndex))
-            return AbortNode(state, "Failed to write transaction index");
-
-    if (fTIMECoinstampIndex)
-        if (!pblocktree->WriteTIMECoinstampIndex(CTIMECoinstampIndexKey(pindex->nTIMECoin, pindex->GetBlockHash())))
-            return AbortNode(state, "Failed to write timestamp index");
-
     // add this block to the view's block chain
     view.SetBestBlock(pindex->GetBlockHash());
 
@@ -2330,16 +2254,19 @@ bool static FlushStateToDisk(CValidationState &state, FlushStateMode mode) {
         nLastSetChain = nNow;
     }
     int64_t nMempoolSizeMax = GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000;
-    int64_t cacheSize = pcoinsTip->DynamicMemoryUsage() * DB_PEAK_USAGE_FACTOR;
+    // Coins handed to a background flush stay in memory until they are written.
+    int64_t cacheSize = (pcoinsTip->DynamicMemoryUsage() + pcoinsdbview->FlushingMemoryUsage()) * DB_PEAK_USAGE_FACTOR;
     int64_t nTotalSpace = nCoinCacheUsage + std::max<int64_t>(nMempoolSizeMax - nMempoolUsage, 0);
+    // Flushing again before a background flush is done would wait for it, which is only worth it when we have to.
+    bool fFlushing = pcoinsdbview->IsFlushing();
     // The cache is large and we're within 10% and 10 MiB of the limit, but we have time now (not in the middle of a block processing).
-    bool fCacheLarge = mode == FLUSH_STATE_PERIODIC && cacheSize > std::max((9 * nTotalSpace) / 10, nTotalSpace - MAX_BLOCK_COINSDB_USAGE * 1024 * 1024);
+    bool fCacheLarge = mode == FLUSH_STATE_PERIODIC && !fFlushing && cacheSize > std::max((9 * nTotalSpace) / 10, nTotalSpace - MAX_BLOCK_COINSDB_USAGE * 1024 * 1024);
     // The cache is over the limit, we have to write now.
     bool fCacheCritical = mode == FLUSH_STATE_IF_NEEDED && cacheSize > nCoinCacheUsage;
     // It's been a while since we wrote the block index to disk. Do this frequently, so we don't need to redownload after a crash.
     bool fPeriodicWrite = mode == FLUSH_STATE_PERIODIC && nNow > nLastWrite + (int64_t)DATABASE_WRITE_INTERVAL * 1000000;
     // It's been very long since we flushed the cache. Do this infrequently, to optimize cache usage.
-    bool fPeriodicFlush = mode == FLUSH_STATE_PERIODIC && nNow > nLastFlush + (int64_t)DATABASE_FLUSH_INTERVAL * 1000000;
+    bool fPeriodicFlush = mode == FLUSH_STATE_PERIODIC && !fFlushing && nNow > nLastFlush + (int64_t)DATABASE_FLUSH_INTERVAL * 1000000;
     // Combine all conditions that result in a full cache flush.
     bool fDoFullFlush = (mode == FLUSH_STATE_ALWAYS) || fCacheLarge || fCacheCritical || fPeriodicFlush || fFlushForPrune;
     // Write blocks and block index to disk.
@@ -2373,7 +2300,8 @@ bool static FlushStateToDisk(CValidationState &state, FlushStateMode mode) {
         nLastWrite = nNow;
     }
     // Flush best chain related state. This can only be done if the blocks / block index write was also done.
-    if (fDoFullFlush) {
+    // A UTXO snapshot being loaded owns the chainstate database until it is activated.
+    if (fDoFullFlush && !fLoadingUTXOSnapshot) {
         // Typical Coin structures on disk are around 48 bytes in size.
         // Pushing a new one to the database can cause it to be written
         // twice (once in the log, and once in the tables). This is already
@@ -2381,9 +2309,17 @@ bool static FlushStateToDisk(CValidationState &state, FlushStateMode mode) {
         // overwrite one. Still, use a conservative safety factor of 2.
         if (!CheckDiskSpace(48 * 2 * 2 * pcoinsTip->GetCacheSize()))
             return state.Error("out of disk space");
+        // The explorer indexes must not fall behind the chainstate on disk:
+        // after a crash, blocks are only reconnected from the chainstate's best block.
+        if (!indexWriter.Sync())
+            return AbortNode(state, "Failed to write explorer indexes");
         // Flush the chainstate (which may refer to block index entries).
+        // With -backgroundflush this only hands the dirty coins to the
+        // flush thread; wait for them when shutting down or pruning.
         if (!pcoinsTip->Flush())
             return AbortNode(state, "Failed to write to coin database");
+        if ((mode == FLUSH_STATE_ALWAYS || fFlushForPrune) && !pcoinsdbview->WaitForFlush())
+            return AbortNode(state, "Failed to write to coin database");
         nLastFlush = nNow;
     }
     if (fDoFullFlush || ((mode == FLUSH_STATE_ALWAYS || mode == FLUSH_STATE_PERIODIC) && nNow > nLastSetChain + (int64_t)DATABASE_WRITE_INTERVAL * 1000000)) {
@@ -2490,7 +2426,7 @@ bool static DisconnectTip(CValidationState& state, const Consensus::Params& cons
     std::vector<uint256> vHashUpdate;
     BOOST_FOREACH(const CTransaction &tx, block.vtx) {
         // ignore validation errors in resurrected transactions
-        list<CTransaction> removed;
+        list<CTransactionRef> removed;
         CValidationState stateDummy;
         if (tx.IsCoinBase() || !AcceptToMemoryPool(mempool, stateDummy, tx, false, NULL, true)) {
             mempool.remove(tx, removed, true);
@@ -2506,6 +2442,7 @@ bool static DisconnectTip(CValidationState& state, const Consensus::Params& cons
     mempool.UpdateTransactionsFromBlock(vHashUpdate);
     // Update chainActive and related variables.
     UpdateTip(pindexDelete->pprev);
+    mnLastPaidIndex.BlockDisconnected(block, pindexDelete);
     // Let wallets know transactions went from 1-confirmed to
     // 0-confirmed or conflicted:
     BOOST_FOREACH(const CTransaction &tx, block.vtx) {
@@ -2560,14 +2497,16 @@ bool static ConnectTip(CValidationState& state, const CChainParams& chainparams,
     int64_t nTIMECoin5 = GetTIMECoinMicros(); nTIMECoinChainState += nTIMECoin5 - nTIMECoin4;
     LogPrint("bench", "  - Writing chainstate: %.2fms [%.2fs]\n", (nTIMECoin5 - nTIMECoin4) * 0.001, nTIMECoinChainState * 0.000001);
     // Remove conflicting transactions from the mempool.
-    list<CTransaction> txConflicted;
+    list<CTransactionRef> txConflicted;
     mempool.removeForBlock(pblock->vtx, pindexNew->nHeight, txConflicted, !IsInitialBlockDownload());
     // Update chainActive & related variables.
     UpdateTip(pindexNew);
+    mnLastPaidIndex.BlockConnected(*pblock, pindexNew);
+    mnodeman.BlockConnected(*pblock);
     // Tell wallet about transactions that went from mempool
     // to conflicted:
-    BOOST_FOREACH(const CTransaction &tx, txConflicted) {
-        GetMainSignals().SyncTransaction(tx, NULL);
+    BOOST_FOREACH(const CTransactionRef &tx, txConflicted) {
+        GetMainSignals().SyncTransaction(*tx, NULL);
     }
     // ... and about transactions that got confirmed:
     BOOST_FOREACH(const CTransaction &tx, pblock->vtx) {
@@ -2809,6 +2748,9 @@ bool ActivateBestChain(CValidationState &state, const CChainParams& chainparams,
         bool fInitialDownload;
         {
             LOCK(cs_main);
+            // Blocks are connected once the snapshot being loaded is activated
+            if (fLoadingUTXOSnapshot)
+                return true;
             CBlockIndex *pindexOldTip = chainActive.Tip();
             if (pindexMostWork == NULL) {
                 pindexMostWork = FindMostWorkChain();
@@ -2925,6 +2867,13 @@ bool ReconsiderBlock(CValidationState& state, CBlockIndex *pindex) {
     return true;
 }
 
+/** Clear mapBlockIndex and free its entries */
+static void FreeBlockIndex()
+{
+    mapBlockIndex.clear();
+    CBlockIndexArena::Clear();
+}
+
 CBlockIndex* AddToBlockIndex(const CBlockHeader& block)
 {
     // Check for duplicate
@@ -2934,8 +2883,8 @@ CBlockIndex* AddToBlockIndex(const CBlockHeader& block)
         return it->second;
 
     // Construct new block index object
-    CBlockIndex* pindexNew = new CBlockIndex(block);
-    assert(pindexNew);
+    CBlockIndex* pindexNew = CBlockIndexArena::Allocate();
+    *pindexNew = CBlockIndex(block);
     // We assign the sequence id to blocks only when the full data is available,
     // to avoid miners withholding blocks but broadcasting headers, to get a
     // competitive advantage.
@@ -3689,35 +3638,75 @@ CBlockIndex * InsertBlockIndex(uint256 hash)
         return (*mi).second;
 
     // Create new
-    CBlockIndex* pindexNew = new CBlockIndex();
-    if (!pindexNew)
-        throw runtime_error("InsertBlockIndex(): new CBlockIndex failed");
+    CBlockIndex* pindexNew = CBlockIndexArena::Allocate();
     mi = mapBlockIndex.insert(make_pair(hash, pindexNew)).first;
     pindexNew->phashBlock = &((*mi).first);
 
     return pindexNew;
 }
 
+
 bool static LoadBlockIndexDB()
 {
     const CChainParams& chainparams = Params();
-    if (!pblocktree->LoadBlockIndexGuts(InsertBlockIndex))
+    int64_t nStart = GetTIMECoinMillis();
+    std::vector<CDiskBlockIndex> vEntries;
+    if (!pblocktree->LoadBlockIndexGuts(vEntries, std::min(GetNumCores(), MAX_BLOCK_INDEX_LOAD_THREADS)))
         return false;
 
     boost::this_thread::interruption_point();
-
-    // Calculate nChainWork
-    vector<pair<int, CBlockIndex*> > vSortedByHeight;
-    vSortedByHeight.reserve(mapBlockIndex.size());
+    int64_t nLoaded = GetTIMECoinMillis();
+
+    // Link the entries: every one goes into the map first, so the parents
+    // are found whatever order they were read in. They are allocated in
+    // height order, so walking back from a block stays close in memory.
+    int nMaxEntryHeight = -1;
+    for (size_t i = 0; i < vEntries.size(); i++)
+        nMaxEntryHeight = std::max(nMaxEntryHeight, vEntries[i].nHeight);
+    vector<size_t> vEntryHeightStart(nMaxEntryHeight + 2, 0);
+    for (size_t i = 0; i < vEntries.size(); i++)
+        vEntryHeightStart[vEntries[i].nHeight + 1]++;
+    for (int nHeight = 0; nHeight <= nMaxEntryHeight; nHeight++)
+        vEntryHeightStart[nHeight + 1] += vEntryHeightStart[nHeight];
+    vector<size_t> vEntryOrder(vEntries.size());
+    for (size_t i = 0; i < vEntries.size(); i++)
+        vEntryOrder[vEntryHeightStart[vEntries[i].nHeight]++] = i;
+
+    vector<CBlockIndex*> vEntryIndex(vEntries.size());
+    mapBlockIndex.reserve(mapBlockIndex.size() + vEntries.size());
+    for (size_t n = 0; n < vEntryOrder.size(); n++) {
+        const size_t i = vEntryOrder[n];
+        CBlockIndex* pindexNew = CBlockIndexArena::Allocate();
+        *pindexNew = vEntries[i];
+        BlockMap::iterator mi = mapBlockIndex.insert(make_pair(vEntries[i].hash, pindexNew)).first;
+        pindexNew->phashBlock = &((*mi).first);
+        vEntryIndex[i] = pindexNew;
+    }
+    for (size_t i = 0; i < vEntries.size(); i++) {
+        vEntryIndex[i]->pprev = InsertBlockIndex(vEntries[i].hashPrev);
+    }
+    std::vector<CDiskBlockIndex>().swap(vEntries);
+    int64_t nLinked = GetTIMECoinMillis();
+
+    uint256 hashSnapshotBase;
+    unsigned int nSnapshotChainTx = 0;
+    pblocktree->ReadSnapshotBase(hashSnapshotBase, nSnapshotChainTx);
+
+    // Calculate nChainWork. A block only has to come after its parent, so
+    // bucketing the entries by height is as good as sorting them.
+    int nMaxHeight = -1;
     BOOST_FOREACH(const PAIRTYPE(uint256, CBlockIndex*)& item, mapBlockIndex)
+        nMaxHeight = std::max(nMaxHeight, item.second->nHeight);
+    vector<size_t> vHeightStart(nMaxHeight + 2, 0);
+    BOOST_FOREACH(const PAIRTYPE(uint256, CBlockIndex*)& item, mapBlockIndex)
+        vHeightStart[item.second->nHeight + 1]++;
+    for (int nHeight = 0; nHeight <= nMaxHeight; nHeight++)
+        vHeightStart[nHeight + 1] += vHeightStart[nHeight];
+    vector<CBlockIndex*> vSortedByHeight(mapBlockIndex.size());
+    BOOST_FOREACH(const PAIRTYPE(uint256, CBlockIndex*)& item, mapBlockIndex)
+        vSortedByHeight[vHeightStart[item.second->nHeight]++] = item.second;
+    BOOST_FOREACH(CBlockIndex* pindex, vSortedByHeight)
     {
-        CBlockIndex* pindex = item.second;
-        vSortedByHeight.push_back(make_pair(pindex->nHeight, pindex));
-    }
-    sort(vSortedByHeight.begin(), vSortedByHeight.end());
-    BOOST_FOREACH(const PAIRTYPE(int, CBlockIndex*)& item, vSortedByHeight)
-    {
-        CBlockIndex* pindex = item.second;
         pindex->nChainWork = (pindex->pprev ? pindex->pprev->nChainWork : 0) + GetBlockProof(*pindex);
         // We can link the chain of blocks for which we've received transactions at some point.
         // Pruned nodes may have deleted the block.
@@ -3725,6 +3714,9 @@ bool static LoadBlockIndexDB()
             if (pindex->pprev) {
                 if (pindex->pprev->nChainTx) {
                     pindex->nChainTx = pindex->pprev->nChainTx + pindex->nTx;
+                } else if (pindex->GetBlockHash() == hashSnapshotBase) {
+                    // The ancestors of the block a UTXO snapshot was loaded at were never downloaded
+                    pindex->nChainTx = nSnapshotChainTx;
                 } else {
                     pindex->nChainTx = 0;
                     mapBlocksUnlinked.insert(std::make_pair(pindex->pprev, pindex));
@@ -3742,6 +3734,7 @@ bool static LoadBlockIndexDB()
         if (pindex->IsValid(BLOCK_VALID_TREE) && (pindexBestHeader == NULL || CBlockIndexWorkComparator()(pindexBestHeader, pindex)))
             pindexBestHeader = pindex;
     }
+    int64_t nChainWork = GetTIMECoinMillis();
 
     // Load block file info
     pblocktree->ReadLastBlockFile(nLastBlockFile);
@@ -3777,6 +3770,8 @@ bool static LoadBlockIndexDB()
             return false;
         }
     }
+    LogPrintf("%s: loaded %u block index entries in %dms (read %dms, link %dms, chain work %dms, block files %dms)\n", __func__,
+        mapBlockIndex.size(), GetTIMECoinMillis() - nStart, nLoaded - nStart, nLinked - nLoaded, nChainWork - nLinked, GetTIMECoinMillis() - nChainWork);
 
     // Check whether we have ever pruned block & undo files
     pblocktree->ReadFlag("prunedblockfiles", fHavePruned);
@@ -3792,18 +3787,6 @@ bool static LoadBlockIndexDB()
     pblocktree->ReadFlag("txindex", fTxIndex);
     LogPrintf("%s: transaction index %s\n", __func__, fTxIndex ? "enabled" : "disabled");
 
-    // Check whether we have an address index
-    pblocktree->ReadFlag("addressindex", fAddressIndex);
-    LogPrintf("%s: address index %s\n", __func__, fAddressIndex ? "enabled" : "disabled");
-
-    // Check whether we have a timestamp index
-    pblocktree->ReadFlag("timestampindex", fTIMECoinstampIndex);
-    LogPrintf("%s: timestamp index %s\n", __func__, fTIMECoinstampIndex ? "enabled" : "disabled");
-
-    // Check whether we have a spent index
-    pblocktree->ReadFlag("spentindex", fSpentIndex);
-    LogPrintf("%s: spent index %s\n", __func__, fSpentIndex ? "enabled" : "disabled");
-
     // Load pointer to end of best chain
     BlockMap::iterator it = mapBlockIndex.find(pcoinsTip->GetBestBlock());
     if (it == mapBlockIndex.end())
@@ -3854,6 +3837,11 @@ bool CVerifyDB::VerifyDB(const CChainParams& chainparams, CCoinsView *coinsview,
         uiInterface.ShowProgress(_("Verifying blocks..."), std::max(1, std::min(99, (int)(((double)(chainActive.Height() - pindex->nHeight)) / (double)nCheckDepth * (nCheckLevel >= 4 ? 50 : 100)))));
         if (pindex->nHeight < chainActive.Height()-nCheckDepth)
             break;
+        // Pruned blocks, and the blocks below a loaded UTXO snapshot, have no data
+        if (!(pindex->nStatus & BLOCK_HAVE_DATA)) {
+            LogPrintf("VerifyDB(): block data ends at height %d, stopping\n", pindex->nHeight);
+            break;
+        }
         CBlock block;
         // check level 0: read from disk
         if (!ReadBlockFromDisk(block, pindex, chainparams.GetConsensus()))
@@ -3872,7 +3860,7 @@ bool CVerifyDB::VerifyDB(const CChainParams& chainparams, CCoinsView *coinsview,
         }
         // check level 3: check for inconsistencies during memory-only disconnect of tip blocks
         if (nCheckLevel >= 3 && pindex == pindexState && (coins.DynamicMemoryUsage() + pcoinsTip->DynamicMemoryUsage()) <= nCoinCacheUsage) {
-            DisconnectResult res = DisconnectBlock(block, state, pindex, coins);
+            DisconnectResult res = DisconnectBlock(block, state, pindex, coins, true);
             if (res == DISCONNECT_FAILED) {
                 return error("VerifyDB(): *** irrecoverable inconsistency in block data at %d, hash=%s", pindex->nHeight, pindex->GetBlockHash().ToString());
             }
@@ -3921,6 +3909,7 @@ void UnloadBlockIndex()
     pindexBestInvalid = NULL;
     pindexBestHeader = NULL;
     mempool.clear();
+    mnLastPaidIndex.Clear();
     mapBlocksUnlinked.clear();
     vinfoBlockFile.clear();
     nLastBlockFile = 0;
@@ -3932,13 +3921,80 @@ void UnloadBlockIndex()
         warningcache[b].clear();
     }
 
-    BOOST_FOREACH(BlockMap::value_type& entry, mapBlockIndex) {
-        delete entry.second;
-    }
-    mapBlockIndex.clear();
+    FreeBlockIndex();
     fHavePruned = false;
 }
 
+bool CheckUTXOSnapshotBase(const CBlockIndex* pindexBase, unsigned int nTx, unsigned int nChainTx, std::string& strError)
+{
+    AssertLockHeld(cs_main);
+    if (pindexBase->nHeight <= 0) {
+        strError = "the snapshot block is the genesis block";
+        return false;
+    }
+    // Every block holds at least its coinbase, the genesis block included
+    if (nTx == 0 || nChainTx < nTx || nChainTx - nTx < (unsigned int)pindexBase->nHeight) {
+        strError = strprintf("the snapshot's transaction counts (%u in the block, %u in the chain) are impossible at height %d", nTx, nChainTx, pindexBase->nHeight);
+        return false;
+    }
+
+    // The chain the snapshot builds on has to pass through the checkpoints below it
+    const CCheckpointData& checkpoints = Params().Checkpoints();
+    BOOST_FOREACH(const MapCheckpoints::value_type& checkpoint, checkpoints.mapCheckpoints) {
+        if (checkpoint.first > pindexBase->nHeight)
+            break;
+        if (pindexBase->GetAncestor(checkpoint.first)->GetBlockHash() != checkpoint.second) {
+            strError = strprintf("the snapshot block is not on the chain of the checkpoint at height %d", checkpoint.first);
+            return false;
+        }
+    }
+
+    // and its transaction count has to agree with that of the last checkpoint, counting one transaction per block in between
+    if (!checkpoints.mapCheckpoints.empty() && checkpoints.nTransactionsLastCheckpoint > 0) {
+        int nLastHeight = checkpoints.mapCheckpoints.rbegin()->first;
+        int64_t nLastChainTx = checkpoints.nTransactionsLastCheckpoint;
+        if ((pindexBase->nHeight >= nLastHeight && (int64_t)nChainTx < nLastChainTx + (pindexBase->nHeight - nLastHeight)) ||
+            (pindexBase->nHeight < nLastHeight && (int64_t)nChainTx + (nLastHeight - pindexBase->nHeight) > nLastChainTx)) {
+            strError = strprintf("the snapshot's %u transactions up to height %d disagree with the %d up to the checkpoint at height %d",
+                                 nChainTx, pindexBase->nHeight, nLastChainTx, nLastHeight);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ActivateUTXOSnapshot(CBlockIndex* pindexBase, unsigned int nTx, unsigned int nChainTx)
+{
+    AssertLockHeld(cs_main);
+    assert(pcoinsdbview->GetBestBlock() == pindexBase->GetBlockHash());
+    pcoinsTip->SetBestBlock(pindexBase->GetBlockHash());
+
+    // The block itself is never downloaded, but stands in for the whole chain below it
+    pindexBase->nTx = nTx;
+    pindexBase->nChainTx = nChainTx;
+    pindexBase->RaiseValidity(BLOCK_VALID_SCRIPTS);
+    {
+        LOCK(cs_nBlockSequenceId);
+        pindexBase->nSequenceId = nBlockSequenceId++;
+    }
+    setDirtyBlockIndex.insert(pindexBase);
+    if (!pblocktree->WriteSnapshotBase(pindexBase->GetBlockHash(), nChainTx))
+        return error("%s: failed to write snapshot base", __func__);
+
+    const CBlockIndex* pindexFork = chainActive.FindFork(pindexBase);
+    mempool.clear();
+    setBlockIndexCandidates.insert(pindexBase);
+    UpdateTip(pindexBase);
+    PruneBlockIndexCandidates();
+
+    CValidationState state;
+    if (!FlushStateToDisk(state, FLUSH_STATE_ALWAYS))
+        return false;
+    GetMainSignals().UpdatedBlockTip(pindexBase, pindexFork, IsInitialBlockDownload());
+    uiInterface.NotifyBlockTip(IsInitialBlockDownload(), pindexBase);
+    return true;
+}
+
 bool LoadBlockIndex()
 {
     // Load block index from databases
@@ -3959,17 +4015,6 @@ bool InitBlockIndex(const CChainParams& chainparams)
     fTxIndex = GetBoolArg("-txindex", DEFAULT_TXINDEX);
     pblocktree->WriteFlag("txindex", fTxIndex);
 
-    // Use the provided setting for -addressindex in the new database
-    fAddressIndex = GetBoolArg("-addressindex", DEFAULT_ADDRESSINDEX);
-    pblocktree->WriteFlag("addressindex", fAddressIndex);
-
-    // Use the provided setting for -timestampindex in the new database
-    fTIMECoinstampIndex = GetBoolArg("-timestampindex", DEFAULT_TIMECSTAMPINDEX);
-    pblocktree->WriteFlag("timestampindex", fTIMECoinstampIndex);
-
-    fSpentIndex = GetBoolArg("-spentindex", DEFAULT_SPENTINDEX);
-    pblocktree->WriteFlag("spentindex", fSpentIndex);
-
     LogPrintf("Initializing databases...\n");
 
     // Only add the genesis block if not reindexing (in which case we reuse the one already on disk)
@@ -3999,10 +4044,75 @@ bool InitBlockIndex(const CChainParams& chainparams)
     return true;
 }
 
+/** Map of disk positions for blocks with unknown parent (only used for reindex) */
+static std::multimap<uint256, CDiskBlockPos> mapBlocksUnknownParent;
+
+bool ImportBlock(const CChainParams& chainparams, const CBlock& blockIn, const CDiskBlockPos* dbp, int& nLoaded)
+{
+    // detect out of order blocks, and store them for later
+    uint256 hash = blockIn.GetHash();
+    if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex.find(blockIn.hashPrevBlock) == mapBlockIndex.end()) {
+        LogPrint("reindex", "%s: Out of order block %s, parent %s not known\n", __func__, hash.ToString(),
+                blockIn.hashPrevBlock.ToString());
+        if (dbp)
+            mapBlocksUnknownParent.insert(std::make_pair(blockIn.hashPrevBlock, *dbp));
+        return true;
+    }
+
+    // process in case the block isn't known yet
+    if (mapBlockIndex.count(hash) == 0 || (mapBlockIndex[hash]->nStatus & BLOCK_HAVE_DATA) == 0) {
+        LOCK(cs_main);
+        CValidationState state;
+        if (AcceptBlock(blockIn, state, chainparams, NULL, true, dbp, NULL))
+            nLoaded++;
+        if (state.IsError())
+            return false;
+    } else if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex[hash]->nHeight % 1000 == 0) {
+        LogPrint("reindex", "Block Import: already had block %s at height %d\n", hash.ToString(), mapBlockIndex[hash]->nHeight);
+    }
+
+    // Activate the genesis block so normal node progress can continue
+    if (hash == chainparams.GetConsensus().hashGenesisBlock) {
+        CValidationState state;
+        if (!ActivateBestChain(state, chainparams)) {
+            return false;
+        }
+    }
+
+    NotifyHeaderTip();
+
+    // Recursively process earlier encountered successors of this block
+    CBlock block;
+    deque<uint256> queue;
+    queue.push_back(hash);
+    while (!queue.empty()) {
+        uint256 head = queue.front();
+        queue.pop_front();
+        std::pair<std::multimap<uint256, CDiskBlockPos>::iterator, std::multimap<uint256, CDiskBlockPos>::iterator> range = mapBlocksUnknownParent.equal_range(head);
+        while (range.first != range.second) {
+            std::multimap<uint256, CDiskBlockPos>::iterator it = range.first;
+            if (ReadBlockFromDisk(block, it->second, chainparams.GetConsensus()))
+            {
+                LogPrint("reindex", "%s: Processing out of order child %s of %s\n", __func__, block.GetHash().ToString(),
+                        head.ToString());
+                LOCK(cs_main);
+                CValidationState dummy;
+                if (AcceptBlock(block, dummy, chainparams, NULL, true, &it->second, NULL))
+                {
+                    nLoaded++;
+                    queue.push_back(block.GetHash());
+                }
+            }
+            range.first++;
+            mapBlocksUnknownParent.erase(it);
+            NotifyHeaderTip();
+        }
+    }
+    return true;
+}
+
 bool LoadExternalBlockFile(const CChainParams& chainparams, FILE* fileIn, CDiskBlockPos *dbp)
 {
-    // Map of disk positions for blocks with unknown parent (only used for reindex)
-    static std::multimap<uint256, CDiskBlockPos> mapBlocksUnknownParent;
     int64_t nStart = GetTIMECoinMillis();
 
     int nLoaded = 0;
@@ -4045,64 +4155,8 @@ bool LoadExternalBlockFile(const CChainParams& chainparams, FILE* fileIn, CDiskB
                 blkdat >> block;
                 nRewind = blkdat.GetPos();
 
-                // detect out of order blocks, and store them for later
-                uint256 hash = block.GetHash();
-                if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex.find(block.hashPrevBlock) == mapBlockIndex.end()) {
-                    LogPrint("reindex", "%s: Out of order block %s, parent %s not known\n", __func__, hash.ToString(),
-                            block.hashPrevBlock.ToString());
-                    if (dbp)
-                        mapBlocksUnknownParent.insert(std::make_pair(block.hashPrevBlock, *dbp));
-                    continue;
-                }
-
-                // process in case the block isn't known yet
-                if (mapBlockIndex.count(hash) == 0 || (mapBlockIndex[hash]->nStatus & BLOCK_HAVE_DATA) == 0) {
-                    LOCK(cs_main);
-                    CValidationState state;
-                    if (AcceptBlock(block, state, chainparams, NULL, true, dbp, NULL))
-                        nLoaded++;
-                    if (state.IsError())
-                        break;
-                } else if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex[hash]->nHeight % 1000 == 0) {
-                    LogPrint("reindex", "Block Import: already had block %s at height %d\n", hash.ToString(), mapBlockIndex[hash]->nHeight);
-                }
-
-                // Activate the genesis block so normal node progress can continue
-                if (hash == chainparams.GetConsensus().hashGenesisBlock) {
-                    CValidationState state;
-                    if (!ActivateBestChain(state, chainparams)) {
-                        break;
-                    }
-                }
-
-                NotifyHeaderTip();
-
-                // Recursively process earlier encountered successors of this block
-                deque<uint256> queue;
-                queue.push_back(hash);
-                while (!queue.empty()) {
-                    uint256 head = queue.front();
-                    queue.pop_front();
-                    std::pair<std::multimap<uint256, CDiskBlockPos>::iterator, std::multimap<uint256, CDiskBlockPos>::iterator> range = mapBlocksUnknownParent.equal_range(head);
-                    while (range.first != range.second) {
-                        std::multimap<uint256, CDiskBlockPos>::iterator it = range.first;
-                        if (ReadBlockFromDisk(block, it->second, chainparams.GetConsensus()))
-                        {
-                            LogPrint("reindex", "%s: Processing out of order child %s of %s\n", __func__, block.GetHash().ToString(),
-                                    head.ToString());
-                            LOCK(cs_main);
-                            CValidationState dummy;
-                            if (AcceptBlock(block, dummy, chainparams, NULL, true, &it->second, NULL))
-                            {
-                                nLoaded++;
-                                queue.push_back(block.GetHash());
-                            }
-                        }
-                        range.first++;
-                        mapBlocksUnknownParent.erase(it);
-                        NotifyHeaderTip();
-                    }
-                }
+                if (!ImportBlock(chainparams, block, dbp, nLoaded))
+                    break;
             } catch (const std::exception& e) {
                 LogPrintf("%s: Deserialize or I/O error - %s\n", __func__, e.what());
             }
@@ -4378,9 +4432,6 @@ public:
     CMainCleanup() {}
     ~CMainCleanup() {
         // block headers
-        BlockMap::iterator it1 = mapBlockIndex.begin();
-        for (; it1 != mapBlockIndex.end(); it1++)
-            delete (*it1).second;
-        mapBlockIndex.clear();
+        FreeBlockIndex();
     }
 } instance_of_cmaincleanup;
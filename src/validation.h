@@ -14,6 +14,7 @@
 #include "amount.h"
 #include "chain.h"
 #include "coins.h"
+#include "pooledmap.h"
 #include "protocol.h" // For CMessageHeader::MessageStartChars
 #include "script/script_error.h"
 #include "sync.h"
@@ -31,11 +32,13 @@
 
 #include <atomic>
 
+#include <boost/function.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/filesystem/path.hpp>
 
 class CBlockIndex;
 class CBlockTreeDB;
+class CBlockUndo;
 class CBloomFilter;
 class CChainParams;
 class CCoinsViewDB;
@@ -120,6 +123,8 @@ static const bool DEFAULT_TXINDEX = true;
 static const bool DEFAULT_ADDRESSINDEX = false;
 static const bool DEFAULT_TIMECSTAMPINDEX = false;
 static const bool DEFAULT_SPENTINDEX = false;
+static const bool DEFAULT_ADDRESSBALANCEINDEX = false;
+static const bool DEFAULT_COINSTATSINDEX = false;
 static const unsigned int DEFAULT_BANSCORE_THRESHOLD = 100;
 
 static const bool DEFAULT_TESTSAFEMODE = false;
@@ -137,7 +142,8 @@ struct BlockHasher
 extern CScript COINBASE_FLAGS;
 extern CCriticalSection cs_main;
 extern CTxMemPool mempool;
-typedef boost::unordered_map<uint256, CBlockIndex*, BlockHasher> BlockMap;
+/** Block index entries by hash. CBlockIndex::phashBlock points at the key, which the map never moves. */
+typedef pooledmap<uint256, CBlockIndex*, BlockHasher> BlockMap;
 extern BlockMap mapBlockIndex;
 extern uint64_t nLastBlockTx;
 extern uint64_t nLastBlockSize;
@@ -148,6 +154,11 @@ extern bool fImporting;
 extern bool fReindex;
 extern int nScriptCheckThreads;
 extern bool fTxIndex;
+extern bool fAddressIndex;
+extern bool fSpentIndex;
+extern bool fTIMECoinstampIndex;
+extern bool fAddressBalanceIndex;
+extern bool fCoinStatsIndex;
 extern bool fIsBareMultisigStd;
 extern bool fRequireStandard;
 extern unsigned int nBytesPerSigOp;
@@ -165,6 +176,8 @@ extern std::map<uint256, int64_t> mapRejectedBlocks;
 
 extern std::atomic<bool> fDIP0001WasLockedIn;
 extern std::atomic<bool> fDIP0001ActiveAtTip;
+/** Set while loadtxoutset writes a snapshot to the chainstate database: no block is connected and the coins cache is not flushed */
+extern std::atomic<bool> fLoadingUTXOSnapshot;
 
 /** Block hash whose ancestors we will assume to have valid scripts without checking them. */
 extern uint256 hashAssumeValid;
@@ -238,6 +251,12 @@ FILE* OpenUndoFile(const CDiskBlockPos &pos, bool fReadOnly = false);
 boost::filesystem::path GetBlockPosFilename(const CDiskBlockPos &pos, const char *prefix);
 /** Import blocks from an external file */
 bool LoadExternalBlockFile(const CChainParams& chainparams, FILE* fileIn, CDiskBlockPos *dbp = NULL);
+/**
+ * Store one imported block, read from dbp in a block file or from an external
+ * file if dbp is NULL, followed by any earlier read blocks of a block file
+ * that were waiting for it as their parent. Returns false if importing has to stop.
+ */
+bool ImportBlock(const CChainParams& chainparams, const CBlock& block, const CDiskBlockPos* dbp, int& nLoaded);
 /** Initialize a new block tree database + block data on disk */
 bool InitBlockIndex(const CChainParams& chainparams);
 /** Load the block tree and coins database from disk */
@@ -291,6 +310,10 @@ void UnlinkPrunedFiles(std::set<int>& setFilesToPrune);
 CBlockIndex * InsertBlockIndex(uint256 hash);
 /** Flush all state, indexes and buffers to disk. */
 void FlushStateToDisk();
+/** Check the block and transaction counts of a UTXO snapshot against the chain parameters. cs_main must be held. */
+bool CheckUTXOSnapshotBase(const CBlockIndex* pindexBase, unsigned int nTx, unsigned int nChainTx, std::string& strError);
+/** Make the block a UTXO snapshot was loaded at the tip, with the chainstate already at it. cs_main must be held. */
+bool ActivateUTXOSnapshot(CBlockIndex* pindexBase, unsigned int nTx, unsigned int nChainTx);
 /** Prune block files and flush state to disk. */
 void PruneAndFlush();
 
@@ -419,11 +442,19 @@ bool GetAddressIndex(uint160 addressHash, int type,
                      int start = 0, int end = 0);
 bool GetAddressUnspent(uint160 addressHash, int type,
                        std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > &unspentOutputs);
+/** Running totals of an address from the balance index. Returns false if that index is not enabled or not built yet. */
+bool GetAddressBalance(uint160 addressHash, int type, CAddressBalanceValue &value);
+/** Visit address index entries or unspent outputs one at a time, resuming after *pafter if given (see CExplorerIndexDB) */
+bool ForEachAddressIndex(uint160 addressHash, int type, int start, int end, const CAddressIndexKey* pafter,
+                         boost::function<bool(const CAddressIndexKey&, CAmount)> fn);
+bool ForEachAddressUnspent(uint160 addressHash, int type, const CAddressUnspentKey* pafter,
+                           boost::function<bool(const CAddressUnspentKey&, const CAddressUnspentValue&)> fn);
 
 /** Functions for disk access for blocks */
 bool WriteBlockToDisk(const CBlock& block, CDiskBlockPos& pos, const CMessageHeader::MessageStartChars& messageStart);
 bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos, const Consensus::Params& consensusParams);
 bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus::Params& consensusParams);
+bool UndoReadFromDisk(CBlockUndo& blockundo, const CDiskBlockPos& pos, const uint256& hashBlock);
 
 /** Functions for validating blocks and updating the block tree */
 